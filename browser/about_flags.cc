@@ -519,14 +519,6 @@
           kOsAll,                                                              \
           FEATURE_VALUE_TYPE(brave_shields::features::kBraveReduceLanguage),   \
       },                                                                       \
-      {                                                                        \
-          "brave-cosmetic-filtering-sync-load",                                \
-          "Enable sync loading of cosmetic filter rules",                      \
-          "Enable sync loading of cosmetic filter rules",                      \
-          kOsAll,                                                              \
-          FEATURE_VALUE_TYPE(                                                  \
-              brave_shields::features::kCosmeticFilteringSyncLoad),            \
-      },                                                                       \
       {                                                                        \
           "brave-super-referral",                                              \
           "Enable Brave Super Referral",                                       \
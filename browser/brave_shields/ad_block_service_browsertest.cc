@@ -15,6 +15,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/path_service.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
@@ -34,6 +35,7 @@
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "brave/components/constants/brave_paths.h"
 #include "brave/components/constants/pref_names.h"
+#include "brave/components/cosmetic_filters/browser/cosmetic_filters_tab_helper.h"
 #include "brave/components/de_amp/common/pref_names.h"
 #include "brave/components/playlist/common/buildflags/buildflags.h"
 #include "build/build_config.h"
@@ -1962,6 +1964,61 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringSimple) {
   EXPECT_EQ(base::Value(true), result_third.value);
 }
 
+// Resources pushed on navigation commit are used instead of being requested
+// by the frame.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringPushedResources) {
+  base::HistogramTester histogram_tester;
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("b.com###ad-banner");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  auto result =
+      EvalJs(contents, R"(waitCSSSelector('#ad-banner', 'display', 'none'))",
+             content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+
+  content::FetchHistogramsFromChildProcesses();
+  histogram_tester.ExpectTotalCount(
+      "Brave.CosmeticFilters.UrlCosmeticResources", 0);
+}
+
+// A frame that is told resources are coming but never gets them falls back to
+// requesting them.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringPushedResourcesFallback) {
+  base::HistogramTester histogram_tester;
+  auto drop_pushed_resources = cosmetic_filters::CosmeticFiltersTabHelper::
+      DropPushedResourcesForTesting();
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("b.com###ad-banner");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  auto result =
+      EvalJs(contents, R"(waitCSSSelector('#ad-banner', 'display', 'none'))",
+             content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+
+  content::FetchHistogramsFromChildProcesses();
+  EXPECT_FALSE(
+      histogram_tester
+          .GetAllSamples("Brave.CosmeticFilters.UrlCosmeticResources")
+          .empty());
+}
+
 // Test that cosmetic filtering is applied independently in a third-party child
 // frame
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringFrames) {
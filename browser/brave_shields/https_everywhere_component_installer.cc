@@ -124,7 +124,7 @@ void HTTPSEverywhereComponentInstallerPolicy::ComponentReady(
   if (g_browser_process->IsShuttingDown())
     return;
 
-  g_brave_browser_process->https_everywhere_service()->InitDB(path);
+  g_brave_browser_process->https_everywhere_service()->InitDB(path, version);
 }
 
 bool HTTPSEverywhereComponentInstallerPolicy::VerifyInstallation(
@@ -9,6 +9,7 @@
 #include "base/feature_list.h"
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 #include "brave/browser/brave_ads/search_result_ad/search_result_ad_tab_helper.h"
+#include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_news/brave_news_tab_helper.h"
 #include "brave/browser/brave_rewards/rewards_tab_helper.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
@@ -20,12 +21,15 @@
 #include "brave/browser/ui/bookmark/brave_bookmark_tab_helper.h"
 #include "brave/components/brave_news/common/features.h"
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_wayback_machine/buildflags/buildflags.h"
+#include "brave/components/cosmetic_filters/browser/cosmetic_filters_tab_helper.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "brave/components/speedreader/common/buildflags/buildflags.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "build/build_config.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/web_contents.h"
 #include "extensions/buildflags/buildflags.h"
@@ -79,6 +83,13 @@ void AttachTabHelpers(content::WebContents* web_contents) {
 #endif
   brave_shields::BraveShieldsWebContentsObserver::CreateForWebContents(
       web_contents);
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockCosmeticFiltering)) {
+    cosmetic_filters::CosmeticFiltersTabHelper::CreateForWebContents(
+        web_contents, g_brave_browser_process->ad_block_service(),
+        HostContentSettingsMapFactory::GetForProfile(
+            web_contents->GetBrowserContext()));
+  }
 #if BUILDFLAG(IS_ANDROID)
   BackgroundVideoPlaybackTabHelper::CreateForWebContents(web_contents);
 #else
@@ -18,6 +18,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
+#include "base/test/values_test_util.h"
 #include "base/values.h"
 #include "brave/browser/brave_wallet/asset_ratio_service_factory.h"
 #include "brave/browser/brave_wallet/brave_wallet_provider_delegate_impl.h"
@@ -2113,7 +2114,9 @@ TEST_F(EthereumProviderImplUnitTest, EthSubscribeLogs) {
         std::string header_value;
         EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
         std::string content;
-        if (header_value == "eth_getLogs") {
+        if (header_value == "eth_blockNumber") {
+          content = R"({"id":1,"jsonrpc":"2.0","result":"0x10"})";
+        } else if (header_value == "eth_getLogs") {
           content =
               R"({"id":1,"jsonrpc":"2.0","result":[{"address":"0x91",
               "blockHash":"0xe8","blockNumber":"0x10","data":"0x0067",
@@ -2189,6 +2192,13 @@ TEST_F(EthereumProviderImplUnitTest, EthSubscribeLogsFiltered) {
         std::string header_value;
         EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
 
+        if (header_value == "eth_blockNumber") {
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              R"({"id":1,"jsonrpc":"2.0","result":"0xb000"})");
+          return;
+        }
+
         if (header_value == "eth_getLogs") {
           const absl::optional<base::Value> req_body_payload =
               base::JSONReader::Read(
@@ -2244,6 +2254,76 @@ TEST_F(EthereumProviderImplUnitTest, EthSubscribeLogsFiltered) {
   EXPECT_FALSE(provider_->eth_logs_tracker_.IsRunning());
 }
 
+TEST_F(EthereumProviderImplUnitTest, EthSubscribeLogsFollowsLatestBlock) {
+  CreateWallet();
+  std::string latest_block = "0x10";
+  std::vector<base::Value> get_logs_params;
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+
+        std::string header_value;
+        EXPECT_TRUE(request.headers.GetHeader("X-Eth-Method", &header_value));
+        if (header_value == "eth_blockNumber") {
+          url_loader_factory_.AddResponse(
+              request.url.spec(),
+              base::StringPrintf(R"({"id":1,"jsonrpc":"2.0","result":"%s"})",
+                                 latest_block.c_str()));
+          return;
+        }
+
+        EXPECT_EQ(header_value, "eth_getLogs");
+        auto payload = ToValue(request);
+        ASSERT_TRUE(payload);
+        const auto* params = payload->GetDict().FindList("params");
+        ASSERT_TRUE(params);
+        get_logs_params.push_back(params->front().Clone());
+        url_loader_factory_.AddResponse(
+            request.url.spec(),
+            R"({"id":1,"jsonrpc":"2.0","result":[{"address":"0x91",
+                      "blockHash":"0xe8","blockNumber":"0x10","data":"0x0067",
+                      "logIndex":"0x0","removed":false,
+                      "topics":["0x4b","0x06e","0x085"],
+                      "transactionHash":"0x22f7","transactionIndex":"0x0"}]})");
+      }));
+
+  std::string request_payload_json =
+      R"({"id":1,"jsonrpc:": "2.0","method":"eth_subscribe",
+  "params": ["logs", {"address": "0x1111"}]})";
+  absl::optional<base::Value> request_payload = base::JSONReader::Read(
+      request_payload_json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                                base::JSONParserOptions::JSON_PARSE_RFC);
+  auto response = CommonRequestOrSendAsync(request_payload.value());
+  EXPECT_EQ(response.first, false);
+  ASSERT_TRUE(response.second.is_string());
+
+  // The first poll fetches the latest block only.
+  browser_task_environment_.FastForwardBy(
+      base::Seconds(kLogTrackerDefaultTimeInSeconds));
+  EXPECT_TRUE(observer_->MessageEventFired());
+  ASSERT_EQ(get_logs_params.size(), 1u);
+  EXPECT_EQ(get_logs_params[0],
+            base::test::ParseJson(R"({"address": "0x1111", "fromBlock": "0x10",
+                                      "toBlock": "0x10"})"));
+
+  // No new blocks, so no logs are fetched or delivered again.
+  observer_->Reset();
+  browser_task_environment_.FastForwardBy(
+      base::Seconds(kLogTrackerDefaultTimeInSeconds));
+  EXPECT_FALSE(observer_->MessageEventFired());
+  EXPECT_EQ(get_logs_params.size(), 1u);
+
+  // Only the blocks after the last polled one are fetched.
+  latest_block = "0x12";
+  browser_task_environment_.FastForwardBy(
+      base::Seconds(kLogTrackerDefaultTimeInSeconds));
+  EXPECT_TRUE(observer_->MessageEventFired());
+  ASSERT_EQ(get_logs_params.size(), 2u);
+  EXPECT_EQ(get_logs_params[1],
+            base::test::ParseJson(R"({"address": "0x1111", "fromBlock": "0x11",
+                                      "toBlock": "0x12"})"));
+}
+
 TEST_F(EthereumProviderImplUnitTest, Web3ClientVersion) {
   std::string expected_version = base::StringPrintf(
       "BraveWallet/v%s", version_info::GetBraveChromiumVersionNumber().c_str());
@@ -12,6 +12,7 @@
 #include "base/json/json_reader.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/values_test_util.h"
@@ -1383,6 +1384,118 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, UnlockDoesNotBlockCallingSequence) {
+  KeyringService service(json_rpc_service(), GetPrefs(), GetLocalState());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+  ASSERT_TRUE(service.IsLockedSync());
+
+  // Key derivation runs on the thread pool, so Unlock returns before the
+  // result is known and tasks posted to the calling sequence keep running.
+  absl::optional<bool> unlocked;
+  bool posted_task_ran = false;
+  base::RunLoop run_loop;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   run_loop.Quit();
+                 }));
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, base::BindLambdaForTesting([&] { posted_task_ran = true; }));
+  EXPECT_FALSE(unlocked);
+  EXPECT_TRUE(service.IsLockedSync());
+
+  run_loop.Run();
+  EXPECT_TRUE(posted_task_ran);
+  EXPECT_EQ(unlocked, true);
+  EXPECT_FALSE(service.IsLockedSync());
+
+  absl::optional<bool> valid;
+  base::RunLoop validate_run_loop;
+  service.ValidatePassword("brave",
+                           base::BindLambdaForTesting([&](bool result) {
+                             valid = result;
+                             validate_run_loop.Quit();
+                           }));
+  EXPECT_FALSE(valid);
+  validate_run_loop.Run();
+  EXPECT_EQ(valid, true);
+}
+
+TEST_F(KeyringServiceUnitTest, LockAndResetDuringUnlock) {
+  KeyringService service(json_rpc_service(), GetPrefs(), GetLocalState());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // Locking while the keys are derived fails the unlock, and the keyring
+  // stays locked once they are ready.
+  absl::optional<bool> unlocked;
+  service.Unlock("brave", base::BindLambdaForTesting(
+                              [&](bool success) { unlocked = success; }));
+  service.Lock();
+  EXPECT_EQ(unlocked, false);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(service.IsLockedSync());
+  EXPECT_TRUE(service.encryptors_.empty());
+
+  // Same for a reset, which must not end with the wiped wallet unlocked.
+  unlocked.reset();
+  service.Unlock("brave", base::BindLambdaForTesting(
+                              [&](bool success) { unlocked = success; }));
+  service.Reset();
+  EXPECT_EQ(unlocked, false);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(service.IsLockedSync());
+  EXPECT_TRUE(service.encryptors_.empty());
+  EXPECT_FALSE(service.IsKeyringCreated(mojom::kDefaultKeyringId));
+}
+
+TEST_F(KeyringServiceUnitTest, OverlappingUnlock) {
+  KeyringService service(json_rpc_service(), GetPrefs(), GetLocalState());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // A second unlock with the same password, as from a double submit, shares
+  // the result of the keys being derived.
+  absl::optional<bool> first_unlocked;
+  absl::optional<bool> second_unlocked;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   first_unlocked = success;
+                 }));
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   second_unlocked = success;
+                 }));
+  EXPECT_FALSE(first_unlocked);
+  EXPECT_FALSE(second_unlocked);
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(first_unlocked, true);
+  EXPECT_EQ(second_unlocked, true);
+  EXPECT_FALSE(service.IsLockedSync());
+}
+
+TEST_F(KeyringServiceUnitTest, OverlappingUnlockWithAnotherPassword) {
+  KeyringService service(json_rpc_service(), GetPrefs(), GetLocalState());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // An unlock with another password waits for the pending one, then derives
+  // its own keys.
+  absl::optional<bool> first_unlocked;
+  absl::optional<bool> second_unlocked;
+  service.Unlock("brave123", base::BindLambdaForTesting([&](bool success) {
+                   first_unlocked = success;
+                 }));
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   EXPECT_EQ(first_unlocked, false);
+                   second_unlocked = success;
+                 }));
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(first_unlocked, false);
+  EXPECT_EQ(second_unlocked, true);
+  EXPECT_FALSE(service.IsLockedSync());
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs(), GetLocalState());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
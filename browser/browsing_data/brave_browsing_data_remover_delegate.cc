@@ -13,6 +13,7 @@
 #include "brave/components/brave_news/common/features.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
+#include "brave/components/speedreader/common/buildflags/buildflags.h"
 #include "build/build_config.h"
 #include "chrome/browser/browsing_data/chrome_browsing_data_remover_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -33,6 +34,11 @@
 #include "brave/components/ipfs/ipfs_service.h"
 #endif
 
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/speedreader/speedreader_service_factory.h"
+#include "brave/components/speedreader/speedreader_service.h"
+#endif
+
 BraveBrowsingDataRemoverDelegate::BraveBrowsingDataRemoverDelegate(
     content::BrowserContext* browser_context)
     : ChromeBrowsingDataRemoverDelegate(browser_context),
@@ -65,6 +71,14 @@ void BraveBrowsingDataRemoverDelegate::RemoveEmbedderData(
 #if BUILDFLAG(ENABLE_IPFS)
   if (remove_mask & content::BrowsingDataRemover::DATA_TYPE_CACHE)
     ClearIPFSCache();
+#endif
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+  // Distilled pages are kept in memory for the life of the profile.
+  if (remove_mask & content::BrowsingDataRemover::DATA_TYPE_CACHE) {
+    speedreader::SpeedreaderServiceFactory::GetForProfile(profile_)
+        ->distilled_page_cache()
+        ->Clear();
+  }
 #endif
   if (base::FeatureList::IsEnabled(brave_news::features::kBraveNewsFeature)) {
     // Brave News feed cache
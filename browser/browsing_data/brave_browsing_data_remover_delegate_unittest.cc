@@ -13,14 +13,23 @@
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
+#include "brave/components/speedreader/common/buildflags/buildflags.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/test/base/testing_profile.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_types.h"
+#include "content/public/browser/browsing_data_remover.h"
 #include "content/public/test/browser_task_environment.h"
+#include "content/public/test/browsing_data_remover_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/speedreader/speedreader_service_factory.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+#include "brave/components/speedreader/speedreader_service.h"
+#endif
+
 class BraveBrowsingDataRemoverDelegateTest : public testing::Test {
  public:
   void SetUp() override {
@@ -85,3 +94,23 @@ TEST_F(BraveBrowsingDataRemoverDelegateTest, ShieldsSettingsClearTest) {
   delegate()->ClearShieldsSettings(k1DaysOld, kNow);
   EXPECT_EQ(start_count, GetShieldsSettingsCount());
 }
+
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+TEST_F(BraveBrowsingDataRemoverDelegateTest, SpeedreaderCacheClearTest) {
+  speedreader::SpeedreaderDistilledPageCache* cache =
+      speedreader::SpeedreaderServiceFactory::GetForProfile(profile())
+          ->distilled_page_cache();
+  cache->Put("key", speedreader::DistilledPage("content", base::TimeDelta()));
+  ASSERT_EQ(1u, cache->size());
+
+  content::BrowsingDataRemover* remover = profile()->GetBrowsingDataRemover();
+  content::BrowsingDataRemoverCompletionObserver observer(remover);
+  remover->RemoveAndReply(
+      base::Time(), base::Time::Max(),
+      content::BrowsingDataRemover::DATA_TYPE_CACHE,
+      content::BrowsingDataRemover::ORIGIN_TYPE_UNPROTECTED_WEB, &observer);
+  observer.BlockUntilCompletion();
+
+  EXPECT_EQ(0u, cache->size());
+}
+#endif
@@ -8,12 +8,18 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
 #include "brave/browser/ipfs/ipfs_blob_context_getter_factory.h"
+#include "brave/components/ipfs/import/ipfs_multipart_data_pipe_getter.h"
 #include "chrome/test/base/testing_profile.h"
 #include "content/public/test/browser_task_environment.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_utils.h"
+#include "net/base/net_errors.h"
 #include "services/network/public/cpp/data_element.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "storage/browser/blob/blob_data_builder.h"
@@ -111,6 +117,69 @@ TEST_F(IpfsNetwrokUtilsUnitTest, CreateRequestForFileTest) {
   run_loop.Run();
 }
 
+TEST_F(IpfsNetwrokUtilsUnitTest, CreateStreamingRequestForFileTest) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  std::string content = "test\n\rmultiline\n\rcontent";
+  std::string filename = "test_name";
+  base::FilePath upload_file_path =
+      CreateCustomTestFile(dir.GetPath(), filename, content);
+  std::unique_ptr<network::ResourceRequest> request;
+  CreateStreamingRequestForFile(
+      upload_file_path, "test/type", filename, ImportProgressCallback(),
+      base::BindLambdaForTesting(
+          [&](std::unique_ptr<network::ResourceRequest> result) {
+            request = std::move(result);
+          }),
+      content.size());
+  ASSERT_TRUE(request);
+  ValidateRequest(base::OnceClosure(), std::move(request));
+}
+
+TEST_F(IpfsNetwrokUtilsUnitTest, StreamingRequestBody) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  // Spans several upload chunks.
+  std::string content(kUploadChunkSize * 3 + 17, 'x');
+  base::FilePath upload_file_path =
+      CreateCustomTestFile(dir.GetPath(), "test_name", content);
+  uint64_t uploaded = 0;
+  uint64_t total = 0;
+  std::vector<MultipartUploadSegment> segments;
+  segments.push_back(MultipartUploadSegment::FromData("header"));
+  segments.push_back(
+      MultipartUploadSegment::FromFile(upload_file_path, content.size()));
+  segments.push_back(MultipartUploadSegment::FromData("footer"));
+  mojo::Remote<network::mojom::DataPipeGetter> getter(
+      IpfsMultipartDataPipeGetter::Create(
+          std::move(segments),
+          base::BindLambdaForTesting(
+              [&](uint64_t uploaded_bytes, uint64_t total_bytes) {
+                EXPECT_GE(uploaded_bytes, uploaded);
+                uploaded = uploaded_bytes;
+                total = total_bytes;
+              })));
+
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  ASSERT_EQ(MOJO_RESULT_OK, mojo::CreateDataPipe(nullptr, producer, consumer));
+  base::RunLoop run_loop;
+  getter->Read(std::move(producer),
+               base::BindLambdaForTesting([&](int32_t status, uint64_t size) {
+                 EXPECT_EQ(net::OK, status);
+                 EXPECT_EQ(content.size() + 12, size);
+                 run_loop.Quit();
+               }));
+  run_loop.Run();
+
+  std::string body;
+  ASSERT_TRUE(mojo::BlockingCopyToString(std::move(consumer), &body));
+  EXPECT_EQ("header" + content + "footer", body);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(body.size(), uploaded);
+  EXPECT_EQ(body.size(), total);
+}
+
 TEST_F(IpfsNetwrokUtilsUnitTest, CreateRequestForTextTest) {
   std::string text = "test\n\rmultiline\n\rcontent";
   std::string filename = "test_name";
@@ -137,7 +206,7 @@ TEST_F(IpfsNetwrokUtilsUnitTest, CreateRequestForFolderTest) {
   auto upload_callback =
       base::BindOnce(&IpfsNetwrokUtilsUnitTest::ValidateRequest,
                      base::Unretained(this), run_loop.QuitClosure());
-  CreateRequestForFolder(dir.GetPath(), blob_getter_factory(),
+  CreateRequestForFolder(dir.GetPath(), ImportProgressCallback(),
                          std::move(upload_callback));
   run_loop.Run();
 }
@@ -5,20 +5,28 @@
 
 #include "brave/browser/ntp_background/custom_background_file_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/thread_pool.h"
 #include "brave/browser/ntp_background/constants.h"
+#include "brave/browser/ntp_background/ntp_custom_background_images_service_factory.h"
+#include "brave/components/ntp_background_images/browser/ntp_custom_background_images_service.h"
 #include "chrome/browser/image_fetcher/image_decoder_impl.h"
 #include "chrome/browser/profiles/profile.h"
 #include "services/data_decoder/public/cpp/data_decoder.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/display/display.h"
+#include "ui/display/screen.h"
 #include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/image/image.h"
 
 namespace {
@@ -28,6 +36,37 @@ data_decoder::DataDecoder* GetDataDecoder() {
   return data_decoder.get();
 }
 
+// Custom backgrounds cover the new tab page, so they are never shown larger
+// than the largest display.
+gfx::Size GetMaxDisplaySizeInPixels() {
+  gfx::Size max_size;
+  auto* screen = display::Screen::GetScreen();
+  if (!screen)
+    return max_size;
+
+  for (const auto& display : screen->GetAllDisplays())
+    max_size.SetToMax(display.GetSizeInPixel());
+  return max_size;
+}
+
+// Downscales |bitmap|, keeping its aspect ratio, to the smallest size which
+// still covers |size|. Smaller bitmaps are left as is.
+SkBitmap DownscaleToCover(const SkBitmap& bitmap, const gfx::Size& size) {
+  if (size.IsEmpty() || bitmap.drawsNothing())
+    return bitmap;
+
+  const double scale =
+      std::max(static_cast<double>(size.width()) / bitmap.width(),
+               static_cast<double>(size.height()) / bitmap.height());
+  if (scale >= 1)
+    return bitmap;
+
+  return skia::ImageOperations::Resize(
+      bitmap, skia::ImageOperations::RESIZE_BEST,
+      std::max(1, base::ClampRound(bitmap.width() * scale)),
+      std::max(1, base::ClampRound(bitmap.height() * scale)));
+}
+
 }  // namespace
 
 CustomBackgroundFileManager::CustomBackgroundFileManager(Profile* profile)
@@ -66,6 +105,8 @@ void CustomBackgroundFileManager::SaveImage(
 void CustomBackgroundFileManager::MoveImage(
     const base::FilePath& source_file_path,
     base::OnceCallback<void(bool /*result*/)> callback) {
+  const auto target_path =
+      GetCustomBackgroundDirectory().Append(source_file_path.BaseName());
   auto move_file = base::BindOnce(
       [](const base::FilePath& source_file, const base::FilePath& target_path) {
         base::File::Info info;
@@ -82,8 +123,10 @@ void CustomBackgroundFileManager::MoveImage(
 
         return true;
       },
-      source_file_path,
-      GetCustomBackgroundDirectory().Append(source_file_path.BaseName()));
+      source_file_path, target_path);
+  callback = base::BindOnce(&CustomBackgroundFileManager::OnImageMovedOrRemoved,
+                            weak_factory_.GetWeakPtr(), target_path,
+                            std::move(callback));
 
   auto on_check_dir = base::BindOnce(
       [](base::OnceCallback<bool()> move,
@@ -108,7 +151,10 @@ void CustomBackgroundFileManager::RemoveImage(
     base::OnceCallback<void(bool /*result*/)> callback) {
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(base::DeleteFile, file_path), std::move(callback));
+      base::BindOnce(base::DeleteFile, file_path),
+      base::BindOnce(&CustomBackgroundFileManager::OnImageMovedOrRemoved,
+                     weak_factory_.GetWeakPtr(), file_path,
+                     std::move(callback)));
 }
 
 base::FilePath CustomBackgroundFileManager::GetCustomBackgroundDirectory()
@@ -187,11 +233,15 @@ void CustomBackgroundFileManager::SaveImageAsPNG(
     DVLOG(2) << __func__ << "Given |image| is empty";
     return std::move(callback).Run(base::FilePath());
   }
+  // The image is decoded here anyway, so it is also downscaled once here
+  // rather than every time it is shown.
   auto encode_and_save = base::BindOnce(
-      [](const SkBitmap& bitmap, const base::FilePath& target_path) {
+      [](const SkBitmap& bitmap, const gfx::Size& max_size,
+         const base::FilePath& target_path) {
         auto encoded = base::MakeRefCounted<base::RefCountedBytes>();
         if (!gfx::PNGCodec::EncodeBGRASkBitmap(
-                bitmap, /*discard_transparency=*/false, &encoded->data())) {
+                DownscaleToCover(bitmap, max_size),
+                /*discard_transparency=*/false, &encoded->data())) {
           DVLOG(2) << "Failed to encode image as PNG";
           return base::FilePath();
         }
@@ -211,9 +261,33 @@ void CustomBackgroundFileManager::SaveImageAsPNG(
 
         return modified_path;
       },
-      image.AsBitmap(), target_path);
+      image.AsBitmap(), GetMaxDisplaySizeInPixels(), target_path);
 
-  base::ThreadPool::PostTaskAndReplyWithResult(FROM_HERE, {base::MayBlock()},
-                                               std::move(encode_and_save),
-                                               std::move(callback));
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()}, std::move(encode_and_save),
+      base::BindOnce(&CustomBackgroundFileManager::OnImageSaved,
+                     weak_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void CustomBackgroundFileManager::OnImageSaved(SaveFileCallback callback,
+                                               const base::FilePath& path) {
+  if (!path.empty())
+    InvalidateCachedImage(path);
+  std::move(callback).Run(path);
+}
+
+void CustomBackgroundFileManager::OnImageMovedOrRemoved(
+    const base::FilePath& path,
+    base::OnceCallback<void(bool /*result*/)> callback,
+    bool result) {
+  InvalidateCachedImage(path);
+  std::move(callback).Run(result);
+}
+
+void CustomBackgroundFileManager::InvalidateCachedImage(
+    const base::FilePath& path) {
+  if (auto* service =
+          NTPCustomBackgroundImagesServiceFactory::GetForContext(profile_)) {
+    service->OnCustomImageChanged(path);
+  }
 }
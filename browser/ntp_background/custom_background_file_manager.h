@@ -192,6 +192,12 @@ class CustomBackgroundFileManager final {
   void SaveImageAsPNG(SaveFileCallback callback,
                       const base::FilePath& target_path,
                       const gfx::Image& image);
+  void OnImageSaved(SaveFileCallback callback, const base::FilePath& path);
+  void OnImageMovedOrRemoved(const base::FilePath& path,
+                             base::OnceCallback<void(bool /*result*/)> callback,
+                             bool result);
+  // Drops |path| from the custom images cached for the new tab page.
+  void InvalidateCachedImage(const base::FilePath& path);
 
   raw_ptr<Profile> profile_ = nullptr;
 
@@ -5,21 +5,30 @@
 
 #include "brave/browser/ntp_background/custom_background_file_manager.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/path_service.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/ntp_background/constants.h"
+#include "brave/browser/ntp_background/ntp_custom_background_images_service_factory.h"
 #include "brave/components/constants/brave_paths.h"
+#include "brave/components/ntp_background_images/browser/ntp_custom_background_images_service.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "content/public/test/browser_task_environment.h"
 #include "content/public/test/browser_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "ui/gfx/codec/png_codec.h"
 
 // CustomBackgroundFileManager requires data decoder which can't be initialized
 // in unit tests.
@@ -140,3 +149,74 @@ IN_PROC_BROWSER_TEST_F(CustomBackgroundFileManagerBrowserTest,
     EXPECT_TRUE(base::PathExists(test_file()));
   }
 }
+
+IN_PROC_BROWSER_TEST_F(CustomBackgroundFileManagerBrowserTest,
+                       ReuploadAfterRemoveIsNotServedFromCache) {
+  auto* service = NTPCustomBackgroundImagesServiceFactory::GetForContext(
+      browser()->profile());
+  ASSERT_TRUE(service);
+
+  auto save_image = [&]() {
+    base::FilePath saved_path;
+    base::RunLoop run_loop;
+    custom_file_manager().SaveImage(
+        test_file(),
+        base::BindLambdaForTesting([&](const base::FilePath& path) {
+          saved_path = path;
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return saved_path;
+  };
+  auto get_cached_image = [&](const base::FilePath& path) {
+    scoped_refptr<base::RefCountedMemory> result;
+    base::RunLoop run_loop;
+    service->image_cache()->Get(
+        path, base::BindLambdaForTesting(
+                  [&](scoped_refptr<base::RefCountedMemory> bytes) {
+                    result = std::move(bytes);
+                    run_loop.Quit();
+                  }));
+    run_loop.Run();
+    return result;
+  };
+
+  const base::FilePath path = save_image();
+  ASSERT_FALSE(path.empty());
+  const scoped_refptr<base::RefCountedMemory> old_bytes =
+      get_cached_image(path);
+  ASSERT_TRUE(old_bytes);
+
+  base::RunLoop run_loop;
+  custom_file_manager().RemoveImage(
+      path, base::BindLambdaForTesting([&](bool result) {
+        EXPECT_TRUE(result);
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+  EXPECT_FALSE(service->image_cache()->IsCached(path));
+
+  // Another image uploaded with the same name.
+  {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(4, 4);
+    bitmap.eraseColor(SK_ColorRED);
+    std::vector<unsigned char> png;
+    ASSERT_TRUE(gfx::PNGCodec::EncodeBGRASkBitmap(
+        bitmap, /*discard_transparency=*/false, &png));
+    base::ScopedAllowBlockingForTesting allow_blocking_call;
+    ASSERT_TRUE(base::WriteFile(test_file(), png));
+  }
+  ASSERT_EQ(path, save_image());
+
+  const scoped_refptr<base::RefCountedMemory> new_bytes =
+      get_cached_image(path);
+  ASSERT_TRUE(new_bytes);
+  EXPECT_FALSE(new_bytes->Equals(old_bytes));
+
+  std::string contents;
+  base::ScopedAllowBlockingForTesting allow_blocking_call;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  EXPECT_EQ(contents, std::string(new_bytes->front_as<char>(),
+                                  new_bytes->size()));
+}
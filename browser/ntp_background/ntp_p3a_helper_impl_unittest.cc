@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include "base/files/scoped_temp_dir.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/strings/strcat.h"
 #include "base/test/metrics/histogram_tester.h"
@@ -37,6 +38,7 @@ class NTPP3AHelperImplTest : public testing::Test {
 
  protected:
   void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
     histogram_tester_ = std::make_unique<base::HistogramTester>();
 
     brave::BraveP3AService::RegisterPrefs(local_state_.registry(),
@@ -44,7 +46,8 @@ class NTPP3AHelperImplTest : public testing::Test {
     NTPP3AHelperImpl::RegisterLocalStatePrefs(local_state_.registry());
 
     p3a_service_ = scoped_refptr(
-        new brave::BraveP3AService(&local_state_, "release", "2049-01-01"));
+        new brave::BraveP3AService(&local_state_, "release", "2049-01-01",
+                                   temp_dir_.GetPath()));
 
     ntp_p3a_helper_ = std::make_unique<NTPP3AHelperImpl>(
         &local_state_, p3a_service_.get(), &ads_service_);
@@ -55,6 +58,7 @@ class NTPP3AHelperImplTest : public testing::Test {
         {kHistogramPrefix, kTestCreativeMetricId, ".", event_type});
   }
 
+  base::ScopedTempDir temp_dir_;
   content::BrowserTaskEnvironment task_environment_;
   std::unique_ptr<base::HistogramTester> histogram_tester_;
 
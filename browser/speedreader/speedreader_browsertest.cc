@@ -11,6 +11,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/app/brave_command_ids.h"
 #include "brave/browser/speedreader/speedreader_service_factory.h"
@@ -286,6 +287,17 @@ IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, P3ATest) {
   tester.ExpectBucketCount(kSpeedreaderToggleUMAHistogramName, 2, 0);
 }
 
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, TimeToFirstByte) {
+  base::HistogramTester tester;
+  ToggleSpeedreader();
+
+  // Recorded once for each page that goes through the distiller.
+  NavigateToPageSynchronously(kTestPageReadable);
+  EXPECT_TRUE(
+      speedreader::PageStateIsDistilled(tab_helper()->PageDistillState()));
+  tester.ExpectTotalCount("Brave.Speedreader.TimeToFirstByte", 1);
+}
+
 IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, ClickingOnReaderButton) {
   EXPECT_FALSE(speedreader_service()->IsEnabled());
 
@@ -16,38 +16,18 @@ namespace net {
 
 CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
                              NetLog* net_log)
-    : ChromiumCookieMonster(store, net_log),
-      net_log_(
-          NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)) {}
+    : ChromiumCookieMonster(store, net_log) {}
 
 CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
                              base::TimeDelta last_access_threshold,
                              NetLog* net_log)
-    : ChromiumCookieMonster(store, last_access_threshold, net_log),
-      net_log_(
-          NetLogWithSource::Make(net_log, NetLogSourceType::COOKIE_STORE)) {}
+    : ChromiumCookieMonster(store, last_access_threshold, net_log) {}
 
 CookieMonster::~CookieMonster() {}
 
-ChromiumCookieMonster*
-CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
-    const GURL& top_frame_url) {
-  std::string domain = URLToEphemeralStorageDomain(top_frame_url);
-  auto it = ephemeral_cookie_stores_.find(domain);
-  if (it != ephemeral_cookie_stores_.end())
-    return it->second.get();
-
-  return ephemeral_cookie_stores_
-      .emplace(domain, new ChromiumCookieMonster(nullptr /* store */,
-                                                 net_log_.net_log()))
-      .first->second.get();
-}
-
 void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
                                                DeleteCallback callback) {
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteCanonicalCookieAsync(cookie, DeleteCallback());
-  }
+  ephemeral_cookie_store_.DeleteCanonicalCookie(cookie);
   ChromiumCookieMonster::DeleteCanonicalCookieAsync(cookie,
                                                     std::move(callback));
 }
@@ -55,10 +35,7 @@ void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
 void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
     const CookieDeletionInfo::TimeRange& creation_range,
     DeleteCallback callback) {
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteAllCreatedInTimeRangeAsync(creation_range,
-                                                DeleteCallback());
-  }
+  ephemeral_cookie_store_.DeleteAllCreatedInTimeRange(creation_range);
   ChromiumCookieMonster::DeleteAllCreatedInTimeRangeAsync(creation_range,
                                                           std::move(callback));
 }
@@ -66,31 +43,26 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
 void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
                                                DeleteCallback callback) {
   if (delete_info.ephemeral_storage_domain.has_value()) {
-    ephemeral_cookie_stores_.erase(*delete_info.ephemeral_storage_domain);
+    ephemeral_cookie_store_.DeletePartition(
+        *delete_info.ephemeral_storage_domain);
     std::move(callback).Run(0);
     return;
   }
 
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteAllMatchingInfoAsync(delete_info, DeleteCallback());
-  }
+  ephemeral_cookie_store_.DeleteAllMatchingInfo(delete_info);
   ChromiumCookieMonster::DeleteAllMatchingInfoAsync(delete_info,
                                                     std::move(callback));
 }
 
 void CookieMonster::DeleteSessionCookiesAsync(DeleteCallback callback) {
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->DeleteSessionCookiesAsync(DeleteCallback());
-  }
+  ephemeral_cookie_store_.DeleteSessionCookies();
   ChromiumCookieMonster::DeleteSessionCookiesAsync(std::move(callback));
 }
 
 void CookieMonster::SetCookieableSchemes(
     const std::vector<std::string>& schemes,
     SetCookieableSchemesCallback callback) {
-  for (auto& it : ephemeral_cookie_stores_) {
-    it.second->SetCookieableSchemes(schemes, SetCookieableSchemesCallback());
-  }
+  ephemeral_cookie_store_.SetCookieableSchemes(schemes);
   ChromiumCookieMonster::SetCookieableSchemes(schemes, std::move(callback));
 }
 
@@ -110,12 +82,10 @@ void CookieMonster::SetCanonicalCookieAsync(
               CookieInclusionStatus::EXCLUDE_UNKNOWN_ERROR)));
       return;
     }
-    ChromiumCookieMonster* ephemeral_monster =
-        GetOrCreateEphemeralCookieStoreForTopFrameURL(
-            options.top_frame_origin()->GetURL());
-    ephemeral_monster->SetCanonicalCookieAsync(std::move(cookie), source_url,
-                                               options, std::move(callback),
-                                               std::move(cookie_access_result));
+    ephemeral_cookie_store_.SetCanonicalCookie(
+        URLToEphemeralStorageDomain(options.top_frame_origin()->GetURL()),
+        std::move(cookie), source_url, options, std::move(callback),
+        std::move(cookie_access_result));
     return;
   }
 
@@ -137,11 +107,9 @@ void CookieMonster::GetCookieListWithOptionsAsync(
                              CookieAccessResultList());
       return;
     }
-    ChromiumCookieMonster* ephemeral_monster =
-        GetOrCreateEphemeralCookieStoreForTopFrameURL(
-            options.top_frame_origin()->GetURL());
-    ephemeral_monster->GetCookieListWithOptionsAsync(
-        url, options, cookie_partition_key_collection, std::move(callback));
+    ephemeral_cookie_store_.GetCookieListWithOptions(
+        URLToEphemeralStorageDomain(options.top_frame_origin()->GetURL()), url,
+        options, cookie_partition_key_collection, std::move(callback));
     return;
   }
 
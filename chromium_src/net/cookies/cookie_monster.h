@@ -6,6 +6,8 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 
+#include "brave/net/cookies/ephemeral_cookie_store.h"
+
 #define CookieMonster ChromiumCookieMonster
 #include "src/net/cookies/cookie_monster.h"  // IWYU pragma: export
 #undef CookieMonster
@@ -25,7 +27,7 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
   // CookieStore implementation.
   //
   // This only includes methods that needs special behavior to deal with
-  // our collection of ephemeral monsters.
+  // ephemeral cookies.
   void DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
                                   DeleteCallback callback) override;
   void DeleteAllCreatedInTimeRangeAsync(
@@ -51,11 +53,9 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
       GetCookieListCallback callback) override;
 
  private:
-  NetLogWithSource net_log_;
-  std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
-      ephemeral_cookie_stores_;
-  ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
-      const GURL& top_frame_url);
+  // Cookies of all ephemeral storage partitions, keyed by the ephemeral
+  // storage domain of the top frame.
+  EphemeralCookieStore ephemeral_cookie_store_;
 };
 
 }  // namespace net
@@ -78,6 +78,12 @@ BASE_FEATURE(kBraveRoundTimeStamps,
              "BraveRoundTimeStamps",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+// Seeds canvas farbling from a SipHash over sampled tiles of the canvas
+// instead of an HMAC-SHA256 over all of its pixels.
+BASE_FEATURE(kBraveCanvasFarblingV2,
+             "BraveCanvasFarblingV2",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // Enable EventSource connection pool limit per eTLD+1.
 BASE_FEATURE(kRestrictEventSourcePool,
              "RestrictEventSourcePool",
@@ -21,7 +21,7 @@
 #include "brave/components/brave_ads/core/internal/ads/serving/targeting/user_model_info.h"
 #include "brave/components/brave_ads/core/internal/ads_client_helper.h"
 #include "brave/components/brave_ads/core/internal/common/logging_util.h"
-#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
 #include "brave/components/brave_ads/core/internal/geographic/subdivision/subdivision_targeting.h"
 #include "brave/components/brave_ads/core/internal/resources/behavioral/anti_targeting/anti_targeting_resource.h"
 
@@ -98,8 +98,7 @@ void EligibleAdsV1::GetForChildSegments(
     BLOG(1, "  " << segment);
   }
 
-  const database::table::CreativeNotificationAds database_table;
-  database_table.GetForSegments(
+  CreativeNotificationAdsServingIndex::GetInstance()->GetForSegments(
       segments,
       base::BindOnce(&EligibleAdsV1::OnGetForChildSegments,
                      base::Unretained(this), std::move(user_model), ad_events,
@@ -153,8 +152,7 @@ void EligibleAdsV1::GetForParentSegments(
     BLOG(1, "  " << segment);
   }
 
-  const database::table::CreativeNotificationAds database_table;
-  database_table.GetForSegments(
+  CreativeNotificationAdsServingIndex::GetInstance()->GetForSegments(
       segments, base::BindOnce(&EligibleAdsV1::OnGetForParentSegments,
                                base::Unretained(this), ad_events,
                                browsing_history, std::move(callback)));
@@ -195,8 +193,7 @@ void EligibleAdsV1::GetForUntargeted(
     GetEligibleAdsCallback<CreativeNotificationAdList> callback) {
   BLOG(1, "Get eligible ads for untargeted segment");
 
-  const database::table::CreativeNotificationAds database_table;
-  database_table.GetForSegments(
+  CreativeNotificationAdsServingIndex::GetInstance()->GetForSegments(
       {kUntargeted},
       base::BindOnce(&EligibleAdsV1::OnGetForUntargeted, base::Unretained(this),
                      ad_events, browsing_history, std::move(callback)));
@@ -16,7 +16,7 @@
 #include "brave/components/brave_ads/core/internal/ads/serving/targeting/user_model_info.h"
 #include "brave/components/brave_ads/core/internal/ads_client_helper.h"
 #include "brave/components/brave_ads/core/internal/common/logging_util.h"
-#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
 #include "brave/components/brave_ads/core/internal/geographic/subdivision/subdivision_targeting.h"
 #include "brave/components/brave_ads/core/internal/resources/behavioral/anti_targeting/anti_targeting_resource.h"
 #include "brave/components/brave_ads/core/internal/segments/segment_alias.h"
@@ -74,8 +74,7 @@ void EligibleAdsV2::GetEligibleAds(
     const AdEventList& ad_events,
     GetEligibleAdsCallback<CreativeNotificationAdList> callback,
     const BrowsingHistoryList& browsing_history) {
-  const database::table::CreativeNotificationAds database_table;
-  database_table.GetAll(base::BindOnce(
+  CreativeNotificationAdsServingIndex::GetInstance()->GetAll(base::BindOnce(
       &EligibleAdsV2::OnGetEligibleAds, base::Unretained(this),
       std::move(user_model), ad_events, browsing_history, std::move(callback)));
 }
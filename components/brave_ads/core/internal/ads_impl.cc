@@ -29,6 +29,7 @@
 #include "brave/components/brave_ads/core/internal/conversions/conversion_queue_item_info.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversions.h"
 #include "brave/components/brave_ads/core/internal/covariates/covariate_manager.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
 #include "brave/components/brave_ads/core/internal/creatives/notification_ads/notification_ad_manager.h"
 #include "brave/components/brave_ads/core/internal/database/database_manager.h"
 #include "brave/components/brave_ads/core/internal/deprecated/client/client_state_manager.h"
@@ -83,6 +84,8 @@ AdsImpl::AdsImpl(AdsClient* ads_client)
   client_state_manager_ = std::make_unique<ClientStateManager>();
   confirmation_state_manager_ = std::make_unique<ConfirmationStateManager>();
   covariate_manager_ = std::make_unique<CovariateManager>();
+  creative_notification_ads_serving_index_ =
+      std::make_unique<CreativeNotificationAdsServingIndex>();
   database_manager_ = std::make_unique<DatabaseManager>();
   diagnostic_manager_ = std::make_unique<DiagnosticManager>();
   flag_manager_ = std::make_unique<FlagManager>();
@@ -102,7 +105,7 @@ AdsImpl::AdsImpl(AdsClient* ads_client)
 
   transfer_ = std::make_unique<Transfer>();
 
-  conversions_ = std::make_unique<Conversions>();
+  conversions_ = std::make_unique<Conversions>(catalog_.get());
 
   subdivision_targeting_ = std::make_unique<geographic::SubdivisionTargeting>();
 
@@ -62,6 +62,7 @@ class ClientStateManager;
 class ConfirmationStateManager;
 class Conversions;
 class CovariateManager;
+class CreativeNotificationAdsServingIndex;
 class DatabaseManager;
 class DiagnosticManager;
 class FlagManager;
@@ -228,6 +229,8 @@ class AdsImpl final : public Ads,
   std::unique_ptr<FlagManager> flag_manager_;
   std::unique_ptr<ConfirmationStateManager> confirmation_state_manager_;
   std::unique_ptr<CovariateManager> covariate_manager_;
+  std::unique_ptr<CreativeNotificationAdsServingIndex>
+      creative_notification_ads_serving_index_;
   std::unique_ptr<DatabaseManager> database_manager_;
   std::unique_ptr<DiagnosticManager> diagnostic_manager_;
   std::unique_ptr<HistoryManager> history_manager_;
@@ -13,9 +13,8 @@
 #include "brave/components/brave_ads/core/internal/ads_client_helper.h"
 #include "brave/components/brave_ads/core/internal/catalog/catalog_info.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversions_database_util.h"
-#include "brave/components/brave_ads/core/internal/creatives/campaigns_database_util.h"
-#include "brave/components/brave_ads/core/internal/creatives/creative_ads_database_util.h"
 #include "brave/components/brave_ads/core/internal/creatives/creatives_builder.h"
+#include "brave/components/brave_ads/core/internal/creatives/creatives_database_util.h"
 #include "brave/components/brave_ads/core/internal/creatives/creatives_info.h"
 #include "brave/components/brave_ads/core/internal/creatives/dayparts_database_util.h"
 #include "brave/components/brave_ads/core/internal/creatives/geo_targets_database_util.h"
@@ -31,14 +30,13 @@ namespace {
 
 constexpr base::TimeDelta kCatalogLifespan = base::Days(1);
 
-void Delete() {
-  database::DeleteCampaigns();
-  database::DeleteCreativeNotificationAds();
-  database::DeleteCreativeInlineContentAds();
-  database::DeleteCreativeNewTabPageAds();
+void Delete(const CreativesInfo& creatives) {
+  // Campaigns and creative ads are keyed by id, so only those which are no
+  // longer in the catalog are deleted and the rest are upserted when saved.
+  database::DeleteCreativesNotIn(creatives);
+
+  // Tables keyed by multiple columns are replaced.
   database::DeleteCreativeNewTabPageAdWallpapers();
-  database::DeleteCreativePromotedContentAds();
-  database::DeleteCreativeAds();
   database::DeleteSegments();
   database::DeleteGeoTargets();
   database::DeleteDayparts();
@@ -52,7 +50,9 @@ void PurgeExpired() {
 }  // namespace
 
 void SaveCatalog(const CatalogInfo& catalog) {
-  Delete();
+  const CreativesInfo creatives = BuildCreatives(catalog);
+
+  Delete(creatives);
 
   PurgeExpired();
 
@@ -60,7 +60,6 @@ void SaveCatalog(const CatalogInfo& catalog) {
   SetCatalogVersion(catalog.version);
   SetCatalogPing(catalog.ping);
 
-  const CreativesInfo creatives = BuildCreatives(catalog);
   database::SaveCreativeNotificationAds(creatives.notification_ads);
   database::SaveCreativeInlineContentAds(creatives.inline_content_ads);
   database::SaveCreativeNewTabPageAds(creatives.new_tab_page_ads);
@@ -11,6 +11,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "brave/components/brave_ads/common/interfaces/ads.mojom.h"
+#include "brave/components/brave_ads/core/internal/common/database/database_bind_util.h"
 
 namespace ads::database {
 
@@ -93,6 +94,32 @@ void DeleteTable(mojom::DBTransactionInfo* transaction,
   transaction->commands.push_back(std::move(command));
 }
 
+void DeleteTableRowsExcept(mojom::DBTransactionInfo* transaction,
+                           const std::string& table_name,
+                           const std::string& column,
+                           const std::vector<std::string>& values) {
+  DCHECK(transaction);
+  DCHECK(!table_name.empty());
+  DCHECK(!column.empty());
+
+  if (values.empty()) {
+    return DeleteTable(transaction, table_name);
+  }
+
+  mojom::DBCommandInfoPtr command = mojom::DBCommandInfo::New();
+  command->type = mojom::DBCommandInfo::Type::RUN;
+  command->command = base::StringPrintf(
+      "DELETE FROM %s WHERE %s NOT IN %s", table_name.c_str(), column.c_str(),
+      BuildBindingParameterPlaceholder(values.size()).c_str());
+
+  int index = 0;
+  for (const auto& value : values) {
+    BindString(command.get(), index++, value);
+  }
+
+  transaction->commands.push_back(std::move(command));
+}
+
 void CopyTableColumns(mojom::DBTransactionInfo* transaction,
                       const std::string& from,
                       const std::string& to,
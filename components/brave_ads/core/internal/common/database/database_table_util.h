@@ -23,6 +23,13 @@ void DropTable(mojom::DBTransactionInfo* transaction,
 void DeleteTable(mojom::DBTransactionInfo* transaction,
                  const std::string& table_name);
 
+// Deletes the rows of |table_name| whose |column| is not one of |values|, or
+// all rows if |values| is empty.
+void DeleteTableRowsExcept(mojom::DBTransactionInfo* transaction,
+                           const std::string& table_name,
+                           const std::string& column,
+                           const std::vector<std::string>& values);
+
 void CopyTableColumns(mojom::DBTransactionInfo* transaction,
                       const std::string& from,
                       const std::string& to,
@@ -192,6 +192,9 @@ void UnitTestBase::Initialize() {
 
   covariate_manager_ = std::make_unique<CovariateManager>();
 
+  creative_notification_ads_serving_index_ =
+      std::make_unique<CreativeNotificationAdsServingIndex>();
+
   database_manager_ = std::make_unique<DatabaseManager>();
   database_manager_->CreateOrOpen(
       base::BindOnce([](const bool success) { ASSERT_TRUE(success); }));
@@ -17,6 +17,7 @@
 #include "brave/components/brave_ads/core/internal/browser/browser_manager.h"
 #include "brave/components/brave_ads/core/internal/common/platform/platform_helper_mock.h"
 #include "brave/components/brave_ads/core/internal/covariates/covariate_manager.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
 #include "brave/components/brave_ads/core/internal/creatives/notification_ads/notification_ad_manager.h"
 #include "brave/components/brave_ads/core/internal/database/database_manager.h"
 #include "brave/components/brave_ads/core/internal/deprecated/client/client_state_manager.h"
@@ -164,6 +165,8 @@ class UnitTestBase : public testing::Test {
   std::unique_ptr<ClientStateManager> client_state_manager_;
   std::unique_ptr<ConfirmationStateManager> confirmation_state_manager_;
   std::unique_ptr<CovariateManager> covariate_manager_;
+  std::unique_ptr<CreativeNotificationAdsServingIndex>
+      creative_notification_ads_serving_index_;
   std::unique_ptr<DatabaseManager> database_manager_;
   std::unique_ptr<DiagnosticManager> diagnostic_manager_;
   std::unique_ptr<FlagManager> flag_manager_;
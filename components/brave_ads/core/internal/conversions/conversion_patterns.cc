@@ -0,0 +1,191 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/conversions/conversion_patterns.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/ranges/algorithm.h"
+#include "brave/components/brave_ads/core/internal/common/logging_util.h"
+#include "brave/components/brave_ads/core/internal/common/url/url_util.h"
+#include "url/gurl.h"
+
+namespace ads {
+
+namespace {
+
+// Same bound for each pattern as DebounceRulesIndex uses for its sets.
+constexpr int64_t kMaxMemoryPerUrlPattern = 2 << 11;
+
+// Translates a |base::MatchPattern| pattern, where '*' matches any number of
+// characters, '?' matches zero or one character and '\' escapes the next
+// character, to a regex which matches the same strings.
+std::string UrlPatternToRegex(const std::string& url_pattern) {
+  std::string regex;
+  for (size_t i = 0; i < url_pattern.size(); i++) {
+    switch (url_pattern[i]) {
+      case '*': {
+        regex += ".*";
+        break;
+      }
+
+      case '?': {
+        regex += ".?";
+        break;
+      }
+
+      case '\\': {
+        // A trailing escape matches nothing, as with |base::MatchPattern|.
+        if (++i < url_pattern.size()) {
+          regex += RE2::QuoteMeta(re2::StringPiece(&url_pattern[i], 1));
+        }
+        break;
+      }
+
+      default: {
+        regex += RE2::QuoteMeta(re2::StringPiece(&url_pattern[i], 1));
+        break;
+      }
+    }
+  }
+
+  return regex;
+}
+
+std::unique_ptr<RE2::Set> BuildUrlPatternSet(
+    const base::flat_set<std::string>& url_patterns) {
+  if (url_patterns.empty()) {
+    return nullptr;
+  }
+
+  RE2::Options options;
+  options.set_dot_nl(true);
+  options.set_max_mem(kMaxMemoryPerUrlPattern *
+                      static_cast<int64_t>(url_patterns.size()));
+  auto url_pattern_set =
+      std::make_unique<RE2::Set>(options, RE2::ANCHOR_BOTH);
+  for (const auto& url_pattern : url_patterns) {
+    std::string error;
+    if (url_pattern_set->Add(UrlPatternToRegex(url_pattern), &error) < 0) {
+      BLOG(1, "Failed to add conversion url pattern " << url_pattern << ": "
+                                                      << error);
+      return nullptr;
+    }
+  }
+
+  if (!url_pattern_set->Compile()) {
+    BLOG(1, "Failed to compile conversion url patterns");
+    return nullptr;
+  }
+
+  return url_pattern_set;
+}
+
+bool DoesRedirectChainMatchUrlPattern(const std::vector<GURL>& redirect_chain,
+                                      const std::string& url_pattern) {
+  return base::ranges::any_of(redirect_chain, [&url_pattern](const GURL& url) {
+    return MatchUrlPattern(url, url_pattern);
+  });
+}
+
+ConversionList FilterConversionsOneByOne(
+    const std::vector<GURL>& redirect_chain,
+    const ConversionList& conversions) {
+  ConversionList filtered_conversions;
+
+  base::ranges::copy_if(conversions, std::back_inserter(filtered_conversions),
+                        [&redirect_chain](const ConversionInfo& conversion) {
+                          return DoesRedirectChainMatchUrlPattern(
+                              redirect_chain, conversion.url_pattern);
+                        });
+
+  return filtered_conversions;
+}
+
+}  // namespace
+
+ConversionPatterns::ConversionPatterns() = default;
+
+ConversionPatterns::~ConversionPatterns() = default;
+
+void ConversionPatterns::UpdateUrlPatterns(const ConversionList& conversions) {
+  std::vector<std::string> url_patterns;
+  url_patterns.reserve(conversions.size());
+  for (const auto& conversion : conversions) {
+    // Empty url patterns never match, see |MatchUrlPattern|.
+    if (!conversion.url_pattern.empty()) {
+      url_patterns.push_back(conversion.url_pattern);
+    }
+  }
+
+  base::flat_set<std::string> sorted_url_patterns(std::move(url_patterns));
+  if (sorted_url_patterns != url_patterns_) {
+    url_patterns_ = std::move(sorted_url_patterns);
+    url_pattern_set_ = BuildUrlPatternSet(url_patterns_);
+  }
+}
+
+ConversionList ConversionPatterns::FilterConversions(
+    const std::vector<GURL>& redirect_chain,
+    const ConversionList& conversions) const {
+  if (!url_pattern_set_) {
+    return FilterConversionsOneByOne(redirect_chain, conversions);
+  }
+
+  std::vector<bool> matched_url_patterns(url_patterns_.size());
+  std::vector<int> indices;
+  for (const auto& url : redirect_chain) {
+    if (!url.is_valid()) {
+      continue;
+    }
+
+    RE2::Set::ErrorInfo error_info;
+    if (!url_pattern_set_->Match(url.spec(), &indices, &error_info)) {
+      if (error_info.kind != RE2::Set::kNoError) {
+        BLOG(1, "Failed to match conversion url patterns");
+        return FilterConversionsOneByOne(redirect_chain, conversions);
+      }
+      continue;
+    }
+
+    for (const int index : indices) {
+      matched_url_patterns[index] = true;
+    }
+  }
+
+  ConversionList filtered_conversions;
+
+  base::ranges::copy_if(
+      conversions, std::back_inserter(filtered_conversions),
+      [this, &redirect_chain,
+       &matched_url_patterns](const ConversionInfo& conversion) {
+        const auto iter = url_patterns_.find(conversion.url_pattern);
+        if (iter == url_patterns_.cend()) {
+          return DoesRedirectChainMatchUrlPattern(redirect_chain,
+                                                  conversion.url_pattern);
+        }
+
+        return static_cast<bool>(
+            matched_url_patterns[iter - url_patterns_.cbegin()]);
+      });
+
+  return filtered_conversions;
+}
+
+const RE2& ConversionPatterns::GetIdPattern(const std::string& pattern) {
+  auto iter = id_patterns_.find(pattern);
+  if (iter == id_patterns_.cend()) {
+    iter = id_patterns_.emplace(pattern, std::make_unique<RE2>(pattern)).first;
+  }
+
+  return *iter->second;
+}
+
+void ConversionPatterns::ClearIdPatterns() {
+  id_patterns_.clear();
+}
+
+}  // namespace ads
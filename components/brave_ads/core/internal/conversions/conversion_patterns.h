@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CONVERSIONS_CONVERSION_PATTERNS_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CONVERSIONS_CONVERSION_PATTERNS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "brave/components/brave_ads/core/internal/conversions/conversion_info.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/re2/src/re2/set.h"
+
+class GURL;
+
+namespace ads {
+
+// Compiled url patterns of the conversions and conversion id patterns, so that
+// checking a page for conversions doesn't compile a regex per conversion.
+class ConversionPatterns final {
+ public:
+  ConversionPatterns();
+
+  ConversionPatterns(const ConversionPatterns& other) = delete;
+  ConversionPatterns& operator=(const ConversionPatterns& other) = delete;
+
+  ConversionPatterns(ConversionPatterns&& other) noexcept = delete;
+  ConversionPatterns& operator=(ConversionPatterns&& other) noexcept = delete;
+
+  ~ConversionPatterns();
+
+  // Recompiles the url patterns if those of |conversions| changed since the
+  // last call.
+  void UpdateUrlPatterns(const ConversionList& conversions);
+
+  // Returns the |conversions|, in order, whose url pattern matches a url in
+  // |redirect_chain|, as |MatchUrlPattern| would. Url patterns which were not
+  // passed to |UpdateUrlPatterns| are matched one at a time.
+  ConversionList FilterConversions(const std::vector<GURL>& redirect_chain,
+                                   const ConversionList& conversions) const;
+
+  // Returns |pattern| compiled, compiling it on first use.
+  const RE2& GetIdPattern(const std::string& pattern);
+
+  // Drops the compiled id patterns, i.e. when the conversion id patterns
+  // resource changes.
+  void ClearIdPatterns();
+
+  size_t url_pattern_count() const { return url_patterns_.size(); }
+
+ private:
+  // The position of a url pattern in |url_patterns_| is its index in
+  // |url_pattern_set_|.
+  base::flat_set<std::string> url_patterns_;
+  // Null if the url patterns could not be compiled into a set, in which case
+  // they are matched one at a time.
+  std::unique_ptr<RE2::Set> url_pattern_set_;
+
+  base::flat_map<std::string, std::unique_ptr<RE2>> id_patterns_;
+};
+
+}  // namespace ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CONVERSIONS_CONVERSION_PATTERNS_H_
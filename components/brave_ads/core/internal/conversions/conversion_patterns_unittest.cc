@@ -0,0 +1,221 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/conversions/conversion_patterns.h"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "brave/components/brave_ads/core/internal/common/url/url_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BatAds*
+
+namespace ads {
+
+namespace {
+
+constexpr char kIdPattern[] =
+    "<meta.*name=\"ad-conversion-id\".*content=\"([-a-zA-Z0-9]*)\".*>";
+
+ConversionInfo BuildConversion(const std::string& url_pattern) {
+  ConversionInfo conversion;
+  conversion.creative_set_id = url_pattern;
+  conversion.type = "postview";
+  conversion.url_pattern = url_pattern;
+  return conversion;
+}
+
+// A mix of the url patterns advertisers use, some of them shared between
+// conversions.
+ConversionList BuildConversions(const int count) {
+  ConversionList conversions;
+  for (int i = 0; i < count; i++) {
+    switch (i % 4) {
+      case 0: {
+        conversions.push_back(BuildConversion(
+            base::StringPrintf("https://www.foo%d.com/*", i)));
+        break;
+      }
+
+      case 1: {
+        conversions.push_back(BuildConversion(
+            base::StringPrintf("https://*.bar%d.com/checkout?id=*", i)));
+        break;
+      }
+
+      case 2: {
+        conversions.push_back(BuildConversion(
+            base::StringPrintf("https://baz%d.com/thank-you/?", i % 100)));
+        break;
+      }
+
+      case 3: {
+        conversions.push_back(BuildConversion(
+            base::StringPrintf("https://qux%d.com/\\*/done", i)));
+        break;
+      }
+    }
+  }
+
+  return conversions;
+}
+
+std::vector<std::vector<GURL>> BuildRedirectChains(const int count) {
+  std::vector<std::vector<GURL>> redirect_chains;
+  for (int i = 0; i < count; i++) {
+    const std::string n = base::NumberToString(i);
+    redirect_chains.push_back({GURL("https://www.foo" + n + ".com/bar")});
+    redirect_chains.push_back(
+        {GURL("https://example.com/"),
+         GURL("https://shop.bar" + n + ".com/checkout?id=" + n)});
+    redirect_chains.push_back({GURL("https://baz" + n + ".com/thank-you/")});
+    redirect_chains.push_back({GURL("https://baz" + n + ".com/thank-you/x")});
+    redirect_chains.push_back({GURL("https://baz" + n + ".com/thank-you/xy")});
+    redirect_chains.push_back({GURL("https://qux" + n + ".com/*/done")});
+    redirect_chains.push_back({GURL("https://qux" + n + ".com/a/done")});
+    redirect_chains.push_back({GURL("https://www.unrelated.com/" + n)});
+  }
+
+  return redirect_chains;
+}
+
+// What Conversions did before the url patterns were compiled into a set.
+ConversionList FilterConversionsOneByOne(
+    const std::vector<GURL>& redirect_chain,
+    const ConversionList& conversions) {
+  ConversionList filtered_conversions;
+
+  base::ranges::copy_if(conversions, std::back_inserter(filtered_conversions),
+                        [&redirect_chain](const ConversionInfo& conversion) {
+                          return base::ranges::any_of(
+                              redirect_chain, [&conversion](const GURL& url) {
+                                return MatchUrlPattern(url,
+                                                       conversion.url_pattern);
+                              });
+                        });
+
+  return filtered_conversions;
+}
+
+}  // namespace
+
+TEST(BatAdsConversionPatternsTest, FilterConversions) {
+  // Arrange
+  const ConversionList conversions = {
+      BuildConversion("https://www.foo.com/*"),
+      BuildConversion("https://www.foo.com/bar?"),
+      BuildConversion("https://www.foo.com/\\?"),
+      BuildConversion("https://www.bar.com/*"),
+      BuildConversion(""),
+      BuildConversion("https://www.foo.com/*")};
+
+  ConversionPatterns patterns;
+  patterns.UpdateUrlPatterns(conversions);
+
+  // Act
+  const ConversionList filtered_conversions = patterns.FilterConversions(
+      {GURL("https://www.foo.com/bar"), GURL("invalid")}, conversions);
+
+  // Assert
+  const ConversionList expected_conversions = {conversions[0], conversions[1],
+                                               conversions[5]};
+  EXPECT_EQ(expected_conversions, filtered_conversions);
+  EXPECT_EQ(4U, patterns.url_pattern_count());
+}
+
+TEST(BatAdsConversionPatternsTest, FilterConversionsAfterUpdate) {
+  // Arrange
+  ConversionPatterns patterns;
+  patterns.UpdateUrlPatterns({BuildConversion("https://www.foo.com/*")});
+
+  const ConversionList conversions = {BuildConversion("https://www.bar.com/*")};
+  patterns.UpdateUrlPatterns(conversions);
+
+  // Act
+  const ConversionList filtered_conversions = patterns.FilterConversions(
+      {GURL("https://www.bar.com/checkout")}, conversions);
+
+  // Assert
+  EXPECT_EQ(conversions, filtered_conversions);
+}
+
+TEST(BatAdsConversionPatternsTest, FilterConversionsNotPassedToUpdate) {
+  // Arrange
+  ConversionPatterns patterns;
+  patterns.UpdateUrlPatterns({BuildConversion("https://www.foo.com/*")});
+
+  const ConversionList conversions = {BuildConversion("https://www.foo.com/*"),
+                                      BuildConversion("https://www.bar.com/*"),
+                                      BuildConversion("https://www.baz.com/*")};
+
+  // Act
+  const ConversionList filtered_conversions = patterns.FilterConversions(
+      {GURL("https://www.foo.com/"), GURL("https://www.bar.com/checkout")},
+      conversions);
+
+  // Assert
+  const ConversionList expected_conversions = {conversions[0], conversions[1]};
+  EXPECT_EQ(expected_conversions, filtered_conversions);
+}
+
+TEST(BatAdsConversionPatternsTest, MatchSameConversionsAsMatchUrlPattern) {
+  // Arrange
+  const ConversionList conversions = BuildConversions(1000);
+
+  ConversionPatterns patterns;
+  patterns.UpdateUrlPatterns(conversions);
+
+  // Act & Assert
+  int matches = 0;
+  for (const auto& redirect_chain : BuildRedirectChains(250)) {
+    const ConversionList expected_conversions =
+        FilterConversionsOneByOne(redirect_chain, conversions);
+    EXPECT_EQ(expected_conversions,
+              patterns.FilterConversions(redirect_chain, conversions))
+        << redirect_chain.back();
+    matches += static_cast<int>(expected_conversions.size());
+  }
+  EXPECT_GT(matches, 0);
+}
+
+TEST(BatAdsConversionPatternsTest, GetIdPattern) {
+  // Arrange
+  ConversionPatterns patterns;
+
+  // Act
+  const RE2& id_pattern = patterns.GetIdPattern(kIdPattern);
+
+  // Assert
+  EXPECT_EQ(&id_pattern, &patterns.GetIdPattern(kIdPattern));
+  std::string conversion_id;
+  EXPECT_TRUE(RE2::PartialMatch(
+      R"(<meta name="ad-conversion-id" content="abc-123">)", id_pattern,
+      &conversion_id));
+  EXPECT_EQ("abc-123", conversion_id);
+}
+
+TEST(BatAdsConversionPatternsTest, ClearIdPatterns) {
+  // Arrange
+  ConversionPatterns patterns;
+  patterns.GetIdPattern(kIdPattern);
+
+  // Act
+  patterns.ClearIdPatterns();
+
+  // Assert
+  std::string conversion_id;
+  EXPECT_TRUE(RE2::PartialMatch(
+      R"(<meta name="ad-conversion-id" content="abc-123">)",
+      patterns.GetIdPattern(kIdPattern), &conversion_id));
+  EXPECT_EQ("abc-123", conversion_id);
+}
+
+}  // namespace ads
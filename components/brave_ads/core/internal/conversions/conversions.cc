@@ -16,9 +16,11 @@
 #include "brave/components/brave_ads/core/internal/account/account_util.h"
 #include "brave/components/brave_ads/core/internal/ads/ad_events/ad_events.h"
 #include "brave/components/brave_ads/core/internal/ads/ad_events/ad_events_database_table.h"
+#include "brave/components/brave_ads/core/internal/catalog/catalog.h"
 #include "brave/components/brave_ads/core/internal/common/logging_util.h"
 #include "brave/components/brave_ads/core/internal/common/time/time_formatting_util.h"
 #include "brave/components/brave_ads/core/internal/common/url/url_util.h"
+#include "brave/components/brave_ads/core/internal/conversions/conversion_patterns.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversion_queue_database_table.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversions_database_table.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversions_features.h"
@@ -97,7 +99,10 @@ std::string ExtractConversionIdFromText(
     const std::string& html,
     const std::vector<GURL>& redirect_chain,
     const std::string& conversion_url_pattern,
-    const ConversionIdPatternMap& conversion_id_patterns) {
+    const ConversionIdPatternMap& conversion_id_patterns,
+    ConversionPatterns* patterns) {
+  DCHECK(patterns);
+
   std::string conversion_id;
   std::string conversion_id_pattern = features::GetDefaultConversionIdPattern();
   std::string text = html;
@@ -123,8 +128,9 @@ std::string ExtractConversionIdFromText(
   }
 
   re2::StringPiece text_string_piece(text);
-  const RE2 r(conversion_id_pattern);
-  RE2::FindAndConsume(&text_string_piece, r, &conversion_id);
+  RE2::FindAndConsume(&text_string_piece,
+                      patterns->GetIdPattern(conversion_id_pattern),
+                      &conversion_id);
 
   return conversion_id;
 }
@@ -178,24 +184,6 @@ AdEventList FilterAdEventsForConversion(const AdEventList& ad_events,
   return filtered_ad_events;
 }
 
-ConversionList FilterConversions(const std::vector<GURL>& redirect_chain,
-                                 const ConversionList& conversions) {
-  ConversionList filtered_conversions;
-
-  base::ranges::copy_if(conversions, std::back_inserter(filtered_conversions),
-                        [&redirect_chain](const ConversionInfo& conversion) {
-                          const auto iter = base::ranges::find_if(
-                              redirect_chain, [&conversion](const GURL& url) {
-                                return MatchUrlPattern(url,
-                                                       conversion.url_pattern);
-                              });
-
-                          return iter != redirect_chain.cend();
-                        });
-
-  return filtered_conversions;
-}
-
 ConversionList SortConversions(const ConversionList& conversions) {
   const auto sort =
       ConversionsSortFactory::Build(ConversionSortType::kDescendingOrder);
@@ -206,15 +194,19 @@ ConversionList SortConversions(const ConversionList& conversions) {
 
 }  // namespace
 
-Conversions::Conversions() {
+Conversions::Conversions(Catalog* catalog) : catalog_(catalog) {
+  DCHECK(catalog_);
+
   resource_ = std::make_unique<resource::Conversions>();
 
+  catalog_->AddObserver(this);
   LocaleManager::GetInstance()->AddObserver(this);
   ResourceManager::GetInstance()->AddObserver(this);
   TabManager::GetInstance()->AddObserver(this);
 }
 
 Conversions::~Conversions() {
+  catalog_->RemoveObserver(this);
   LocaleManager::GetInstance()->RemoveObserver(this);
   ResourceManager::GetInstance()->RemoveObserver(this);
   TabManager::GetInstance()->RemoveObserver(this);
@@ -322,8 +314,12 @@ void Conversions::OnGetAllConversions(
   }
 
   // Filter conversions by url pattern
+  if (should_update_url_patterns_) {
+    patterns_.UpdateUrlPatterns(conversions);
+    should_update_url_patterns_ = false;
+  }
   ConversionList filtered_conversions =
-      FilterConversions(redirect_chain, conversions);
+      patterns_.FilterConversions(redirect_chain, conversions);
 
   // Sort conversions in descending order
   filtered_conversions = SortConversions(filtered_conversions);
@@ -349,7 +345,8 @@ void Conversions::OnGetAllConversions(
 
       VerifiableConversionInfo verifiable_conversion;
       verifiable_conversion.id = ExtractConversionIdFromText(
-          html, redirect_chain, conversion.url_pattern, conversion_id_patterns);
+          html, redirect_chain, conversion.url_pattern, conversion_id_patterns,
+          &patterns_);
       verifiable_conversion.public_key = conversion.advertiser_public_key;
 
       Convert(ad_event, verifiable_conversion);
@@ -582,12 +579,18 @@ void Conversions::NotifyConversionFailed(
   }
 }
 
+void Conversions::OnDidUpdateCatalog(const CatalogInfo& /*catalog*/) {
+  should_update_url_patterns_ = true;
+}
+
 void Conversions::OnLocaleDidChange(const std::string& /*locale*/) {
+  patterns_.ClearIdPatterns();
   resource_->Load();
 }
 
 void Conversions::OnResourceDidUpdate(const std::string& id) {
   if (IsValidCountryComponentId(id)) {
+    patterns_.ClearIdPatterns();
     resource_->Load();
   }
 }
@@ -11,10 +11,13 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/raw_ptr.h"
 #include "base/observer_list.h"
 #include "brave/components/brave_ads/core/internal/ads/ad_events/ad_event_info.h"
+#include "brave/components/brave_ads/core/internal/catalog/catalog_observer.h"
 #include "brave/components/brave_ads/core/internal/common/timer/timer.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversion_info.h"
+#include "brave/components/brave_ads/core/internal/conversions/conversion_patterns.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversion_queue_item_info.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversions_observer.h"
 #include "brave/components/brave_ads/core/internal/locale/locale_manager_observer.h"
@@ -30,14 +33,17 @@ namespace resource {
 class Conversions;
 }  // namespace resource
 
+class Catalog;
 struct AdEventInfo;
+struct CatalogInfo;
 struct VerifiableConversionInfo;
 
-class Conversions final : public LocaleManagerObserver,
+class Conversions final : public CatalogObserver,
+                          public LocaleManagerObserver,
                           public ResourceManagerObserver,
                           public TabManagerObserver {
  public:
-  Conversions();
+  explicit Conversions(Catalog* catalog);
 
   Conversions(const Conversions& other) = delete;
   Conversions& operator=(const Conversions& other) = delete;
@@ -112,6 +118,9 @@ class Conversions final : public LocaleManagerObserver,
   void NotifyConversionFailed(
       const ConversionQueueItemInfo& conversion_queue_item) const;
 
+  // CatalogObserver:
+  void OnDidUpdateCatalog(const CatalogInfo& catalog) override;
+
   // LocaleManagerObserver:
   void OnLocaleDidChange(const std::string& locale) override;
 
@@ -127,7 +136,14 @@ class Conversions final : public LocaleManagerObserver,
 
   std::unique_ptr<resource::Conversions> resource_;
 
+  ConversionPatterns patterns_;
+  // Set when the catalog, and so the conversions, may have changed since the
+  // url patterns were last compiled.
+  bool should_update_url_patterns_ = true;
+
   Timer timer_;
+
+  const raw_ptr<Catalog> catalog_ = nullptr;  // NOT OWNED
 };
 
 }  // namespace ads
@@ -12,6 +12,7 @@
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/brave_ads/core/internal/ads/ad_events/ad_event_unittest_util.h"
 #include "brave/components/brave_ads/core/internal/ads/ad_events/ad_events_database_table.h"
+#include "brave/components/brave_ads/core/internal/catalog/catalog.h"
 #include "brave/components/brave_ads/core/internal/common/unittest/unittest_base.h"
 #include "brave/components/brave_ads/core/internal/common/unittest/unittest_time_util.h"
 #include "brave/components/brave_ads/core/internal/conversions/conversion_queue_database_table.h"
@@ -40,7 +41,8 @@ class BatAdsConversionsTest : public UnitTestBase {
   void SetUp() override {
     UnitTestBase::SetUp();
 
-    conversions_ = std::make_unique<Conversions>();
+    catalog_ = std::make_unique<Catalog>();
+    conversions_ = std::make_unique<Conversions>(catalog_.get());
     ad_events_database_table_ = std::make_unique<database::table::AdEvents>();
     conversion_queue_database_table_ =
         std::make_unique<database::table::ConversionQueue>();
@@ -48,6 +50,7 @@ class BatAdsConversionsTest : public UnitTestBase {
         std::make_unique<database::table::Conversions>();
   }
 
+  std::unique_ptr<Catalog> catalog_;
   std::unique_ptr<Conversions> conversions_;
   std::unique_ptr<database::table::AdEvents> ad_events_database_table_;
   std::unique_ptr<database::table::ConversionQueue>
@@ -11,6 +11,7 @@
 
 #include "base/base64.h"
 #include "base/check_op.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_ads/core/internal/common/crypto/crypto_util.h"
 #include "brave/components/brave_ads/core/internal/common/crypto/key_pair_info.h"
 #include "brave/components/brave_ads/core/internal/conversions/verifiable_conversion_envelope_info.h"
@@ -30,7 +31,8 @@ constexpr size_t kVacMessageMaxLength = 30;
 constexpr size_t kVacMessageMinLength = 1;
 
 bool IsConversionIdValid(const std::string& conversion_id) {
-  return RE2::FullMatch(conversion_id, "^[a-zA-Z0-9-]*$");
+  static const base::NoDestructor<RE2> kConversionIdRegex("^[a-zA-Z0-9-]*$");
+  return RE2::FullMatch(conversion_id, *kConversionIdRegex);
 }
 
 }  // namespace
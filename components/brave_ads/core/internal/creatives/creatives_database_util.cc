@@ -0,0 +1,101 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/creatives/creatives_database_util.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/containers/flat_set.h"
+#include "base/functional/bind.h"
+#include "brave/components/brave_ads/common/interfaces/ads.mojom.h"
+#include "brave/components/brave_ads/core/internal/ads_client_helper.h"
+#include "brave/components/brave_ads/core/internal/common/database/database_table_util.h"
+#include "brave/components/brave_ads/core/internal/common/logging_util.h"
+#include "brave/components/brave_ads/core/internal/creatives/campaigns_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/creative_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/creatives_info.h"
+#include "brave/components/brave_ads/core/internal/creatives/inline_content_ads/creative_inline_content_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/new_tab_page_ads/creative_new_tab_page_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
+#include "brave/components/brave_ads/core/internal/creatives/promoted_content_ads/creative_promoted_content_ads_database_table.h"
+
+namespace ads::database {
+
+namespace {
+
+constexpr char kCampaignIdColumn[] = "campaign_id";
+constexpr char kCreativeInstanceIdColumn[] = "creative_instance_id";
+
+template <typename T>
+void AddIds(const T& creative_ads,
+            base::flat_set<std::string>* campaign_ids,
+            base::flat_set<std::string>* creative_instance_ids) {
+  DCHECK(campaign_ids);
+  DCHECK(creative_instance_ids);
+
+  for (const auto& creative_ad : creative_ads) {
+    campaign_ids->insert(creative_ad.campaign_id);
+    creative_instance_ids->insert(creative_ad.creative_instance_id);
+  }
+}
+
+void OnDeleteCreativesNotIn(mojom::DBCommandResponseInfoPtr response) {
+  // Invalidated once the transaction has run, so the serving index cannot be
+  // reloaded from the deleted rows.
+  if (CreativeNotificationAdsServingIndex::HasInstance()) {
+    CreativeNotificationAdsServingIndex::GetInstance()->Invalidate();
+  }
+
+  if (!response || response->status !=
+                       mojom::DBCommandResponseInfo::StatusType::RESPONSE_OK) {
+    BLOG(0, "Failed to delete creatives which are no longer in the catalog");
+    return;
+  }
+
+  BLOG(3, "Successfully deleted creatives which are no longer in the catalog");
+}
+
+}  // namespace
+
+void DeleteCreativesNotIn(const CreativesInfo& creatives) {
+  base::flat_set<std::string> campaign_ids;
+  base::flat_set<std::string> creative_instance_ids;
+  AddIds(creatives.notification_ads, &campaign_ids, &creative_instance_ids);
+  AddIds(creatives.inline_content_ads, &campaign_ids, &creative_instance_ids);
+  AddIds(creatives.new_tab_page_ads, &campaign_ids, &creative_instance_ids);
+  AddIds(creatives.promoted_content_ads, &campaign_ids,
+         &creative_instance_ids);
+
+  const std::vector<std::string> campaign_ids_list(campaign_ids.cbegin(),
+                                                   campaign_ids.cend());
+  const std::vector<std::string> creative_instance_ids_list(
+      creative_instance_ids.cbegin(), creative_instance_ids.cend());
+
+  mojom::DBTransactionInfoPtr transaction = mojom::DBTransactionInfo::New();
+
+  DeleteTableRowsExcept(transaction.get(), table::Campaigns().GetTableName(),
+                        kCampaignIdColumn, campaign_ids_list);
+
+  const std::vector<std::string> creative_instance_table_names = {
+      table::CreativeAds().GetTableName(),
+      table::CreativeNotificationAds().GetTableName(),
+      table::CreativeInlineContentAds().GetTableName(),
+      table::CreativeNewTabPageAds().GetTableName(),
+      table::CreativePromotedContentAds().GetTableName()};
+  for (const auto& table_name : creative_instance_table_names) {
+    DeleteTableRowsExcept(transaction.get(), table_name,
+                          kCreativeInstanceIdColumn,
+                          creative_instance_ids_list);
+  }
+
+  AdsClientHelper::GetInstance()->RunDBTransaction(
+      std::move(transaction), base::BindOnce(&OnDeleteCreativesNotIn));
+}
+
+}  // namespace ads::database
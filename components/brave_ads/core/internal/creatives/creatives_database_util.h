@@ -0,0 +1,23 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_CREATIVES_DATABASE_UTIL_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_CREATIVES_DATABASE_UTIL_H_
+
+namespace ads {
+
+struct CreativesInfo;
+
+namespace database {
+
+// Deletes the campaigns and creative ads which are not in |creatives|, so that
+// saving |creatives| afterwards only has to upsert the remaining rows.
+void DeleteCreativesNotIn(const CreativesInfo& creatives);
+
+}  // namespace database
+
+}  // namespace ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_CREATIVES_DATABASE_UTIL_H_
@@ -0,0 +1,70 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/creatives/creatives_database_util.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "brave/components/brave_ads/core/internal/common/unittest/unittest_base.h"
+#include "brave/components/brave_ads/core/internal/common/unittest/unittest_container_util.h"
+#include "brave/components/brave_ads/core/internal/creatives/creatives_info.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ad_unittest_util.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_table.h"
+
+// npm run test -- brave_unit_tests --filter=BatAds*
+
+namespace ads::database {
+
+class BatAdsCreativesDatabaseUtilTest : public UnitTestBase {};
+
+TEST_F(BatAdsCreativesDatabaseUtilTest, DeleteCreativesNotIn) {
+  // Arrange
+  CreativeNotificationAdList creative_ads = BuildCreativeNotificationAds(3);
+  creative_ads[0].creative_instance_id = "it's-a-creative-instance-id";
+  SaveCreativeAds(creative_ads);
+
+  CreativesInfo creatives;
+  creatives.notification_ads = {creative_ads[0], creative_ads[2]};
+
+  // Act
+  DeleteCreativesNotIn(creatives);
+
+  // Assert
+  CreativeNotificationAdList expected_creative_ads = creatives.notification_ads;
+
+  const table::CreativeNotificationAds database_table;
+  database_table.GetAll(base::BindOnce(
+      [](const CreativeNotificationAdList& expected_creative_ads,
+         const bool success, const SegmentList& /*segments*/,
+         const CreativeNotificationAdList& creative_ads) {
+        EXPECT_TRUE(success);
+        EXPECT_TRUE(ContainersEq(expected_creative_ads, creative_ads));
+      },
+      std::move(expected_creative_ads)));
+}
+
+TEST_F(BatAdsCreativesDatabaseUtilTest, DeleteAllCreativesIfNoneInCatalog) {
+  // Arrange
+  const CreativeNotificationAdList creative_ads =
+      BuildCreativeNotificationAds(2);
+  SaveCreativeAds(creative_ads);
+
+  const CreativesInfo creatives;
+
+  // Act
+  DeleteCreativesNotIn(creatives);
+
+  // Assert
+  const table::CreativeNotificationAds database_table;
+  database_table.GetAll(
+      base::BindOnce([](const bool success, const SegmentList& /*segments*/,
+                        const CreativeNotificationAdList& creative_ads) {
+        EXPECT_TRUE(success);
+        EXPECT_TRUE(creative_ads.empty());
+      }));
+}
+
+}  // namespace ads::database
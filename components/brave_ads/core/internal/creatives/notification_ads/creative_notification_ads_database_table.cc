@@ -27,6 +27,7 @@
 #include "brave/components/brave_ads/core/internal/creatives/creative_ads_database_table.h"
 #include "brave/components/brave_ads/core/internal/creatives/dayparts_database_table.h"
 #include "brave/components/brave_ads/core/internal/creatives/geo_targets_database_table.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
 #include "brave/components/brave_ads/core/internal/creatives/segments_database_table.h"
 #include "brave/components/brave_ads/core/internal/segments/segment_util.h"
 #include "url/gurl.h"
@@ -163,6 +164,41 @@ void OnGetForSegments(const SegmentList& segments,
   std::move(callback).Run(/*success*/ true, segments, creative_ads);
 }
 
+// Unlike |GroupCreativeAdsFromResponse| keeps one creative ad for each
+// segment.
+CreativeNotificationAdList GetCreativeAdsForEachSegmentFromResponse(
+    mojom::DBCommandResponseInfoPtr response) {
+  DCHECK(response);
+
+  std::map<std::pair<std::string, std::string>, CreativeNotificationAdInfo>
+      grouped_creative_ads;
+  for (const auto& record : response->result->get_records()) {
+    CreativeNotificationAdInfo creative_ad = GetFromRecord(record.get());
+
+    const auto [iter, inserted] = grouped_creative_ads.insert(
+        {{creative_ad.creative_instance_id, creative_ad.segment},
+         creative_ad});
+    if (inserted) {
+      continue;
+    }
+
+    iter->second.geo_targets.insert(creative_ad.geo_targets.cbegin(),
+                                    creative_ad.geo_targets.cend());
+    for (const auto& daypart : creative_ad.dayparts) {
+      if (!base::Contains(iter->second.dayparts, daypart)) {
+        iter->second.dayparts.push_back(daypart);
+      }
+    }
+  }
+
+  CreativeNotificationAdList creative_ads;
+  for (const auto& [key, creative_ad] : grouped_creative_ads) {
+    creative_ads.push_back(creative_ad);
+  }
+
+  return creative_ads;
+}
+
 void OnGetAll(GetCreativeNotificationAdsCallback callback,
               mojom::DBCommandResponseInfoPtr response) {
   if (!response || response->status !=
@@ -180,6 +216,35 @@ void OnGetAll(GetCreativeNotificationAdsCallback callback,
   std::move(callback).Run(/*success*/ true, segments, creative_ads);
 }
 
+void OnGetUnexpiredForEachSegment(
+    GetCreativeNotificationAdsCallback callback,
+    mojom::DBCommandResponseInfoPtr response) {
+  if (!response || response->status !=
+                       mojom::DBCommandResponseInfo::StatusType::RESPONSE_OK) {
+    BLOG(0, "Failed to get unexpired creative notification ads");
+    std::move(callback).Run(/*success*/ false, {}, {});
+    return;
+  }
+
+  const CreativeNotificationAdList creative_ads =
+      GetCreativeAdsForEachSegmentFromResponse(std::move(response));
+
+  const SegmentList segments = GetSegments(creative_ads);
+
+  std::move(callback).Run(/*success*/ true, segments, creative_ads);
+}
+
+// Invalidated once the transaction has run, so the serving index cannot be
+// reloaded from the rows it replaces.
+void OnChangedCreativeAds(ResultCallback callback,
+                          mojom::DBCommandResponseInfoPtr response) {
+  if (CreativeNotificationAdsServingIndex::HasInstance()) {
+    CreativeNotificationAdsServingIndex::GetInstance()->Invalidate();
+  }
+
+  OnResultCallback(std::move(callback), std::move(response));
+}
+
 void MigrateToV24(mojom::DBTransactionInfo* transaction) {
   DCHECK(transaction);
 
@@ -246,7 +311,7 @@ void CreativeNotificationAds::Save(
 
   AdsClientHelper::GetInstance()->RunDBTransaction(
       std::move(transaction),
-      base::BindOnce(&OnResultCallback, std::move(callback)));
+      base::BindOnce(&OnChangedCreativeAds, std::move(callback)));
 }
 
 void CreativeNotificationAds::Delete(ResultCallback callback) const {
@@ -256,7 +321,7 @@ void CreativeNotificationAds::Delete(ResultCallback callback) const {
 
   AdsClientHelper::GetInstance()->RunDBTransaction(
       std::move(transaction),
-      base::BindOnce(&OnResultCallback, std::move(callback)));
+      base::BindOnce(&OnChangedCreativeAds, std::move(callback)));
 }
 
 void CreativeNotificationAds::GetForSegments(
@@ -439,6 +504,89 @@ void CreativeNotificationAds::GetAll(
       std::move(transaction), base::BindOnce(&OnGetAll, std::move(callback)));
 }
 
+void CreativeNotificationAds::GetUnexpiredForEachSegment(
+    GetCreativeNotificationAdsCallback callback) const {
+  const std::string query = base::StringPrintf(
+      "SELECT "
+      "can.creative_instance_id, "
+      "can.creative_set_id, "
+      "can.campaign_id, "
+      "cam.start_at_timestamp, "
+      "cam.end_at_timestamp, "
+      "cam.daily_cap, "
+      "cam.advertiser_id, "
+      "cam.priority, "
+      "ca.conversion, "
+      "ca.per_day, "
+      "ca.per_week, "
+      "ca.per_month, "
+      "ca.total_max, "
+      "ca.value, "
+      "ca.split_test_group, "
+      "s.segment, "
+      "gt.geo_target, "
+      "ca.target_url, "
+      "can.title, "
+      "can.body, "
+      "cam.ptr, "
+      "dp.dow, "
+      "dp.start_minute, "
+      "dp.end_minute "
+      "FROM %s AS can "
+      "INNER JOIN campaigns AS cam "
+      "ON cam.campaign_id = can.campaign_id "
+      "INNER JOIN segments AS s "
+      "ON s.creative_set_id = can.creative_set_id "
+      "INNER JOIN creative_ads AS ca "
+      "ON ca.creative_instance_id = can.creative_instance_id "
+      "INNER JOIN geo_targets AS gt "
+      "ON gt.campaign_id = can.campaign_id "
+      "INNER JOIN dayparts AS dp "
+      "ON dp.campaign_id = can.campaign_id "
+      "WHERE cam.end_at_timestamp >= %s",
+      GetTableName().c_str(), TimeAsTimestampString(base::Time::Now()).c_str());
+
+  mojom::DBCommandInfoPtr command = mojom::DBCommandInfo::New();
+  command->type = mojom::DBCommandInfo::Type::READ;
+  command->command = query;
+
+  command->record_bindings = {
+      mojom::DBCommandInfo::RecordBindingType::
+          STRING_TYPE,  // creative_instance_id
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // creative_set_id
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // campaign_id
+      mojom::DBCommandInfo::RecordBindingType::DOUBLE_TYPE,  // start_at
+      mojom::DBCommandInfo::RecordBindingType::DOUBLE_TYPE,  // end_at
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // daily_cap
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // advertiser_id
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // priority
+      mojom::DBCommandInfo::RecordBindingType::BOOL_TYPE,    // conversion
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // per_day
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // per_week
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // per_month
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE,     // total_max
+      mojom::DBCommandInfo::RecordBindingType::DOUBLE_TYPE,  // value
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // split_test_group
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // segment
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // geo_target
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // target_url
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // title
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // body
+      mojom::DBCommandInfo::RecordBindingType::DOUBLE_TYPE,  // ptr
+      mojom::DBCommandInfo::RecordBindingType::STRING_TYPE,  // dayparts->dow
+      mojom::DBCommandInfo::RecordBindingType::
+          INT_TYPE,  // dayparts->start_minute
+      mojom::DBCommandInfo::RecordBindingType::INT_TYPE  // dayparts->end_minute
+  };
+
+  mojom::DBTransactionInfoPtr transaction = mojom::DBTransactionInfo::New();
+  transaction->commands.push_back(std::move(command));
+
+  AdsClientHelper::GetInstance()->RunDBTransaction(
+      std::move(transaction),
+      base::BindOnce(&OnGetUnexpiredForEachSegment, std::move(callback)));
+}
+
 std::string CreativeNotificationAds::GetTableName() const {
   return kTableName;
 }
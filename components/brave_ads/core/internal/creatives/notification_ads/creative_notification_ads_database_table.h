@@ -55,6 +55,12 @@ class CreativeNotificationAds final : public TableInterface {
 
   void GetAll(GetCreativeNotificationAdsCallback callback) const;
 
+  // Gets the creative ads of campaigns which have not ended yet with one entry
+  // for each segment of a creative ad, including campaigns which have not
+  // started yet, to build |CreativeNotificationAdsServingIndex|.
+  void GetUnexpiredForEachSegment(
+      GetCreativeNotificationAdsCallback callback) const;
+
   void SetBatchSize(const int batch_size) {
     DCHECK_GT(batch_size, 0);
 
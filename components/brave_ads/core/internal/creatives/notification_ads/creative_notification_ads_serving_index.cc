@@ -0,0 +1,209 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
+
+#include <iterator>
+#include <map>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "brave/components/brave_ads/core/internal/common/logging_util.h"
+#include "brave/components/brave_ads/core/internal/segments/segment_util.h"
+
+namespace ads {
+
+namespace {
+
+CreativeNotificationAdsServingIndex*
+    g_creative_notification_ads_serving_index_instance = nullptr;
+
+}  // namespace
+
+CreativeNotificationAdsServingIndex::CreativeNotificationAdsServingIndex() {
+  DCHECK(!g_creative_notification_ads_serving_index_instance);
+  g_creative_notification_ads_serving_index_instance = this;
+}
+
+CreativeNotificationAdsServingIndex::~CreativeNotificationAdsServingIndex() {
+  DCHECK_EQ(this, g_creative_notification_ads_serving_index_instance);
+  g_creative_notification_ads_serving_index_instance = nullptr;
+}
+
+// static
+CreativeNotificationAdsServingIndex*
+CreativeNotificationAdsServingIndex::GetInstance() {
+  DCHECK(g_creative_notification_ads_serving_index_instance);
+  return g_creative_notification_ads_serving_index_instance;
+}
+
+// static
+bool CreativeNotificationAdsServingIndex::HasInstance() {
+  return !!g_creative_notification_ads_serving_index_instance;
+}
+
+void CreativeNotificationAdsServingIndex::GetForSegments(
+    const SegmentList& segments,
+    database::table::GetCreativeNotificationAdsCallback callback) {
+  if (segments.empty()) {
+    std::move(callback).Run(/*success*/ true, segments, {});
+    return;
+  }
+
+  MaybeLoad(base::BindOnce(
+      &CreativeNotificationAdsServingIndex::OnLoadedForSegments,
+      weak_factory_.GetWeakPtr(), segments, std::move(callback)));
+}
+
+void CreativeNotificationAdsServingIndex::GetAll(
+    database::table::GetCreativeNotificationAdsCallback callback) {
+  MaybeLoad(base::BindOnce(&CreativeNotificationAdsServingIndex::OnLoadedForAll,
+                           weak_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void CreativeNotificationAdsServingIndex::Invalidate() {
+  // Callbacks waiting for a stale load wait for the reload instead, and an
+  // index in use is reloaded so serving stays synchronous.
+  const bool should_reload = is_loaded_ || is_loading_;
+
+  generation_++;
+  is_loaded_ = false;
+  segment_to_creative_ads_.clear();
+
+  if (should_reload) {
+    Load();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CreativeNotificationAdsServingIndex::MaybeLoad(LoadCallback callback) {
+  if (is_loaded_) {
+    std::move(callback).Run(/*success*/ true);
+    return;
+  }
+
+  pending_callbacks_.push_back(std::move(callback));
+  if (!is_loading_) {
+    Load();
+  }
+}
+
+void CreativeNotificationAdsServingIndex::Load() {
+  BLOG(1, "Loading creative notification ads serving index");
+
+  is_loading_ = true;
+
+  const database::table::CreativeNotificationAds database_table;
+  database_table.GetUnexpiredForEachSegment(
+      base::BindOnce(&CreativeNotificationAdsServingIndex::OnLoad,
+                     weak_factory_.GetWeakPtr(), generation_));
+}
+
+void CreativeNotificationAdsServingIndex::OnLoad(
+    const int generation,
+    const bool success,
+    const SegmentList& /*segments*/,
+    const CreativeNotificationAdList& creative_ads) {
+  if (generation != generation_) {
+    return;
+  }
+
+  is_loading_ = false;
+
+  if (!success) {
+    BLOG(0, "Failed to load creative notification ads serving index");
+  } else {
+    std::map<std::string, CreativeNotificationAdList> segment_to_creative_ads;
+    for (const auto& creative_ad : creative_ads) {
+      segment_to_creative_ads[creative_ad.segment].push_back(creative_ad);
+    }
+    segment_to_creative_ads_ = base::flat_map<std::string,
+                                              CreativeNotificationAdList>(
+        std::make_move_iterator(segment_to_creative_ads.begin()),
+        std::make_move_iterator(segment_to_creative_ads.end()));
+    is_loaded_ = true;
+
+    BLOG(1, "Loaded " << creative_ads.size()
+                      << " creative notification ads into serving index");
+  }
+
+  std::vector<LoadCallback> pending_callbacks;
+  pending_callbacks.swap(pending_callbacks_);
+  for (auto& callback : pending_callbacks) {
+    std::move(callback).Run(success);
+  }
+}
+
+void CreativeNotificationAdsServingIndex::OnLoadedForSegments(
+    const SegmentList& segments,
+    database::table::GetCreativeNotificationAdsCallback callback,
+    const bool success) {
+  if (!success) {
+    std::move(callback).Run(/*success*/ false, segments, {});
+    return;
+  }
+
+  std::move(callback).Run(/*success*/ true, segments,
+                          GetActiveCreativeAdsForSegments(segments));
+}
+
+void CreativeNotificationAdsServingIndex::OnLoadedForAll(
+    database::table::GetCreativeNotificationAdsCallback callback,
+    const bool success) {
+  if (!success) {
+    std::move(callback).Run(/*success*/ false, {}, {});
+    return;
+  }
+
+  SegmentList all_segments;
+  for (const auto& [segment, creative_ads] : segment_to_creative_ads_) {
+    all_segments.push_back(segment);
+  }
+
+  const CreativeNotificationAdList creative_ads =
+      GetActiveCreativeAdsForSegments(all_segments);
+
+  std::move(callback).Run(/*success*/ true, GetSegments(creative_ads),
+                          creative_ads);
+}
+
+CreativeNotificationAdList
+CreativeNotificationAdsServingIndex::GetActiveCreativeAdsForSegments(
+    const SegmentList& segments) const {
+  const base::Time now = base::Time::Now();
+
+  // Keyed by creative instance id, as the database table groups them.
+  std::map<std::string, CreativeNotificationAdInfo> active_creative_ads;
+  for (const auto& segment : segments) {
+    const auto iter =
+        segment_to_creative_ads_.find(base::ToLowerASCII(segment));
+    if (iter == segment_to_creative_ads_.cend()) {
+      continue;
+    }
+
+    for (const auto& creative_ad : iter->second) {
+      if (now < creative_ad.start_at || now > creative_ad.end_at) {
+        continue;
+      }
+
+      active_creative_ads.insert(
+          {creative_ad.creative_instance_id, creative_ad});
+    }
+  }
+
+  CreativeNotificationAdList creative_ads;
+  creative_ads.reserve(active_creative_ads.size());
+  for (auto& [creative_instance_id, creative_ad] : active_creative_ads) {
+    creative_ads.push_back(std::move(creative_ad));
+  }
+
+  return creative_ads;
+}
+
+}  // namespace ads
@@ -0,0 +1,95 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_NOTIFICATION_ADS_CREATIVE_NOTIFICATION_ADS_SERVING_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_NOTIFICATION_ADS_CREATIVE_NOTIFICATION_ADS_SERVING_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ad_info.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_table.h"
+#include "brave/components/brave_ads/core/internal/segments/segment_alias.h"
+
+namespace ads {
+
+// In-memory index of the creative notification ads keyed by segment, with the
+// campaign, daypart and geo target data already joined. It is loaded from the
+// database on first use after the creative notification ads change, so
+// serving does not query the database.
+class CreativeNotificationAdsServingIndex final {
+ public:
+  CreativeNotificationAdsServingIndex();
+
+  CreativeNotificationAdsServingIndex(
+      const CreativeNotificationAdsServingIndex& other) = delete;
+  CreativeNotificationAdsServingIndex& operator=(
+      const CreativeNotificationAdsServingIndex& other) = delete;
+
+  CreativeNotificationAdsServingIndex(
+      CreativeNotificationAdsServingIndex&& other) noexcept = delete;
+  CreativeNotificationAdsServingIndex& operator=(
+      CreativeNotificationAdsServingIndex&& other) noexcept = delete;
+
+  ~CreativeNotificationAdsServingIndex();
+
+  static CreativeNotificationAdsServingIndex* GetInstance();
+
+  static bool HasInstance();
+
+  // Same results as |database::table::CreativeNotificationAds|. |callback| is
+  // run synchronously once the index is loaded.
+  void GetForSegments(
+      const SegmentList& segments,
+      database::table::GetCreativeNotificationAdsCallback callback);
+  void GetAll(database::table::GetCreativeNotificationAdsCallback callback);
+
+  // Must be called once the creative notification ads in the database have
+  // changed. Reloads the index if it was loaded or loading.
+  void Invalidate();
+
+  bool IsLoaded() const { return is_loaded_; }
+
+ private:
+  using LoadCallback = base::OnceCallback<void(bool success)>;
+
+  void MaybeLoad(LoadCallback callback);
+  void Load();
+  void OnLoad(int generation,
+              bool success,
+              const SegmentList& segments,
+              const CreativeNotificationAdList& creative_ads);
+
+  void OnLoadedForSegments(
+      const SegmentList& segments,
+      database::table::GetCreativeNotificationAdsCallback callback,
+      bool success);
+  void OnLoadedForAll(
+      database::table::GetCreativeNotificationAdsCallback callback,
+      bool success);
+
+  CreativeNotificationAdList GetActiveCreativeAdsForSegments(
+      const SegmentList& segments) const;
+
+  bool is_loaded_ = false;
+  bool is_loading_ = false;
+  // Incremented by |Invalidate| so loads started before are discarded.
+  int generation_ = 0;
+  std::vector<LoadCallback> pending_callbacks_;
+
+  // Unexpired creative ads, one for each of their segments.
+  base::flat_map<std::string, CreativeNotificationAdList>
+      segment_to_creative_ads_;
+
+  base::WeakPtrFactory<CreativeNotificationAdsServingIndex> weak_factory_{
+      this};
+};
+
+}  // namespace ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_CREATIVES_NOTIFICATION_ADS_CREATIVE_NOTIFICATION_ADS_SERVING_INDEX_H_
@@ -0,0 +1,221 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_serving_index.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "brave/components/brave_ads/common/interfaces/ads.mojom.h"
+#include "brave/components/brave_ads/core/ads_client_callback.h"
+#include "brave/components/brave_ads/core/internal/common/unittest/unittest_base.h"
+#include "brave/components/brave_ads/core/internal/common/unittest/unittest_container_util.h"
+#include "brave/components/brave_ads/core/internal/common/unittest/unittest_time_util.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ad_unittest_util.h"
+#include "brave/components/brave_ads/core/internal/creatives/notification_ads/creative_notification_ads_database_util.h"
+
+// npm run test -- brave_unit_tests --filter=BatAds*
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+
+namespace ads {
+
+namespace {
+
+CreativeNotificationAdList GetForSegmentsFromDatabase(
+    const SegmentList& segments) {
+  CreativeNotificationAdList creative_ads;
+
+  const database::table::CreativeNotificationAds database_table;
+  database_table.GetForSegments(
+      segments, base::BindOnce(
+                    [](CreativeNotificationAdList* creative_ads,
+                       const bool success, const SegmentList& /*segments*/,
+                       const CreativeNotificationAdList& result) {
+                      EXPECT_TRUE(success);
+                      *creative_ads = result;
+                    },
+                    &creative_ads));
+
+  return creative_ads;
+}
+
+CreativeNotificationAdList GetForSegmentsFromServingIndex(
+    const SegmentList& segments) {
+  CreativeNotificationAdList creative_ads;
+
+  CreativeNotificationAdsServingIndex::GetInstance()->GetForSegments(
+      segments, base::BindOnce(
+                    [](CreativeNotificationAdList* creative_ads,
+                       const bool success, const SegmentList& /*segments*/,
+                       const CreativeNotificationAdList& result) {
+                      EXPECT_TRUE(success);
+                      *creative_ads = result;
+                    },
+                    &creative_ads));
+
+  return creative_ads;
+}
+
+}  // namespace
+
+class BatAdsCreativeNotificationAdsServingIndexTest : public UnitTestBase {};
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest,
+       GetForSegmentsMatchesDatabase) {
+  // Arrange
+  CreativeNotificationAdList creative_ads;
+
+  CreativeNotificationAdInfo creative_ad_1 = BuildCreativeNotificationAd();
+  creative_ad_1.segment = "technology & computing";
+  creative_ad_1.geo_targets = {"US", "GB"};
+  creative_ads.push_back(creative_ad_1);
+
+  CreativeNotificationAdInfo creative_ad_2 = BuildCreativeNotificationAd();
+  creative_ad_2.segment = "food & drink";
+  creative_ads.push_back(creative_ad_2);
+
+  CreativeNotificationAdInfo creative_ad_3 = BuildCreativeNotificationAd();
+  creative_ad_3.segment = "untargeted";
+  creative_ads.push_back(creative_ad_3);
+
+  database::SaveCreativeNotificationAds(creative_ads);
+
+  // Act
+  const SegmentList segments = {"Technology & Computing", "food & drink"};
+  const CreativeNotificationAdList index_creative_ads =
+      GetForSegmentsFromServingIndex(segments);
+
+  // Assert
+  EXPECT_TRUE(CreativeNotificationAdsServingIndex::GetInstance()->IsLoaded());
+  EXPECT_TRUE(
+      ContainersEq(GetForSegmentsFromDatabase(segments), index_creative_ads));
+  EXPECT_EQ(2U, index_creative_ads.size());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest,
+       DoNotGetCreativeAdsForInactiveCampaigns) {
+  // Arrange
+  CreativeNotificationAdList creative_ads;
+
+  CreativeNotificationAdInfo creative_ad_1 = BuildCreativeNotificationAd();
+  creative_ad_1.start_at = Now() + base::Days(1);
+  creative_ads.push_back(creative_ad_1);
+
+  CreativeNotificationAdInfo creative_ad_2 = BuildCreativeNotificationAd();
+  creative_ad_2.end_at = Now() - base::Days(1);
+  creative_ads.push_back(creative_ad_2);
+
+  database::SaveCreativeNotificationAds(creative_ads);
+
+  // Act
+  const CreativeNotificationAdList index_creative_ads =
+      GetForSegmentsFromServingIndex({"untargeted"});
+
+  // Assert
+  EXPECT_TRUE(index_creative_ads.empty());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest,
+       GetCreativeAdsForCampaignWhichHasStarted) {
+  // Arrange
+  CreativeNotificationAdInfo creative_ad = BuildCreativeNotificationAd();
+  creative_ad.start_at = Now() + base::Days(1);
+  database::SaveCreativeNotificationAds({creative_ad});
+
+  ASSERT_TRUE(GetForSegmentsFromServingIndex({"untargeted"}).empty());
+
+  // Act
+  AdvanceClockBy(base::Days(2));
+
+  // Assert
+  EXPECT_EQ(1U, GetForSegmentsFromServingIndex({"untargeted"}).size());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest, InvalidateWhenSaved) {
+  // Arrange
+  database::SaveCreativeNotificationAds({BuildCreativeNotificationAd()});
+  ASSERT_EQ(1U, GetForSegmentsFromServingIndex({"untargeted"}).size());
+
+  // Act
+  database::SaveCreativeNotificationAds({BuildCreativeNotificationAd()});
+
+  // Assert
+  EXPECT_EQ(2U, GetForSegmentsFromServingIndex({"untargeted"}).size());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest, InvalidateWhenDeleted) {
+  // Arrange
+  database::SaveCreativeNotificationAds({BuildCreativeNotificationAd()});
+  ASSERT_EQ(1U, GetForSegmentsFromServingIndex({"untargeted"}).size());
+
+  // Act
+  database::DeleteCreativeNotificationAds();
+
+  // Assert
+  EXPECT_TRUE(GetForSegmentsFromServingIndex({"untargeted"}).empty());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest,
+       InvalidateWhenSavedWhileLoading) {
+  // Arrange
+  mojom::DBTransactionInfoPtr load_transaction;
+  RunDBTransactionCallback load_callback;
+  EXPECT_CALL(*ads_client_mock_, RunDBTransaction(_, _)).Times(AnyNumber());
+  EXPECT_CALL(*ads_client_mock_, RunDBTransaction(_, _))
+      .WillOnce(Invoke([&load_transaction, &load_callback](
+                           mojom::DBTransactionInfoPtr transaction,
+                           RunDBTransactionCallback callback) {
+        load_transaction = std::move(transaction);
+        load_callback = std::move(callback);
+      }))
+      .RetiresOnSaturation();
+
+  CreativeNotificationAdList creative_ads;
+  CreativeNotificationAdsServingIndex::GetInstance()->GetForSegments(
+      {"untargeted"}, base::BindOnce(
+                          [](CreativeNotificationAdList* creative_ads,
+                             const bool success,
+                             const SegmentList& /*segments*/,
+                             const CreativeNotificationAdList& result) {
+                            EXPECT_TRUE(success);
+                            *creative_ads = result;
+                          },
+                          &creative_ads));
+  ASSERT_TRUE(load_callback);
+
+  // Act
+  database::SaveCreativeNotificationAds({BuildCreativeNotificationAd()});
+  ads_client_mock_->RunDBTransaction(std::move(load_transaction),
+                                     std::move(load_callback));
+
+  // Assert
+  EXPECT_EQ(1U, creative_ads.size());
+  EXPECT_EQ(1U, GetForSegmentsFromServingIndex({"untargeted"}).size());
+}
+
+TEST_F(BatAdsCreativeNotificationAdsServingIndexTest, GetAll) {
+  // Arrange
+  CreativeNotificationAdInfo creative_ad_1 = BuildCreativeNotificationAd();
+  creative_ad_1.segment = "technology & computing";
+  CreativeNotificationAdInfo creative_ad_2 = BuildCreativeNotificationAd();
+  database::SaveCreativeNotificationAds({creative_ad_1, creative_ad_2});
+
+  // Act
+  CreativeNotificationAdsServingIndex::GetInstance()->GetAll(base::BindOnce(
+      [](const bool success, const SegmentList& segments,
+         const CreativeNotificationAdList& creative_ads) {
+        // Assert
+        EXPECT_TRUE(success);
+        const SegmentList expected_segments = {"technology & computing",
+                                               "untargeted"};
+        EXPECT_TRUE(ContainersEq(expected_segments, segments));
+        EXPECT_EQ(2U, creative_ads.size());
+      }));
+}
+
+}  // namespace ads
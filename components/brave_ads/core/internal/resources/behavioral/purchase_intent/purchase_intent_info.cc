@@ -7,6 +7,7 @@
 
 #include "base/values.h"
 #include "brave/components/brave_ads/core/internal/features/purchase_intent_features.h"
+#include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_keyword_index.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
@@ -146,6 +147,22 @@ std::unique_ptr<PurchaseIntentInfo> PurchaseIntentInfo::CreateFromValue(
     }
   }
 
+  std::vector<std::string> segment_keywords;
+  segment_keywords.reserve(purchase_intent->segment_keywords.size());
+  for (const auto& info : purchase_intent->segment_keywords) {
+    segment_keywords.push_back(info.keywords);
+  }
+  purchase_intent->segment_keyword_index =
+      PurchaseIntentKeywordIndex(segment_keywords);
+
+  std::vector<std::string> funnel_keywords;
+  funnel_keywords.reserve(purchase_intent->funnel_keywords.size());
+  for (const auto& info : purchase_intent->funnel_keywords) {
+    funnel_keywords.push_back(info.keywords);
+  }
+  purchase_intent->funnel_keyword_index =
+      PurchaseIntentKeywordIndex(funnel_keywords);
+
   return purchase_intent;
 }
 
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "brave/components/brave_ads/core/internal/ads/serving/targeting/models/behavioral/purchase_intent/purchase_intent_funnel_keyword_info.h"
+#include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_keyword_index.h"
 #include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_segment_keyword_info.h"
 #include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_site_info.h"
 
@@ -40,6 +41,10 @@ struct PurchaseIntentInfo final {
   std::vector<PurchaseIntentSiteInfo> sites;
   std::vector<PurchaseIntentSegmentKeywordInfo> segment_keywords;
   std::vector<PurchaseIntentFunnelKeywordInfo> funnel_keywords;
+
+  // Indexes of the keywords of |segment_keywords| and |funnel_keywords|.
+  PurchaseIntentKeywordIndex segment_keyword_index;
+  PurchaseIntentKeywordIndex funnel_keyword_index;
 };
 
 }  // namespace ads::targeting
@@ -0,0 +1,114 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_keyword_index.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "brave/components/brave_ads/core/internal/common/strings/string_strip_util.h"
+
+namespace ads::targeting {
+
+namespace {
+
+// Returns the distinct keywords with the times each of them is repeated.
+std::map<std::string, uint32_t> CountKeywords(const KeywordList& keywords) {
+  std::map<std::string, uint32_t> keyword_counts;
+  for (const auto& keyword : keywords) {
+    keyword_counts[keyword]++;
+  }
+
+  return keyword_counts;
+}
+
+}  // namespace
+
+KeywordList ToKeywords(const std::string& value) {
+  const std::string lowercase_value = base::ToLowerASCII(value);
+
+  const std::string stripped_value =
+      StripNonAlphaNumericCharacters(lowercase_value);
+
+  return base::SplitString(stripped_value, " ", base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY);
+}
+
+PurchaseIntentKeywordIndex::PurchaseIntentKeywordIndex() = default;
+
+PurchaseIntentKeywordIndex::PurchaseIntentKeywordIndex(
+    const std::vector<std::string>& entries) {
+  std::map<std::string, uint32_t> keyword_ids;
+  entry_keyword_counts_.reserve(entries.size());
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const std::map<std::string, uint32_t> keyword_counts =
+        CountKeywords(ToKeywords(entries[i]));
+    entry_keyword_counts_.push_back(
+        static_cast<uint32_t>(keyword_counts.size()));
+
+    if (keyword_counts.empty()) {
+      entries_without_keywords_.push_back(i);
+      continue;
+    }
+
+    for (const auto& [keyword, count] : keyword_counts) {
+      const auto [iter, inserted] = keyword_ids.emplace(
+          keyword, static_cast<uint32_t>(postings_.size()));
+      if (inserted) {
+        postings_.emplace_back();
+      }
+
+      postings_[iter->second].push_back({static_cast<uint32_t>(i), count});
+    }
+  }
+
+  keyword_ids_ = base::flat_map<std::string, uint32_t>(keyword_ids.cbegin(),
+                                                       keyword_ids.cend());
+}
+
+PurchaseIntentKeywordIndex::PurchaseIntentKeywordIndex(
+    PurchaseIntentKeywordIndex&& other) noexcept = default;
+
+PurchaseIntentKeywordIndex& PurchaseIntentKeywordIndex::operator=(
+    PurchaseIntentKeywordIndex&& other) noexcept = default;
+
+PurchaseIntentKeywordIndex::~PurchaseIntentKeywordIndex() = default;
+
+std::vector<size_t> PurchaseIntentKeywordIndex::Match(
+    const KeywordList& search_query_keywords) const {
+  // Number of distinct keywords of each entry the search query has enough of.
+  std::map<uint32_t, uint32_t> matched_keyword_counts;
+  for (const auto& [keyword, count] : CountKeywords(search_query_keywords)) {
+    const auto iter = keyword_ids_.find(keyword);
+    if (iter == keyword_ids_.cend()) {
+      continue;
+    }
+
+    for (const auto& posting : postings_[iter->second]) {
+      if (posting.count <= count) {
+        matched_keyword_counts[posting.entry]++;
+      }
+    }
+  }
+
+  std::vector<size_t> entries = entries_without_keywords_;
+  const size_t entries_without_keywords_count = entries.size();
+  for (const auto& [entry, matched_keyword_count] : matched_keyword_counts) {
+    if (matched_keyword_count == entry_keyword_counts_[entry]) {
+      entries.push_back(entry);
+    }
+  }
+
+  std::inplace_merge(entries.begin(),
+                     entries.begin() + entries_without_keywords_count,
+                     entries.end());
+
+  return entries;
+}
+
+}  // namespace ads::targeting
@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_RESOURCES_BEHAVIORAL_PURCHASE_INTENT_PURCHASE_INTENT_KEYWORD_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_RESOURCES_BEHAVIORAL_PURCHASE_INTENT_PURCHASE_INTENT_KEYWORD_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+
+namespace ads::targeting {
+
+using KeywordList = std::vector<std::string>;
+
+// Lowercases |value|, strips non alphanumeric characters and splits it into
+// keywords.
+KeywordList ToKeywords(const std::string& value);
+
+// Inverted index over the keywords of a list of entries, e.g. the segment
+// keywords of the purchase intent resource. Finds the entries whose keywords
+// are all in a search query by counting, for each entry sharing a keyword
+// with the query, how many of its keywords the query has. So a search only
+// touches the entries it shares keywords with.
+class PurchaseIntentKeywordIndex final {
+ public:
+  PurchaseIntentKeywordIndex();
+  // |entries| are the keywords of each entry, as passed to |ToKeywords|.
+  explicit PurchaseIntentKeywordIndex(const std::vector<std::string>& entries);
+
+  PurchaseIntentKeywordIndex(const PurchaseIntentKeywordIndex& other) = delete;
+  PurchaseIntentKeywordIndex& operator=(
+      const PurchaseIntentKeywordIndex& other) = delete;
+
+  PurchaseIntentKeywordIndex(PurchaseIntentKeywordIndex&& other) noexcept;
+  PurchaseIntentKeywordIndex& operator=(
+      PurchaseIntentKeywordIndex&& other) noexcept;
+
+  ~PurchaseIntentKeywordIndex();
+
+  // Returns the positions, in ascending order, of the entries whose keywords
+  // are all in |search_query_keywords|, counting repeated keywords as many
+  // times as they are repeated.
+  std::vector<size_t> Match(const KeywordList& search_query_keywords) const;
+
+ private:
+  struct Posting final {
+    uint32_t entry;
+    // Times the keyword is repeated in the entry.
+    uint32_t count;
+  };
+
+  base::flat_map<std::string, uint32_t> keyword_ids_;
+  // Indexed by keyword id.
+  std::vector<std::vector<Posting>> postings_;
+  // Number of distinct keywords of each entry.
+  std::vector<uint32_t> entry_keyword_counts_;
+  // Entries without keywords, which match every search query.
+  std::vector<size_t> entries_without_keywords_;
+};
+
+}  // namespace ads::targeting
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_CORE_INTERNAL_RESOURCES_BEHAVIORAL_PURCHASE_INTENT_PURCHASE_INTENT_KEYWORD_INDEX_H_
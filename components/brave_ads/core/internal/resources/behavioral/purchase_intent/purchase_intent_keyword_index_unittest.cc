@@ -0,0 +1,130 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/core/internal/resources/behavioral/purchase_intent/purchase_intent_keyword_index.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAds*
+
+namespace ads::targeting {
+
+namespace {
+
+// About the size of the purchase intent resources we ship.
+constexpr int kVocabularySize = 3000;
+constexpr int kSegmentKeywordCount = 8000;
+
+// What PurchaseIntent used to check for every entry of the resource.
+bool IsSubset(KeywordList keywords_lhs, KeywordList keywords_rhs) {
+  base::ranges::sort(keywords_lhs);
+  base::ranges::sort(keywords_rhs);
+  return base::ranges::includes(keywords_lhs, keywords_rhs);
+}
+
+std::vector<size_t> MatchOneByOne(const std::vector<std::string>& entries,
+                                  const std::string& search_query) {
+  const KeywordList search_query_keywords = ToKeywords(search_query);
+
+  std::vector<size_t> matches;
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (IsSubset(search_query_keywords, ToKeywords(entries[i]))) {
+      matches.push_back(i);
+    }
+  }
+
+  return matches;
+}
+
+// Deterministic, so that failures reproduce.
+class KeywordGenerator final {
+ public:
+  std::string Generate(const int max_keyword_count) {
+    std::string keywords;
+    const int keyword_count = 1 + Next() % max_keyword_count;
+    for (int i = 0; i < keyword_count; i++) {
+      if (!keywords.empty()) {
+        keywords += ' ';
+      }
+      // Skew towards the first words, as with brands and models.
+      const uint32_t word = Next() % (1 + Next() % kVocabularySize);
+      keywords += "w" + base::NumberToString(word);
+    }
+    return keywords;
+  }
+
+ private:
+  uint32_t Next() {
+    state_ = state_ * 1103515245 + 12345;
+    return state_ >> 8;
+  }
+
+  uint32_t state_ = 42;
+};
+
+std::vector<std::string> GenerateEntries(KeywordGenerator* generator,
+                                         const int count,
+                                         const int max_keyword_count) {
+  std::vector<std::string> entries;
+  for (int i = 0; i < count; i++) {
+    entries.push_back(generator->Generate(max_keyword_count));
+  }
+  return entries;
+}
+
+}  // namespace
+
+TEST(BatAdsPurchaseIntentKeywordIndexTest, Match) {
+  // Arrange
+  const PurchaseIntentKeywordIndex index(
+      {"audi a6", "audi", "Audi-A4 review", "", "buy buy", "bmw"});
+
+  // Act & Assert
+  EXPECT_EQ(std::vector<size_t>({0, 1, 3}),
+            index.Match(ToKeywords("A6 AUDI")));
+  EXPECT_EQ(std::vector<size_t>({1, 2, 3}),
+            index.Match(ToKeywords("audi a4 review")));
+  EXPECT_EQ(std::vector<size_t>({1, 3}),
+            index.Match(ToKeywords("buy audi a4")));
+  EXPECT_EQ(std::vector<size_t>({1, 3, 4}),
+            index.Match(ToKeywords("buy audi, buy")));
+  EXPECT_EQ(std::vector<size_t>({3}), index.Match({}));
+}
+
+TEST(BatAdsPurchaseIntentKeywordIndexTest, MatchNothingWhenEmpty) {
+  // Arrange
+  const PurchaseIntentKeywordIndex index;
+
+  // Act & Assert
+  EXPECT_TRUE(index.Match(ToKeywords("audi a6")).empty());
+}
+
+TEST(BatAdsPurchaseIntentKeywordIndexTest, MatchSameEntriesAsSubsetScan) {
+  // Arrange
+  KeywordGenerator generator;
+  const std::vector<std::string> entries =
+      GenerateEntries(&generator, kSegmentKeywordCount / 4, 3);
+  const PurchaseIntentKeywordIndex index(entries);
+
+  // Act & Assert
+  size_t matches = 0;
+  for (int i = 0; i < 1000; i++) {
+    const std::string search_query = generator.Generate(6);
+    const std::vector<size_t> expected_matches =
+        MatchOneByOne(entries, search_query);
+    EXPECT_EQ(expected_matches, index.Match(ToKeywords(search_query)))
+        << search_query;
+    matches += expected_matches.size();
+  }
+  EXPECT_GT(matches, 0U);
+}
+
+}  // namespace ads::targeting
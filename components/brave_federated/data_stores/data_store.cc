@@ -81,26 +81,22 @@ bool DataStore::InitializeDatabase() {
       base::BindRepeating(&DatabaseErrorCallback, &database_, db_file_path_));
 
   // Attach the database to our index file.
-  return database_.Open(db_file_path_) && MaybeCreateTable();
+  return database_.Open(db_file_path_) && MaybeCreateTable() &&
+         MaybeCreateIndex() && LoadNextTrainingInstanceId();
 }
 
 int DataStore::GetNextTrainingInstanceId() {
-  sql::Statement statement(database_.GetUniqueStatement(
-      base::StringPrintf("SELECT MAX(training_instance_id) FROM %s",
-                         data_store_task_.name.c_str())
-          .c_str()));
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  if (statement.Step()) {
-    return statement.ColumnInt(0) + 1;
-  }
-  return 0;
+  return next_training_instance_id_;
 }
 
-void DataStore::SaveCovariate(
+bool DataStore::SaveCovariate(
     const brave_federated::mojom::CovariateInfo& covariate,
     int training_instance_id,
     const base::Time created_at) {
-  sql::Statement statement(database_.GetUniqueStatement(
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("INSERT INTO %s (training_instance_id, "
                          "feature_name, feature_type, "
                          "feature_value, created_at) "
@@ -110,7 +106,7 @@ void DataStore::SaveCovariate(
 
   BindCovariateToStatement(covariate, training_instance_id, created_at,
                            &statement);
-  statement.Run();
+  return statement.Run();
 }
 
 bool DataStore::AddTrainingInstance(
@@ -118,13 +114,43 @@ bool DataStore::AddTrainingInstance(
         training_instance) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  const int training_instance_id = GetNextTrainingInstanceId();
   const base::Time created_at = base::Time::Now();
 
-  for (const auto& covariate : training_instance) {
-    SaveCovariate(*covariate, training_instance_id, created_at);
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin() ||
+      !SaveTrainingInstance(training_instance, next_training_instance_id_,
+                            created_at) ||
+      !EnforceRetentionPolicy() || !transaction.Commit()) {
+    return false;
+  }
+
+  next_training_instance_id_++;
+  return true;
+}
+
+bool DataStore::AddTrainingInstances(
+    std::vector<std::vector<brave_federated::mojom::CovariateInfoPtr>>
+        training_instances) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const base::Time created_at = base::Time::Now();
+
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin()) {
+    return false;
+  }
+  int training_instance_id = next_training_instance_id_;
+  for (const auto& training_instance : training_instances) {
+    if (!SaveTrainingInstance(training_instance, training_instance_id++,
+                              created_at)) {
+      return false;
+    }
+  }
+  if (!EnforceRetentionPolicy() || !transaction.Commit()) {
+    return false;
   }
 
+  next_training_instance_id_ = training_instance_id;
   return true;
 }
 
@@ -167,17 +193,7 @@ bool DataStore::DeleteTrainingData() {
 void DataStore::PurgeTrainingDataAfterExpirationDate() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  sql::Statement delete_statement(database_.GetUniqueStatement(
-      base::StringPrintf(" DELETE FROM %s WHERE created_at < ? OR id NOT IN "
-                         "(SELECT id FROM %s ORDER BY id DESC LIMIT ?)",
-                         data_store_task_.name.c_str(),
-                         data_store_task_.name.c_str())
-          .c_str()));
-  base::Time expiration_threshold =
-      base::Time::Now() - data_store_task_.max_retention_days;
-  delete_statement.BindDouble(0, expiration_threshold.ToDoubleT());
-  delete_statement.BindInt(1, data_store_task_.max_number_of_records);
-  delete_statement.Run();
+  EnforceRetentionPolicy();
 }
 
 bool DataStore::MaybeCreateTable() {
@@ -198,4 +214,59 @@ bool DataStore::MaybeCreateTable() {
          transaction.Commit();
 }
 
+bool DataStore::MaybeCreateIndex() {
+  // Lets the retention policy find expired records without a table scan.
+  // Stores created before the index existed get it on their next start.
+  return database_.Execute(
+      base::StringPrintf(
+          "CREATE INDEX IF NOT EXISTS %s_created_at_index ON %s (created_at)",
+          data_store_task_.name.c_str(), data_store_task_.name.c_str())
+          .c_str());
+}
+
+bool DataStore::LoadNextTrainingInstanceId() {
+  sql::Statement statement(database_.GetUniqueStatement(
+      base::StringPrintf("SELECT MAX(training_instance_id) FROM %s",
+                         data_store_task_.name.c_str())
+          .c_str()));
+
+  if (!statement.Step()) {
+    return false;
+  }
+  next_training_instance_id_ = statement.ColumnInt(0) + 1;
+  return true;
+}
+
+bool DataStore::SaveTrainingInstance(
+    const std::vector<brave_federated::mojom::CovariateInfoPtr>&
+        training_instance,
+    int training_instance_id,
+    const base::Time created_at) {
+  for (const auto& covariate : training_instance) {
+    if (!SaveCovariate(*covariate, training_instance_id, created_at)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DataStore::EnforceRetentionPolicy() {
+  // Both conditions are range deletes, over the created_at index and the
+  // primary key, so they only touch the records that just fell out of the
+  // retention window.
+  sql::Statement delete_statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
+      base::StringPrintf("DELETE FROM %s WHERE created_at < ? OR id <= "
+                         "(SELECT id FROM %s ORDER BY id DESC LIMIT 1 "
+                         "OFFSET ?)",
+                         data_store_task_.name.c_str(),
+                         data_store_task_.name.c_str())
+          .c_str()));
+  base::Time expiration_threshold =
+      base::Time::Now() - data_store_task_.max_retention_days;
+  delete_statement.BindDouble(0, expiration_threshold.ToDoubleT());
+  delete_statement.BindInt(1, data_store_task_.max_number_of_records);
+  return delete_statement.Run();
+}
+
 }  // namespace brave_federated
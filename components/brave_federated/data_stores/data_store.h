@@ -38,12 +38,20 @@ class DataStore {
   bool InitializeDatabase();
 
   int GetNextTrainingInstanceId();
-  void SaveCovariate(const brave_federated::mojom::CovariateInfo& covariate,
+  bool SaveCovariate(const brave_federated::mojom::CovariateInfo& covariate,
                      int training_instance_id,
                      const base::Time created_at);
+  // Saves |training_instance| under a new training instance id and enforces
+  // the retention policy in one transaction, so a failed or interrupted write
+  // leaves no part of the instance behind.
   bool AddTrainingInstance(
       const std::vector<brave_federated::mojom::CovariateInfoPtr>
           training_instance);
+  // Same as |AddTrainingInstance|, with one transaction for all of
+  // |training_instances|.
+  bool AddTrainingInstances(
+      std::vector<std::vector<brave_federated::mojom::CovariateInfoPtr>>
+          training_instances);
 
   bool DeleteTrainingData();
   TrainingData LoadTrainingData();
@@ -58,6 +66,18 @@ class DataStore {
 
  private:
   bool MaybeCreateTable();
+  bool MaybeCreateIndex();
+  bool LoadNextTrainingInstanceId();
+  bool SaveTrainingInstance(
+      const std::vector<brave_federated::mojom::CovariateInfoPtr>&
+          training_instance,
+      int training_instance_id,
+      const base::Time created_at);
+  bool EnforceRetentionPolicy();
+
+  // Ids are only handed out by this class, so it keeps the next one rather
+  // than querying for it on every write.
+  int next_training_instance_id_ = 1;
 
   SEQUENCE_CHECKER(sequence_checker_);
 };
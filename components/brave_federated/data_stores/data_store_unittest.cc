@@ -10,6 +10,7 @@
 #include "base/check.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "brave/components/brave_federated/data_stores/data_store.h"
 #include "content/public/test/browser_task_environment.h"
@@ -17,6 +18,7 @@
 #include "sql/test/scoped_error_expecter.h"
 #include "sql/test/test_helpers.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/sqlite/sqlite3.h"
 
 // npm run test -- brave_unit_tests --filter=DataStoreTest*
 
@@ -51,6 +53,8 @@ class DataStoreTest : public testing::Test {
 
   bool AddTrainingInstance(std::vector<mojom::CovariateInfoPtr> covariates);
   void InitializeDataStore();
+  void ReopenDataStore();
+  void FailInsertsOfValue(const std::string& value);
 
   base::test::TaskEnvironment task_environment_;
   base::ScopedTempDir temp_dir_;
@@ -59,6 +63,12 @@ class DataStoreTest : public testing::Test {
 
 void DataStoreTest::SetUp() {
   ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  ReopenDataStore();
+  ASSERT_TRUE(data_store_);
+}
+
+void DataStoreTest::ReopenDataStore() {
+  data_store_.reset();
   base::FilePath db_path(
       temp_dir_.GetPath().Append(FILE_PATH_LITERAL("test_data_store")));
   DataStoreTask data_store_task({0, "test_federated_task",
@@ -66,7 +76,19 @@ void DataStoreTest::SetUp() {
                                  base::Days(30)});
   data_store_ =
       std::make_unique<DataStore>(std::move(data_store_task), db_path);
-  ASSERT_TRUE(data_store_->InitializeDatabase());
+  if (!data_store_->InitializeDatabase())
+    data_store_.reset();
+}
+
+// Makes the insert of any covariate with |value| fail, as if the browser
+// went away halfway through writing a training instance.
+void DataStoreTest::FailInsertsOfValue(const std::string& value) {
+  ASSERT_TRUE(data_store_->database_.Execute(
+      base::StringPrintf("CREATE TRIGGER fail_insert BEFORE INSERT ON "
+                         "test_federated_task WHEN NEW.feature_value = '%s' "
+                         "BEGIN SELECT RAISE(ABORT, 'fail_insert'); END",
+                         value.c_str())
+          .c_str()));
 }
 
 int DataStoreTest::RecordCount() const {
@@ -192,4 +214,87 @@ TEST_F(DataStoreTest, PurgeTrainingDataAfterExpirationDate) {
   EXPECT_EQ(0, RecordCount());
 }
 
+TEST_F(DataStoreTest, AddTrainingInstances) {
+  TrainingData training_data = TrainingDataFromTestInfo();
+  std::vector<std::vector<mojom::CovariateInfoPtr>> training_instances;
+  training_instances.push_back(std::move(training_data[0]));
+  training_instances.push_back(std::move(training_data[1]));
+  EXPECT_TRUE(data_store_->AddTrainingInstances(std::move(training_instances)));
+  EXPECT_EQ(4, RecordCount());
+  EXPECT_EQ(2, TrainingInstanceCount());
+  EXPECT_EQ(3, data_store_->GetNextTrainingInstanceId());
+}
+
+TEST_F(DataStoreTest, AddTrainingInstanceIsAtomic) {
+  InitializeDataStore();
+  FailInsertsOfValue("crash");
+
+  TrainingData training_data = TrainingDataFromTestInfo();
+  training_data[1][1]->value = "crash";
+  {
+    sql::test::ScopedErrorExpecter expecter;
+    expecter.ExpectError(SQLITE_CONSTRAINT);
+    EXPECT_FALSE(AddTrainingInstance(std::move(training_data[1])));
+    EXPECT_TRUE(expecter.SawExpectedErrors());
+  }
+  EXPECT_EQ(4, RecordCount());
+  EXPECT_EQ(2, TrainingInstanceCount());
+  EXPECT_EQ(3, data_store_->GetNextTrainingInstanceId());
+
+  EXPECT_TRUE(AddTrainingInstance(std::move(training_data[0])));
+  EXPECT_EQ(6, RecordCount());
+  EXPECT_EQ(1U, data_store_->LoadTrainingData().count(3));
+}
+
+TEST_F(DataStoreTest, AddTrainingInstancesIsAtomic) {
+  FailInsertsOfValue("crash");
+
+  TrainingData training_data = TrainingDataFromTestInfo();
+  training_data[1][0]->value = "crash";
+  std::vector<std::vector<mojom::CovariateInfoPtr>> training_instances;
+  training_instances.push_back(std::move(training_data[0]));
+  training_instances.push_back(std::move(training_data[1]));
+  {
+    sql::test::ScopedErrorExpecter expecter;
+    expecter.ExpectError(SQLITE_CONSTRAINT);
+    EXPECT_FALSE(
+        data_store_->AddTrainingInstances(std::move(training_instances)));
+    EXPECT_TRUE(expecter.SawExpectedErrors());
+  }
+  EXPECT_EQ(0, RecordCount());
+  EXPECT_EQ(1, data_store_->GetNextTrainingInstanceId());
+}
+
+TEST_F(DataStoreTest, AddTrainingInstanceEnforcesMaxNumberOfRecords) {
+  // Two covariates per instance against a limit of 50 records.
+  for (int i = 0; i < 30; i++) {
+    TrainingData training_data = TrainingDataFromTestInfo();
+    EXPECT_TRUE(AddTrainingInstance(std::move(training_data[0])));
+  }
+  EXPECT_EQ(50, RecordCount());
+
+  const TrainingData training_data = data_store_->LoadTrainingData();
+  EXPECT_EQ(25U, training_data.size());
+  EXPECT_EQ(0U, training_data.count(5));
+  EXPECT_EQ(1U, training_data.count(6));
+  EXPECT_EQ(1U, training_data.count(30));
+}
+
+TEST_F(DataStoreTest, AddTrainingInstanceEnforcesRetention) {
+  InitializeDataStore();
+  task_environment_.AdvanceClock(base::Days(31));
+
+  TrainingData training_data = TrainingDataFromTestInfo();
+  EXPECT_TRUE(AddTrainingInstance(std::move(training_data[0])));
+  EXPECT_EQ(2, RecordCount());
+  EXPECT_EQ(1, TrainingInstanceCount());
+}
+
+TEST_F(DataStoreTest, GetNextTrainingInstanceIdAfterReopen) {
+  InitializeDataStore();
+  ReopenDataStore();
+  ASSERT_TRUE(data_store_);
+  EXPECT_EQ(3, data_store_->GetNextTrainingInstanceId());
+}
+
 }  // namespace brave_federated
@@ -15,6 +15,9 @@
 
 namespace brave_perf_predictor {
 
+static_assert(kResourcesTotalSize + 1 == standardise_feat_count,
+              "FeatureSlot must enumerate the standardised features");
+
 namespace {
 
 bool StandardiseFeatsNoOutliers(
@@ -65,6 +68,20 @@ double LinregPredictVector(const std::array<double, feature_count>& features) {
   return std::pow(10, log_prediction);
 }
 
+unsigned int GetThirdPartyBlockedSlot(const std::string& entity) {
+  const auto it = third_party_blocked_slots.find(entity);
+  if (it == third_party_blocked_slots.end())
+    return kUnknownThirdPartySlot;
+  return it->second;
+}
+
+double LinregPredictSlots(const FeatureSlots& features) {
+  std::array<double, feature_count> feature_vector;
+  std::copy(features.begin(), features.begin() + feature_count,
+            feature_vector.begin());
+  return LinregPredictVector(feature_vector);
+}
+
 double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
   std::array<double, feature_count> feature_vector{};
   for (unsigned int i = 0; i < feature_count; i++) {
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -18,11 +19,27 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Slot for blocked third parties that are not model features. It has no
+// coefficient, so they never change the prediction.
+constexpr unsigned int kUnknownThirdPartySlot = feature_count;
+
+// Feature vector indexed by |FeatureSlot| and the thirdParties.*.blocked
+// slots, followed by |kUnknownThirdPartySlot|.
+using FeatureSlots = std::array<double, feature_count + 1>;
+
+// Returns the slot of the thirdParties.<entity>.blocked feature, or
+// |kUnknownThirdPartySlot| if the model has no such feature.
+unsigned int GetThirdPartyBlockedSlot(const std::string& entity);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
 double LinregPredictVector(const std::array<double, feature_count>& features);
 
+// Computes prediction based on a slot-indexed feature vector, ignoring
+// |kUnknownThirdPartySlot|.
+double LinregPredictSlots(const FeatureSlots& features);
+
 // Computes prediction based on key-value map of features.
 // It translates the map to a feature vector internally, and
 // it is the client's responsibility to ensure that all required
@@ -288,6 +288,34 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 3333644.900695055
 };
 
+// Slots of the standardised features in |feature_sequence|, the
+// thirdParties.*.blocked slots follow them.
+enum FeatureSlot : unsigned int {
+  kAdblockRequests,
+  kMetricsFirstMeaningfulPaint,
+  kMetricsObservedDomContentLoaded,
+  kMetricsObservedFirstVisualChange,
+  kMetricsObservedLoad,
+  kResourcesDocumentRequestCount,
+  kResourcesDocumentSize,
+  kResourcesFontRequestCount,
+  kResourcesFontSize,
+  kResourcesImageRequestCount,
+  kResourcesImageSize,
+  kResourcesMediaRequestCount,
+  kResourcesMediaSize,
+  kResourcesOtherRequestCount,
+  kResourcesOtherSize,
+  kResourcesScriptRequestCount,
+  kResourcesScriptSize,
+  kResourcesStylesheetRequestCount,
+  kResourcesStylesheetSize,
+  kResourcesThirdPartyRequestCount,
+  kResourcesThirdPartySize,
+  kResourcesTotalRequestCount,
+  kResourcesTotalSize,
+};
+
 const std::array<std::string, feature_count> feature_sequence{
     "adblockRequests",
     "metrics.firstMeaningfulPaint",
@@ -701,6 +729,200 @@ const base::flat_set<std::string> relevant_entity_set(
     relevant_entities.begin(),
     relevant_entities.end());
 
+// Slot of the thirdParties.<entity>.blocked feature of each relevant entity.
+const base::flat_map<std::string, unsigned int> third_party_blocked_slots = {
+  {"Google Analytics", 23},
+  {"Facebook", 24},
+  {"Google CDN", 25},
+  {"Twitter", 26},
+  {"Other Google APIs/SDKs", 27},
+  {"Scorecard Research", 28},
+  {"Sortable", 29},
+  {"Google/Doubleclick Ads", 30},
+  {"Adobe Tag Manager", 31},
+  {"Google Tag Manager", 32},
+  {"Chartbeat", 33},
+  {"Amazon Ads", 34},
+  {"Salesforce", 35},
+  {"Adobe Test & Target", 36},
+  {"YouTube", 37},
+  {"Outbrain", 38},
+  {"Tumblr", 39},
+  {"WordPress", 40},
+  {"Bing Ads", 41},
+  {"New Relic", 42},
+  {"JuicyAds", 43},
+  {"Audience 360", 44},
+  {"Revcontent", 45},
+  {"Pubmatic", 46},
+  {"AppNexus", 47},
+  {"SpotXchange", 48},
+  {"AOL / Oath / Verizon Media", 49},
+  {"Amazon Web Services", 50},
+  {"LoopMe", 51},
+  {"Quantcast", 52},
+  {"Click4Assistance", 53},
+  {"Hotjar", 54},
+  {"Snapchat", 55},
+  {"jQuery CDN", 56},
+  {"Segment", 57},
+  {"Usabilla", 58},
+  {"Nativo", 59},
+  {"Sharethrough", 60},
+  {"Twitter Online Conversion Tracking", 61},
+  {"BounceX", 62},
+  {"Integral Ad Science", 63},
+  {"Rubicon Project", 64},
+  {"Index Exchange", 65},
+  {"Sentry", 66},
+  {"Cloudflare CDN", 67},
+  {"VigLink", 68},
+  {"Optimizely", 69},
+  {"Ensighten", 70},
+  {"Criteo", 71},
+  {"Nielsen NetRatings SiteCensus", 72},
+  {"Cookie-Script.com", 73},
+  {"Rackspace", 74},
+  {"Adobe TypeKit", 75},
+  {"Stripe", 76},
+  {"Trust Pilot", 77},
+  {"Polyfill service", 78},
+  {"Affiliate Window", 79},
+  {"FontAwesome CDN", 80},
+  {"Bootstrap CDN", 81},
+  {"Auto Link Maker", 82},
+  {"Embedly", 83},
+  {"JSDelivr CDN", 84},
+  {"OneSignal", 85},
+  {"The Trade Desk", 86},
+  {"Instagram", 87},
+  {"PayPal", 88},
+  {"Taboola", 89},
+  {"Opentag", 90},
+  {"Brightcove", 91},
+  {"VWO", 92},
+  {"Rambler", 93},
+  {"Media Math", 94},
+  {"Google Maps", 95},
+  {"Unpkg", 96},
+  {"Yandex Share", 97},
+  {"Yandex Metrica", 98},
+  {"Yandex CDN", 99},
+  {"Amplitude Mobile Analytics", 100},
+  {"Yahoo!", 101},
+  {"Yandex Ads", 102},
+  {"piano", 103},
+  {"Moat", 104},
+  {"Parse.ly", 105},
+  {"Unruly Media", 106},
+  {"Skimbit", 107},
+  {"ZenDesk", 108},
+  {"Silverpop", 109},
+  {"AddThis", 110},
+  {"Polldaddy", 111},
+  {"Dailymotion", 112},
+  {"Disqus", 113},
+  {"Alexa", 114},
+  {"Mailchimp", 115},
+  {"Tealium", 116},
+  {"LiveChat", 117},
+  {"DemandBase", 118},
+  {"Tencent", 119},
+  {"Oracle Recommendations On Demand", 120},
+  {"Mixpanel", 121},
+  {"PerimeterX Bot Defender", 122},
+  {"Evidon", 123},
+  {"Media.net", 124},
+  {"Ghostery Enterprise", 125},
+  {"LongTail Ad Solutions", 126},
+  {"Sailthru", 127},
+  {"Marketplace Web Service", 128},
+  {"Pinterest", 129},
+  {"BrightTag / Signal", 130},
+  {"mPulse", 131},
+  {"ForeSee", 132},
+  {"Permutive", 133},
+  {"FirstImpression", 134},
+  {"Connatix", 135},
+  {"Media Management Technologies", 136},
+  {"Mobify", 137},
+  {"Yieldify", 138},
+  {"Crazy Egg", 139},
+  {"SurveyMonkey", 140},
+  {"Touch Commerce", 141},
+  {"RichRelevance", 142},
+  {"Reevoo", 143},
+  {"Micropat", 144},
+  {"Playbuzz", 145},
+  {"Po.st", 146},
+  {"Fastly", 147},
+  {"eBay", 148},
+  {"TRUSTe", 149},
+  {"Qualtrics", 150},
+  {"Aggregate Knowledge", 151},
+  {"Digioh", 152},
+  {"Gigya", 153},
+  {"Crowd Control", 154},
+  {"LinkedIn Ads", 155},
+  {"Riskified", 156},
+  {"BlueKai", 157},
+  {"AMP", 158},
+  {"eXelate", 159},
+  {"Captify Media", 160},
+  {"Hola Networks", 161},
+  {"Polar Mobile Group", 162},
+  {"Apester", 163},
+  {"StreamRail", 164},
+  {"SpringServer", 165},
+  {"Monetate", 166},
+  {"Adobe Scene7", 167},
+  {"Opta", 168},
+  {"FLXone", 169},
+  {"Sift Science", 170},
+  {"Accuweather", 171},
+  {"Lucky Orange", 172},
+  {"AWeber", 173},
+  {"Salesforce.com", 174},
+  {"Wistia", 175},
+  {"Histats", 176},
+  {"ShareThis", 177},
+  {"Adyoulike", 178},
+  {"Pusher", 179},
+  {"PERFORM", 180},
+  {"Pingdom RUM", 181},
+  {"Cloudflare", 182},
+  {"Hubspot", 183},
+  {"Curalate", 184},
+  {"Decibel Insight", 185},
+  {"Mouseflow", 186},
+  {"Symantec", 187},
+  {"Proper Media", 188},
+  {"Vimeo", 189},
+  {"LivePerson", 190},
+  {"Clicktale", 191},
+  {"iPerceptions", 192},
+  {"Sekindo", 193},
+  {"OpenX", 194},
+  {"Teads", 195},
+  {"sovrn", 196},
+  {"GumGum", 197},
+  {"Microsoft Hosted Libs", 198},
+  {"Vox Media", 199},
+  {"Concert", 200},
+  {"Xaxis", 201},
+  {"unpkg", 202},
+  {"Maxymiser", 203},
+  {"Kaltura Video Platform", 204},
+  {"SoundCloud", 205},
+  {"Kargo", 206},
+  {"TripleLift", 207},
+  {"Trip Advisor", 208},
+  {"Cloudinary", 209},
+  {"Tawk.to", 210},
+  {"Klevu Search", 211},
+  {"Yandex APIs", 212},
+};
+
 struct stdfactor {
   double mean, scale;
 };
@@ -6,20 +6,255 @@
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
 #include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
+namespace {
+
+constexpr char kTestMapping[] = R"(
+[
+{
+    "name":"Google Analytics",
+    "domains":["www.google-analytics.com","google-analytics.com"]
+},
+{
+    "name":"Facebook",
+    "domains":["www.facebook.com","connect.facebook.net","m.facebook.com"]
+},
+{
+    "name":"Example Tracker",
+    "domains":["tracker.example"]
+}
+])";
+
+struct RecordedResource {
+  const char* url;
+  network::mojom::RequestDestination destination;
+  int64_t raw_body_bytes;
+  int64_t total_received_bytes;
+  bool blocked;
+};
+
+struct RecordedPageLoad {
+  const char* main_frame_url;
+  std::vector<RecordedResource> resources;
+  int first_contentful_paint_ms;
+  int first_meaningful_paint_ms;
+  int dom_content_loaded_ms;
+  int load_ms;
+};
+
+std::vector<RecordedPageLoad> GetRecordedPageLoads() {
+  using network::mojom::RequestDestination;
+  return {
+      {"https://news.example.com/",
+       {
+           {"https://news.example.com/", RequestDestination::kDocument, 60000,
+            61000, false},
+           {"https://news.example.com/main.css", RequestDestination::kStyle,
+            90000, 91000, false},
+           {"https://news.example.com/app.js", RequestDestination::kScript,
+            350000, 351000, false},
+           {"https://connect.facebook.net/sdk.js",
+            RequestDestination::kScript, 150000, 151000, false},
+           {"https://cdn.example.org/hero.jpg", RequestDestination::kImage,
+            400000, 401000, false},
+           {"https://news.example.com/logo.png", RequestDestination::kImage,
+            20000, 21000, false},
+           {"https://news.example.com/font.woff2", RequestDestination::kFont,
+            80000, 81000, false},
+           {"https://video.example.org/embed", RequestDestination::kIframe,
+            30000, 31000, false},
+           {"https://video.example.org/clip.mp4", RequestDestination::kVideo,
+            10000, 11000, false},
+           {"https://news.example.com/api", RequestDestination::kEmpty, 5000,
+            5500, false},
+           {"https://www.google-analytics.com/analytics.js",
+            RequestDestination::kScript, 0, 0, true},
+           {"https://www.facebook.com/tr", RequestDestination::kImage, 0, 0,
+            true},
+           {"https://tracker.example/pixel.gif", RequestDestination::kImage,
+            0, 0, true},
+       },
+       700,
+       1000,
+       1200,
+       2500},
+      {"https://blog.example.net/post",
+       {
+           {"https://blog.example.net/post", RequestDestination::kDocument,
+            40000, 41000, false},
+           {"https://blog.example.net/theme.css", RequestDestination::kStyle,
+            30000, 31000, false},
+           {"https://blog.example.net/audio.mp3", RequestDestination::kAudio,
+            200000, 201000, false},
+           {"https://tracker.example/beacon", RequestDestination::kEmpty, 0, 0,
+            true},
+       },
+       400,
+       600,
+       800,
+       1500},
+      {"https://static.example.com/",
+       {
+           {"https://static.example.com/", RequestDestination::kDocument, 5000,
+            5200, false},
+       },
+       100,
+       100,
+       150,
+       200},
+  };
+}
+
+// What BandwidthSavingsPredictor did before features were indexed by slot:
+// accumulate them in a map keyed by feature name.
+class NamedFeaturizer {
+ public:
+  explicit NamedFeaturizer(const NamedThirdPartyRegistry* registry)
+      : tp_registry_(registry) {}
+
+  void OnPageLoadTimingUpdated(
+      const page_load_metrics::mojom::PageLoadTiming& timing) {
+    if (timing.paint_timing->first_meaningful_paint.has_value())
+      feature_map_["metrics.firstMeaningfulPaint"] =
+          timing.paint_timing->first_meaningful_paint->InMillisecondsF();
+    if (timing.document_timing->dom_content_loaded_event_start.has_value())
+      feature_map_["metrics.observedDomContentLoaded"] =
+          timing.document_timing->dom_content_loaded_event_start
+              ->InMillisecondsF();
+    if (timing.paint_timing->first_contentful_paint.has_value())
+      feature_map_["metrics.observedFirstVisualChange"] =
+          timing.paint_timing->first_contentful_paint->InMillisecondsF();
+    if (timing.document_timing->load_event_start.has_value())
+      feature_map_["metrics.observedLoad"] =
+          timing.document_timing->load_event_start->InMillisecondsF();
+  }
+
+  void OnSubresourceBlocked(const std::string& resource_url) {
+    feature_map_["adblockRequests"] += 1;
+    const auto tp_name = tp_registry_->GetThirdParty(resource_url);
+    if (tp_name.has_value())
+      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+  }
+
+  void OnResourceLoadComplete(
+      const GURL& main_frame_url,
+      const blink::mojom::ResourceLoadInfo& resource_load_info) {
+    if (!net::registry_controlled_domains::SameDomainOrHost(
+            main_frame_url, resource_load_info.final_url,
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+      feature_map_["resources.third-party.requestCount"] += 1;
+      feature_map_["resources.third-party.size"] +=
+          resource_load_info.raw_body_bytes;
+    }
+    feature_map_["resources.total.requestCount"] += 1;
+    feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
+    feature_map_["transfer.total.size"] +=
+        resource_load_info.total_received_bytes;
+    std::string resource_type;
+    switch (resource_load_info.request_destination) {
+      case network::mojom::RequestDestination::kDocument:
+      case network::mojom::RequestDestination::kIframe:
+        resource_type = "document";
+        break;
+      case network::mojom::RequestDestination::kStyle:
+        resource_type = "stylesheet";
+        break;
+      case network::mojom::RequestDestination::kScript:
+        resource_type = "script";
+        break;
+      case network::mojom::RequestDestination::kImage:
+        resource_type = "image";
+        break;
+      case network::mojom::RequestDestination::kFont:
+        resource_type = "font";
+        break;
+      case network::mojom::RequestDestination::kAudio:
+      case network::mojom::RequestDestination::kTrack:
+      case network::mojom::RequestDestination::kVideo:
+        resource_type = "media";
+        break;
+      default:
+        resource_type = "other";
+        break;
+    }
+    feature_map_["resources." + resource_type + ".requestCount"] += 1;
+    feature_map_["resources." + resource_type + ".size"] +=
+        resource_load_info.raw_body_bytes;
+  }
+
+  double PredictSavingsBytes() const {
+    const auto total_size = feature_map_.find("transfer.total.size");
+    if (total_size == feature_map_.end() || total_size->second <= 0)
+      return 0;
+    const auto adblock_requests = feature_map_.find("adblockRequests");
+    if (adblock_requests == feature_map_.end() ||
+        adblock_requests->second < 1) {
+      return 0;
+    }
+    const double prediction = LinregPredictNamed(feature_map_);
+    if (prediction > kSavingsAbsoluteOutlier &&
+        (prediction / kOutlierThreshold) > total_size->second) {
+      return 0;
+    }
+    return prediction;
+  }
+
+  const base::flat_map<std::string, double>& feature_map() const {
+    return feature_map_;
+  }
+
+ private:
+  const NamedThirdPartyRegistry* tp_registry_;  // not owned
+  base::flat_map<std::string, double> feature_map_;
+};
+
+// Feeds |page_load| to |featurizer| in the order the tab helper would: the
+// loads and blocks as they come in, then the timing once the page is loaded.
+template <typename Featurizer>
+void ReplayPageLoad(const RecordedPageLoad& page_load,
+                    Featurizer* featurizer) {
+  const GURL main_frame(page_load.main_frame_url);
+  for (const auto& resource : page_load.resources) {
+    if (resource.blocked)
+      featurizer->OnSubresourceBlocked(resource.url);
+    auto info =
+        predictors::CreateResourceLoadInfo(resource.url, resource.destination);
+    info->raw_body_bytes = resource.raw_body_bytes;
+    info->total_received_bytes = resource.total_received_bytes;
+    featurizer->OnResourceLoadComplete(main_frame, *info);
+  }
+
+  auto timing = page_load_metrics::CreatePageLoadTiming();
+  timing->paint_timing->first_contentful_paint =
+      base::Milliseconds(page_load.first_contentful_paint_ms);
+  timing->paint_timing->first_meaningful_paint =
+      base::Milliseconds(page_load.first_meaningful_paint_ms);
+  timing->document_timing->dom_content_loaded_event_start =
+      base::Milliseconds(page_load.dom_content_loaded_ms);
+  timing->document_timing->load_event_start =
+      base::Milliseconds(page_load.load_ms);
+  featurizer->OnPageLoadTimingUpdated(*timing);
+}
+
+}  // namespace
+
 class BandwidthSavingsPredictorTest : public ::testing::Test {
  public:
   BandwidthSavingsPredictorTest() {
@@ -39,42 +274,42 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 1);
+  EXPECT_EQ(predictor_->features_[GetThirdPartyBlockedSlot("Google Analytics")],
             1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(predictor_->features_[kAdblockRequests], 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(predictor_->features_[kMetricsFirstMeaningfulPaint], 0);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedDomContentLoaded], 0);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedFirstVisualChange], 0);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedLoad], 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::Milliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedDomContentLoaded], 1000);
 
   timing->document_timing->load_event_start = base::Milliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedLoad], 2000);
 
   timing->paint_timing->first_meaningful_paint = base::Milliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(predictor_->features_[kMetricsFirstMeaningfulPaint], 1500);
 
   timing->paint_timing->first_contentful_paint = base::Milliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(predictor_->features_[kMetricsObservedFirstVisualChange], 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(predictor_->features_[kResourcesThirdPartyRequestCount], 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -83,9 +318,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(predictor_->features_[kResourcesThirdPartyRequestCount], 0);
+  EXPECT_EQ(predictor_->features_[kResourcesStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kResourcesStylesheetSize], 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -93,14 +328,14 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(predictor_->features_[kResourcesThirdPartyRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kResourcesStylesheetRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kResourcesScriptRequestCount], 1);
+  EXPECT_EQ(predictor_->features_[kResourcesStylesheetSize], 1000);
+  EXPECT_EQ(predictor_->features_[kResourcesScriptSize], 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(predictor_->features_[kResourcesTotalRequestCount], 2);
+  EXPECT_EQ(predictor_->features_[kResourcesTotalSize], 2001);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -157,4 +392,39 @@ TEST_F(BandwidthSavingsPredictorTest, PredictNonZero) {
   EXPECT_NE(predictor_->PredictSavingsBytes(), 0);
 }
 
+TEST_F(BandwidthSavingsPredictorTest, SlotsMatchNamedFeatures) {
+  // Keep entities the model has no feature for, so they reach the fallback
+  // slot.
+  NamedThirdPartyRegistry registry;
+  ASSERT_TRUE(registry.LoadMappings(kTestMapping, false));
+  BandwidthSavingsPredictor predictor(&registry);
+
+  int non_zero_predictions = 0;
+  for (const auto& page_load : GetRecordedPageLoads()) {
+    SCOPED_TRACE(page_load.main_frame_url);
+    predictor.Reset();
+    NamedFeaturizer named(&registry);
+    ReplayPageLoad(page_load, &predictor);
+    ReplayPageLoad(page_load, &named);
+
+    for (unsigned int i = 0; i < feature_count; i++) {
+      const auto it = named.feature_map().find(feature_sequence[i]);
+      const double expected = it == named.feature_map().end() ? 0 : it->second;
+      EXPECT_EQ(expected, predictor.features_[i]) << feature_sequence[i];
+    }
+    EXPECT_EQ(LinregPredictNamed(named.feature_map()),
+              LinregPredictSlots(predictor.features_));
+
+    const double prediction = predictor.PredictSavingsBytes();
+    EXPECT_EQ(named.PredictSavingsBytes(), prediction);
+    if (prediction != 0)
+      non_zero_predictions++;
+  }
+  EXPECT_GT(non_zero_predictions, 0);
+
+  EXPECT_EQ(kUnknownThirdPartySlot,
+            GetThirdPartyBlockedSlot("Example Tracker"));
+  EXPECT_NE(kUnknownThirdPartySlot, GetThirdPartyBlockedSlot("Facebook"));
+}
+
 }  // namespace brave_perf_predictor
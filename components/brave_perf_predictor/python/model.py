@@ -3,6 +3,7 @@ import pandas as pd
 import numpy as np
 import joblib
 import jinja2
+import re
 from sklearn.model_selection import train_test_split
 from sklearn.pipeline import Pipeline
 from sklearn.pipeline import FeatureUnion
@@ -148,6 +149,11 @@ def train_model(print_params=False, reg=REGRESSOR):
 
     return model.get_params()
 
+def feature_slot_name(feature):
+    # "resources.third-party.size" -> "kResourcesThirdPartySize"
+    words = re.split(r'[.\-]', feature)
+    return 'k' + ''.join(word[0].upper() + word[1:] for word in words)
+
 def export_model():
     # Load trained model and predict on test set
     model = joblib.load(MODEL_PATH)
@@ -170,6 +176,7 @@ def export_model():
             transformers['standardise']['mean'] = transformer.mean_
             transformers['standardise']['scale'] = transformer.scale_
             transformers['standardise']['features'] = features
+            transformers['standardise']['slots'] = [feature_slot_name(feature) for feature in features]
             transformers['standardise']['feature_map'] = list(zip(features, zip(transformer.mean_, transformer.scale_)))
         elif name == 'pass_through':
             transformers['passthrough']['features'] = features
@@ -184,7 +191,8 @@ def export_model():
             'coefficients': model['model'].coef_
         },
         'misc': {
-            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ]
+            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ],
+            'entity_slots': [ (feature.replace('thirdParties.', '').replace('.blocked', ''), len(transformers['standardise']['features']) + index) for index, feature in enumerate(transformers['passthrough']['features']) if feature.startswith('thirdParties.') ]
         }
     }
     env.get_template(EXPORT_TEMPLATE_NAME).stream(data).dump(EXPORT_OUTPUT_PATH)
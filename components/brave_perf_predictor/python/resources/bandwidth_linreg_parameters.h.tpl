@@ -32,6 +32,14 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 {{transformers.standardise.scale | join(',\n')}}
 };
 
+// Slots of the standardised features in |feature_sequence|, the
+// thirdParties.*.blocked slots follow them.
+enum FeatureSlot : unsigned int {
+  {% for slot in transformers.standardise.slots %}
+  {{slot}},
+  {% endfor %}
+};
+
 const std::array<std::string, feature_count> feature_sequence{
     {% for feature in transformers.standardise.features %}
     "{{feature}}",
@@ -51,6 +59,13 @@ const base::flat_set<std::string> relevant_entity_set(
     relevant_entities.begin(),
     relevant_entities.end());
 
+// Slot of the thirdParties.<entity>.blocked feature of each relevant entity.
+const base::flat_map<std::string, unsigned int> third_party_blocked_slots = {
+  {% for entity, slot in misc.entity_slots %}
+  {"{{entity}}", {{slot}}},
+  {% endfor %}
+};
+
 struct stdfactor {
   double mean, scale;
 };
@@ -0,0 +1,213 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Bump |kVersion| whenever the layout below changes.
+constexpr uint32_t kMagic = 0x45535448;  // "HTSE"
+constexpr uint32_t kVersion = 1;
+
+// The file is a header, the domain entries sorted by domain, the rule set
+// entries and then the strings the entries point into.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t domain_count;
+  uint32_t rule_set_count;
+};
+
+template <typename T>
+void AppendEntries(const std::vector<T>& entries, std::string* buffer) {
+  buffer->append(reinterpret_cast<const char*>(entries.data()),
+                 entries.size() * sizeof(T));
+}
+
+}  // namespace
+
+HTTPSECompiledRuleset::HTTPSECompiledRuleset() = default;
+
+HTTPSECompiledRuleset::~HTTPSECompiledRuleset() = default;
+
+// static
+bool HTTPSECompiledRuleset::Build(leveldb::DB* db, const base::FilePath& path) {
+  static_assert(sizeof(DomainEntry) == 3 * sizeof(uint32_t),
+                "DomainEntry must not be padded");
+  static_assert(sizeof(RuleSetEntry) == 2 * sizeof(uint32_t),
+                "RuleSetEntry must not be padded");
+
+  std::string strings;
+  std::map<std::string, uint32_t> rule_set_ids;
+  std::vector<RuleSetEntry> rule_sets;
+  std::vector<std::pair<std::string, uint32_t>> domains;
+
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    const leveldb::Slice value = it->value();
+    if (value.empty()) {
+      // Empty values never matched when looked up in the database either.
+      continue;
+    }
+    const auto [iter, inserted] = rule_set_ids.emplace(
+        value.ToString(), static_cast<uint32_t>(rule_sets.size()));
+    if (inserted) {
+      rule_sets.push_back({static_cast<uint32_t>(strings.size()),
+                           static_cast<uint32_t>(value.size())});
+      strings.append(value.data(), value.size());
+    }
+    domains.emplace_back(it->key().ToString(), iter->second);
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE database: "
+               << it->status().ToString();
+    return false;
+  }
+
+  std::sort(domains.begin(), domains.end());
+  std::vector<DomainEntry> domain_entries;
+  domain_entries.reserve(domains.size());
+  for (const auto& [domain, rule_set_id] : domains) {
+    domain_entries.push_back({static_cast<uint32_t>(strings.size()),
+                              static_cast<uint32_t>(domain.size()),
+                              rule_set_id});
+    strings.append(domain);
+  }
+
+  if (strings.size() > std::numeric_limits<uint32_t>::max()) {
+    LOG(ERROR) << "HTTPSE database is too large to compile";
+    return false;
+  }
+
+  const Header header = {kMagic, kVersion,
+                         static_cast<uint32_t>(domain_entries.size()),
+                         static_cast<uint32_t>(rule_sets.size())};
+  std::string buffer(reinterpret_cast<const char*>(&header), sizeof(header));
+  AppendEntries(domain_entries, &buffer);
+  AppendEntries(rule_sets, &buffer);
+  buffer.append(strings);
+
+  if (!base::WriteFile(path, buffer)) {
+    LOG(ERROR) << "Failed to write compiled HTTPSE ruleset "
+               << path.value().c_str();
+    return false;
+  }
+  return true;
+}
+
+// static
+std::unique_ptr<HTTPSECompiledRuleset> HTTPSECompiledRuleset::Load(
+    const base::FilePath& path) {
+  auto ruleset = base::WrapUnique(new HTTPSECompiledRuleset());
+  if (!ruleset->Initialize(path)) {
+    return nullptr;
+  }
+  return ruleset;
+}
+
+absl::optional<uint32_t> HTTPSECompiledRuleset::FindRuleSetId(
+    base::StringPiece domain) const {
+  const auto iter = std::lower_bound(
+      domains_.begin(), domains_.end(), domain,
+      [this](const DomainEntry& entry, base::StringPiece domain) {
+        return GetString(entry.domain_offset, entry.domain_length) < domain;
+      });
+  if (iter == domains_.end() ||
+      GetString(iter->domain_offset, iter->domain_length) != domain) {
+    return absl::nullopt;
+  }
+  return iter->rule_set_id;
+}
+
+base::StringPiece HTTPSECompiledRuleset::GetRuleSetJson(
+    uint32_t rule_set_id) const {
+  DCHECK_LT(rule_set_id, rule_sets_.size());
+  const RuleSetEntry& entry = rule_sets_[rule_set_id];
+  return GetString(entry.json_offset, entry.json_length);
+}
+
+bool HTTPSECompiledRuleset::Initialize(const base::FilePath& path) {
+  if (!file_.Initialize(path)) {
+    LOG(ERROR) << "Failed to map compiled HTTPSE ruleset "
+               << path.value().c_str();
+    return false;
+  }
+
+  const uint8_t* data = file_.data();
+  const size_t length = file_.length();
+  Header header;
+  if (length < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion) {
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  const size_t domains_size =
+      static_cast<size_t>(header.domain_count) * sizeof(DomainEntry);
+  const size_t rule_sets_size =
+      static_cast<size_t>(header.rule_set_count) * sizeof(RuleSetEntry);
+  if (length - offset < domains_size + rule_sets_size) {
+    return false;
+  }
+
+  // Entries are 4-byte aligned since the mapping starts on a page boundary
+  // and everything before them is made of uint32_t.
+  domains_ = base::make_span(
+      reinterpret_cast<const DomainEntry*>(data + offset), header.domain_count);
+  offset += domains_size;
+  rule_sets_ =
+      base::make_span(reinterpret_cast<const RuleSetEntry*>(data + offset),
+                      header.rule_set_count);
+  offset += rule_sets_size;
+  strings_ = base::StringPiece(reinterpret_cast<const char*>(data + offset),
+                               length - offset);
+
+  // Check every entry once here so lookups don't have to.
+  const auto is_in_strings = [this](uint32_t string_offset,
+                                    uint32_t string_length) {
+    return string_offset <= strings_.size() &&
+           string_length <= strings_.size() - string_offset;
+  };
+  for (const auto& entry : domains_) {
+    if (!is_in_strings(entry.domain_offset, entry.domain_length) ||
+        entry.rule_set_id >= rule_sets_.size()) {
+      return false;
+    }
+  }
+  for (const auto& entry : rule_sets_) {
+    if (!is_in_strings(entry.json_offset, entry.json_length)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+base::StringPiece HTTPSECompiledRuleset::GetString(uint32_t offset,
+                                                   uint32_t length) const {
+  return strings_.substr(offset, length);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,80 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/containers/span.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/strings/string_piece.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace leveldb {
+class DB;
+}  // namespace leveldb
+
+namespace brave_shields {
+
+// Flat table from the lookup domains of the HTTPS Everywhere database, such
+// as "com.example.*", to the JSON of their rule set. Domains sharing a rule
+// set share its id. The table is written to a file once when the component
+// loads and memory mapped, so lookups are a binary search over the mapped
+// entries instead of a database read.
+class HTTPSECompiledRuleset {
+ public:
+  HTTPSECompiledRuleset(const HTTPSECompiledRuleset&) = delete;
+  HTTPSECompiledRuleset& operator=(const HTTPSECompiledRuleset&) = delete;
+  ~HTTPSECompiledRuleset();
+
+  // Writes the table for all the entries of |db| to |path|.
+  static bool Build(leveldb::DB* db, const base::FilePath& path);
+
+  // Maps a table written by |Build|. Returns nullptr if the file is missing
+  // or malformed.
+  static std::unique_ptr<HTTPSECompiledRuleset> Load(
+      const base::FilePath& path);
+
+  absl::optional<uint32_t> FindRuleSetId(base::StringPiece domain) const;
+  base::StringPiece GetRuleSetJson(uint32_t rule_set_id) const;
+
+  size_t domain_count() const { return domains_.size(); }
+  size_t rule_set_count() const { return rule_sets_.size(); }
+
+ private:
+  struct DomainEntry {
+    uint32_t domain_offset;
+    uint32_t domain_length;
+    uint32_t rule_set_id;
+  };
+
+  struct RuleSetEntry {
+    uint32_t json_offset;
+    uint32_t json_length;
+  };
+
+  HTTPSECompiledRuleset();
+
+  bool Initialize(const base::FilePath& path);
+
+  base::StringPiece GetString(uint32_t offset, uint32_t length) const;
+
+  base::MemoryMappedFile file_;
+  // Sorted by domain. All of these point into |file_|.
+  base::span<const DomainEntry> domains_;
+  base::span<const RuleSetEntry> rule_sets_;
+  base::StringPiece strings_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_H_
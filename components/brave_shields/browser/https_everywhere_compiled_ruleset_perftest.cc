@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset.h"
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset_test_util.h"
+#include "brave/components/constants/brave_paths.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "HTTPSECompiledRuleset.";
+constexpr char kMetricBuildTime[] = "build_time";
+constexpr char kMetricLoadTime[] = "load_time";
+constexpr char kMetricTimePerUrl[] = "time_per_url";
+
+// Each URL of the corpus is looked up this many times, the first lookup of a
+// rule set parsing it and the later ones hitting the cache, as they do when
+// browsing.
+constexpr int kIterations = 200;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricBuildTime, "us");
+  reporter.RegisterImportantMetric(kMetricLoadTime, "us");
+  reporter.RegisterImportantMetric(kMetricTimePerUrl, "us");
+  return reporter;
+}
+
+}  // namespace
+
+class HTTPSECompiledRulesetPerfTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() { brave::RegisterPathProvider(); }
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    db_ = OpenHTTPSETestDatabase(temp_dir_.GetPath());
+    ASSERT_TRUE(db_);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<leveldb::DB> db_;
+};
+
+// What HTTPSEverywhereService::Engine did before the ruleset was compiled:
+// read the database and parse the rule set JSON for every URL.
+TEST_F(HTTPSECompiledRulesetPerfTest, Database) {
+  const std::vector<GURL> urls = GetHTTPSETestUrls();
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const GURL& url : urls) {
+      GetHTTPSURLFromDatabase(db_.get(), url);
+    }
+  }
+  SetUpReporter("database")
+      .AddResult(kMetricTimePerUrl,
+                 timer.Elapsed() / (kIterations * urls.size()));
+}
+
+TEST_F(HTTPSECompiledRulesetPerfTest, CompiledRuleset) {
+  const std::vector<GURL> urls = GetHTTPSETestUrls();
+  const base::FilePath ruleset_path =
+      temp_dir_.GetPath().AppendASCII("httpse.ruleset");
+  auto reporter = SetUpReporter("compiled_ruleset");
+
+  base::ElapsedTimer build_timer;
+  ASSERT_TRUE(HTTPSECompiledRuleset::Build(db_.get(), ruleset_path));
+  reporter.AddResult(kMetricBuildTime, build_timer.Elapsed());
+
+  base::ElapsedTimer load_timer;
+  const std::unique_ptr<HTTPSECompiledRuleset> ruleset =
+      HTTPSECompiledRuleset::Load(ruleset_path);
+  ASSERT_TRUE(ruleset);
+  reporter.AddResult(kMetricLoadTime, load_timer.Elapsed());
+
+  CompiledRulesetLookup lookup(ruleset.get());
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const GURL& url : urls) {
+      lookup.GetHTTPSURL(url);
+    }
+  }
+  reporter.AddResult(kMetricTimePerUrl,
+                     timer.Elapsed() / (kIterations * urls.size()));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,189 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset_test_util.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "base/files/file_path.h"
+#include "base/json/json_reader.h"
+#include "base/path_service.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "brave/components/constants/brave_paths.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/zlib/google/zip.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char* const kUrls[] = {
+    "http://www.digg.com/",
+    "http://digg.com/news?page=2",
+    "http://www.80spurple.com/",
+    "http://news.80spurple.com/article.html",
+    "http://smcdn.80spurple.com/image.png",
+    "http://www.cloudmagic.com/",
+    "http://readitlaterlist.com/",
+    "http://www.worldofwarcraft.com/en/",
+    "http://www.oxfordjournals.org/",
+    "http://www.eff.org/https-everywhere",
+    "http://en.wikipedia.org/wiki/HTTPS",
+    "http://www.brianbondy.com/",
+    "http://example.com/",
+    "http://a.b.c.d.example.net/path?query=1",
+    "http://localhost/",
+};
+
+std::vector<std::string> ExpandDomainForLookup(const std::string& host) {
+  std::vector<std::string> domain_parts = base::SplitString(
+      host, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  std::vector<std::string> domains;
+  for (size_t i = 0; i + 1 < domain_parts.size(); i++) {
+    std::vector<std::string> slice(domain_parts.rbegin(),
+                                   domain_parts.rend() - i);
+    domains.push_back(base::JoinString(slice, ".") + (i == 0 ? "" : ".*"));
+  }
+  return domains;
+}
+
+std::string CorrecttoRuleToRE2Engine(std::string to) {
+  std::replace(to.begin(), to.end(), '$', '\\');
+  return to;
+}
+
+// Parses the JSON of |rule| and builds its regexes on every call.
+std::string ApplyHTTPSRule(const std::string& original_url,
+                           const std::string& rule) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
+  if (!json_object || !json_object->is_list()) {
+    return "";
+  }
+
+  for (const auto& top_value : json_object->GetList()) {
+    const base::Value::Dict* top_dict = top_value.GetIfDict();
+    if (!top_dict) {
+      continue;
+    }
+
+    if (const base::Value::List* exclusions = top_dict->FindList("e")) {
+      for (const auto& exclusion : *exclusions) {
+        const base::Value::Dict* exclusion_dict = exclusion.GetIfDict();
+        const std::string* pattern =
+            exclusion_dict ? exclusion_dict->FindString("p") : nullptr;
+        if (pattern && RE2::FullMatch(original_url,
+                                      CorrecttoRuleToRE2Engine(*pattern))) {
+          return "";
+        }
+      }
+    }
+
+    const base::Value::List* rules = top_dict->FindList("r");
+    if (!rules) {
+      return "";
+    }
+    for (const auto& rule_value : *rules) {
+      const base::Value::Dict* rule_dict = rule_value.GetIfDict();
+      if (!rule_dict) {
+        continue;
+      }
+      if (rule_dict->Find("d")) {
+        std::string new_url(original_url);
+        return new_url.insert(4, "s");
+      }
+      const std::string* from = rule_dict->FindString("f");
+      const std::string* to = rule_dict->FindString("t");
+      if (!from || !to) {
+        continue;
+      }
+      std::string new_url(original_url);
+      if (RE2::Replace(&new_url, RE2(*from), CorrecttoRuleToRE2Engine(*to)) &&
+          new_url != original_url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace
+
+std::vector<GURL> GetHTTPSETestUrls() {
+  return std::vector<GURL>(std::begin(kUrls), std::end(kUrls));
+}
+
+std::unique_ptr<leveldb::DB> OpenHTTPSETestDatabase(
+    const base::FilePath& dir) {
+  base::FilePath test_data_dir;
+  if (!base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir) ||
+      !zip::Unzip(test_data_dir.AppendASCII("https-everywhere-data")
+                      .AppendASCII("6.0")
+                      .AppendASCII("httpse.leveldb.zip"),
+                  dir)) {
+    return nullptr;
+  }
+
+  leveldb::DB* db = nullptr;
+  if (!leveldb::DB::Open(leveldb::Options(),
+                         dir.AppendASCII("httpse.leveldb").AsUTF8Unsafe(), &db)
+           .ok()) {
+    return nullptr;
+  }
+  return std::unique_ptr<leveldb::DB>(db);
+}
+
+std::string GetHTTPSURLFromDatabase(leveldb::DB* db, const GURL& url) {
+  for (const auto& domain : ExpandDomainForLookup(url.host())) {
+    std::string value;
+    if (!db->Get(leveldb::ReadOptions(), domain, &value).ok() ||
+        value.empty()) {
+      continue;
+    }
+    const std::string new_url = ApplyHTTPSRule(url.spec(), value);
+    if (!new_url.empty()) {
+      return new_url;
+    }
+  }
+  return "";
+}
+
+CompiledRulesetLookup::CompiledRulesetLookup(
+    const HTTPSECompiledRuleset* ruleset)
+    : ruleset_(ruleset), rule_sets_(100) {}
+
+CompiledRulesetLookup::~CompiledRulesetLookup() = default;
+
+std::string CompiledRulesetLookup::GetHTTPSURL(const GURL& url) {
+  for (const auto& domain : ExpandDomainForLookup(url.host())) {
+    const absl::optional<uint32_t> rule_set_id =
+        ruleset_->FindRuleSetId(domain);
+    if (!rule_set_id) {
+      continue;
+    }
+    auto iter = rule_sets_.Get(*rule_set_id);
+    if (iter == rule_sets_.end()) {
+      iter = rule_sets_.Put(*rule_set_id,
+                            HTTPSERuleSet::Parse(
+                                ruleset_->GetRuleSetJson(*rule_set_id)));
+    }
+    if (!iter->second) {
+      continue;
+    }
+    const std::string new_url = iter->second->Apply(url.spec());
+    if (!new_url.empty()) {
+      return new_url;
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,60 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_TEST_UTIL_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_TEST_UTIL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+
+class GURL;
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace leveldb {
+class DB;
+}  // namespace leveldb
+
+namespace brave_shields {
+
+class HTTPSECompiledRuleset;
+class HTTPSERuleSet;
+
+// URLs covered by the test HTTPS Everywhere database, and some which aren't.
+std::vector<GURL> GetHTTPSETestUrls();
+
+// Unzips the test HTTPS Everywhere database into |dir| and opens it. Returns
+// nullptr on failure.
+std::unique_ptr<leveldb::DB> OpenHTTPSETestDatabase(const base::FilePath& dir);
+
+// What HTTPSEverywhereService::Engine did before the ruleset was compiled:
+// parse the JSON from the database and build the regexes for every URL.
+std::string GetHTTPSURLFromDatabase(leveldb::DB* db, const GURL& url);
+
+// The same lookup HTTPSEverywhereService::Engine does now.
+class CompiledRulesetLookup {
+ public:
+  explicit CompiledRulesetLookup(const HTTPSECompiledRuleset* ruleset);
+  CompiledRulesetLookup(const CompiledRulesetLookup&) = delete;
+  CompiledRulesetLookup& operator=(const CompiledRulesetLookup&) = delete;
+  ~CompiledRulesetLookup();
+
+  std::string GetHTTPSURL(const GURL& url);
+
+ private:
+  const HTTPSECompiledRuleset* ruleset_;
+  base::LRUCache<uint32_t, std::unique_ptr<HTTPSERuleSet>> rule_sets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_COMPILED_RULESET_TEST_UTIL_H_
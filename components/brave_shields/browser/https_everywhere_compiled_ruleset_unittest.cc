@@ -0,0 +1,78 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+class HTTPSECompiledRulesetTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    db_ = OpenHTTPSETestDatabase(temp_dir_.GetPath());
+    ASSERT_TRUE(db_);
+
+    const base::FilePath ruleset_path =
+        temp_dir_.GetPath().AppendASCII("httpse.ruleset");
+    ASSERT_TRUE(HTTPSECompiledRuleset::Build(db_.get(), ruleset_path));
+    ruleset_ = HTTPSECompiledRuleset::Load(ruleset_path);
+    ASSERT_TRUE(ruleset_);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<leveldb::DB> db_;
+  std::unique_ptr<HTTPSECompiledRuleset> ruleset_;
+};
+
+TEST_F(HTTPSECompiledRulesetTest, DomainsShareRuleSets) {
+  EXPECT_GT(ruleset_->domain_count(), ruleset_->rule_set_count());
+
+  const absl::optional<uint32_t> rule_set_id =
+      ruleset_->FindRuleSetId("com.80spurple");
+  ASSERT_TRUE(rule_set_id);
+  std::string value;
+  ASSERT_TRUE(db_->Get(leveldb::ReadOptions(), "com.80spurple", &value).ok());
+  EXPECT_EQ(value, ruleset_->GetRuleSetJson(*rule_set_id));
+
+  EXPECT_FALSE(ruleset_->FindRuleSetId("com.brianbondy"));
+  EXPECT_FALSE(ruleset_->FindRuleSetId(""));
+  EXPECT_FALSE(ruleset_->FindRuleSetId("zzzz"));
+}
+
+TEST_F(HTTPSECompiledRulesetTest, SameRewritesAsDatabase) {
+  CompiledRulesetLookup lookup(ruleset_.get());
+  int rewrites = 0;
+  for (const GURL& url : GetHTTPSETestUrls()) {
+    const std::string expected = GetHTTPSURLFromDatabase(db_.get(), url);
+    EXPECT_EQ(expected, lookup.GetHTTPSURL(url)) << url;
+    if (!expected.empty()) {
+      rewrites++;
+    }
+  }
+  EXPECT_GT(rewrites, 0);
+  EXPECT_EQ("https://www.digg.com/",
+            lookup.GetHTTPSURL(GURL("http://www.digg.com/")));
+}
+
+TEST_F(HTTPSECompiledRulesetTest, RejectsMalformedFile) {
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("malformed");
+  ASSERT_TRUE(base::WriteFile(path, "HTSE"));
+  EXPECT_FALSE(HTTPSECompiledRuleset::Load(path));
+  EXPECT_FALSE(HTTPSECompiledRuleset::Load(
+      temp_dir_.GetPath().AppendASCII("missing")));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,135 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::string CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+}  // namespace
+
+HTTPSERuleSet::Rule::Rule() = default;
+HTTPSERuleSet::Rule::Rule(Rule&&) = default;
+HTTPSERuleSet::Rule& HTTPSERuleSet::Rule::operator=(Rule&&) = default;
+HTTPSERuleSet::Rule::~Rule() = default;
+
+HTTPSERuleSet::Target::Target() = default;
+HTTPSERuleSet::Target::Target(Target&&) = default;
+HTTPSERuleSet::Target& HTTPSERuleSet::Target::operator=(Target&&) = default;
+HTTPSERuleSet::Target::~Target() = default;
+
+HTTPSERuleSet::HTTPSERuleSet() = default;
+
+HTTPSERuleSet::~HTTPSERuleSet() = default;
+
+// static
+std::unique_ptr<HTTPSERuleSet> HTTPSERuleSet::Parse(base::StringPiece json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (absl::nullopt == json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  auto rule_set = base::WrapUnique(new HTTPSERuleSet());
+  for (const auto& topValue : json_object->GetList()) {
+    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
+    if (nullptr == childTopDictionary) {
+      continue;
+    }
+
+    Target target;
+    const base::Value::List* eValues = childTopDictionary->FindList("e");
+    if (nullptr != eValues) {
+      for (const auto& eValue : *eValues) {
+        const base::Value::Dict* pDictionary = eValue.GetIfDict();
+        if (nullptr == pDictionary) {
+          continue;
+        }
+        const std::string* pattern = pDictionary->FindString("p");
+        if (!pattern) {
+          continue;
+        }
+        target.exclusions.push_back(
+            std::make_unique<re2::RE2>(CorrecttoRuleToRE2Engine(*pattern)));
+      }
+    }
+
+    const base::Value::List* rValues = childTopDictionary->FindList("r");
+    target.has_rules = nullptr != rValues;
+    if (target.has_rules) {
+      for (const auto& rValue : *rValues) {
+        const base::Value::Dict* pDictionary = rValue.GetIfDict();
+        if (nullptr == pDictionary) {
+          continue;
+        }
+        Rule rule;
+        if (pDictionary->Find("d")) {
+          rule.is_default = true;
+          target.rules.push_back(std::move(rule));
+          continue;
+        }
+
+        const std::string* from = pDictionary->FindString("f");
+        const std::string* to = pDictionary->FindString("t");
+        if (!from || !to) {
+          continue;
+        }
+        rule.from = std::make_unique<re2::RE2>(*from);
+        rule.to = CorrecttoRuleToRE2Engine(*to);
+        target.rules.push_back(std::move(rule));
+      }
+    }
+
+    rule_set->targets_.push_back(std::move(target));
+  }
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& url) const {
+  for (const auto& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (RE2::FullMatch(url, *exclusion)) {
+        return "";
+      }
+    }
+
+    if (!target.has_rules) {
+      return "";
+    }
+
+    for (const auto& rule : target.rules) {
+      if (rule.is_default) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(url);
+      if (RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,68 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The HTTPS Everywhere rules stored for a domain, parsed once with their
+// exclusion and rule regexes compiled, so they can be applied to many URLs.
+class HTTPSERuleSet {
+ public:
+  HTTPSERuleSet(const HTTPSERuleSet&) = delete;
+  HTTPSERuleSet& operator=(const HTTPSERuleSet&) = delete;
+  ~HTTPSERuleSet();
+
+  // Parses the JSON stored in the HTTPS Everywhere database for a domain.
+  static std::unique_ptr<HTTPSERuleSet> Parse(base::StringPiece json);
+
+  // Returns |url| rewritten by the first matching rule, or an empty string
+  // if it is excluded or no rule rewrites it.
+  std::string Apply(const std::string& url) const;
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    Rule& operator=(Rule&&);
+    ~Rule();
+
+    // Default rules upgrade any URL by inserting "s" after "http".
+    bool is_default = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&&);
+    Target& operator=(Target&&);
+    ~Target();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // Without a list of rules, no later target is applied either.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleSet();
+
+  std::vector<Target> targets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
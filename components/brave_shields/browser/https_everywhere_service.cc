@@ -13,21 +13,23 @@
 #include "base/base_paths.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_compiled_ruleset.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
+#define COMPILED_RULESET_FILE "httpse.ruleset"
+#define COMPILED_RULESET_VERSION_FILE "httpse.ruleset.version"
 #define DAT_FILE_VERSION "6.0"
 #define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RULE_SETS_CACHE_SIZE         100
 
 namespace {
 
@@ -66,31 +68,47 @@ std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
   }
   return resultDomains;
 }
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
-  }
-
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
-}
 
 }  // namespace
 
 namespace brave_shields {
 
 HTTPSEverywhereService::Engine::Engine(HTTPSEverywhereService* service)
-    : level_db_(nullptr), service_(service) {
+    : rule_sets_(HTTPSE_RULE_SETS_CACHE_SIZE), service_(service) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
-void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
+HTTPSEverywhereService::Engine::~Engine() = default;
+
+void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir,
+                                          const base::Version& version) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath zip_db_file_path =
       base_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
   base::FilePath destination = zip_db_file_path.DirName();
+  const base::FilePath ruleset_path =
+      destination.AppendASCII(COMPILED_RULESET_FILE);
+  const base::FilePath ruleset_version_path =
+      destination.AppendASCII(COMPILED_RULESET_VERSION_FILE);
+
+  ruleset_.reset();
+  rule_sets_.Clear();
+
+  // Reuse the ruleset built for this version of the component on a previous
+  // run, so the database is only unzipped and read when the component
+  // updates.
+  std::string ruleset_version;
+  if (version.IsValid() &&
+      base::ReadFileToString(ruleset_version_path, &ruleset_version) &&
+      ruleset_version == version.GetString()) {
+    ruleset_ = HTTPSECompiledRuleset::Load(ruleset_path);
+    if (ruleset_) {
+      return;
+    }
+  }
+  base::DeleteFile(ruleset_version_path);
+
   // Unzip doesn't allow overwriting existing files, so delete previously
   // unzipped db. Attempting to delete a non-existent path returns success.
   bool deleted = base::DeletePathRecursively(unzipped_level_db_path);
@@ -106,20 +124,38 @@ void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
     return;
   }
 
-  CloseDatabase();
-
+  // The database is only read once, to build the compiled ruleset.
+  leveldb::DB* level_db = nullptr;
   leveldb::Options options;
   leveldb::Status status =
       leveldb::DB::Open(options,
                         unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
+                        &level_db);
+  std::unique_ptr<leveldb::DB> db(level_db);
+  if (!status.ok() || !db) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
                << ", error: " << status.ToString();
-    CloseDatabase();
     return;
   }
+
+  if (!HTTPSECompiledRuleset::Build(db.get(), ruleset_path)) {
+    return;
+  }
+  db.reset();
+
+  ruleset_ = HTTPSECompiledRuleset::Load(ruleset_path);
+  if (!ruleset_) {
+    LOG(ERROR) << "Failed to load compiled HTTPSE ruleset "
+               << ruleset_path.value().c_str();
+    return;
+  }
+
+  if (version.IsValid() &&
+      !base::WriteFile(ruleset_version_path, version.GetString())) {
+    LOG(ERROR) << "Failed to write compiled HTTPSE ruleset version "
+               << ruleset_version_path.value().c_str();
+  }
 }
 
 bool HTTPSEverywhereService::Engine::GetHTTPSURL(
@@ -131,7 +167,7 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!ruleset_ || url->scheme() == url::kHttpsScheme) {
     return false;
   }
 
@@ -154,10 +190,15 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+  for (const auto& domain : domains) {
+    const absl::optional<uint32_t> rule_set_id =
+        ruleset_->FindRuleSetId(domain);
+    if (!rule_set_id) {
+      continue;
+    }
+    const HTTPSERuleSet* rule_set = GetRuleSet(*rule_set_id);
+    if (rule_set) {
+      *new_url = rule_set->Apply(candidate_url.spec());
       if (0 != new_url->length()) {
         service_->recently_used_cache().add(candidate_url.spec(), *new_url);
         service_->AddHTTPSEUrlToRedirectList(request_identifier);
@@ -169,108 +210,18 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   return false;
 }
 
-std::string HTTPSEverywhereService::Engine::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::List& topValues = json_object->GetList();
-  for (const auto& topValue : topValues) {
-    if (!topValue.is_dict()) {
-      continue;
-    }
-    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = childTopDictionary->Find("e");
-    if (nullptr != exclusion) {
-      const base::Value::List* eValues = exclusion->GetIfList();
-      if (nullptr != eValues) {
-        for (const auto& eValue : *eValues) {
-          const base::Value::Dict* pDictionary = eValue.GetIfDict();
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = pDictionary->Find("p");
-          if (!patternValue) {
-            continue;
-          }
-          if (!patternValue->is_string()) {
-            continue;
-          }
-          std::string pattern =
-              CorrecttoRuleToRE2Engine(patternValue->GetString());
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = childTopDictionary->Find("r");
-    if (!rules) {
-      return "";
-    }
-    const base::Value::List* rValues = rules->GetIfList();
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (const auto& rValue : *rValues) {
-      const base::Value::Dict* pDictionary = rValue.GetIfDict();
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = pDictionary->Find("d");
-      if (patternValue) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = pDictionary->Find("f");
-      const base::Value* to_value = pDictionary->Find("t");
-      if (!from_value || !to_value) {
-        continue;
-      }
-      if (!from_value->is_string() || !to_value->is_string()) {
-        continue;
-      }
-
-      std::string to = CorrecttoRuleToRE2Engine(to_value->GetString());
-      std::string newUrl(originalUrl);
-      RE2 regExp(from_value->GetString());
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::Engine::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
-void HTTPSEverywhereService::Engine::CloseDatabase() {
+const HTTPSERuleSet* HTTPSEverywhereService::Engine::GetRuleSet(
+    uint32_t rule_set_id) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
+  auto iter = rule_sets_.Get(rule_set_id);
+  if (iter == rule_sets_.end()) {
+    // Rule sets which fail to parse are cached too, so they are only parsed
+    // once.
+    iter = rule_sets_.Put(
+        rule_set_id,
+        HTTPSERuleSet::Parse(ruleset_->GetRuleSetJson(rule_set_id)));
   }
+  return iter->second.get();
 }
 
 bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
@@ -288,11 +239,12 @@ bool HTTPSEverywhereService::Init() {
   return true;
 }
 
-void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
+void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir,
+                                    const base::Version& version) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  GetTaskRunner()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Engine::Init, engine_->AsWeakPtr(), install_dir));
+  GetTaskRunner()->PostTask(FROM_HERE,
+                            base::BindOnce(&Engine::Init, engine_->AsWeakPtr(),
+                                           install_dir, version));
 }
 
 bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
@@ -10,23 +10,24 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "base/version.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
-namespace leveldb {
-class DB;
-}
-
 class HTTPSEverywhereServiceTest;
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSECompiledRuleset;
+class HTTPSERuleSet;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
@@ -56,24 +57,25 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
     explicit Engine(HTTPSEverywhereService* service);
     Engine(const Engine&) = delete;
     Engine& operator=(const Engine&) = delete;
+    ~Engine();
 
-    void Init(const base::FilePath& base_dir);
+    void Init(const base::FilePath& base_dir, const base::Version& version);
     bool GetHTTPSURL(const GURL* url,
                      const uint64_t& request_id,
                      std::string* new_url);
 
    private:
-    std::string ApplyHTTPSRule(const std::string& originalUrl,
-                               const std::string& rule);
-    std::string CorrecttoRuleToRE2Engine(const std::string& to);
-    void CloseDatabase();
+    // Returns the parsed rule set, from |rule_sets_| if it was used recently.
+    const HTTPSERuleSet* GetRuleSet(uint32_t rule_set_id);
 
-    leveldb::DB* level_db_;
+    std::unique_ptr<HTTPSECompiledRuleset> ruleset_;
+    base::LRUCache<uint32_t, std::unique_ptr<HTTPSERuleSet>> rule_sets_;
     HTTPSEverywhereService* service_;  // not owned
     SEQUENCE_CHECKER(sequence_checker_);
   };
 
-  void InitDB(const base::FilePath& install_dir);
+  // Loads the ruleset of the component |version| installed in |install_dir|.
+  void InitDB(const base::FilePath& install_dir, const base::Version& version);
 
   bool GetHTTPSURLFromCacheOnly(const GURL* url,
                                 const uint64_t& request_id,
@@ -87,7 +87,7 @@ class HTTPSEverywhereServiceTest : public ExtensionBrowserTest {
       return false;
 
     g_brave_browser_process->https_everywhere_service()->InitDB(
-        httpse_extension->path());
+        httpse_extension->path(), httpse_extension->version());
     WaitForHTTPSEverywhereServiceThread();
 
     return true;
@@ -77,10 +77,6 @@ BASE_FEATURE(kBraveReduceLanguage,
 BASE_FEATURE(kBraveDarkModeBlock,
              "BraveDarkModeBlock",
              base::FEATURE_ENABLED_BY_DEFAULT);
-// load the cosmetic filter rules using sync ipc
-BASE_FEATURE(kCosmeticFilteringSyncLoad,
-             "CosmeticFilterSyncLoad",
-             base::FEATURE_ENABLED_BY_DEFAULT);
 
 // Enables extra TRACE_EVENTs in content filter js. The feature is
 // primary designed for local debugging.
@@ -10,14 +10,18 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/containers/cxx20_erase.h"
 #include "base/environment.h"
 #include "base/json/json_writer.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/stringprintf.h"
+#include "base/task/sequenced_task_runner.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/constants/brave_services_key.h"
 #include "net/base/load_flags.h"
 #include "net/base/url_util.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 
@@ -94,12 +98,68 @@ std::vector<std::string> VectorToLowerCase(const std::vector<std::string>& v) {
   return v_lower;
 }
 
+// Prices younger than this are served from the cache as they are.
+constexpr base::TimeDelta kPriceCacheTTL = base::Seconds(30);
+// Prices up to this old are still served from the cache, but fetched again
+// in the background for the next calls. Older ones are fetched first.
+constexpr base::TimeDelta kPriceCacheMaxAge = base::Minutes(5);
+
+base::flat_map<std::string, std::string> GetPriceRequestHeaders() {
+  base::flat_map<std::string, std::string> request_headers;
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  std::string brave_key(BUILDFLAG(BRAVE_SERVICES_KEY));
+  if (env->HasVar("BRAVE_SERVICES_KEY")) {
+    env->GetVar("BRAVE_SERVICES_KEY", &brave_key);
+  }
+  request_headers["x-brave-key"] = std::move(brave_key);
+  return request_headers;
+}
+
+bool ContainsAll(const base::flat_set<std::string>& set,
+                 const std::vector<std::string>& values) {
+  return base::ranges::all_of(values, [&set](const std::string& value) {
+    return set.contains(value);
+  });
+}
+
 }  // namespace
 
 namespace brave_wallet {
 
 GURL AssetRatioService::base_url_for_test_;
 
+AssetRatioService::CachedPrice::CachedPrice() = default;
+AssetRatioService::CachedPrice::CachedPrice(const CachedPrice&) = default;
+AssetRatioService::CachedPrice& AssetRatioService::CachedPrice::operator=(
+    const CachedPrice&) = default;
+AssetRatioService::CachedPrice::~CachedPrice() = default;
+
+AssetRatioService::CachedPriceHistory::CachedPriceHistory() = default;
+AssetRatioService::CachedPriceHistory::CachedPriceHistory(
+    CachedPriceHistory&&) = default;
+AssetRatioService::CachedPriceHistory&
+AssetRatioService::CachedPriceHistory::operator=(CachedPriceHistory&&) =
+    default;
+AssetRatioService::CachedPriceHistory::~CachedPriceHistory() = default;
+
+AssetRatioService::PriceRequest::PriceRequest(
+    std::vector<std::string> from_assets,
+    std::vector<std::string> to_assets,
+    GetPriceCallback callback)
+    : from_assets(std::move(from_assets)),
+      to_assets(std::move(to_assets)),
+      callback(std::move(callback)) {}
+AssetRatioService::PriceRequest::PriceRequest(PriceRequest&&) = default;
+AssetRatioService::PriceRequest& AssetRatioService::PriceRequest::operator=(
+    PriceRequest&&) = default;
+AssetRatioService::PriceRequest::~PriceRequest() = default;
+
+AssetRatioService::PriceBatch::PriceBatch() = default;
+AssetRatioService::PriceBatch::PriceBatch(PriceBatch&&) = default;
+AssetRatioService::PriceBatch& AssetRatioService::PriceBatch::operator=(
+    PriceBatch&&) = default;
+AssetRatioService::PriceBatch::~PriceBatch() = default;
+
 AssetRatioService::AssetRatioService(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
     : api_request_helper_(new api_request_helper::APIRequestHelper(
@@ -281,21 +341,109 @@ void AssetRatioService::GetPrice(
     GetPriceCallback callback) {
   std::vector<std::string> from_assets_lower = VectorToLowerCase(from_assets);
   std::vector<std::string> to_assets_lower = VectorToLowerCase(to_assets);
-  auto internal_callback = base::BindOnce(
-      &AssetRatioService::OnGetPrice, weak_ptr_factory_.GetWeakPtr(),
-      from_assets_lower, to_assets_lower, std::move(callback));
 
-  base::flat_map<std::string, std::string> request_headers;
-  std::unique_ptr<base::Environment> env(base::Environment::Create());
-  std::string brave_key(BUILDFLAG(BRAVE_SERVICES_KEY));
-  if (env->HasVar("BRAVE_SERVICES_KEY")) {
-    env->GetVar("BRAVE_SERVICES_KEY", &brave_key);
+  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+  bool stale = false;
+  if (!GetCachedPrices(from_assets_lower, to_assets_lower, timeframe, &prices,
+                       &stale)) {
+    QueuePrices(from_assets_lower, to_assets_lower, timeframe,
+                std::move(callback));
+    return;
+  }
+
+  std::move(callback).Run(true, std::move(prices));
+  if (stale) {
+    QueuePrices(from_assets_lower, to_assets_lower, timeframe,
+                GetPriceCallback());
+  }
+}
+
+bool AssetRatioService::GetCachedPrices(
+    const std::vector<std::string>& from_assets,
+    const std::vector<std::string>& to_assets,
+    mojom::AssetPriceTimeframe timeframe,
+    std::vector<mojom::AssetPricePtr>* prices,
+    bool* stale) const {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (const std::string& from_asset : from_assets) {
+    for (const std::string& to_asset : to_assets) {
+      auto it =
+          price_cache_.find(PriceCacheKey(from_asset, to_asset, timeframe));
+      if (it == price_cache_.end() ||
+          now - it->second.fetched_at > kPriceCacheMaxAge) {
+        return false;
+      }
+      if (now - it->second.fetched_at > kPriceCacheTTL) {
+        *stale = true;
+      }
+
+      auto asset_price = mojom::AssetPrice::New();
+      asset_price->from_asset = from_asset;
+      asset_price->to_asset = to_asset;
+      asset_price->price = it->second.price;
+      asset_price->asset_timeframe_change = it->second.asset_timeframe_change;
+      prices->push_back(std::move(asset_price));
+    }
+  }
+  return true;
+}
+
+void AssetRatioService::QueuePrices(const std::vector<std::string>& from_assets,
+                                    const std::vector<std::string>& to_assets,
+                                    mojom::AssetPriceTimeframe timeframe,
+                                    GetPriceCallback callback) {
+  for (auto& [batch_id, batch] : price_batches_in_flight_) {
+    if (batch.timeframe == timeframe &&
+        ContainsAll(batch.from_assets, from_assets) &&
+        ContainsAll(batch.to_assets, to_assets)) {
+      if (callback) {
+        batch.requests.emplace_back(from_assets, to_assets,
+                                    std::move(callback));
+      }
+      return;
+    }
+  }
+
+  auto [it, inserted] = queued_price_batches_.try_emplace(timeframe);
+  PriceBatch& batch = it->second;
+  batch.timeframe = timeframe;
+  batch.from_assets.insert(from_assets.begin(), from_assets.end());
+  batch.to_assets.insert(to_assets.begin(), to_assets.end());
+  if (callback) {
+    batch.requests.emplace_back(from_assets, to_assets, std::move(callback));
   }
-  request_headers["x-brave-key"] = std::move(brave_key);
+
+  // The prices asked for until the batch is sent, as when the wallet pages
+  // ask for the prices of their tokens at once, are fetched together.
+  if (inserted) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&AssetRatioService::SendPriceBatch,
+                                  weak_ptr_factory_.GetWeakPtr(), timeframe));
+  }
+}
+
+void AssetRatioService::SendPriceBatch(mojom::AssetPriceTimeframe timeframe) {
+  auto it = queued_price_batches_.find(timeframe);
+  DCHECK(it != queued_price_batches_.end());
+  PriceBatch batch = std::move(it->second);
+  queued_price_batches_.erase(it);
+  FetchPriceBatch(std::move(batch));
+}
+
+void AssetRatioService::FetchPriceBatch(PriceBatch batch) {
+  const mojom::AssetPriceTimeframe timeframe = batch.timeframe;
+  const std::vector<std::string> from_assets(batch.from_assets.begin(),
+                                             batch.from_assets.end());
+  const std::vector<std::string> to_assets(batch.to_assets.begin(),
+                                           batch.to_assets.end());
+  const uint32_t batch_id = next_price_batch_id_++;
+  price_batches_in_flight_.emplace(batch_id, std::move(batch));
 
   api_request_helper_->Request(
-      "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "", "",
-      true, std::move(internal_callback), request_headers);
+      "GET", GetPriceURL(from_assets, to_assets, timeframe), "", "", true,
+      base::BindOnce(&AssetRatioService::OnGetPrice,
+                     weak_ptr_factory_.GetWeakPtr(), batch_id),
+      GetPriceRequestHeaders());
 }
 
 void AssetRatioService::OnGetSardineAuthToken(
@@ -322,22 +470,73 @@ void AssetRatioService::OnGetSardineAuthToken(
   std::move(callback).Run(std::move(sardine_buy_url.spec()), absl::nullopt);
 }
 
-void AssetRatioService::OnGetPrice(std::vector<std::string> from_assets,
-                                   std::vector<std::string> to_assets,
-                                   GetPriceCallback callback,
+void AssetRatioService::OnGetPrice(uint32_t batch_id,
                                    APIRequestResult api_request_result) {
-  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+  auto it = price_batches_in_flight_.find(batch_id);
+  DCHECK(it != price_batches_in_flight_.end());
+  PriceBatch batch = std::move(it->second);
+  price_batches_in_flight_.erase(it);
+
   if (!api_request_result.Is2XXResponseCode()) {
-    std::move(callback).Run(false, std::move(prices));
+    // The provider rejects the whole query for a single asset it doesn't
+    // know, so each call is sent again on its own to only fail the calls
+    // asking for that asset. Other errors, like rate limiting or a server
+    // error, would fail each of the calls alike.
+    const int response_code = api_request_result.response_code();
+    const bool is_rejected_query = response_code >= 400 &&
+                                   response_code < 500 &&
+                                   response_code != net::HTTP_TOO_MANY_REQUESTS;
+    if (is_rejected_query && batch.requests.size() > 1) {
+      for (auto& request : batch.requests) {
+        PriceBatch request_batch;
+        request_batch.timeframe = batch.timeframe;
+        request_batch.from_assets.insert(request.from_assets.begin(),
+                                         request.from_assets.end());
+        request_batch.to_assets.insert(request.to_assets.begin(),
+                                       request.to_assets.end());
+        request_batch.requests.push_back(std::move(request));
+        FetchPriceBatch(std::move(request_batch));
+      }
+      return;
+    }
+
+    for (auto& request : batch.requests) {
+      std::move(request.callback)
+          .Run(false, std::vector<brave_wallet::mojom::AssetPricePtr>());
+    }
     return;
   }
-  if (!ParseAssetPrice(api_request_result.value_body(), from_assets, to_assets,
-                       &prices)) {
-    std::move(callback).Run(false, std::move(prices));
-    return;
+
+  // Cache every price of the batch the response has, even though another one
+  // may be missing.
+  const base::Value& body = api_request_result.value_body();
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (const std::string& from_asset : batch.from_assets) {
+    for (const std::string& to_asset : batch.to_assets) {
+      std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+      if (!ParseAssetPrice(body, {from_asset}, {to_asset}, &prices)) {
+        continue;
+      }
+      CachedPrice& cached =
+          price_cache_[PriceCacheKey(from_asset, to_asset, batch.timeframe)];
+      cached.price = std::move(prices[0]->price);
+      cached.asset_timeframe_change =
+          std::move(prices[0]->asset_timeframe_change);
+      cached.fetched_at = now;
+    }
   }
+  base::EraseIf(price_cache_, [now](const auto& entry) {
+    return now - entry.second.fetched_at > kPriceCacheMaxAge;
+  });
 
-  std::move(callback).Run(true, std::move(prices));
+  // Each call succeeds or fails as if it had sent its own request, whatever
+  // the other prices of the batch.
+  for (auto& request : batch.requests) {
+    std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+    const bool success = ParseAssetPrice(body, request.from_assets,
+                                         request.to_assets, &prices);
+    std::move(request.callback).Run(success, std::move(prices));
+  }
 }
 
 void AssetRatioService::GetPriceHistory(
@@ -345,29 +544,76 @@ void AssetRatioService::GetPriceHistory(
     const std::string& vs_asset,
     brave_wallet::mojom::AssetPriceTimeframe timeframe,
     GetPriceHistoryCallback callback) {
-  std::string asset_lower = base::ToLowerASCII(asset);
-  std::string vs_asset_lower = base::ToLowerASCII(vs_asset);
+  const PriceCacheKey key(base::ToLowerASCII(asset),
+                          base::ToLowerASCII(vs_asset), timeframe);
+
+  auto it = price_history_cache_.find(key);
+  if (it != price_history_cache_.end()) {
+    const base::TimeDelta age = base::TimeTicks::Now() - it->second.fetched_at;
+    if (age <= kPriceCacheMaxAge) {
+      std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
+      for (const auto& value : it->second.values) {
+        values.push_back(value.Clone());
+      }
+      std::move(callback).Run(true, std::move(values));
+      if (age > kPriceCacheTTL) {
+        FetchPriceHistory(key);
+      }
+      return;
+    }
+    price_history_cache_.erase(it);
+  }
+
+  FetchPriceHistory(key);
+  price_history_requests_in_flight_[key].push_back(std::move(callback));
+}
+
+void AssetRatioService::FetchPriceHistory(const PriceCacheKey& key) {
+  if (!price_history_requests_in_flight_.try_emplace(key).second) {
+    return;
+  }
+
+  const auto& [asset, vs_asset, timeframe] = key;
   auto internal_callback =
       base::BindOnce(&AssetRatioService::OnGetPriceHistory,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+                     weak_ptr_factory_.GetWeakPtr(), key);
   api_request_helper_->Request(
-      "GET", GetPriceHistoryURL(asset_lower, vs_asset_lower, timeframe), "", "",
-      true, std::move(internal_callback));
+      "GET", GetPriceHistoryURL(asset, vs_asset, timeframe), "", "", true,
+      std::move(internal_callback));
 }
 
-void AssetRatioService::OnGetPriceHistory(GetPriceHistoryCallback callback,
+void AssetRatioService::OnGetPriceHistory(const PriceCacheKey& key,
                                           APIRequestResult api_request_result) {
+  auto it = price_history_requests_in_flight_.find(key);
+  DCHECK(it != price_history_requests_in_flight_.end());
+  std::vector<GetPriceHistoryCallback> callbacks = std::move(it->second);
+  price_history_requests_in_flight_.erase(it);
+
   std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
-  if (!api_request_result.Is2XXResponseCode()) {
-    std::move(callback).Run(false, std::move(values));
+  if (!api_request_result.Is2XXResponseCode() ||
+      !ParseAssetPriceHistory(api_request_result.value_body(), &values)) {
+    for (auto& callback : callbacks) {
+      std::move(callback).Run(
+          false, std::vector<brave_wallet::mojom::AssetTimePricePtr>());
+    }
     return;
   }
-  if (!ParseAssetPriceHistory(api_request_result.value_body(), &values)) {
-    std::move(callback).Run(false, std::move(values));
-    return;
+
+  for (auto& callback : callbacks) {
+    std::vector<brave_wallet::mojom::AssetTimePricePtr> callback_values;
+    for (const auto& value : values) {
+      callback_values.push_back(value.Clone());
+    }
+    std::move(callback).Run(true, std::move(callback_values));
   }
 
-  std::move(callback).Run(true, std::move(values));
+  const base::TimeTicks now = base::TimeTicks::Now();
+  CachedPriceHistory& cached = price_history_cache_[key];
+  cached.values = std::move(values);
+  cached.fetched_at = now;
+  base::EraseIf(price_history_cache_, [now](const auto& entry) {
+    return now - entry.second.fetched_at > kPriceCacheMaxAge;
+  });
 }
 
 // static
@@ -6,11 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ASSET_RATIO_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ASSET_RATIO_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/functional/callback.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
@@ -109,11 +112,82 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
                              GetBuyUrlV1Callback callback,
                              APIRequestResult api_request_result);
 
-  void OnGetPrice(std::vector<std::string> from_assets,
-                  std::vector<std::string> to_assets,
-                  GetPriceCallback callback,
-                  APIRequestResult api_request_result);
-  void OnGetPriceHistory(GetPriceHistoryCallback callback,
+  // Prices and price histories are cached by (asset, vs asset, timeframe).
+  using PriceCacheKey =
+      std::tuple<std::string, std::string, mojom::AssetPriceTimeframe>;
+
+  struct CachedPrice {
+    CachedPrice();
+    CachedPrice(const CachedPrice&);
+    CachedPrice& operator=(const CachedPrice&);
+    ~CachedPrice();
+
+    std::string price;
+    std::string asset_timeframe_change;
+    base::TimeTicks fetched_at;
+  };
+
+  struct CachedPriceHistory {
+    CachedPriceHistory();
+    CachedPriceHistory(CachedPriceHistory&&);
+    CachedPriceHistory& operator=(CachedPriceHistory&&);
+    ~CachedPriceHistory();
+
+    std::vector<mojom::AssetTimePricePtr> values;
+    base::TimeTicks fetched_at;
+  };
+
+  // A |GetPrice| call waiting for a batch of prices to be fetched.
+  struct PriceRequest {
+    PriceRequest(std::vector<std::string> from_assets,
+                 std::vector<std::string> to_assets,
+                 GetPriceCallback callback);
+    PriceRequest(PriceRequest&&);
+    PriceRequest& operator=(PriceRequest&&);
+    ~PriceRequest();
+
+    std::vector<std::string> from_assets;
+    std::vector<std::string> to_assets;
+    GetPriceCallback callback;
+  };
+
+  // The prices of |from_assets| in |to_assets| fetched in a single request
+  // for all the |requests| which need them. A batch fetched to refresh stale
+  // prices may have no requests.
+  struct PriceBatch {
+    PriceBatch();
+    PriceBatch(PriceBatch&&);
+    PriceBatch& operator=(PriceBatch&&);
+    ~PriceBatch();
+
+    mojom::AssetPriceTimeframe timeframe = mojom::AssetPriceTimeframe::Live;
+    base::flat_set<std::string> from_assets;
+    base::flat_set<std::string> to_assets;
+    std::vector<PriceRequest> requests;
+  };
+
+  // Looks up the prices of every |from_assets| in every |to_assets|. Returns
+  // false if one of them isn't cached or is too old to be served, and sets
+  // |stale| if one of them should be fetched again.
+  bool GetCachedPrices(const std::vector<std::string>& from_assets,
+                       const std::vector<std::string>& to_assets,
+                       mojom::AssetPriceTimeframe timeframe,
+                       std::vector<mojom::AssetPricePtr>* prices,
+                       bool* stale) const;
+  // Adds the prices to the batch to be sent for |timeframe|, unless a batch
+  // in flight already fetches all of them. |callback| may be null when the
+  // prices are only refreshed.
+  void QueuePrices(const std::vector<std::string>& from_assets,
+                   const std::vector<std::string>& to_assets,
+                   mojom::AssetPriceTimeframe timeframe,
+                   GetPriceCallback callback);
+  void SendPriceBatch(mojom::AssetPriceTimeframe timeframe);
+  // Sends the request for the prices of |batch| and keeps it in flight.
+  void FetchPriceBatch(PriceBatch batch);
+  void OnGetPrice(uint32_t batch_id, APIRequestResult api_request_result);
+  // Fetches the price history of |key| unless it is already being fetched.
+  void FetchPriceHistory(const PriceCacheKey& key);
+  void OnGetPriceHistory(const PriceCacheKey& key,
                          APIRequestResult api_request_result);
 
   void OnGetTokenInfo(GetTokenInfoCallback callback,
@@ -126,6 +200,18 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
 
   static GURL base_url_for_test_;
   std::unique_ptr<api_request_helper::APIRequestHelper> api_request_helper_;
+
+  std::map<PriceCacheKey, CachedPrice> price_cache_;
+  std::map<PriceCacheKey, CachedPriceHistory> price_history_cache_;
+  // Batches collecting the prices asked for in the current task, by
+  // timeframe, and batches sent, by id.
+  base::flat_map<mojom::AssetPriceTimeframe, PriceBatch> queued_price_batches_;
+  base::flat_map<uint32_t, PriceBatch> price_batches_in_flight_;
+  uint32_t next_price_batch_id_ = 0;
+  // The callbacks waiting for each price history being fetched.
+  std::map<PriceCacheKey, std::vector<GetPriceHistoryCallback>>
+      price_history_requests_in_flight_;
+
   base::WeakPtrFactory<AssetRatioService> weak_ptr_factory_;
 };
 
@@ -4,7 +4,9 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
@@ -18,6 +20,45 @@
 
 namespace {
 
+constexpr char kPriceResponse[] = R"(
+    {
+      "payload":{
+        "bat":{
+          "btc":0.00001732,
+          "btc_timeframe_change":8.021672460190562,
+          "usd":0.55393,
+          "usd_timeframe_change":9.523443444373276
+        },
+        "link":{
+          "btc":0.00261901,
+          "btc_timeframe_change":0.5871625385632929,
+          "usd":83.77,
+          "usd_timeframe_change":1.7646208048244043
+        }
+      },
+      "lastUpdated":"2021-07-16T19:11:28.907Z"
+    })";
+
+constexpr char kPriceHistoryResponse[] = R"(
+    {
+      "payload":{
+        "prices":[[1622733088498,0.8201346624954003]],
+        "market_caps":[[1622733088498,1223507820.383275]],
+        "total_volumes":[[1622733088498,163426828.00299588]]
+      }
+    })";
+
+std::vector<brave_wallet::mojom::AssetPricePtr> BatPrices() {
+  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+  auto asset_price = brave_wallet::mojom::AssetPrice::New();
+  asset_price->from_asset = "bat";
+  asset_price->to_asset = "btc";
+  asset_price->price = "0.00001732";
+  asset_price->asset_timeframe_change = "8.021672460190562";
+  prices.push_back(std::move(asset_price));
+  return prices;
+}
+
 void OnGetPrice(bool* callback_run,
                 bool expected_success,
                 std::vector<brave_wallet::mojom::AssetPricePtr> expected_values,
@@ -74,6 +115,7 @@ class AssetRatioServiceUnitTest : public testing::Test {
                       const std::string expected_header = "") {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, content, expected_header](const network::ResourceRequest& request) {
+          request_count_++;
           url_loader_factory_.ClearResponses();
           std::string header;
           request.headers.GetHeader("Authorization", &header);
@@ -84,6 +126,7 @@ class AssetRatioServiceUnitTest : public testing::Test {
   void SetErrorInterceptor(const std::string& content) {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, content](const network::ResourceRequest& request) {
+          request_count_++;
           url_loader_factory_.ClearResponses();
           url_loader_factory_.AddResponse(request.url.spec(), content,
                                           net::HTTP_REQUEST_TIMEOUT);
@@ -145,11 +188,14 @@ class AssetRatioServiceUnitTest : public testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  network::TestURLLoaderFactory url_loader_factory_;
+  // The requests seen by the interceptors.
+  int request_count_ = 0;
   std::unique_ptr<AssetRatioService> asset_ratio_service_;
 
  private:
-  base::test::TaskEnvironment task_environment_;
-  network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
 };
@@ -319,6 +365,250 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceUnexpectedResponse) {
   EXPECT_TRUE(callback_run);
 }
 
+TEST_F(AssetRatioServiceUnitTest, GetPriceIsCached) {
+  SetInterceptor(kPriceResponse);
+  bool callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(1, request_count_);
+
+  // Fresh prices are served from the cache, right away.
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"BAT"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  EXPECT_TRUE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, request_count_);
+
+  // Prices of another timeframe aren't.
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneWeek,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  EXPECT_FALSE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(2, request_count_);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceExpires) {
+  SetInterceptor(kPriceResponse);
+  bool callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(1, request_count_);
+
+  // Stale prices are still served right away, and fetched again.
+  task_environment_.FastForwardBy(base::Minutes(1));
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  EXPECT_TRUE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, request_count_);
+
+  // Fetching them again made them fresh.
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  EXPECT_TRUE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, request_count_);
+
+  // Expired prices are fetched before answering.
+  task_environment_.FastForwardBy(base::Minutes(10));
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  EXPECT_FALSE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(3, request_count_);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceBatchesCalls) {
+  std::vector<GURL> request_urls;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        request_urls.push_back(request.url);
+        url_loader_factory_.AddResponse(request.url.spec(), kPriceResponse);
+      }));
+
+  bool bat_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &bat_callback_run, true, BatPrices()));
+  bool link_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"link"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> prices) {
+            EXPECT_TRUE(success);
+            ASSERT_EQ(1u, prices.size());
+            EXPECT_EQ("link", prices[0]->from_asset);
+            EXPECT_EQ("usd", prices[0]->to_asset);
+            EXPECT_EQ("83.77", prices[0]->price);
+            link_callback_run = true;
+          }));
+  bool missing_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat", "unknown"}, {"btc"},
+      brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> prices) {
+            EXPECT_FALSE(success);
+            missing_callback_run = true;
+          }));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(bat_callback_run);
+  EXPECT_TRUE(link_callback_run);
+  // Only the call asking for a price the response doesn't have fails.
+  EXPECT_TRUE(missing_callback_run);
+  EXPECT_EQ(std::vector<GURL>({AssetRatioService::GetPriceURL(
+                {"bat", "link", "unknown"}, {"btc", "usd"},
+                brave_wallet::mojom::AssetPriceTimeframe::OneDay)}),
+            request_urls);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceRetriesFailedBatchPerCall) {
+  std::vector<GURL> request_urls;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        request_urls.push_back(request.url);
+        if (request.url.spec().find("unknown") != std::string::npos) {
+          url_loader_factory_.AddResponse(request.url.spec(), "error",
+                                          net::HTTP_BAD_REQUEST);
+          return;
+        }
+        url_loader_factory_.AddResponse(request.url.spec(), kPriceResponse);
+      }));
+
+  bool bat_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &bat_callback_run, true, BatPrices()));
+  bool unknown_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"unknown"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &unknown_callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+
+  base::RunLoop().RunUntilIdle();
+  // The batch is rejected for the unknown asset, so each call is sent again
+  // on its own and only the one asking for it fails.
+  EXPECT_TRUE(bat_callback_run);
+  EXPECT_TRUE(unknown_callback_run);
+  EXPECT_EQ(
+      std::vector<GURL>(
+          {AssetRatioService::GetPriceURL(
+               {"bat", "unknown"}, {"btc"},
+               brave_wallet::mojom::AssetPriceTimeframe::OneDay),
+           AssetRatioService::GetPriceURL(
+               {"bat"}, {"btc"},
+               brave_wallet::mojom::AssetPriceTimeframe::OneDay),
+           AssetRatioService::GetPriceURL(
+               {"unknown"}, {"btc"},
+               brave_wallet::mojom::AssetPriceTimeframe::OneDay)}),
+      request_urls);
+
+  // A server error fails each call alike, so the batch is not sent again.
+  request_urls.clear();
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        request_urls.push_back(request.url);
+        url_loader_factory_.AddResponse(request.url.spec(), "error",
+                                        net::HTTP_INTERNAL_SERVER_ERROR);
+      }));
+
+  bool link_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"link"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &link_callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+  bool eth_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"eth"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &eth_callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(link_callback_run);
+  EXPECT_TRUE(eth_callback_run);
+  EXPECT_EQ(std::vector<GURL>({AssetRatioService::GetPriceURL(
+                {"eth", "link"}, {"btc"},
+                brave_wallet::mojom::AssetPriceTimeframe::OneDay)}),
+            request_urls);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceJoinsRequestInFlight) {
+  bool callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat", "link"}, {"btc", "usd"},
+      brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> prices) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ(4u, prices.size());
+            callback_run = true;
+          }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+
+  // Asks for prices the request in flight already fetches.
+  bool bat_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &bat_callback_run, true, BatPrices()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+  EXPECT_FALSE(bat_callback_run);
+
+  EXPECT_TRUE(url_loader_factory_.SimulateResponseForPendingRequest(
+      AssetRatioService::GetPriceURL(
+          {"bat", "link"}, {"btc", "usd"},
+          brave_wallet::mojom::AssetPriceTimeframe::OneDay)
+          .spec(),
+      kPriceResponse));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_TRUE(bat_callback_run);
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceDoesNotCacheErrors) {
+  SetErrorInterceptor("error");
+  bool callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+
+  SetInterceptor(kPriceResponse);
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"btc"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, true, BatPrices()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(2, request_count_);
+}
+
 TEST_F(AssetRatioServiceUnitTest, GetPriceHistory) {
   SetInterceptor(R"({
       "payload": {
@@ -380,6 +670,47 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryUnexpectedResponse) {
   EXPECT_TRUE(callback_run);
 }
 
+TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryIsCached) {
+  SetInterceptor(kPriceHistoryResponse);
+  int callback_count = 0;
+  auto callback =
+      [&](bool success,
+          std::vector<brave_wallet::mojom::AssetTimePricePtr> values) {
+        EXPECT_TRUE(success);
+        ASSERT_EQ(1u, values.size());
+        EXPECT_EQ("0.8201346624954003", values[0]->price);
+        callback_count++;
+      };
+
+  // Calls made while the history is fetched share the request.
+  asset_ratio_service_->GetPriceHistory(
+      "bat", "usd", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(callback));
+  asset_ratio_service_->GetPriceHistory(
+      "BAT", "USD", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(callback));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, callback_count);
+  EXPECT_EQ(1, request_count_);
+
+  asset_ratio_service_->GetPriceHistory(
+      "bat", "usd", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(callback));
+  EXPECT_EQ(3, callback_count);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, request_count_);
+
+  // Expired histories are fetched again.
+  task_environment_.FastForwardBy(base::Minutes(10));
+  asset_ratio_service_->GetPriceHistory(
+      "bat", "usd", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(callback));
+  EXPECT_EQ(3, callback_count);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(4, callback_count);
+  EXPECT_EQ(2, request_count_);
+}
+
 TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryURL) {
   // Basic test
   EXPECT_EQ("/v2/history/coingecko/bat/usd/1d",
@@ -5,11 +5,76 @@
 
 #include "brave/components/brave_wallet/browser/eth_logs_tracker.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
+#include "brave/components/brave_wallet/common/hex_utils.h"
+
 namespace brave_wallet {
 
+namespace {
+
+absl::optional<uint256_t> GetBlockNumber(const base::Value::Dict& filter,
+                                         const std::string& key) {
+  const std::string* block = filter.FindString(key);
+  uint256_t block_number;
+  if (!block || !HexValueToUint256(*block, &block_number)) {
+    return absl::nullopt;
+  }
+  return block_number;
+}
+
+// Narrows |filter| to the blocks after |last_block| up to |latest_block|.
+// Returns absl::nullopt when there are no new blocks to fetch logs for.
+absl::optional<base::Value::Dict> GetFilterForNewBlocks(
+    const base::Value::Dict& filter,
+    const absl::optional<uint256_t>& last_block,
+    uint256_t latest_block) {
+  // Logs of a block requested by hash don't change, fetch them once.
+  if (filter.Find("blockHash")) {
+    if (last_block) {
+      return absl::nullopt;
+    }
+    return filter.Clone();
+  }
+
+  uint256_t to_block = latest_block;
+  if (auto requested_to_block = GetBlockNumber(filter, "toBlock")) {
+    to_block = std::min(*requested_to_block, latest_block);
+  }
+
+  // Block tags other than numbers are kept on the first poll.
+  absl::optional<uint256_t> from_block;
+  if (last_block) {
+    from_block = *last_block + 1;
+  } else if (!filter.Find("fromBlock")) {
+    from_block = latest_block;
+  } else {
+    from_block = GetBlockNumber(filter, "fromBlock");
+  }
+  if (from_block && *from_block > to_block) {
+    return absl::nullopt;
+  }
+
+  auto new_blocks_filter = filter.Clone();
+  if (from_block) {
+    new_blocks_filter.Set("fromBlock", Uint256ValueToHex(*from_block));
+  }
+  new_blocks_filter.Set("toBlock", Uint256ValueToHex(to_block));
+  return new_blocks_filter;
+}
+
+}  // namespace
+
+EthLogsTracker::SubscriptionInfo::SubscriptionInfo(base::Value::Dict filter)
+    : filter(std::move(filter)) {}
+EthLogsTracker::SubscriptionInfo::SubscriptionInfo(SubscriptionInfo&&) =
+    default;
+EthLogsTracker::SubscriptionInfo& EthLogsTracker::SubscriptionInfo::operator=(
+    SubscriptionInfo&&) = default;
+EthLogsTracker::SubscriptionInfo::~SubscriptionInfo() = default;
+
 EthLogsTracker::EthLogsTracker(JsonRpcService* json_rpc_service)
     : json_rpc_service_(json_rpc_service) {
   DCHECK(json_rpc_service_);
@@ -33,8 +98,8 @@ bool EthLogsTracker::IsRunning() const {
 
 void EthLogsTracker::AddSubscriber(const std::string& subscription_id,
                                    base::Value::Dict filter) {
-  eth_logs_subscription_info_.insert(std::pair<std::string, base::Value::Dict>(
-      subscription_id, std::move(filter)));
+  eth_logs_subscription_info_.emplace(subscription_id,
+                                      SubscriptionInfo(std::move(filter)));
 }
 
 void EthLogsTracker::RemoveSubscriber(const std::string& subscription_id) {
@@ -50,27 +115,60 @@ void EthLogsTracker::RemoveObserver(EthLogsTracker::Observer* observer) {
 }
 
 void EthLogsTracker::GetLogs() {
+  if (eth_logs_subscription_info_.empty()) {
+    return;
+  }
+
+  json_rpc_service_->GetBlockNumber(base::BindOnce(
+      &EthLogsTracker::OnGetBlockNumber, weak_factory_.GetWeakPtr()));
+}
+
+void EthLogsTracker::OnGetBlockNumber(uint256_t latest_block,
+                                      mojom::ProviderError error,
+                                      const std::string& error_message) {
+  if (error != mojom::ProviderError::kSuccess) {
+    LOG(ERROR) << "OnGetBlockNumber failed";
+    return;
+  }
+
   const auto chain_id = json_rpc_service_->GetChainId(mojom::CoinType::ETH);
 
   for (auto const& esi : std::as_const(eth_logs_subscription_info_)) {
+    auto filter = GetFilterForNewBlocks(esi.second.filter,
+                                        esi.second.last_block, latest_block);
+    if (!filter) {
+      continue;
+    }
     json_rpc_service_->EthGetLogs(
-        chain_id, esi.second.Clone(),
+        chain_id, std::move(*filter),
         base::BindOnce(&EthLogsTracker::OnGetLogs, weak_factory_.GetWeakPtr(),
-                       esi.first));
+                       esi.first, latest_block));
   }
 }
 
 void EthLogsTracker::OnGetLogs(const std::string& subscription,
+                               uint256_t to_block,
                                [[maybe_unused]] const std::vector<Log>& logs,
                                base::Value rawlogs,
                                mojom::ProviderError error,
                                const std::string& error_message) {
-  if (error == mojom::ProviderError::kSuccess && rawlogs.is_dict()) {
-    for (auto& observer : observers_)
-      observer.OnLogsReceived(subscription, rawlogs.Clone());
-  } else {
+  if (error != mojom::ProviderError::kSuccess || !rawlogs.is_dict()) {
     LOG(ERROR) << "OnGetLogs failed";
+    return;
   }
+
+  auto it = eth_logs_subscription_info_.find(subscription);
+  if (it == eth_logs_subscription_info_.end()) {
+    return;
+  }
+  if (it->second.last_block && *it->second.last_block >= to_block) {
+    // A slower response for blocks that were already delivered.
+    return;
+  }
+  it->second.last_block = to_block;
+
+  for (auto& observer : observers_)
+    observer.OnLogsReceived(subscription, rawlogs.Clone());
 }
 
 }  // namespace brave_wallet
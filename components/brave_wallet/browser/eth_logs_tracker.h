@@ -18,6 +18,7 @@
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -52,8 +53,24 @@ class EthLogsTracker {
   void RemoveObserver(Observer* observer);
 
  private:
+  // Each subscription follows the chain head from the last block it has
+  // received logs for, so every poll only fetches blocks not seen before.
+  struct SubscriptionInfo {
+    explicit SubscriptionInfo(base::Value::Dict filter);
+    SubscriptionInfo(SubscriptionInfo&&);
+    SubscriptionInfo& operator=(SubscriptionInfo&&);
+    ~SubscriptionInfo();
+
+    base::Value::Dict filter;
+    absl::optional<uint256_t> last_block;
+  };
+
   void GetLogs();
+  void OnGetBlockNumber(uint256_t latest_block,
+                        mojom::ProviderError error,
+                        const std::string& error_message);
   void OnGetLogs(const std::string& subscription,
+                 uint256_t to_block,
                  const std::vector<Log>& logs,
                  base::Value rawlogs,
                  mojom::ProviderError error,
@@ -62,7 +79,7 @@ class EthLogsTracker {
   base::RepeatingTimer timer_;
   raw_ptr<JsonRpcService> json_rpc_service_ = nullptr;
 
-  std::map<std::string, base::Value::Dict> eth_logs_subscription_info_;
+  std::map<std::string, SubscriptionInfo> eth_logs_subscription_info_;
 
   base::ObserverList<Observer> observers_;
 
@@ -72,9 +72,14 @@ TEST(EthereumKeyringUnitTest, Accounts) {
   for (size_t i = 0; i < accounts.size(); ++i) {
     EXPECT_EQ(accounts[i], keyring.GetAddress(i));
   }
+  // Removed account must no longer be found through the address cache.
+  EXPECT_TRUE(keyring.HasAddress("0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7"));
+  EXPECT_FALSE(
+      keyring.HasAddress("0x02e77f0e2fa06F95BDEa79Fad158477723145838"));
 
   keyring.AddAccounts(1);
   EXPECT_EQ(keyring.GetAccounts().size(), 3u);
+  EXPECT_TRUE(keyring.HasAddress("0x02e77f0e2fa06F95BDEa79Fad158477723145838"));
   EXPECT_EQ(keyring.GetAddress(2),
             "0x02e77f0e2fa06F95BDEa79Fad158477723145838");
 
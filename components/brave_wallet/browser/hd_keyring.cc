@@ -7,6 +7,9 @@
 
 #include <utility>
 
+#include "base/check_op.h"
+#include "base/containers/contains.h"
+
 namespace brave_wallet {
 
 HDKeyring::HDKeyring() = default;
@@ -28,25 +31,29 @@ std::vector<AddedAcountInfo> HDKeyring::AddAccounts(size_t number) {
   }
 
   size_t cur_accounts_number = accounts_.size();
+  accounts_.reserve(cur_accounts_number + number);
   for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
-    auto& added_account = accounts_.emplace_back(DeriveAccount(i));
-    result.push_back(
-        {added_account->GetPath(), GetAddressInternal(added_account.get())});
+    accounts_.emplace_back(DeriveAccount(i));
+  }
+
+  const auto& addresses = GetDerivedAddresses();
+  result.reserve(number);
+  for (size_t i = cur_accounts_number; i < accounts_.size(); ++i) {
+    result.push_back({accounts_[i]->GetPath(), addresses[i]});
   }
 
   return result;
 }
 
 std::vector<std::string> HDKeyring::GetAccounts() const {
-  std::vector<std::string> addresses;
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    addresses.push_back(GetAddress(i));
-  }
-  return addresses;
+  return GetDerivedAddresses();
 }
 
 void HDKeyring::RemoveAccount() {
   accounts_.pop_back();
+  if (derived_addresses_.size() > accounts_.size()) {
+    derived_addresses_.resize(accounts_.size());
+  }
 }
 
 bool HDKeyring::AddImportedAddress(const std::string& address,
@@ -55,10 +62,8 @@ bool HDKeyring::AddImportedAddress(const std::string& address,
   if (imported_accounts_.find(address) != imported_accounts_.end())
     return false;
   // Check if it is duplicate in derived accounts
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return false;
-  }
+  if (HasAddress(address))
+    return false;
 
   imported_accounts_[address] = std::move(hd_key);
   return true;
@@ -88,7 +93,18 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 std::string HDKeyring::GetAddress(size_t index) const {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
-  return GetAddressInternal(accounts_[index].get());
+  return GetDerivedAddresses()[index];
+}
+
+const std::vector<std::string>& HDKeyring::GetDerivedAddresses() const {
+  // Accounts are only ever appended or popped from the back, so any accounts
+  // past the cached prefix are the only ones that need an address computed.
+  DCHECK_LE(derived_addresses_.size(), accounts_.size());
+  derived_addresses_.reserve(accounts_.size());
+  for (size_t i = derived_addresses_.size(); i < accounts_.size(); ++i) {
+    derived_addresses_.push_back(GetAddressInternal(accounts_[i].get()));
+  }
+  return derived_addresses_;
 }
 
 std::string HDKeyring::GetDiscoveryAddress(size_t index) const {
@@ -120,19 +136,16 @@ HDKeyBase* HDKeyring::GetHDKeyFromAddress(const std::string& address) {
   const auto imported_accounts_iter = imported_accounts_.find(address);
   if (imported_accounts_iter != imported_accounts_.end())
     return imported_accounts_iter->second.get();
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
+  const auto& addresses = GetDerivedAddresses();
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    if (addresses[i] == address)
       return accounts_[i].get();
   }
   return nullptr;
 }
 
 bool HDKeyring::HasAddress(const std::string& address) {
-  for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return true;
-  }
-  return false;
+  return base::Contains(GetDerivedAddresses(), address);
 }
 
 bool HDKeyring::HasImportedAddress(const std::string& address) {
@@ -68,9 +68,13 @@ class HDKeyring {
   bool AddImportedAddress(const std::string& address,
                           std::unique_ptr<HDKeyBase> hd_key);
   HDKeyBase* GetHDKeyFromAddress(const std::string& address);
+  // Addresses of |accounts_|, by index. Computed on first use and cached for
+  // as long as the keyring lives, i.e. until it is locked.
+  const std::vector<std::string>& GetDerivedAddresses() const;
 
   std::unique_ptr<HDKeyBase> root_;
   std::vector<std::unique_ptr<HDKeyBase>> accounts_;
+  mutable std::vector<std::string> derived_addresses_;
   // TODO(apaymyshev): make separate abstraction for imported keys as they are
   // not HD keys.
   // (address, key)
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 
+#include <algorithm>
 #include <memory>
 #include <unordered_set>
 #include <utility>
@@ -12,10 +13,12 @@
 #include "base/base64.h"
 #include "base/feature_list.h"
 #include "base/functional/bind.h"
+#include "base/json/json_reader.h"
 #include "base/no_destructor.h"
 #include "base/notreached.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/sequenced_task_runner.h"
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
@@ -119,6 +122,11 @@ net::NetworkTrafficAnnotationTag GetENSOffchainNetworkTrafficAnnotationTag() {
     )");
 }
 
+bool JsonRpcBatchingEnabled() {
+  return base::FeatureList::IsEnabled(
+      brave_wallet::features::kBraveWalletJsonRpcBatchingFeature);
+}
+
 bool EnsL2FeatureEnabled() {
   return base::FeatureList::IsEnabled(
       brave_wallet::features::kBraveWalletENSL2Feature);
@@ -350,6 +358,14 @@ void JsonRpcService::AddObserver(
   observers_.Add(std::move(observer));
 }
 
+JsonRpcService::PendingJsonRpcBatch::PendingJsonRpcBatch() = default;
+JsonRpcService::PendingJsonRpcBatch::PendingJsonRpcBatch(
+    PendingJsonRpcBatch&&) = default;
+JsonRpcService::PendingJsonRpcBatch&
+JsonRpcService::PendingJsonRpcBatch::operator=(PendingJsonRpcBatch&&) =
+    default;
+JsonRpcService::PendingJsonRpcBatch::~PendingJsonRpcBatch() = default;
+
 void JsonRpcService::RequestInternal(
     const std::string& json_payload,
     bool auto_retry_on_network_change,
@@ -359,6 +375,28 @@ void JsonRpcService::RequestInternal(
         base::NullCallback()) {
   DCHECK(network_url.is_valid());
 
+  // Conversion callbacks rewrite the raw response body of a single call, so
+  // those calls are always sent on their own.
+  if (JsonRpcBatchingEnabled() && auto_retry_on_network_change &&
+      !conversion_callback && GetJsonRpcBatchLimit(network_url) > 1) {
+    auto request = base::JSONReader::Read(json_payload);
+    if (request && request->is_dict()) {
+      EnqueueJsonRpcBatchRequest(network_url, std::move(request->GetDict()),
+                                 std::move(callback));
+      return;
+    }
+  }
+
+  SendRequest(json_payload, auto_retry_on_network_change, network_url,
+              std::move(callback), std::move(conversion_callback));
+}
+
+void JsonRpcService::SendRequest(
+    const std::string& json_payload,
+    bool auto_retry_on_network_change,
+    const GURL& network_url,
+    RequestIntermediateCallback callback,
+    APIRequestHelper::ResponseConversionCallback conversion_callback) {
   api_request_helper_->Request("POST", network_url, json_payload,
                                "application/json", auto_retry_on_network_change,
                                std::move(callback),
@@ -366,6 +404,121 @@ void JsonRpcService::RequestInternal(
                                std::move(conversion_callback));
 }
 
+void JsonRpcService::SetJsonRpcBatchLimit(const GURL& network_url,
+                                          size_t limit) {
+  json_rpc_batch_limits_[network_url] = limit;
+}
+
+size_t JsonRpcService::GetJsonRpcBatchLimit(const GURL& network_url) const {
+  auto it = json_rpc_batch_limits_.find(network_url);
+  if (it != json_rpc_batch_limits_.end()) {
+    return it->second;
+  }
+  return std::max(features::kJsonRpcBatchMaxSize.Get(), 1);
+}
+
+void JsonRpcService::EnqueueJsonRpcBatchRequest(
+    const GURL& network_url,
+    base::Value::Dict request,
+    RequestIntermediateCallback callback) {
+  auto& batch = pending_json_rpc_batches_[network_url];
+  // Ids are rewritten to the position in the batch to match responses, which
+  // may come back in any order.
+  batch.ids.push_back(
+      request.Extract("id").value_or(base::Value(base::Value::Type::NONE)));
+  request.Set("id", static_cast<int>(batch.payload.size()));
+  batch.payload.Append(std::move(request));
+  batch.callbacks.push_back(std::move(callback));
+
+  if (batch.payload.size() >= GetJsonRpcBatchLimit(network_url)) {
+    FlushJsonRpcBatch(network_url);
+    return;
+  }
+
+  if (!json_rpc_batch_flush_scheduled_) {
+    json_rpc_batch_flush_scheduled_ = true;
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&JsonRpcService::FlushJsonRpcBatches,
+                                  weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void JsonRpcService::FlushJsonRpcBatches() {
+  json_rpc_batch_flush_scheduled_ = false;
+  while (!pending_json_rpc_batches_.empty()) {
+    const GURL network_url = pending_json_rpc_batches_.begin()->first;
+    FlushJsonRpcBatch(network_url);
+  }
+}
+
+void JsonRpcService::FlushJsonRpcBatch(const GURL& network_url) {
+  auto it = pending_json_rpc_batches_.find(network_url);
+  if (it == pending_json_rpc_batches_.end()) {
+    return;
+  }
+  PendingJsonRpcBatch batch = std::move(it->second);
+  pending_json_rpc_batches_.erase(it);
+
+  if (batch.payload.size() == 1) {
+    // A lone call is sent as a plain request with its own id.
+    base::Value::Dict& request = batch.payload.front().GetDict();
+    request.Set("id", std::move(batch.ids.front()));
+    SendRequest(GetJSON(request), true, network_url,
+                std::move(batch.callbacks.front()), base::NullCallback());
+    return;
+  }
+
+  SendRequest(GetJSON(batch.payload), true, network_url,
+              base::BindOnce(&JsonRpcService::OnJsonRpcBatchResponse,
+                             std::move(batch.ids), std::move(batch.callbacks)),
+              base::NullCallback());
+}
+
+// static
+void JsonRpcService::OnJsonRpcBatchResponse(
+    std::vector<base::Value> ids,
+    std::vector<RequestIntermediateCallback> callbacks,
+    APIRequestResult api_request_result) {
+  std::vector<base::Value> responses(callbacks.size());
+  if (api_request_result.Is2XXResponseCode() &&
+      api_request_result.value_body().is_list()) {
+    for (const auto& response : api_request_result.value_body().GetList()) {
+      if (!response.is_dict()) {
+        continue;
+      }
+      auto index = response.GetDict().FindInt("id");
+      if (!index || *index < 0 ||
+          static_cast<size_t>(*index) >= responses.size()) {
+        continue;
+      }
+      responses[*index] = response.Clone();
+      responses[*index].GetDict().Set("id", std::move(ids[*index]));
+    }
+  }
+
+  for (size_t i = 0; i < callbacks.size(); ++i) {
+    // Calls left out of the response, or a failed batch, get the result of
+    // the whole request so they surface the same error.
+    if (responses[i].is_none()) {
+      std::move(callbacks[i])
+          .Run(APIRequestResult(api_request_result.response_code(),
+                                api_request_result.body(),
+                                api_request_result.value_body().Clone(),
+                                api_request_result.headers(),
+                                api_request_result.error_code(),
+                                api_request_result.final_url()));
+      continue;
+    }
+    std::string body = GetJSON(responses[i]);
+    std::move(callbacks[i])
+        .Run(APIRequestResult(api_request_result.response_code(),
+                              std::move(body), std::move(responses[i]),
+                              api_request_result.headers(),
+                              api_request_result.error_code(),
+                              api_request_result.final_url()));
+  }
+}
+
 void JsonRpcService::Request(const std::string& json_payload,
                              bool auto_retry_on_network_change,
                              base::Value id,
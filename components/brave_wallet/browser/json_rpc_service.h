@@ -384,6 +384,10 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void SetAPIRequestHelperForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Overrides the maximum number of calls sent in one JSON-RPC batch to
+  // |network_url|. A limit of 1 disables batching for that network.
+  void SetJsonRpcBatchLimit(const GURL& network_url, size_t limit);
+
   // Solana JSON RPCs
   void GetSolanaBalance(const std::string& pubkey,
                         const std::string& chain_id,
@@ -545,6 +549,38 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const GURL& network_url,
       RequestIntermediateCallback callback,
       APIRequestHelper::ResponseConversionCallback conversion_callback);
+  void SendRequest(
+      const std::string& json_payload,
+      bool auto_retry_on_network_change,
+      const GURL& network_url,
+      RequestIntermediateCallback callback,
+      APIRequestHelper::ResponseConversionCallback conversion_callback);
+
+  // Calls queued for the next JSON-RPC batch to one network. Calls made
+  // during the same task are sent together once it finishes, or as soon as
+  // the batch reaches the network's limit.
+  struct PendingJsonRpcBatch {
+    PendingJsonRpcBatch();
+    PendingJsonRpcBatch(PendingJsonRpcBatch&&);
+    PendingJsonRpcBatch& operator=(PendingJsonRpcBatch&&);
+    ~PendingJsonRpcBatch();
+
+    base::Value::List payload;
+    // Ids the callers used, restored on the split responses.
+    std::vector<base::Value> ids;
+    std::vector<RequestIntermediateCallback> callbacks;
+  };
+  size_t GetJsonRpcBatchLimit(const GURL& network_url) const;
+  void EnqueueJsonRpcBatchRequest(const GURL& network_url,
+                                  base::Value::Dict request,
+                                  RequestIntermediateCallback callback);
+  void FlushJsonRpcBatches();
+  void FlushJsonRpcBatch(const GURL& network_url);
+  static void OnJsonRpcBatchResponse(
+      std::vector<base::Value> ids,
+      std::vector<RequestIntermediateCallback> callbacks,
+      APIRequestResult api_request_result);
+
   void OnEthChainIdValidatedForOrigin(const std::string& chain_id,
                                       const GURL& rpc_url,
                                       APIRequestResult api_request_result);
@@ -602,6 +638,9 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   std::unique_ptr<APIRequestHelper> api_request_helper_;
   std::unique_ptr<APIRequestHelper> api_request_helper_ens_offchain_;
   base::flat_map<mojom::CoinType, GURL> network_urls_;
+  base::flat_map<GURL, PendingJsonRpcBatch> pending_json_rpc_batches_;
+  base::flat_map<GURL, size_t> json_rpc_batch_limits_;
+  bool json_rpc_batch_flush_scheduled_ = false;
   // <mojom::CoinType, chain_id>
   base::flat_map<mojom::CoinType, std::string> chain_ids_;
   // <chain_id, mojom::AddChainRequest>
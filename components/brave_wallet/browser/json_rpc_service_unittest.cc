@@ -13,6 +13,7 @@
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 
 #include "base/base64.h"
+#include "base/containers/adapters.h"
 #include "base/containers/span.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
@@ -20,6 +21,7 @@
 #include "base/json/json_writer.h"
 #include "base/notreached.h"
 #include "base/ranges/algorithm.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/mock_callback.h"
@@ -30,6 +32,7 @@
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/ens_resolver_task.h"
+#include "brave/components/brave_wallet/browser/json_rpc_requests_helper.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service_test_utils.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/browser/sns_resolver_task.h"
@@ -2451,6 +2454,92 @@ TEST_F(JsonRpcServiceUnitTest, GetBalance) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(JsonRpcServiceUnitTest, BatchesJsonRpcCalls) {
+  base::test::ScopedFeatureList feature_list(
+      features::kBraveWalletJsonRpcBatchingFeature);
+  const GURL network_url =
+      GetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH);
+  size_t http_requests = 0;
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        ++http_requests;
+        auto payload = ToValue(request);
+        ASSERT_TRUE(payload);
+        // Each call is answered with its address as the balance. Batch
+        // responses come back in reverse order.
+        auto respond = [](const base::Value::Dict& call) {
+          base::Value::Dict response;
+          response.Set("jsonrpc", "2.0");
+          response.Set("id", call.Find("id")->Clone());
+          response.Set("result",
+                       call.FindList("params")->front().GetString());
+          return response;
+        };
+        if (payload->is_dict()) {
+          url_loader_factory_.AddResponse(
+              request.url.spec(), GetJSON(respond(payload->GetDict())));
+          return;
+        }
+        base::Value::List responses;
+        for (const auto& call : base::Reversed(payload->GetList())) {
+          responses.Append(respond(call.GetDict()));
+        }
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetJSON(responses));
+      }));
+
+  constexpr size_t kAccounts = 25;
+  auto get_balances = [&] {
+    http_requests = 0;
+    size_t callbacks_called = 0;
+    for (size_t i = 0; i < kAccounts; ++i) {
+      const std::string address =
+          base::StringPrintf("0x4e02f254184e904300e0775e4b8eecb1%06zx", i);
+      json_rpc_service_->GetBalance(
+          address, mojom::CoinType::ETH, mojom::kMainnetChainId,
+          base::BindLambdaForTesting([&, address](const std::string& balance,
+                                                  mojom::ProviderError error,
+                                                  const std::string&) {
+            EXPECT_EQ(error, mojom::ProviderError::kSuccess);
+            EXPECT_EQ(balance, address);
+            ++callbacks_called;
+          }));
+    }
+    base::RunLoop().RunUntilIdle();
+    EXPECT_EQ(callbacks_called, kAccounts);
+  };
+
+  // Calls made in the same task share requests of up to 10 calls each.
+  get_balances();
+  EXPECT_EQ(http_requests, 3u);
+
+  json_rpc_service_->SetJsonRpcBatchLimit(network_url, 1);
+  get_balances();
+  EXPECT_EQ(http_requests, kAccounts);
+}
+
+TEST_F(JsonRpcServiceUnitTest, JsonRpcBatchFailureReachesEveryCall) {
+  base::test::ScopedFeatureList feature_list(
+      features::kBraveWalletJsonRpcBatchingFeature);
+  SetHTTPRequestTimeoutInterceptor();
+  bool first_callback_called = false;
+  bool second_callback_called = false;
+  for (bool* callback_called :
+       {&first_callback_called, &second_callback_called}) {
+    json_rpc_service_->GetBalance(
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+        mojom::kMainnetChainId,
+        base::BindOnce(&OnStringResponse, callback_called,
+                       mojom::ProviderError::kInternalError,
+                       l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR),
+                       ""));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(first_callback_called);
+  EXPECT_TRUE(second_callback_called);
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetFeeHistory) {
   std::string json =
       R"(
@@ -8,15 +8,18 @@
 #include <string>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/check_op.h"
 #include "base/command_line.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/notreached.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/bitcoin_keyring.h"
@@ -215,6 +218,22 @@ int GetPbkdf2Iterations() {
       kPbkdf2Iterations);
 }
 
+// Label of the legacy key derived for |keyring_id| during PBKDF2 iterations
+// migration. The key derived with current iterations is labeled with the
+// keyring id itself.
+std::string GetLegacyKeyLabel(const std::string& keyring_id) {
+  return keyring_id + ".legacy";
+}
+
+std::pair<std::string, std::unique_ptr<PasswordEncryptor>> DeriveEncryptor(
+    const std::string& password,
+    const std::string& label,
+    const std::vector<uint8_t>& salt,
+    int iterations) {
+  return {label, PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+                     password, salt, iterations, kPbkdf2KeySize)};
+}
+
 const base::Value::List* GetPrefForKeyringList(const PrefService& profile_prefs,
                                                const std::string& key,
                                                const std::string& id) {
@@ -484,6 +503,50 @@ KeyringService::~KeyringService() {
 }
 
 // static
+KeyringService::Pbkdf2Request::Pbkdf2Request(std::string label,
+                                             std::vector<uint8_t> salt,
+                                             int iterations)
+    : label(std::move(label)), salt(std::move(salt)), iterations(iterations) {}
+KeyringService::Pbkdf2Request::Pbkdf2Request(const Pbkdf2Request&) = default;
+KeyringService::Pbkdf2Request& KeyringService::Pbkdf2Request::operator=(
+    const Pbkdf2Request&) = default;
+KeyringService::Pbkdf2Request::Pbkdf2Request(Pbkdf2Request&&) = default;
+KeyringService::Pbkdf2Request& KeyringService::Pbkdf2Request::operator=(
+    Pbkdf2Request&&) = default;
+KeyringService::Pbkdf2Request::~Pbkdf2Request() = default;
+
+// static
+void KeyringService::DeriveEncryptorsInParallel(
+    const std::string& password,
+    std::vector<Pbkdf2Request> requests,
+    base::OnceCallback<void(DerivedEncryptors)> callback) {
+  using DerivedEncryptor =
+      std::pair<std::string, std::unique_ptr<PasswordEncryptor>>;
+  auto barrier = base::BarrierCallback<DerivedEncryptor>(
+      requests.size(),
+      base::BindOnce(
+          [](base::OnceCallback<void(DerivedEncryptors)> callback,
+             std::vector<DerivedEncryptor> results) {
+            DerivedEncryptors encryptors;
+            for (auto& result : results) {
+              encryptors[result.first] = std::move(result.second);
+            }
+            std::move(callback).Run(std::move(encryptors));
+          },
+          std::move(callback)));
+  // Each derivation takes hundreds of milliseconds, so they run as separate
+  // tasks to let the thread pool spread them over cores.
+  for (auto& request : requests) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::TaskPriority::USER_BLOCKING,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(&DeriveEncryptor, password, std::move(request.label),
+                       std::move(request.salt), request.iterations),
+        barrier);
+  }
+}
+
 absl::optional<int>& KeyringService::GetPbkdf2IterationsForTesting() {
   static absl::optional<int> iterations;
   return iterations;
@@ -604,6 +667,23 @@ HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id,
     return nullptr;
   }
 
+  return ResumeKeyringInternal(keyring_id);
+}
+
+HDKeyring* KeyringService::ResumeKeyringWithEncryptor(
+    const std::string& keyring_id,
+    std::unique_ptr<PasswordEncryptor> encryptor) {
+  encryptors_[keyring_id] = std::move(encryptor);
+  if (!encryptors_[keyring_id]) {
+    return nullptr;
+  }
+
+  return ResumeKeyringInternal(keyring_id);
+}
+
+HDKeyring* KeyringService::ResumeKeyringInternal(
+    const std::string& keyring_id) {
+  DCHECK(encryptors_[keyring_id]);
   const std::string mnemonic = GetMnemonicForKeyringImpl(keyring_id);
   if (mnemonic.empty()) {
     return nullptr;
@@ -1717,8 +1797,16 @@ void KeyringService::AddAccountsWithDefaultName(size_t number) {
 
   size_t current_num = GetDerivedAccountsNumberForKeyring(
       profile_prefs_, mojom::kDefaultKeyringId);
-  for (size_t i = current_num + 1; i <= current_num + number; ++i) {
-    AddAccountForKeyring(mojom::kDefaultKeyringId, GetAccountName(i));
+  // Derive all accounts in one pass so their addresses land in the keyring's
+  // address cache together, then persist them.
+  const auto added_accounts = keyring->AddAccounts(number);
+  for (size_t i = 0; i < added_accounts.size(); ++i) {
+    SetDerivedAccountInfoForKeyring(
+        profile_prefs_,
+        DerivedAccountInfo(added_accounts[i].path,
+                           GetAccountName(current_num + i + 1),
+                           added_accounts[i].address),
+        mojom::kDefaultKeyringId);
   }
 }
 
@@ -1781,6 +1869,7 @@ absl::optional<std::string> KeyringService::GetFilecoinSelectedAccount(
 }
 
 void KeyringService::Lock() {
+  CancelPendingUnlock();
   if (IsLockedSync()) {
     return;
   }
@@ -1808,45 +1897,135 @@ bool KeyringService::IsHardwareAccount(const std::string& keyring_id,
 
 void KeyringService::Unlock(const std::string& password,
                             KeyringService::UnlockCallback callback) {
-  if (!ResumeKeyring(mojom::kDefaultKeyringId, password)) {
-    encryptors_.erase(mojom::kDefaultKeyringId);
+  if (password.empty()) {
     std::move(callback).Run(false);
     return;
   }
+  // Only one unlock derives keys at a time. Unlocks with the same password
+  // share its result, others are started once it is done.
+  if (!pending_unlock_callbacks_.empty()) {
+    if (password == pending_unlock_password_) {
+      pending_unlock_callbacks_.push_back(std::move(callback));
+    } else {
+      queued_unlocks_.emplace_back(password, std::move(callback));
+    }
+    return;
+  }
+  pending_unlock_password_ = password;
+  pending_unlock_callbacks_.push_back(std::move(callback));
+
+  // Added 08.08.2022
+  if (!profile_prefs_->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated)) {
+    auto requests = GetPbkdf2MigrationRequests();
+    DeriveEncryptorsInParallel(
+        password, requests,
+        base::BindOnce(&KeyringService::OnPbkdf2MigrationEncryptorsDerived,
+                       unlock_weak_factory_.GetWeakPtr(), password, requests));
+    return;
+  }
+
+  DeriveUnlockEncryptors(password);
+}
+
+void KeyringService::OnPbkdf2MigrationEncryptorsDerived(
+    const std::string& password,
+    const std::vector<Pbkdf2Request>& requests,
+    DerivedEncryptors encryptors) {
+  if (!profile_prefs_->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated)) {
+    ApplyPbkdf2Migration(requests, std::move(encryptors));
+  }
+  DeriveUnlockEncryptors(password);
+}
+
+void KeyringService::DeriveUnlockEncryptors(const std::string& password) {
+  std::vector<std::string> keyring_ids = {mojom::kDefaultKeyringId};
+  if (IsFilecoinEnabled()) {
+    keyring_ids.push_back(mojom::kFilecoinKeyringId);
+    keyring_ids.push_back(mojom::kFilecoinTestnetKeyringId);
+  }
+  if (IsSolanaEnabled()) {
+    keyring_ids.push_back(mojom::kSolanaKeyringId);
+  }
+  if (IsBitcoinEnabled()) {
+    keyring_ids.push_back(mojom::kBitcoinKeyringId);
+  }
+
+  std::vector<Pbkdf2Request> requests;
+  for (const auto& keyring_id : keyring_ids) {
+    requests.emplace_back(keyring_id, GetOrCreateSaltForKeyring(keyring_id),
+                          GetPbkdf2Iterations());
+  }
+  DeriveEncryptorsInParallel(
+      password, std::move(requests),
+      base::BindOnce(&KeyringService::OnUnlockEncryptorsDerived,
+                     unlock_weak_factory_.GetWeakPtr()));
+}
+
+void KeyringService::OnUnlockEncryptorsDerived(DerivedEncryptors encryptors) {
+  DCHECK(!pending_unlock_callbacks_.empty());
+  const bool success = ResumeKeyringsWithEncryptors(std::move(encryptors));
+  pending_unlock_password_.clear();
+  std::vector<UnlockCallback> callbacks;
+  callbacks.swap(pending_unlock_callbacks_);
+  std::vector<std::pair<std::string, UnlockCallback>> queued_unlocks;
+  queued_unlocks.swap(queued_unlocks_);
+
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(success);
+  }
+  for (auto& [password, callback] : queued_unlocks) {
+    Unlock(password, std::move(callback));
+  }
+}
+
+bool KeyringService::ResumeKeyringsWithEncryptors(
+    DerivedEncryptors encryptors) {
+  if (!ResumeKeyringWithEncryptor(
+          mojom::kDefaultKeyringId,
+          std::move(encryptors[mojom::kDefaultKeyringId]))) {
+    encryptors_.erase(mojom::kDefaultKeyringId);
+    return false;
+  }
 
   if (IsFilecoinEnabled()) {
-    if (!ResumeKeyring(mojom::kFilecoinKeyringId, password)) {
+    if (!ResumeKeyringWithEncryptor(
+            mojom::kFilecoinKeyringId,
+            std::move(encryptors[mojom::kFilecoinKeyringId]))) {
       // If Filecoin keyring doesnt exist we keep encryptor pre-created
       // to be able to lazily create keyring later
       if (IsKeyringExist(mojom::kFilecoinKeyringId)) {
         VLOG(1) << __func__ << " Unable to unlock filecoin keyring";
         encryptors_.erase(mojom::kFilecoinKeyringId);
-        std::move(callback).Run(false);
-        return;
+        return false;
       }
     }
 
-    if (!ResumeKeyring(mojom::kFilecoinTestnetKeyringId, password)) {
+    if (!ResumeKeyringWithEncryptor(
+            mojom::kFilecoinTestnetKeyringId,
+            std::move(encryptors[mojom::kFilecoinTestnetKeyringId]))) {
       if (IsKeyringExist(mojom::kFilecoinTestnetKeyringId)) {
         VLOG(1) << __func__ << " Unable to unlock filecoin testnet keyring";
         encryptors_.erase(mojom::kFilecoinTestnetKeyringId);
-        std::move(callback).Run(false);
-        return;
+        return false;
       }
     }
   }
 
-  if (IsSolanaEnabled() && !ResumeKeyring(mojom::kSolanaKeyringId, password)) {
+  if (IsSolanaEnabled() &&
+      !ResumeKeyringWithEncryptor(
+          mojom::kSolanaKeyringId,
+          std::move(encryptors[mojom::kSolanaKeyringId]))) {
     if (IsKeyringExist(mojom::kSolanaKeyringId)) {
       VLOG(1) << __func__ << " Unable to unlock Solana keyring";
       encryptors_.erase(mojom::kSolanaKeyringId);
-      std::move(callback).Run(false);
-      return;
+      return false;
     }
   }
 
   if (IsBitcoinEnabled()) {
-    auto* bitcoin_keyring = ResumeKeyring(mojom::kBitcoinKeyringId, password);
+    auto* bitcoin_keyring = ResumeKeyringWithEncryptor(
+        mojom::kBitcoinKeyringId,
+        std::move(encryptors[mojom::kBitcoinKeyringId]));
     DCHECK(bitcoin_keyring);
   }
 
@@ -1856,8 +2035,22 @@ void KeyringService::Unlock(const std::string& password,
     observer->Unlocked();
   }
   ResetAutoLockTimer();
+  return true;
+}
 
-  std::move(callback).Run(true);
+void KeyringService::CancelPendingUnlock() {
+  unlock_weak_factory_.InvalidateWeakPtrs();
+  pending_unlock_password_.clear();
+  std::vector<UnlockCallback> callbacks;
+  callbacks.swap(pending_unlock_callbacks_);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(false);
+  }
+  std::vector<std::pair<std::string, UnlockCallback>> queued_unlocks;
+  queued_unlocks.swap(queued_unlocks_);
+  for (auto& queued_unlock : queued_unlocks) {
+    std::move(queued_unlock.second).Run(false);
+  }
 }
 
 void KeyringService::OnAutoLockFired() {
@@ -1869,6 +2062,7 @@ void KeyringService::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringService::Reset(bool notify_observer) {
+  CancelPendingUnlock();
   StopAutoLockTimer();
   encryptors_.clear();
   keyrings_.clear();
@@ -1890,6 +2084,21 @@ void KeyringService::MaybeMigratePBKDF2Iterations(const std::string& password) {
   DCHECK(
       !profile_prefs_->HasPrefPath(kBraveWalletKeyringEncryptionKeysMigrated));
 
+  const auto requests = GetPbkdf2MigrationRequests();
+  DerivedEncryptors encryptors;
+  for (const auto& request : requests) {
+    encryptors.insert(DeriveEncryptor(password, request.label, request.salt,
+                                      request.iterations));
+  }
+  ApplyPbkdf2Migration(requests, std::move(encryptors));
+}
+
+std::vector<KeyringService::Pbkdf2Request>
+KeyringService::GetPbkdf2MigrationRequests() const {
+  // For each keyring still encrypted with legacy iterations, one key is
+  // derived from the stored salt to decrypt and one from a new salt with
+  // current iterations to re-encrypt. Both are independent of each other.
+  std::vector<Pbkdf2Request> requests;
   for (auto* keyring_id :
        {mojom::kDefaultKeyringId, mojom::kFilecoinKeyringId,
         mojom::kFilecoinTestnetKeyringId, mojom::kSolanaKeyringId}) {
@@ -1904,9 +2113,36 @@ void KeyringService::MaybeMigratePBKDF2Iterations(const std::string& password) {
       continue;
     }
 
-    auto legacy_encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-        password, *legacy_salt, kPbkdf2IterationsLegacy, kPbkdf2KeySize);
-    if (!legacy_encryptor) {
+    requests.emplace_back(GetLegacyKeyLabel(keyring_id),
+                          std::move(*legacy_salt), kPbkdf2IterationsLegacy);
+    std::vector<uint8_t> salt(kSaltSize);
+    crypto::RandBytes(salt);
+    requests.emplace_back(keyring_id, std::move(salt), GetPbkdf2Iterations());
+  }
+  return requests;
+}
+
+void KeyringService::ApplyPbkdf2Migration(
+    const std::vector<Pbkdf2Request>& requests,
+    DerivedEncryptors encryptors) {
+  for (const auto& request : requests) {
+    // Legacy keys are looked up through the request for the current key.
+    const std::string& keyring_id = request.label;
+    auto legacy_encryptor_it = encryptors.find(GetLegacyKeyLabel(keyring_id));
+    if (legacy_encryptor_it == encryptors.end()) {
+      continue;
+    }
+    PasswordEncryptor* legacy_encryptor = legacy_encryptor_it->second.get();
+    PasswordEncryptor* encryptor = encryptors[keyring_id].get();
+    if (!legacy_encryptor || !encryptor) {
+      continue;
+    }
+
+    auto legacy_encrypted_mnemonic = GetPrefInBytesForKeyring(
+        *profile_prefs_, kEncryptedMnemonic, keyring_id);
+    auto legacy_nonce = GetPrefInBytesForKeyring(
+        *profile_prefs_, kPasswordEncryptorNonce, keyring_id);
+    if (!legacy_encrypted_mnemonic || !legacy_nonce) {
       continue;
     }
 
@@ -1916,13 +2152,8 @@ void KeyringService::MaybeMigratePBKDF2Iterations(const std::string& password) {
       continue;
     }
 
-    auto salt = GetOrCreateSaltForKeyring(keyring_id, /*force_create = */ true);
-
-    auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-        password, salt, GetPbkdf2Iterations(), kPbkdf2KeySize);
-    if (!encryptor) {
-      continue;
-    }
+    SetPrefInBytesForKeyring(profile_prefs_, kPasswordEncryptorSalt,
+                             request.salt, keyring_id);
 
     auto nonce =
         GetOrCreateNonceForKeyring(keyring_id, /*force_create = */ true);
@@ -2390,8 +2621,6 @@ bool KeyringService::ValidatePasswordInternal(const std::string& password) {
           ? GetPbkdf2Iterations()
           : kPbkdf2IterationsLegacy;
 
-  // TODO(apaymyshev): move this call(and other ones in this file) to
-  // background thread.
   auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
       password, *salt, iterations, kPbkdf2KeySize);
 
@@ -2405,7 +2634,44 @@ bool KeyringService::ValidatePasswordInternal(const std::string& password) {
 
 void KeyringService::ValidatePassword(const std::string& password,
                                       ValidatePasswordCallback callback) {
-  std::move(callback).Run(ValidatePasswordInternal(password));
+  const std::string keyring_id = mojom::kDefaultKeyringId;
+
+  auto salt = GetPrefInBytesForKeyring(*profile_prefs_, kPasswordEncryptorSalt,
+                                       keyring_id);
+  auto encrypted_mnemonic =
+      GetPrefInBytesForKeyring(*profile_prefs_, kEncryptedMnemonic, keyring_id);
+  auto nonce = GetPrefInBytesForKeyring(*profile_prefs_,
+                                        kPasswordEncryptorNonce, keyring_id);
+
+  if (password.empty() || !salt || !encrypted_mnemonic || !nonce) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  auto iterations =
+      profile_prefs_->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated)
+          ? GetPbkdf2Iterations()
+          : kPbkdf2IterationsLegacy;
+
+  std::vector<Pbkdf2Request> requests;
+  requests.emplace_back(keyring_id, std::move(*salt), iterations);
+  DeriveEncryptorsInParallel(
+      password, std::move(requests),
+      base::BindOnce(
+          [](const std::string& keyring_id,
+             const std::vector<uint8_t>& encrypted_mnemonic,
+             const std::vector<uint8_t>& nonce,
+             ValidatePasswordCallback callback, DerivedEncryptors encryptors) {
+            auto& encryptor = encryptors[keyring_id];
+            if (!encryptor) {
+              std::move(callback).Run(false);
+              return;
+            }
+            auto mnemonic = encryptor->Decrypt(encrypted_mnemonic, nonce);
+            std::move(callback).Run(mnemonic && !mnemonic->empty());
+          },
+          keyring_id, std::move(*encrypted_mnemonic), std::move(*nonce),
+          std::move(callback)));
 }
 
 void KeyringService::GetChecksumEthAddress(
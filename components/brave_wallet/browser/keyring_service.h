@@ -8,8 +8,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/functional/callback.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -237,6 +240,23 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
       uint32_t change_index);
 
  private:
+  // A PBKDF2 key derivation to run on the thread pool. |label| identifies its
+  // result among derivations running in parallel.
+  struct Pbkdf2Request {
+    Pbkdf2Request(std::string label, std::vector<uint8_t> salt, int iterations);
+    Pbkdf2Request(const Pbkdf2Request&);
+    Pbkdf2Request& operator=(const Pbkdf2Request&);
+    Pbkdf2Request(Pbkdf2Request&&);
+    Pbkdf2Request& operator=(Pbkdf2Request&&);
+    ~Pbkdf2Request();
+
+    std::string label;
+    std::vector<uint8_t> salt;
+    int iterations;
+  };
+  using DerivedEncryptors =
+      base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>;
+
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, GetOrCreateNonceForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, GetOrCreateSaltForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, CreateEncryptorForKeyring);
@@ -251,9 +271,12 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockAndUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, Reset);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockAndResetDuringUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, AccountMetasForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, CreateAndRestoreWallet);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, AddAccount);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
+                           RestoreWith100AccountsPerCoin);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, ImportedAccounts);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
                            SetDefaultKeyringDerivedAccountMeta);
@@ -355,8 +378,32 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeKeyring(const std::string& keyring_id,
                            const std::string& password);
+  HDKeyring* ResumeKeyringWithEncryptor(
+      const std::string& keyring_id,
+      std::unique_ptr<PasswordEncryptor> encryptor);
+  HDKeyring* ResumeKeyringInternal(const std::string& keyring_id);
+
+  // Derives keys for all |requests| on the thread pool and runs |callback|
+  // with the results keyed by request label once all of them are done.
+  static void DeriveEncryptorsInParallel(
+      const std::string& password,
+      std::vector<Pbkdf2Request> requests,
+      base::OnceCallback<void(DerivedEncryptors)> callback);
+  void OnPbkdf2MigrationEncryptorsDerived(
+      const std::string& password,
+      const std::vector<Pbkdf2Request>& requests,
+      DerivedEncryptors encryptors);
+  void DeriveUnlockEncryptors(const std::string& password);
+  void OnUnlockEncryptorsDerived(DerivedEncryptors encryptors);
+  bool ResumeKeyringsWithEncryptors(DerivedEncryptors encryptors);
+  // Drops the keys being derived for a pending unlock, so a lock or reset
+  // isn't undone when they are ready, and fails its callback.
+  void CancelPendingUnlock();
 
   void MaybeMigratePBKDF2Iterations(const std::string& password);
+  std::vector<Pbkdf2Request> GetPbkdf2MigrationRequests() const;
+  void ApplyPbkdf2Migration(const std::vector<Pbkdf2Request>& requests,
+                            DerivedEncryptors encryptors);
 
   void NotifyAccountsChanged();
   void NotifyAccountsAdded(mojom::CoinType coin,
@@ -392,11 +439,17 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   raw_ptr<PrefService> profile_prefs_ = nullptr;
   raw_ptr<PrefService> local_state_ = nullptr;
   bool request_unlock_pending_ = false;
+  // Password and callbacks of the unlock waiting for its keys to be derived.
+  std::string pending_unlock_password_;
+  std::vector<UnlockCallback> pending_unlock_callbacks_;
+  // Unlocks with another password, started once the pending one is done.
+  std::vector<std::pair<std::string, UnlockCallback>> queued_unlocks_;
 
   mojo::RemoteSet<mojom::KeyringServiceObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringService> receivers_;
 
   base::WeakPtrFactory<KeyringService> discovery_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> unlock_weak_factory_{this};
 
   KeyringService(const KeyringService&) = delete;
   KeyringService& operator=(const KeyringService&) = delete;
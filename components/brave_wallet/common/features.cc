@@ -60,5 +60,11 @@ BASE_FEATURE(kBraveWalletBitcoinFeature,
              "BraveWalletBitcoin",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kBraveWalletJsonRpcBatchingFeature,
+             "BraveWalletJsonRpcBatching",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+const base::FeatureParam<int> kJsonRpcBatchMaxSize{
+    &kBraveWalletJsonRpcBatchingFeature, "max_batch_size", 10};
+
 }  // namespace features
 }  // namespace brave_wallet
@@ -24,6 +24,8 @@ BASE_DECLARE_FEATURE(kBraveWalletDappsSupportFeature);
 BASE_DECLARE_FEATURE(kBraveWalletENSL2Feature);
 BASE_DECLARE_FEATURE(kBraveWalletSnsFeature);
 BASE_DECLARE_FEATURE(kBraveWalletBitcoinFeature);
+BASE_DECLARE_FEATURE(kBraveWalletJsonRpcBatchingFeature);
+extern const base::FeatureParam<int> kJsonRpcBatchMaxSize;
 
 }  // namespace features
 }  // namespace brave_wallet
@@ -0,0 +1,140 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include <algorithm>
+
+#include "base/containers/contains.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+
+namespace content_settings {
+
+namespace {
+
+// Hosts that can't be split into labels, like IP literals, are not indexed
+// and their rules are checked for every lookup.
+bool IsIndexableHost(const std::string& host) {
+  return !host.empty() && !base::Contains(host, ':') &&
+         !base::Contains(host, '[') && !base::EndsWith(host, ".");
+}
+
+// Returns the position of the label that precedes |end| in |host|.
+size_t PreviousLabel(base::StringPiece host, size_t end) {
+  const size_t dot = host.rfind('.', end == 0 ? 0 : end - 1);
+  return dot == base::StringPiece::npos ? 0 : dot + 1;
+}
+
+}  // namespace
+
+ContentSettingsRulesIndex::Node::Node() = default;
+ContentSettingsRulesIndex::Node::Node(Node&&) = default;
+ContentSettingsRulesIndex::Node& ContentSettingsRulesIndex::Node::operator=(
+    Node&&) = default;
+ContentSettingsRulesIndex::Node::~Node() = default;
+
+ContentSettingsRulesIndex::ContentSettingsRulesIndex(
+    const ContentSettingsForOneType& rules)
+    : rules_(rules), nodes_(1), results_(kMaxCachedResults) {
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const ContentSettingsPattern& pattern = rules_[i].primary_pattern;
+    const std::string host = pattern.GetHost();
+    if (pattern.MatchesAllHosts() || !IsIndexableHost(host)) {
+      any_host_rules_.push_back(i);
+      continue;
+    }
+    Node& node = nodes_[GetOrAddNode(host)];
+    if (pattern.HasDomainWildcard()) {
+      node.domain_rules.push_back(i);
+    } else {
+      node.host_rules.push_back(i);
+    }
+  }
+}
+
+ContentSettingsRulesIndex::~ContentSettingsRulesIndex() = default;
+
+size_t ContentSettingsRulesIndex::GetOrAddNode(const std::string& host) {
+  size_t node = 0;
+  size_t end = host.size();
+  while (end > 0) {
+    const size_t begin = PreviousLabel(host, end);
+    std::string label = host.substr(begin, end - begin);
+    auto it = nodes_[node].children.find(label);
+    if (it == nodes_[node].children.end()) {
+      // Adding a node may reallocate |nodes_|, so look the parent up again.
+      nodes_.emplace_back();
+      it = nodes_[node]
+               .children.emplace(std::move(label), nodes_.size() - 1)
+               .first;
+    }
+    node = it->second;
+    end = begin == 0 ? 0 : begin - 1;
+  }
+  return node;
+}
+
+ContentSetting ContentSettingsRulesIndex::GetContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  auto key = std::make_pair(primary_url, secondary_url);
+  auto it = results_.Get(key);
+  if (it != results_.end()) {
+    return it->second;
+  }
+  const ContentSetting setting =
+      FindContentSetting(primary_url, secondary_url);
+  results_.Put(std::move(key), setting);
+  return setting;
+}
+
+ContentSetting ContentSettingsRulesIndex::FindContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  std::vector<size_t> candidates = any_host_rules_;
+
+  base::StringPiece host = primary_url.host_piece();
+  if (base::EndsWith(host, ".")) {
+    host.remove_suffix(1);
+  }
+  size_t node = 0;
+  size_t end = host.size();
+  bool reached_host = host.empty();
+  while (end > 0) {
+    const size_t begin = PreviousLabel(host, end);
+    const auto it = nodes_[node].children.find(
+        std::string(host.substr(begin, end - begin)));
+    if (it == nodes_[node].children.end()) {
+      break;
+    }
+    node = it->second;
+    const Node& current = nodes_[node];
+    candidates.insert(candidates.end(), current.domain_rules.begin(),
+                      current.domain_rules.end());
+    end = begin == 0 ? 0 : begin - 1;
+    reached_host = begin == 0;
+  }
+  if (reached_host && node != 0) {
+    const Node& current = nodes_[node];
+    candidates.insert(candidates.end(), current.host_rules.begin(),
+                      current.host_rules.end());
+  }
+
+  // The rules are ordered by precedence, so check the candidates in the same
+  // order to get the same answer as a linear walk.
+  base::ranges::sort(candidates);
+  for (size_t i : candidates) {
+    const ContentSettingPatternSource& rule = rules_[i];
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.GetContentSetting();
+    }
+  }
+  return CONTENT_SETTING_DEFAULT;
+}
+
+}  // namespace content_settings
@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+// Answers "which is the first rule matching these URLs" for a list of rules
+// without walking all of them. Rules are bucketed by the host of their
+// primary pattern in a trie of reversed host labels, so a lookup only checks
+// the rules for the primary URL's host, its parent domains' wildcard rules
+// and the rules that match any host. Results are memoized until the index is
+// rebuilt.
+class ContentSettingsRulesIndex {
+ public:
+  static constexpr size_t kMaxCachedResults = 256;
+
+  explicit ContentSettingsRulesIndex(const ContentSettingsForOneType& rules);
+  ~ContentSettingsRulesIndex();
+
+  ContentSettingsRulesIndex(const ContentSettingsRulesIndex&) = delete;
+  ContentSettingsRulesIndex& operator=(const ContentSettingsRulesIndex&) =
+      delete;
+
+  // Returns the setting of the first rule whose patterns match both URLs,
+  // the same as walking the rules in order, or CONTENT_SETTING_DEFAULT.
+  ContentSetting GetContentSetting(const GURL& primary_url,
+                                   const GURL& secondary_url);
+
+ private:
+  struct Node {
+    Node();
+    Node(Node&&);
+    Node& operator=(Node&&);
+    ~Node();
+
+    // Index into |nodes_| of the child for each next label.
+    base::flat_map<std::string, size_t> children;
+    // Rules whose primary host is exactly this node's host.
+    std::vector<size_t> host_rules;
+    // Rules for this node's host and all of its subdomains.
+    std::vector<size_t> domain_rules;
+  };
+
+  size_t GetOrAddNode(const std::string& host);
+  ContentSetting FindContentSetting(const GURL& primary_url,
+                                    const GURL& secondary_url) const;
+
+  ContentSettingsForOneType rules_;
+  // nodes_[0] is the root.
+  std::vector<Node> nodes_;
+  // Rules that are not keyed by a host, e.g. the default one.
+  std::vector<size_t> any_host_rules_;
+
+  base::LRUCache<std::pair<GURL, GURL>, ContentSetting> results_;
+};
+
+}  // namespace content_settings
+
+#endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_RULES_INDEX_H_
@@ -0,0 +1,107 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "ContentSettingsRulesIndex.";
+constexpr char kMetricBuildTime[] = "build_time";
+constexpr char kMetricTimePerLookup[] = "time_per_lookup";
+
+constexpr int kRules = 10000;
+constexpr int kLookups = 10000;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricBuildTime, "us");
+  reporter.RegisterImportantMetric(kMetricTimePerLookup, "us");
+  return reporter;
+}
+
+// Shields rules as the browser sends them: per-site exceptions followed by
+// the default rule.
+ContentSettingsForOneType MakeShieldsRules() {
+  ContentSettingsForOneType rules;
+  for (int i = 0; i < kRules; ++i) {
+    rules.emplace_back(
+        ContentSettingsPattern::FromString(
+            base::StringPrintf("[*.]site%d.com", i)),
+        ContentSettingsPattern::Wildcard(),
+        ContentSettingToValue(i % 2 ? CONTENT_SETTING_BLOCK
+                                    : CONTENT_SETTING_ALLOW),
+        std::string(), false);
+  }
+  rules.emplace_back(ContentSettingsPattern::Wildcard(),
+                     ContentSettingsPattern::Wildcard(),
+                     ContentSettingToValue(CONTENT_SETTING_ALLOW),
+                     std::string(), false);
+  return rules;
+}
+
+std::vector<GURL> MakeUrls() {
+  std::vector<GURL> urls;
+  for (int i = 0; i < kLookups; ++i) {
+    // About half of the lookups miss all the per-site rules.
+    urls.emplace_back(
+        base::StringPrintf("https://www.site%d.com/", i * 7 % (kRules * 2)));
+  }
+  return urls;
+}
+
+}  // namespace
+
+// The linear walk over the rules which the index replaces in the renderer.
+TEST(ContentSettingsRulesIndexPerfTest, LinearWalk) {
+  const ContentSettingsForOneType rules = MakeShieldsRules();
+  const std::vector<GURL> urls = MakeUrls();
+
+  base::ElapsedTimer timer;
+  int blocked = 0;
+  for (const GURL& url : urls) {
+    for (const auto& rule : rules) {
+      if (rule.primary_pattern.Matches(url) &&
+          rule.secondary_pattern.Matches(GURL())) {
+        blocked += rule.GetContentSetting() == CONTENT_SETTING_BLOCK;
+        break;
+      }
+    }
+  }
+  SetUpReporter("linear_10k_rules")
+      .AddResult(kMetricTimePerLookup, timer.Elapsed() / kLookups);
+  EXPECT_GT(blocked, 0);
+}
+
+TEST(ContentSettingsRulesIndexPerfTest, Index) {
+  const ContentSettingsForOneType rules = MakeShieldsRules();
+  const std::vector<GURL> urls = MakeUrls();
+  auto reporter = SetUpReporter("index_10k_rules");
+
+  base::ElapsedTimer build_timer;
+  ContentSettingsRulesIndex index(rules);
+  reporter.AddResult(kMetricBuildTime, build_timer.Elapsed());
+
+  base::ElapsedTimer timer;
+  int blocked = 0;
+  for (const GURL& url : urls) {
+    blocked += index.GetContentSetting(url, GURL()) == CONTENT_SETTING_BLOCK;
+  }
+  reporter.AddResult(kMetricTimePerLookup, timer.Elapsed() / kLookups);
+  EXPECT_GT(blocked, 0);
+}
+
+}  // namespace content_settings
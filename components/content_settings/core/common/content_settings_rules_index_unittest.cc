@@ -0,0 +1,106 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
+
+#include <string>
+#include <vector>
+
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+namespace {
+
+ContentSettingPatternSource MakeRule(const std::string& primary,
+                                     const std::string& secondary,
+                                     ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary),
+      ContentSettingsPattern::FromString(secondary),
+      ContentSettingToValue(setting), std::string(), false);
+}
+
+ContentSetting GetContentSettingLinear(const ContentSettingsForOneType& rules,
+                                       const GURL& primary_url,
+                                       const GURL& secondary_url) {
+  for (const auto& rule : rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.GetContentSetting();
+    }
+  }
+  return CONTENT_SETTING_DEFAULT;
+}
+
+}  // namespace
+
+TEST(ContentSettingsRulesIndexTest, MatchesLinearWalk) {
+  const ContentSettingsForOneType rules = {
+      MakeRule("https://a.example.com", "*", CONTENT_SETTING_ALLOW),
+      MakeRule("[*.]example.com", "https://firstParty/*",
+               CONTENT_SETTING_BLOCK),
+      MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK),
+      MakeRule("http://127.0.0.1", "*", CONTENT_SETTING_BLOCK),
+      MakeRule("file:///*", "*", CONTENT_SETTING_BLOCK),
+      MakeRule("*", "https://firstParty/*", CONTENT_SETTING_ALLOW),
+  };
+  ContentSettingsRulesIndex index(rules);
+
+  const std::vector<GURL> primary_urls = {
+      GURL("https://example.com/"),       GURL("https://a.example.com/"),
+      GURL("http://a.example.com/"),      GURL("https://b.a.example.com/"),
+      GURL("https://example.com./"),      GURL("https://notexample.com/"),
+      GURL("https://com/"),               GURL("http://127.0.0.1/"),
+      GURL("file:///home/user/a.html"),   GURL("https://[::1]/"),
+  };
+  const std::vector<GURL> secondary_urls = {
+      GURL(), GURL("https://firstParty/"), GURL("https://example.com/")};
+  for (const GURL& primary_url : primary_urls) {
+    for (const GURL& secondary_url : secondary_urls) {
+      // The second lookup is answered from the memoized results.
+      for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(GetContentSettingLinear(rules, primary_url, secondary_url),
+                  index.GetContentSetting(primary_url, secondary_url))
+            << primary_url << " " << secondary_url;
+      }
+    }
+  }
+}
+
+TEST(ContentSettingsRulesIndexTest, KeepsRulesPrecedence) {
+  ContentSettingsRulesIndex index({
+      MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK),
+      MakeRule("https://www.example.com", "*", CONTENT_SETTING_ALLOW),
+  });
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            index.GetContentSetting(GURL("https://www.example.com/"), GURL()));
+
+  ContentSettingsRulesIndex reversed_index({
+      MakeRule("https://www.example.com", "*", CONTENT_SETTING_ALLOW),
+      MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK),
+  });
+  EXPECT_EQ(CONTENT_SETTING_ALLOW, reversed_index.GetContentSetting(
+                                       GURL("https://www.example.com/"),
+                                       GURL()));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, reversed_index.GetContentSetting(
+                                       GURL("https://example.com/"), GURL()));
+}
+
+TEST(ContentSettingsRulesIndexTest, NoMatch) {
+  ContentSettingsRulesIndex empty_index((ContentSettingsForOneType()));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            empty_index.GetContentSetting(GURL("https://a.com/"), GURL()));
+
+  ContentSettingsRulesIndex index(
+      {MakeRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK)});
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            index.GetContentSetting(GURL("https://example.org/"), GURL()));
+}
+
+}  // namespace content_settings
@@ -55,23 +55,6 @@ GURL GetOriginOrURL(const blink::WebFrame* frame) {
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
-    }
-  }
-
-  return setting == CONTENT_SETTING_BLOCK;
-}
-
 // Skips everything except main frame domain and javascript urls.
 bool ShouldSkipResource(const GURL& resource_url) {
   return (resource_url.path_piece().empty() ||
@@ -250,12 +233,44 @@ bool BraveContentSettingsAgentImpl::AllowScriptFromSource(
   return allow;
 }
 
+void BraveContentSettingsAgentImpl::SendRendererContentSettingRules(
+    const RendererContentSettingRules& renderer_settings) {
+  ContentSettingsAgentImpl::SendRendererContentSettingRules(renderer_settings);
+  brave_shields_rules_index_.reset();
+  cosmetic_filtering_rules_index_.reset();
+}
+
+void BraveContentSettingsAgentImpl::SetContentSettingRulesForTest(
+    const RendererContentSettingRules& rules) {
+  ContentSettingsAgentImpl::SetRendererContentSettingRulesForTest(rules);
+  brave_shields_rules_index_.reset();
+  cosmetic_filtering_rules_index_.reset();
+}
+
+ContentSettingsRulesIndex&
+BraveContentSettingsAgentImpl::GetBraveShieldsRulesIndex() {
+  if (!brave_shields_rules_index_) {
+    brave_shields_rules_index_.emplace(
+        content_setting_rules_->brave_shields_rules);
+  }
+  return *brave_shields_rules_index_;
+}
+
+ContentSettingsRulesIndex&
+BraveContentSettingsAgentImpl::GetCosmeticFilteringRulesIndex() {
+  if (!cosmetic_filtering_rules_index_) {
+    cosmetic_filtering_rules_index_.emplace(
+        content_setting_rules_->cosmetic_filtering_rules);
+  }
+  return *cosmetic_filtering_rules_index_;
+}
+
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
   return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+         GetBraveShieldsRulesIndex().GetContentSetting(
+             GetOriginOrURL(frame), secondary_url) == CONTENT_SETTING_BLOCK;
 }
 
 bool BraveContentSettingsAgentImpl::IsCosmeticFilteringEnabled(
@@ -265,15 +280,8 @@ bool BraveContentSettingsAgentImpl::IsCosmeticFilteringEnabled(
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    const GURL& primary_url = GetOriginOrURL(frame);
-
-    for (const auto& rule : content_setting_rules_->cosmetic_filtering_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
-    }
+    setting = GetCosmeticFilteringRulesIndex().GetContentSetting(
+        GetOriginOrURL(frame), secondary_url);
   }
 
   return base::FeatureList::IsEnabled(
@@ -289,15 +297,8 @@ bool BraveContentSettingsAgentImpl::IsFirstPartyCosmeticFilteringEnabled(
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    const GURL& primary_url = GetOriginOrURL(frame);
-
-    for (const auto& rule : content_setting_rules_->cosmetic_filtering_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
-    }
+    setting = GetCosmeticFilteringRulesIndex().GetContentSetting(
+        GetOriginOrURL(frame), secondary_url);
   }
 
   return setting == CONTENT_SETTING_BLOCK;
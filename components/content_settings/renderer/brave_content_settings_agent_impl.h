@@ -14,6 +14,7 @@
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
+#include "brave/components/content_settings/core/common/content_settings_rules_index.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
@@ -21,7 +22,7 @@
 #include "mojo/public/cpp/bindings/associated_receiver_set.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
-
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace blink {
@@ -47,6 +48,10 @@ class BraveContentSettingsAgentImpl
 
   bool IsFirstPartyCosmeticFilteringEnabled(const GURL& url) override;
 
+  // Sets the rules and resets the rules indexes built from them. Use instead
+  // of SetRendererContentSettingRulesForTest(), which is not virtual.
+  void SetContentSettingRulesForTest(const RendererContentSettingRules& rules);
+
  protected:
   bool AllowScript(bool enabled_per_settings) override;
   bool AllowScriptFromSource(bool enabled_per_settings,
@@ -65,6 +70,9 @@ class BraveContentSettingsAgentImpl
   bool IsReduceLanguageEnabled() override;
 
  private:
+  // Would leave the rules indexes stale.
+  using ContentSettingsAgentImpl::SetRendererContentSettingRulesForTest;
+
   FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
                            AutoplayBlockedByDefault);
   FRIEND_TEST_ALL_PREFIXES(BraveContentSettingsAgentImplAutoplayBrowserTest,
@@ -75,6 +83,16 @@ class BraveContentSettingsAgentImpl
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
+  // Returns the index of the brave shields or cosmetic filtering rules,
+  // building it on first use after the rules change. Must only be called when
+  // |content_setting_rules_| is set.
+  ContentSettingsRulesIndex& GetBraveShieldsRulesIndex();
+  ContentSettingsRulesIndex& GetCosmeticFilteringRulesIndex();
+
+  // content_settings::mojom::ContentSettingsAgent.
+  void SendRendererContentSettingRules(
+      const RendererContentSettingRules& renderer_settings) override;
+
   // brave_shields::mojom::BraveShields.
   void SetAllowScriptsFromOriginsOnce(
       const std::vector<std::string>& origins) override;
@@ -102,6 +120,11 @@ class BraveContentSettingsAgentImpl
   base::flat_map<url::Origin, blink::WebSecurityOrigin>
       cached_ephemeral_storage_origins_;
 
+  // Host-keyed views of |content_setting_rules_|, reset when new rules arrive
+  // since they are consulted for every frame, script and farbling check.
+  absl::optional<ContentSettingsRulesIndex> brave_shields_rules_index_;
+  absl::optional<ContentSettingsRulesIndex> cosmetic_filtering_rules_index_;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
@@ -0,0 +1,130 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/browser/cosmetic_filters_tab_helper.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+bool g_drop_pushed_resources_for_testing = false;
+
+}  // namespace
+
+CosmeticFiltersTabHelper::CosmeticFiltersTabHelper(
+    content::WebContents* web_contents,
+    brave_shields::AdBlockService* ad_block_service,
+    HostContentSettingsMap* content_settings)
+    : content::WebContentsObserver(web_contents),
+      content::WebContentsUserData<CosmeticFiltersTabHelper>(*web_contents),
+      ad_block_service_(ad_block_service),
+      content_settings_(content_settings) {}
+
+CosmeticFiltersTabHelper::~CosmeticFiltersTabHelper() = default;
+
+// static
+base::AutoReset<bool>
+CosmeticFiltersTabHelper::DropPushedResourcesForTesting() {
+  return base::AutoReset<bool>(&g_drop_pushed_resources_for_testing, true);
+}
+
+void CosmeticFiltersTabHelper::ReadyToCommitNavigation(
+    content::NavigationHandle* navigation_handle) {
+  // Same-document navigations keep the resources of the current document, and
+  // so do restored or activated pages, which the frame doesn't commit again.
+  if (navigation_handle->IsSameDocument() ||
+      navigation_handle->IsErrorPage() ||
+      navigation_handle->IsServedFromBackForwardCache() ||
+      navigation_handle->IsPrerenderedPageActivation()) {
+    return;
+  }
+  const GURL& url = navigation_handle->GetURL();
+  if (!url.SchemeIsHTTPOrHTTPS()) {
+    return;
+  }
+
+  // Mirrors the checks the frame makes with its own copy of the rules.
+  GURL main_frame_url = url;
+  bool aggressive_blocking = false;
+  if (content::RenderFrameHost* parent =
+          navigation_handle->GetParentFrameOrOuterDocument()) {
+    content::RenderFrameHost* main_frame = parent->GetOutermostMainFrame();
+    main_frame_url = main_frame->GetLastCommittedURL();
+    aggressive_blocking =
+        !main_frame->GetLastCommittedOrigin().IsSameOriginWith(
+            url::Origin::Create(url));
+  }
+  aggressive_blocking = aggressive_blocking ||
+                        brave_shields::IsFirstPartyCosmeticFilteringEnabled(
+                            content_settings_, main_frame_url);
+
+  // The frame is told to wait for the resources before the navigation
+  // commits. They are always sent from a later task, once it has committed.
+  content::RenderFrameHost* rfh = navigation_handle->GetRenderFrameHost();
+  mojo::AssociatedRemote<mojom::CosmeticFiltersAgent> agent;
+  rfh->GetRemoteAssociatedInterfaces()->GetInterface(&agent);
+  agent->ExpectUrlCosmeticResources(url.spec());
+
+  const content::GlobalRenderFrameHostId frame_id = rfh->GetGlobalId();
+  if (!brave_shields::GetBraveShieldsEnabled(content_settings_,
+                                             main_frame_url) ||
+      brave_shields::GetCosmeticFilteringControlType(
+          content_settings_, main_frame_url) == brave_shields::ALLOW) {
+    // The frame will not apply any rule, there is nothing to compute.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&CosmeticFiltersTabHelper::SendUrlCosmeticResources,
+                       weak_factory_.GetWeakPtr(), frame_id, url.spec(),
+                       aggressive_blocking, base::Value::Dict()));
+    return;
+  }
+
+  ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
+                     base::Unretained(ad_block_service_.get()), url.spec(),
+                     aggressive_blocking),
+      base::BindOnce(&CosmeticFiltersTabHelper::SendUrlCosmeticResources,
+                     weak_factory_.GetWeakPtr(), frame_id, url.spec(),
+                     aggressive_blocking));
+}
+
+void CosmeticFiltersTabHelper::SendUrlCosmeticResources(
+    content::GlobalRenderFrameHostId frame_id,
+    const std::string& url,
+    bool aggressive_blocking,
+    base::Value::Dict resources) {
+  if (g_drop_pushed_resources_for_testing) {
+    return;
+  }
+  content::RenderFrameHost* rfh = content::RenderFrameHost::FromID(frame_id);
+  if (!rfh || !rfh->IsRenderFrameLive()) {
+    return;
+  }
+  mojo::AssociatedRemote<mojom::CosmeticFiltersAgent> agent;
+  rfh->GetRemoteAssociatedInterfaces()->GetInterface(&agent);
+  agent->SetUrlCosmeticResources(url, aggressive_blocking,
+                                 std::move(resources));
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(CosmeticFiltersTabHelper);
+
+}  // namespace cosmetic_filters
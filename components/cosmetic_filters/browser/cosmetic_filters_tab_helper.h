@@ -0,0 +1,70 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_TAB_HELPER_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_TAB_HELPER_H_
+
+#include <string>
+
+#include "base/auto_reset.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "content/public/browser/global_routing_id.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+class AdBlockService;
+}  // namespace brave_shields
+
+namespace cosmetic_filters {
+
+// Computes the cosmetic resources of a document while its navigation commits
+// and pushes them to the frame, so the renderer never waits on the adblock
+// task runner at document start.
+class CosmeticFiltersTabHelper
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<CosmeticFiltersTabHelper> {
+ public:
+  ~CosmeticFiltersTabHelper() override;
+
+  CosmeticFiltersTabHelper(const CosmeticFiltersTabHelper&) = delete;
+  CosmeticFiltersTabHelper& operator=(const CosmeticFiltersTabHelper&) =
+      delete;
+
+  // Announces the resources to frames but never sends them, so that they
+  // have to fall back to requesting them.
+  static base::AutoReset<bool> DropPushedResourcesForTesting();
+
+  // content::WebContentsObserver:
+  void ReadyToCommitNavigation(
+      content::NavigationHandle* navigation_handle) override;
+
+ private:
+  friend class content::WebContentsUserData<CosmeticFiltersTabHelper>;
+
+  CosmeticFiltersTabHelper(content::WebContents* web_contents,
+                           brave_shields::AdBlockService* ad_block_service,
+                           HostContentSettingsMap* content_settings);
+
+  void SendUrlCosmeticResources(content::GlobalRenderFrameHostId frame_id,
+                                const std::string& url,
+                                bool aggressive_blocking,
+                                base::Value::Dict resources);
+
+  raw_ptr<brave_shields::AdBlockService> ad_block_service_ = nullptr;
+  raw_ptr<HostContentSettingsMap> content_settings_ = nullptr;
+
+  base::WeakPtrFactory<CosmeticFiltersTabHelper> weak_factory_{this};
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_TAB_HELPER_H_
@@ -10,13 +10,16 @@
 #include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/json/json_writer.h"
+#include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
+#include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_render_frame_observer.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "components/content_settings/renderer/content_settings_agent_impl.h"
 #include "content/public/renderer/render_frame.h"
@@ -39,6 +42,10 @@ static base::NoDestructor<std::vector<std::string>> g_vetted_search_engines(
     {"duckduckgo", "qwant", "bing", "startpage", "google", "yandex", "ecosia",
      "brave"});
 
+// How long a frame waits for the resources the browser announced before
+// requesting them itself.
+constexpr base::TimeDelta kPushedResourcesTimeout = base::Seconds(1);
+
 // Entry point to content_cosmetic.ts script.
 const char kObservingScriptletEntryPoint[] =
     "window.content_cosmetic.tryScheduleQueuePump()";
@@ -207,12 +214,15 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
 CosmeticFiltersJSHandler::~CosmeticFiltersJSHandler() = default;
 
 void CosmeticFiltersJSHandler::HiddenClassIdSelectors(
-    const std::string& input) {
-  if (!EnsureConnected())
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids) {
+  if (generichide_ || (classes.empty() && ids.empty()) || !EnsureConnected())
     return;
 
+  TRACE_EVENT2("brave.adblock", "HiddenClassIdSelectors", "classes",
+               classes.size(), "ids", ids.size());
   cosmetic_filters_resources_->HiddenClassIdSelectors(
-      input, exceptions_,
+      classes, ids, exceptions_,
       base::BindOnce(&CosmeticFiltersJSHandler::OnHiddenClassIdSelectors,
                      base::Unretained(this)));
 }
@@ -336,12 +346,15 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
   EnsureConnected();
 }
 
-bool CosmeticFiltersJSHandler::ProcessURL(
-    const GURL& url,
-    absl::optional<base::OnceClosure> callback) {
+bool CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
+                                          base::OnceClosure callback) {
   resources_dict_ = absl::nullopt;
+  resources_pushed_callback_.Reset();
+  push_timeout_timer_.Stop();
   url_ = url;
   enabled_1st_party_cf_ = false;
+  const bool resources_pushed = expected_push_url_ == url_.spec();
+  expected_push_url_.clear();
 
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -362,31 +375,98 @@ bool CosmeticFiltersJSHandler::ProcessURL(
       render_frame_->GetWebFrame()->IsCrossOriginToOutermostMainFrame() ||
       content_settings->IsFirstPartyCosmeticFilteringEnabled(url_);
 
-  if (callback.has_value()) {
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResources");
-    TRACE_EVENT1("brave.adblock", "UrlCosmeticResources", "url", url_.spec());
-    cosmetic_filters_resources_->UrlCosmeticResources(
-        url_.spec(), enabled_1st_party_cf_,
-        base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                       base::Unretained(this), std::move(callback.value())));
-  } else {
-    TRACE_EVENT1("brave.adblock", "UrlCosmeticResourcesSync", "url",
-                 url_.spec());
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResourcesSync");
-    base::Value result;
-    cosmetic_filters_resources_->UrlCosmeticResources(
-        url_.spec(), enabled_1st_party_cf_, &result);
-
-    auto* dict = result.GetIfDict();
-    if (dict)
-      resources_dict_ = std::move(*dict);
+  if (resources_pushed) {
+    // The browser sends the resources after the navigation commits.
+    pushed_resources_ = absl::nullopt;
+    resources_pushed_callback_ = std::move(callback);
+    push_timeout_timer_.Start(
+        FROM_HERE, kPushedResourcesTimeout,
+        base::BindOnce(&CosmeticFiltersJSHandler::OnPushedResourcesTimeout,
+                       base::Unretained(this)));
+    return true;
   }
 
+  blink::WebFrame* parent = render_frame_->GetWebFrame()->Parent();
+  if (parent && parent->IsWebLocalFrame()) {
+    auto* parent_observer = CosmeticFiltersJsRenderFrameObserver::Get(
+        content::RenderFrame::FromWebFrame(parent->ToWebLocalFrame()));
+    const base::Value::Dict* parent_resources =
+        parent_observer ? parent_observer->GetPushedResources(
+                              url_, enabled_1st_party_cf_)
+                        : nullptr;
+    if (parent_resources) {
+      resources_dict_ = parent_resources->Clone();
+      std::move(callback).Run();
+      return true;
+    }
+  }
+
+  RequestUrlCosmeticResources(std::move(callback));
   return true;
 }
 
+void CosmeticFiltersJSHandler::ExpectPushedResources(const std::string& url) {
+  expected_push_url_ = url;
+}
+
+void CosmeticFiltersJSHandler::OnUrlCosmeticResourcesPushed(
+    const std::string& url,
+    bool aggressive_blocking,
+    base::Value::Dict resources) {
+  pushed_url_ = url;
+  pushed_aggressive_blocking_ = aggressive_blocking;
+  pushed_resources_ = std::move(resources);
+  MaybeUsePushedResources();
+}
+
+const base::Value::Dict* CosmeticFiltersJSHandler::GetPushedResources(
+    const GURL& url,
+    bool aggressive_blocking) const {
+  if (!pushed_resources_ || pushed_url_ != url.spec() ||
+      pushed_aggressive_blocking_ != aggressive_blocking) {
+    return nullptr;
+  }
+  return &pushed_resources_.value();
+}
+
+void CosmeticFiltersJSHandler::MaybeUsePushedResources() {
+  if (!resources_pushed_callback_ || !pushed_resources_ ||
+      pushed_url_ != url_.spec()) {
+    return;
+  }
+
+  push_timeout_timer_.Stop();
+  if (pushed_aggressive_blocking_ != enabled_1st_party_cf_) {
+    // The browser and the frame disagree on the blocking mode, e.g. because
+    // the rules changed in between. Ask again with the frame's mode.
+    RequestUrlCosmeticResources(std::move(resources_pushed_callback_));
+    return;
+  }
+
+  resources_dict_ = pushed_resources_->Clone();
+  std::move(resources_pushed_callback_).Run();
+}
+
+void CosmeticFiltersJSHandler::RequestUrlCosmeticResources(
+    base::OnceClosure callback) {
+  SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
+      "Brave.CosmeticFilters.UrlCosmeticResources");
+  TRACE_EVENT1("brave.adblock", "UrlCosmeticResources", "url", url_.spec());
+  cosmetic_filters_resources_->UrlCosmeticResources(
+      url_.spec(), enabled_1st_party_cf_,
+      base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
+                     base::Unretained(this), std::move(callback)));
+}
+
+void CosmeticFiltersJSHandler::OnPushedResourcesTimeout() {
+  if (!resources_pushed_callback_) {
+    return;
+  }
+
+  VLOG(1) << "Cosmetic resources were not pushed for " << url_.spec();
+  RequestUrlCosmeticResources(std::move(resources_pushed_callback_));
+}
+
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
     base::Value result) {
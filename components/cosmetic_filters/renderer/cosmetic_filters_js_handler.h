@@ -12,6 +12,7 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -37,10 +38,25 @@ class CosmeticFiltersJSHandler {
   void AddJavaScriptObjectToFrame(v8::Local<v8::Context> context);
   // Fetches an initial set of resources to inject into the page if cosmetic
   // filtering is enabled, and returns whether or not to proceed with cosmetic
-  // filtering.
-  bool ProcessURL(const GURL& url, absl::optional<base::OnceClosure> callback);
+  // filtering. |callback| runs once the resources are available. They are
+  // sent by the browser along with the navigation if it announced them,
+  // otherwise they are taken from the parent frame if it has them for the
+  // same URL, or requested.
+  bool ProcessURL(const GURL& url, base::OnceClosure callback);
   void ApplyRules(bool de_amp_enabled);
 
+  // Called before a navigation to |url| commits when the browser is going to
+  // push its resources.
+  void ExpectPushedResources(const std::string& url);
+  // Called with the resources the browser computed for a navigation to |url|.
+  void OnUrlCosmeticResourcesPushed(const std::string& url,
+                                    bool aggressive_blocking,
+                                    base::Value::Dict resources);
+  // Returns the resources last pushed to this frame if they were computed for
+  // |url| with the same blocking mode.
+  const base::Value::Dict* GetPushedResources(const GURL& url,
+                                              bool aggressive_blocking) const;
+
  private:
   void BindFunctionsToObject(v8::Isolate* isolate,
                              v8::Local<v8::Object> javascript_object);
@@ -59,9 +75,15 @@ class CosmeticFiltersJSHandler {
 
   void CreateWorkerObject(v8::Isolate* isolate, v8::Local<v8::Context> context);
 
-  // A function to be called from JS
-  void HiddenClassIdSelectors(const std::string& input);
+  // A function to be called from JS with the class and id names added to the
+  // page since the previous call, batched once per animation frame.
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids);
 
+  void MaybeUsePushedResources();
+  // Requests the resources for |url_| instead of waiting for the browser.
+  void RequestUrlCosmeticResources(base::OnceClosure callback);
+  void OnPushedResourcesTimeout();
   void OnUrlCosmeticResources(base::OnceClosure callback,
                               base::Value result);
   void CSSRulesRoutine(const base::Value::Dict& resources_dict);
@@ -82,6 +104,19 @@ class CosmeticFiltersJSHandler {
   std::vector<std::string> exceptions_;
   GURL url_;
   absl::optional<base::Value::Dict> resources_dict_;
+  // The URL of the navigation the browser announced resources for.
+  std::string expected_push_url_;
+  // Runs once the browser pushed the resources for |url_|.
+  base::OnceClosure resources_pushed_callback_;
+  // Falls back to requesting the resources if they are not pushed in time,
+  // e.g. because the frame was swapped out before they were sent.
+  base::OneShotTimer push_timeout_timer_;
+
+  // The resources last pushed by the browser, kept for same-URL child frames
+  // such as about:blank ones.
+  std::string pushed_url_;
+  bool pushed_aggressive_blocking_ = false;
+  absl::optional<base::Value::Dict> pushed_resources_;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
@@ -8,12 +8,11 @@
 #include <memory>
 #include <utility>
 
-#include "base/feature_list.h"
 #include "base/functional/bind.h"
-#include "brave/components/brave_shields/common/features.h"
-#include "brave/components/de_amp/common/features.h"
+#include "base/metrics/histogram_macros.h"
 #include "content/public/renderer/render_frame.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
 #include "third_party/blink/public/platform/web_url.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -61,7 +60,12 @@ CosmeticFiltersJsRenderFrameObserver::CosmeticFiltersJsRenderFrameObserver(
       native_javascript_handle_(
           new CosmeticFiltersJSHandler(render_frame, isolated_world_id)),
       get_de_amp_enabled_closure_(std::move(get_de_amp_enabled_closure)),
-      ready_(new base::OneShotEvent()) {}
+      ready_(new base::OneShotEvent()) {
+  render_frame->GetAssociatedInterfaceRegistry()
+      ->AddInterface<mojom::CosmeticFiltersAgent>(base::BindRepeating(
+          &CosmeticFiltersJsRenderFrameObserver::BindCosmeticFiltersAgent,
+          base::Unretained(this)));
+}
 
 CosmeticFiltersJsRenderFrameObserver::~CosmeticFiltersJsRenderFrameObserver() =
     default;
@@ -75,6 +79,7 @@ void CosmeticFiltersJsRenderFrameObserver::DidStartNavigation(
 void CosmeticFiltersJsRenderFrameObserver::ReadyToCommitNavigation(
     blink::WebDocumentLoader* document_loader) {
   ready_ = std::make_unique<base::OneShotEvent>();
+  document_start_time_ = base::TimeTicks();
   // invalidate weak pointers on navigation so we don't get callbacks from the
   // previous url load
   weak_factory_.InvalidateWeakPtrs();
@@ -88,23 +93,46 @@ void CosmeticFiltersJsRenderFrameObserver::ReadyToCommitNavigation(
   if (!url_.SchemeIsHTTPOrHTTPS())
     return;
 
-  if (base::FeatureList::IsEnabled(
-          ::brave_shields::features::kCosmeticFilteringSyncLoad)) {
-    if (native_javascript_handle_->ProcessURL(url_, absl::nullopt)) {
-      ready_->Signal();
-    }
-  } else {
-    native_javascript_handle_->ProcessURL(
-        url_, absl::make_optional(base::BindOnce(
-                  &CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
-                  weak_factory_.GetWeakPtr())));
-  }
+  native_javascript_handle_->ProcessURL(
+      url_,
+      base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void CosmeticFiltersJsRenderFrameObserver::ExpectUrlCosmeticResources(
+    const std::string& url) {
+  native_javascript_handle_->ExpectPushedResources(url);
+}
+
+void CosmeticFiltersJsRenderFrameObserver::SetUrlCosmeticResources(
+    const std::string& url,
+    bool aggressive_blocking,
+    base::Value::Dict resources) {
+  native_javascript_handle_->OnUrlCosmeticResourcesPushed(
+      url, aggressive_blocking, std::move(resources));
+}
+
+const base::Value::Dict*
+CosmeticFiltersJsRenderFrameObserver::GetPushedResources(
+    const GURL& url,
+    bool aggressive_blocking) const {
+  return native_javascript_handle_->GetPushedResources(url,
+                                                       aggressive_blocking);
+}
+
+void CosmeticFiltersJsRenderFrameObserver::BindCosmeticFiltersAgent(
+    mojo::PendingAssociatedReceiver<mojom::CosmeticFiltersAgent> receiver) {
+  agent_receivers_.Add(this, std::move(receiver));
 }
 
 void CosmeticFiltersJsRenderFrameObserver::RunScriptsAtDocumentStart() {
   if (ready_->is_signaled()) {
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "Brave.CosmeticFilters.DocumentStartWait", base::TimeDelta(),
+        base::Microseconds(1), base::Seconds(1), 50);
     ApplyRules();
   } else {
+    document_start_time_ = base::TimeTicks::Now();
     ready_->Post(
         FROM_HERE,
         base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::ApplyRules,
@@ -118,6 +146,14 @@ void CosmeticFiltersJsRenderFrameObserver::ApplyRules() {
 }
 
 void CosmeticFiltersJsRenderFrameObserver::OnProcessURL() {
+  if (!document_start_time_.is_null()) {
+    // The rules are applied late, after the document has started.
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "Brave.CosmeticFilters.DocumentStartWait",
+        base::TimeTicks::Now() - document_start_time_, base::Microseconds(1),
+        base::Seconds(1), 50);
+    document_start_time_ = base::TimeTicks();
+  }
   ready_->Signal();
 }
 
@@ -7,13 +7,19 @@
 #define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_FILTERS_JS_RENDER_FRAME_OBSERVER_H_
 
 #include <memory>
+#include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_handler.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/render_frame_observer_tracker.h"
+#include "mojo/public/cpp/bindings/associated_receiver_set.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/web/web_navigation_type.h"
 #include "url/gurl.h"
@@ -26,7 +32,8 @@ namespace cosmetic_filters {
 class CosmeticFiltersJsRenderFrameObserver
     : public content::RenderFrameObserver,
       public content::RenderFrameObserverTracker<
-          CosmeticFiltersJsRenderFrameObserver> {
+          CosmeticFiltersJsRenderFrameObserver>,
+      public mojom::CosmeticFiltersAgent {
  public:
   CosmeticFiltersJsRenderFrameObserver(
       content::RenderFrame* render_frame,
@@ -50,9 +57,20 @@ class CosmeticFiltersJsRenderFrameObserver
                               int32_t world_id) override;
   void DidCreateNewDocument() override;
 
+  // mojom::CosmeticFiltersAgent:
+  void ExpectUrlCosmeticResources(const std::string& url) override;
+  void SetUrlCosmeticResources(const std::string& url,
+                               bool aggressive_blocking,
+                               base::Value::Dict resources) override;
+
   void RunScriptsAtDocumentStart();
 
+  const base::Value::Dict* GetPushedResources(const GURL& url,
+                                              bool aggressive_blocking) const;
+
  private:
+  void BindCosmeticFiltersAgent(
+      mojo::PendingAssociatedReceiver<mojom::CosmeticFiltersAgent> receiver);
   void OnProcessURL();
   void ApplyRules();
 
@@ -69,6 +87,10 @@ class CosmeticFiltersJsRenderFrameObserver
   base::RepeatingCallback<bool(void)> get_de_amp_enabled_closure_;
 
   std::unique_ptr<base::OneShotEvent> ready_;
+  // When the document started while waiting for |ready_|.
+  base::TimeTicks document_start_time_;
+
+  mojo::AssociatedReceiverSet<mojom::CosmeticFiltersAgent> agent_receivers_;
 
   base::WeakPtrFactory<CosmeticFiltersJsRenderFrameObserver> weak_factory_{
       this};
@@ -36,6 +36,8 @@ let currentMutationStartTime = performance.now()
 // The next allowed time to call FetchNewClassIdRules() if it's throttled.
 let nextFetchNewClassIdRulesCall = 0
 let fetchNewClassIdRulesTimeoutId: number | undefined
+// The pending animation frame request that sends the collected names.
+let fetchNewClassIdRulesFrameId: number | undefined
 
 const queriedIds = new Set<string>()
 const queriedClasses = new Set<string>()
@@ -173,14 +175,23 @@ const fetchNewClassIdRules = () => {
   }
   // Callback to c++ renderer process
   // @ts-expect-error
-  cf_worker.hiddenClassIdSelectors(
-      JSON.stringify({
-        classes: notYetQueriedClasses, ids: notYetQueriedIds
-      }))
+  cf_worker.hiddenClassIdSelectors(notYetQueriedClasses, notYetQueriedIds)
   notYetQueriedClasses = []
   notYetQueriedIds = []
 }
 
+// Several MutationObserver events may be delivered per frame, so send the
+// names they add in a single call right before the next frame is rendered.
+const scheduleFetchNewClassIdRules = () => {
+  if (fetchNewClassIdRulesFrameId !== undefined) {
+    return
+  }
+  fetchNewClassIdRulesFrameId = window.requestAnimationFrame(() => {
+    fetchNewClassIdRulesFrameId = undefined
+    fetchNewClassIdRules()
+  })
+}
+
 const useMutationObserver = () => {
   if (selectorsPollingIntervalId) {
     clearInterval(selectorsPollingIntervalId)
@@ -280,7 +291,7 @@ const onMutations = (mutations: MutationRecord[], observer: MutationObserver) =>
   }
 
   if (!ShouldThrottleFetchNewClassIdsRules()) {
-    fetchNewClassIdRules()
+    scheduleFetchNewClassIdRules()
   }
 
   if (eventId) {
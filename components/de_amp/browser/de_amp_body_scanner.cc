@@ -0,0 +1,252 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/de_amp/browser/de_amp_body_scanner.h"
+
+#include <vector>
+
+#include "base/strings/string_util.h"
+
+namespace de_amp {
+
+namespace {
+
+// Longest name of the tags we look at: html, link, head and body.
+constexpr size_t kMaxTagNameLength = 4;
+
+constexpr char kAmpAttribute[] = "amp";
+constexpr char kLightningAttribute[] = "⚡";
+
+struct Attribute {
+  base::StringPiece name;
+  base::StringPiece value;
+};
+
+// Splits what follows the tag name, up to the closing '>', into attributes.
+// Values may be double quoted, single quoted or unquoted.
+std::vector<Attribute> ParseAttributes(base::StringPiece attributes) {
+  std::vector<Attribute> result;
+  const size_t size = attributes.size();
+  size_t pos = 0;
+  while (true) {
+    while (pos < size && (base::IsAsciiWhitespace(attributes[pos]) ||
+                          attributes[pos] == '/')) {
+      pos++;
+    }
+    if (pos >= size) {
+      break;
+    }
+
+    const size_t name_start = pos;
+    do {
+      pos++;
+    } while (pos < size && !base::IsAsciiWhitespace(attributes[pos]) &&
+             attributes[pos] != '=' && attributes[pos] != '/');
+    Attribute attribute{attributes.substr(name_start, pos - name_start), {}};
+
+    while (pos < size && base::IsAsciiWhitespace(attributes[pos])) {
+      pos++;
+    }
+    if (pos < size && attributes[pos] == '=') {
+      pos++;
+      while (pos < size && base::IsAsciiWhitespace(attributes[pos])) {
+        pos++;
+      }
+      if (pos < size && (attributes[pos] == '"' || attributes[pos] == '\'')) {
+        const char quote = attributes[pos++];
+        size_t value_end = attributes.find(quote, pos);
+        if (value_end == base::StringPiece::npos) {
+          value_end = size;
+        }
+        attribute.value = attributes.substr(pos, value_end - pos);
+        pos = value_end + 1;
+      } else {
+        const size_t value_start = pos;
+        while (pos < size && !base::IsAsciiWhitespace(attributes[pos])) {
+          pos++;
+        }
+        attribute.value = attributes.substr(value_start, pos - value_start);
+        // A '/' right before the '>' closes the tag, as in <link href=a.com/>.
+        if (pos == size && base::EndsWith(attribute.value, "/")) {
+          attribute.value.remove_suffix(1);
+        }
+      }
+    }
+
+    result.push_back(attribute);
+  }
+  return result;
+}
+
+// The UTF-8 byte order mark is EF BB BF, and may be split across chunks.
+bool IsByteOrderMarkByte(char c) {
+  return c == '\xEF' || c == '\xBB' || c == '\xBF';
+}
+
+bool IsAmpAttribute(const Attribute& attribute) {
+  if (!base::EqualsCaseInsensitiveASCII(attribute.name, kAmpAttribute) &&
+      attribute.name != kLightningAttribute) {
+    return false;
+  }
+  const base::StringPiece value =
+      base::TrimWhitespaceASCII(attribute.value, base::TRIM_ALL);
+  return value.empty() || base::EqualsCaseInsensitiveASCII(value, "true");
+}
+
+}  // namespace
+
+AmpBodyScanner::AmpBodyScanner() = default;
+
+AmpBodyScanner::~AmpBodyScanner() = default;
+
+AmpBodyScanner::Status AmpBodyScanner::Feed(base::StringPiece chunk) {
+  size_t pos = 0;
+  if (!seen_first_character_) {
+    // An HTML document starts with a doctype, a comment or a tag, after any
+    // whitespace and byte order mark. Anything else, such as JSON, plain text
+    // or an image, is not an AMP page and doesn't need to be scanned further.
+    while (pos < chunk.size() && (base::IsAsciiWhitespace(chunk[pos]) ||
+                                  IsByteOrderMarkByte(chunk[pos]))) {
+      pos++;
+    }
+    if (pos == chunk.size()) {
+      return status_;
+    }
+    seen_first_character_ = true;
+    if (chunk[pos] != '<') {
+      status_ = Status::kNotAmp;
+      return status_;
+    }
+  }
+  while (pos < chunk.size() && status_ != Status::kNotAmp &&
+         status_ != Status::kAmpWithCanonicalLink) {
+    switch (tag_state_) {
+      case TagState::kText: {
+        const size_t tag_start = chunk.find('<', pos);
+        if (tag_start == base::StringPiece::npos) {
+          return status_;
+        }
+        pos = tag_start + 1;
+        tag_name_.clear();
+        tag_state_ = TagState::kName;
+        break;
+      }
+      case TagState::kName: {
+        const char c = chunk[pos++];
+        if (c == '<') {
+          // Start over, the tag we were reading was not one.
+          tag_name_.clear();
+          break;
+        }
+        if (base::IsAsciiWhitespace(c) || c == '>' ||
+            (c == '/' && !tag_name_.empty())) {
+          if (tag_name_.empty()) {
+            // Whitespace is allowed before the name, as in "< html>".
+            if (c == '>') {
+              tag_state_ = TagState::kText;
+            }
+            break;
+          }
+          if (tag_name_ != "html" && tag_name_ != "link" &&
+              tag_name_ != "head" && tag_name_ != "body") {
+            tag_state_ = TagState::kText;
+            break;
+          }
+          attributes_.clear();
+          tag_state_ = TagState::kAttributes;
+          if (c == '>') {
+            tag_state_ = TagState::kText;
+            ProcessTag();
+          }
+          break;
+        }
+        tag_name_.push_back(base::ToLowerASCII(c));
+        if (tag_name_.size() > kMaxTagNameLength) {
+          tag_state_ = TagState::kText;
+        }
+        break;
+      }
+      case TagState::kAttributes: {
+        const size_t tag_end = chunk.find('>', pos);
+        if (tag_end == base::StringPiece::npos) {
+          attributes_.append(chunk.data() + pos, chunk.size() - pos);
+          return status_;
+        }
+        attributes_.append(chunk.data() + pos, tag_end - pos);
+        pos = tag_end + 1;
+        tag_state_ = TagState::kText;
+        ProcessTag();
+        break;
+      }
+    }
+  }
+  return status_;
+}
+
+void AmpBodyScanner::ProcessTag() {
+  if (tag_name_ == "html") {
+    OnHtmlTag();
+  } else if (tag_name_ == "link") {
+    OnLinkTag();
+  } else if (status_ == Status::kScanning) {
+    // <head> or <body> before any <html> tag, so there is no AMP attribute.
+    status_ = Status::kNotAmp;
+  }
+}
+
+void AmpBodyScanner::OnHtmlTag() {
+  if (status_ != Status::kScanning) {
+    return;
+  }
+
+  bool is_amp = false;
+  for (const auto& attribute : ParseAttributes(attributes_)) {
+    if (IsAmpAttribute(attribute)) {
+      is_amp = true;
+      break;
+    }
+  }
+
+  if (!is_amp) {
+    status_ = Status::kNotAmp;
+  } else if (found_canonical_link_) {
+    status_ = Status::kAmpWithCanonicalLink;
+  } else {
+    status_ = Status::kAmp;
+  }
+}
+
+void AmpBodyScanner::OnLinkTag() {
+  if (found_canonical_link_) {
+    return;
+  }
+
+  const std::vector<Attribute> attributes = ParseAttributes(attributes_);
+  bool is_canonical = false;
+  for (const auto& attribute : attributes) {
+    if (base::EqualsCaseInsensitiveASCII(attribute.name, "rel") &&
+        base::EqualsCaseInsensitiveASCII(attribute.value, "canonical")) {
+      is_canonical = true;
+      break;
+    }
+  }
+  if (!is_canonical) {
+    return;
+  }
+
+  found_canonical_link_ = true;
+  for (const auto& attribute : attributes) {
+    if (base::EqualsCaseInsensitiveASCII(attribute.name, "href")) {
+      canonical_href_ = std::string(attribute.value);
+      break;
+    }
+  }
+
+  if (status_ == Status::kAmp) {
+    status_ = Status::kAmpWithCanonicalLink;
+  }
+}
+
+}  // namespace de_amp
@@ -0,0 +1,83 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_DE_AMP_BROWSER_DE_AMP_BODY_SCANNER_H_
+#define BRAVE_COMPONENTS_DE_AMP_BROWSER_DE_AMP_BODY_SCANNER_H_
+
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace de_amp {
+
+// Incremental tokenizer which looks at the tags of a response body as it
+// streams in, so each byte is only scanned once. It finds the <html> tag and
+// checks it for the "amp" or "⚡" attribute, and remembers the first
+// <link rel=canonical> tag.
+// https://amp.dev/documentation/guides-and-tutorials/learn/spec/amphtml/?format=websites#ampd
+class AmpBodyScanner {
+ public:
+  enum class Status {
+    // The <html> tag hasn't been seen yet.
+    kScanning,
+    // The <html> tag has no AMP attribute, <head> or <body> came first, or
+    // the body doesn't start with a tag at all.
+    kNotAmp,
+    // AMP page, still looking for the canonical link.
+    kAmp,
+    // AMP page, and the canonical link tag has been found.
+    kAmpWithCanonicalLink,
+  };
+
+  AmpBodyScanner();
+  ~AmpBodyScanner();
+
+  AmpBodyScanner(const AmpBodyScanner&) = delete;
+  AmpBodyScanner& operator=(const AmpBodyScanner&) = delete;
+
+  // Scans the next chunk of the body. Once |kNotAmp| or
+  // |kAmpWithCanonicalLink| is returned, further chunks are ignored.
+  Status Feed(base::StringPiece chunk);
+
+  Status status() const { return status_; }
+  bool is_amp() const {
+    return status_ == Status::kAmp || status_ == Status::kAmpWithCanonicalLink;
+  }
+
+  // Whether a <link rel=canonical> tag has been seen, and its href if it had
+  // one.
+  bool found_canonical_link() const { return found_canonical_link_; }
+  const absl::optional<std::string>& canonical_href() const {
+    return canonical_href_;
+  }
+
+ private:
+  enum class TagState {
+    // Outside of a tag, looking for the next '<'.
+    kText,
+    // Reading the tag name.
+    kName,
+    // Reading the attributes of a tag we care about, up to the '>'.
+    kAttributes,
+  };
+
+  void ProcessTag();
+  void OnHtmlTag();
+  void OnLinkTag();
+
+  Status status_ = Status::kScanning;
+  bool seen_first_character_ = false;
+  TagState tag_state_ = TagState::kText;
+  std::string tag_name_;
+  std::string attributes_;
+
+  bool found_canonical_link_ = false;
+  absl::optional<std::string> canonical_href_;
+};
+
+}  // namespace de_amp
+
+#endif  // BRAVE_COMPONENTS_DE_AMP_BROWSER_DE_AMP_BODY_SCANNER_H_
@@ -5,9 +5,11 @@
 
 #include "brave/components/de_amp/browser/de_amp_url_loader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/logging.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/body_sniffer/body_sniffer_url_loader.h"
 #include "brave/components/de_amp/browser/de_amp_throttle.h"
 #include "brave/components/de_amp/browser/de_amp_util.h"
@@ -68,23 +70,34 @@ void DeAmpURLLoader::OnBodyReadable(MojoResult) {
     ForwardBodyToClient();
     return;
   }
-  if (!CheckBufferedBody(kMaxBytesToCheck - buffered_body_.size())) {
+  const size_t scanned_bytes = buffered_body_.size();
+  if (!CheckBufferedBody(std::min<uint32_t>(
+          kReadBufferSizeBytes, kMaxBytesToCheck - scanned_bytes))) {
     return;
   }
-  if (MaybeRedirectToCanonicalLink()) {
+  // Only the bytes just read are scanned, the scanner keeps its place.
+  const AmpBodyScanner::Status status = scanner_.Feed(
+      base::StringPiece(buffered_body_).substr(scanned_bytes));
+  if (status == AmpBodyScanner::Status::kAmpWithCanonicalLink &&
+      MaybeRedirectToCanonicalLink()) {
     // Only abort if we know we're successfully going to the canonical URL
     Abort();
     return;
   }
-  // If we were not redirected and we didn't find AMP, or
-  // if we did find AMP previously and we've already read more bytes than
-  // max, complete the load.
-  if (!found_amp_ || read_bytes_ >= kMaxBytesToCheck) {
-    found_amp_ = false;  // reset
-    CompleteLoading(std::move(buffered_body_));
+  // Keep reading while this may still be an AMP page without its canonical
+  // link found yet, up to max bytes. Otherwise complete the load, which for
+  // non-AMP pages happens as soon as the <html> tag has been read, and the
+  // rest of the body is streamed through. An AMP page starts with its <html>
+  // tag, so a first read buffer without one is not an AMP page either.
+  const bool may_be_amp =
+      status == AmpBodyScanner::Status::kAmp ||
+      (status == AmpBodyScanner::Status::kScanning &&
+       read_bytes_ < kReadBufferSizeBytes);
+  if (may_be_amp && de_amp_throttle_ && read_bytes_ < kMaxBytesToCheck) {
+    body_consumer_watcher_.ArmOrNotify();
     return;
   }
-  body_consumer_watcher_.ArmOrNotify();
+  CompleteLoading(std::move(buffered_body_));
 }
 
 bool DeAmpURLLoader::MaybeRedirectToCanonicalLink() {
@@ -92,37 +105,26 @@ bool DeAmpURLLoader::MaybeRedirectToCanonicalLink() {
     return false;
   }
 
-  // If we are not already on an AMP page, check if this chunk has the AMP HTML
-  if (!found_amp_ && !CheckIfAmpPage(buffered_body_)) {
-    return false;
-  }
-
-  found_amp_ = true;  // If we get to this point, we know we have an AMP page
-
-  auto canonical_link = FindCanonicalAmpUrl(buffered_body_);
-  if (!canonical_link.has_value()) {
-    VLOG(2) << __func__ << canonical_link.error();
+  if (!scanner_.canonical_href()) {
+    VLOG(2) << __func__ << " couldn't find canonical URL in link tag";
     return false;
   }
 
-  bool redirected = false;
-  const GURL canonical_url(canonical_link.value());
+  const GURL canonical_url(*scanner_.canonical_href());
   // Validate the found canonical AMP URL
-  if (VerifyCanonicalAmpUrl(canonical_url, response_url_)) {
-    // Attempt to go to the canonical URL
-    VLOG(2) << __func__ << " de-amping and loading " << canonical_url;
-    if (de_amp_throttle_->OpenCanonicalURL(canonical_url, response_url_)) {
-      redirected = true;
-    } else {
-      VLOG(2) << __func__ << " failed to open canonical url: " << canonical_url;
-    }
-  } else {
+  if (!VerifyCanonicalAmpUrl(canonical_url, response_url_)) {
     VLOG(2) << __func__ << " canonical link verification failed "
             << canonical_url;
+    return false;
+  }
+
+  // Attempt to go to the canonical URL
+  VLOG(2) << __func__ << " de-amping and loading " << canonical_url;
+  if (!de_amp_throttle_->OpenCanonicalURL(canonical_url, response_url_)) {
+    VLOG(2) << __func__ << " failed to open canonical url: " << canonical_url;
+    return false;
   }
-  // At this point we've either redirected, or we should stop trying
-  found_amp_ = false;
-  return redirected;
+  return true;
 }
 
 void DeAmpURLLoader::OnBodyWritable(MojoResult r) {
@@ -16,7 +16,8 @@ namespace de_amp {
 // Check feature flag and user pref
 bool IsDeAmpEnabled(PrefService* prefs);
 
-// Run a regex against a string to check if AMP page
+// Check the <html> tag of a complete body for the AMP attribute. Use
+// AmpBodyScanner while the body is streaming in.
 bool CheckIfAmpPage(const std::string& body);
 
 // Find canonical link in body or return error
@@ -0,0 +1,152 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/de_amp/browser/de_amp_body_scanner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace de_amp {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "AmpBodyScanner.";
+constexpr char kMetricTimePerNavigation[] = "time_per_navigation";
+
+// Pages are read in network sized chunks.
+constexpr size_t kChunkSize = 16 * 1024;
+constexpr int kNavigations = 200;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimePerNavigation, "us");
+  return reporter;
+}
+
+// What DeAmpURLLoader did before the scanner: run the regexes over the whole
+// buffered body each time a chunk arrives, until the page is known not to be
+// AMP or the canonical link is found.
+bool DetectWithRegex(base::StringPiece body) {
+  RE2::Options opt;
+  opt.set_case_sensitive(false);
+  opt.set_dot_nl(true);
+  static const base::NoDestructor<re2::RE2> kGetHtmlTagRegex(
+      "(<\\s*?html\\s.*?>)", opt);
+  static const base::NoDestructor<re2::RE2> kDetectAmpRegex(
+      "(?:<.*?\\s.*?(amp|⚡|⚡=\"(?:true|\\s*)\"|⚡=\'(?:true|\\s*)\'|amp=\"(?:"
+      "true|\\s*)\"|amp='(?:true|\\s*)')(?:\\s.*?>|>|/>))",
+      opt);
+  static const base::NoDestructor<re2::RE2> kFindCanonicalLinkTagRegex(
+      "(<\\s*?link\\s[^>]*?rel=(?:\"|')?canonical(?:\"|')?(?:\\s[^>]*?>|>|/"
+      ">))",
+      opt);
+
+  bool found_amp = false;
+  for (size_t size = kChunkSize;; size += kChunkSize) {
+    const base::StringPiece buffered_body =
+        body.substr(0, std::min(size, body.size()));
+    if (!found_amp) {
+      std::string html_tag;
+      if (!RE2::PartialMatch(buffered_body, *kGetHtmlTagRegex, &html_tag) ||
+          !RE2::PartialMatch(html_tag, *kDetectAmpRegex)) {
+        return false;
+      }
+      found_amp = true;
+    }
+    if (RE2::PartialMatch(buffered_body, *kFindCanonicalLinkTagRegex)) {
+      return true;
+    }
+    if (size >= body.size()) {
+      return false;
+    }
+  }
+}
+
+bool DetectWithScanner(base::StringPiece body) {
+  AmpBodyScanner scanner;
+  for (size_t pos = 0; pos < body.size(); pos += kChunkSize) {
+    switch (scanner.Feed(body.substr(pos, kChunkSize))) {
+      case AmpBodyScanner::Status::kNotAmp:
+        return false;
+      case AmpBodyScanner::Status::kAmpWithCanonicalLink:
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+// Pages with heads from 1 KiB to 128 KiB, the canonical link at their end.
+std::vector<std::string> BuildPages(bool amp) {
+  std::vector<std::string> pages;
+  for (size_t head_size = 1024; head_size <= 128 * 1024; head_size *= 2) {
+    std::string page = "<!doctype html>\n<html lang=\"en\"";
+    page += amp ? " ⚡>\n" : ">\n";
+    page += "<head>\n<meta charset=\"utf-8\">\n";
+    while (page.size() < head_size) {
+      page +=
+          "<script async custom-element=\"amp-carousel\" "
+          "src=\"https://cdn.ampproject.org/v0/amp-carousel-0.1.js\">"
+          "</script>\n"
+          "<style amp-custom>.a{color:red}.b{margin:0 auto}</style>\n";
+    }
+    page += "<link rel=\"canonical\" href=\"https://brave.com/article\">\n";
+    page += "</head>\n<body>";
+    page.append(64 * 1024, 'x');
+    page += "</body>\n</html>\n";
+    pages.push_back(std::move(page));
+  }
+  return pages;
+}
+
+void RunBenchmark(bool amp,
+                  bool (*detect)(base::StringPiece),
+                  const std::string& story) {
+  const std::vector<std::string> pages = BuildPages(amp);
+
+  base::ElapsedTimer timer;
+  int detected = 0;
+  for (int i = 0; i < kNavigations; i++) {
+    for (const auto& page : pages) {
+      detected += detect(page);
+    }
+  }
+  SetUpReporter(story).AddResult(
+      kMetricTimePerNavigation,
+      timer.Elapsed() / (kNavigations * pages.size()));
+  EXPECT_EQ(amp ? kNavigations * static_cast<int>(pages.size()) : 0,
+            detected);
+}
+
+}  // namespace
+
+// The time AMP detection adds to each navigation, with the scanner and with
+// the regexes DeAmpURLLoader used to run over the buffered body.
+TEST(AmpBodyScannerPerfTest, AmpPagesRegex) {
+  RunBenchmark(true, &DetectWithRegex, "amp_pages_regex");
+}
+
+TEST(AmpBodyScannerPerfTest, AmpPagesScanner) {
+  RunBenchmark(true, &DetectWithScanner, "amp_pages_scanner");
+}
+
+TEST(AmpBodyScannerPerfTest, NonAmpPagesRegex) {
+  RunBenchmark(false, &DetectWithRegex, "non_amp_pages_regex");
+}
+
+TEST(AmpBodyScannerPerfTest, NonAmpPagesScanner) {
+  RunBenchmark(false, &DetectWithScanner, "non_amp_pages_scanner");
+}
+
+}  // namespace de_amp
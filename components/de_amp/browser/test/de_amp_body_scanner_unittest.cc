@@ -0,0 +1,138 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/de_amp/browser/de_amp_body_scanner.h"
+
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace de_amp {
+
+namespace {
+
+using Status = AmpBodyScanner::Status;
+
+// Feeds |body| in chunks of |chunk_size| bytes and returns the status once
+// the scanner is done or the body ends.
+Status FeedInChunks(AmpBodyScanner* scanner,
+                    base::StringPiece body,
+                    size_t chunk_size) {
+  Status status = scanner->status();
+  for (size_t pos = 0; pos < body.size(); pos += chunk_size) {
+    status = scanner->Feed(body.substr(pos, chunk_size));
+    if (status == Status::kNotAmp || status == Status::kAmpWithCanonicalLink) {
+      break;
+    }
+  }
+  return status;
+}
+
+}  // namespace
+
+TEST(AmpBodyScannerUnitTest, DetectsAmpAcrossChunks) {
+  const std::string body =
+      "<!DOCTYPE html>\n"
+      "<html lang=\"en\" amp>\n"
+      "<head>\n"
+      "<link rel=\"author\" href=\"https://xyz.com\"/>\n"
+      "<link rel=\"canonical\" href=\"https://abc.com\"/>\n"
+      "</head><body></body></html>";
+
+  // Every chunk size splits the tags at different places, including inside
+  // the multibyte "⚡" and inside the attributes.
+  for (size_t chunk_size = 1; chunk_size <= body.size(); chunk_size++) {
+    AmpBodyScanner scanner;
+    EXPECT_EQ(Status::kAmpWithCanonicalLink,
+              FeedInChunks(&scanner, body, chunk_size))
+        << chunk_size;
+    EXPECT_EQ("https://abc.com", scanner.canonical_href().value_or(""))
+        << chunk_size;
+  }
+}
+
+TEST(AmpBodyScannerUnitTest, DetectsEmojiAcrossChunks) {
+  const std::string body =
+      "<html ⚡><head><link rel=canonical href=https://abc.com/></head>";
+  for (size_t chunk_size = 1; chunk_size <= body.size(); chunk_size++) {
+    AmpBodyScanner scanner;
+    EXPECT_EQ(Status::kAmpWithCanonicalLink,
+              FeedInChunks(&scanner, body, chunk_size))
+        << chunk_size;
+    EXPECT_EQ("https://abc.com", scanner.canonical_href().value_or(""))
+        << chunk_size;
+  }
+}
+
+TEST(AmpBodyScannerUnitTest, NotAmpOnceHtmlTagIsRead) {
+  AmpBodyScanner scanner;
+  EXPECT_EQ(Status::kScanning, scanner.Feed("<!DOCTYPE html>\n<ht"));
+  EXPECT_EQ(Status::kScanning, scanner.Feed("ml lang=\"en\" class=\"amp\""));
+  EXPECT_EQ(Status::kNotAmp, scanner.Feed(">\n<head>"));
+  EXPECT_FALSE(scanner.is_amp());
+}
+
+TEST(AmpBodyScannerUnitTest, NotAmpWithoutHtmlTag) {
+  AmpBodyScanner scanner;
+  EXPECT_EQ(Status::kScanning, scanner.Feed("<!DOCTYPE html>\n<title>a"));
+  EXPECT_EQ(Status::kNotAmp, scanner.Feed("</title><head amp>"));
+}
+
+TEST(AmpBodyScannerUnitTest, NotAmpIfBodyDoesNotStartWithTag) {
+  AmpBodyScanner scanner;
+  EXPECT_EQ(Status::kScanning, scanner.Feed(" \n"));
+  EXPECT_EQ(Status::kNotAmp, scanner.Feed("{\"html\": \"<html amp>\"}"));
+  EXPECT_FALSE(scanner.is_amp());
+}
+
+TEST(AmpBodyScannerUnitTest, SkipsByteOrderMark) {
+  const std::string body = "\xEF\xBB\xBF\n<html amp>";
+  for (size_t chunk_size = 1; chunk_size <= body.size(); chunk_size++) {
+    AmpBodyScanner scanner;
+    EXPECT_EQ(Status::kAmp, FeedInChunks(&scanner, body, chunk_size))
+        << chunk_size;
+  }
+}
+
+TEST(AmpBodyScannerUnitTest, AmpWithoutCanonicalLink) {
+  AmpBodyScanner scanner;
+  EXPECT_EQ(Status::kAmp,
+            scanner.Feed("<html amp><head><link rel=\"author\" "
+                         "href=\"https://xyz.com\"></head><body>"));
+  EXPECT_TRUE(scanner.is_amp());
+  EXPECT_FALSE(scanner.found_canonical_link());
+}
+
+TEST(AmpBodyScannerUnitTest, CanonicalLinkWithoutHref) {
+  AmpBodyScanner scanner;
+  EXPECT_EQ(Status::kAmpWithCanonicalLink,
+            scanner.Feed("<html amp><head><link rel=\"canonical\">"));
+  EXPECT_TRUE(scanner.found_canonical_link());
+  EXPECT_FALSE(scanner.canonical_href());
+}
+
+TEST(AmpBodyScannerUnitTest, AmpAttributeValues) {
+  const struct {
+    const char* html_tag;
+    bool is_amp;
+  } kTestCases[] = {
+      {"<html amp>", true},
+      {"<html AMP=\"true\">", true},
+      {"<html amp=' '>", true},
+      {"<html ⚡=\"\" lang=en>", true},
+      {"<html amp=\"false\">", false},
+      {"<html data-amp>", false},
+      {"<html lang=\"amp\">", false},
+      {"<html>", false},
+  };
+  for (const auto& test_case : kTestCases) {
+    AmpBodyScanner scanner;
+    scanner.Feed(test_case.html_tag);
+    EXPECT_EQ(test_case.is_amp, scanner.is_amp()) << test_case.html_tag;
+  }
+}
+
+}  // namespace de_amp
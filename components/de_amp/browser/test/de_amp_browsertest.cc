@@ -24,6 +24,7 @@
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/reload_type.h"
 #include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
 #include "content/public/test/content_mock_cert_verifier.h"
 #include "content/public/test/test_navigation_observer.h"
 #include "net/base/net_errors.h"
@@ -310,6 +311,22 @@ IN_PROC_BROWSER_TEST_F(DeAmpBrowserTest, CanonicalLinkOutsideChunkOutsideMax) {
   NavigateToURLAndWaitForRedirects(original_url, original_url);
 }
 
+IN_PROC_BROWSER_TEST_F(DeAmpBrowserTest, LargeNonAmpBody) {
+  TogglePref(true);
+  // A body which doesn't start with a tag is streamed through once the first
+  // chunk has been read, rather than buffered up to the max bytes to check.
+  const size_t body_size = kTestReadBufferSize * 4;
+  https_server_->RegisterRequestHandler(base::BindRepeating(
+      HandleRequest, kTestCanonicalPage, std::string(body_size, 'a')));
+  ASSERT_TRUE(https_server_->Start());
+
+  const GURL url = https_server_->GetURL(kTestHost, kTestSimpleNonAmpPage);
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), url));
+  EXPECT_EQ(web_contents()->GetLastCommittedURL(), url);
+  EXPECT_EQ(static_cast<int>(body_size),
+            content::EvalJs(web_contents(), "document.body.innerText.length"));
+}
+
 IN_PROC_BROWSER_TEST_F(DeAmpBrowserTest, AmpPagesPointingAtEachOther) {
   TogglePref(true);
   https_server_->RegisterRequestHandler(base::BindRepeating(
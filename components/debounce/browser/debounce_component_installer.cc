@@ -51,10 +51,7 @@ void DebounceComponentInstaller::OnDATFileDataReady(
     LOG(WARNING) << parsed_rules.error();
     return;
   }
-  rules_.clear();
-  host_cache_.clear();
-  rules_ = std::move(parsed_rules.value().first);
-  host_cache_ = parsed_rules.value().second;
+  rules_index_ = DebounceRulesIndex(std::move(parsed_rules.value()));
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
@@ -20,6 +20,7 @@
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/debounce/browser/debounce_rule.h"
+#include "brave/components/debounce/browser/debounce_rules_index.h"
 #include "brave/components/debounce/browser/debounce_service.h"
 
 namespace debounce {
@@ -41,10 +42,7 @@ class DebounceComponentInstaller
       delete;
   ~DebounceComponentInstaller() override;
 
-  const std::vector<std::unique_ptr<DebounceRule>>& rules() const {
-    return rules_;
-  }
-  const base::flat_set<std::string>& host_cache() const { return host_cache_; }
+  const DebounceRulesIndex& rules_index() const { return rules_index_; }
 
   // implementation of brave_component_updater::LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
@@ -70,8 +68,7 @@ class DebounceComponentInstaller
   void LoadDirectlyFromResourcePath();
 
   base::ObserverList<Observer> observers_;
-  std::vector<std::unique_ptr<DebounceRule>> rules_;
-  base::flat_set<std::string> host_cache_;
+  DebounceRulesIndex rules_index_;
   base::FilePath resource_dir_;
 
   base::WeakPtrFactory<DebounceComponentInstaller> weak_factory_{this};
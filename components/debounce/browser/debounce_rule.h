@@ -11,7 +11,6 @@
 #include <utility>
 #include <vector>
 
-#include "base/containers/flat_set.h"
 #include "base/json/json_value_converter.h"
 #include "base/strings/escape.h"
 #include "base/types/expected.h"
@@ -21,6 +20,10 @@
 
 class GURL;
 
+namespace re2 {
+class RE2;
+}  // namespace re2
+
 namespace debounce {
 
 enum DebounceAction {
@@ -49,8 +52,7 @@ class DebounceRule {
                                   DebounceAction* field);
   static bool ParsePrependScheme(base::StringPiece value,
                                  DebouncePrependScheme* field);
-  static base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                                  base::flat_set<std::string>>,
+  static base::expected<std::vector<std::unique_ptr<DebounceRule>>,
                         std::string>
   ParseRules(const std::string& contents);
   static const std::string GetETLDForDebounce(const std::string& host);
@@ -58,17 +60,23 @@ class DebounceRule {
   static bool GetURLPatternSetFromValue(const base::Value* value,
                                         extensions::URLPatternSet* result);
 
+  // Compiles the param regex of a regex-path rule. Called once by
+  // |ParseRules|, so that |Apply| does not compile it for every URL.
+  void CompileParamRegex();
+
   bool Apply(const GURL& original_url,
              GURL* final_url,
              const PrefService* prefs) const;
   const extensions::URLPatternSet& include_pattern_set() const {
     return include_pattern_set_;
   }
+  DebounceAction action() const { return action_; }
+  // Null unless this is a regex-path rule with a valid param regex.
+  const re2::RE2* param_regex() const { return param_regex_.get(); }
 
  private:
   bool CheckPrefForRule(const PrefService* prefs) const;
-  bool ValidateAndParsePatternRegex(const std::string& pattern,
-                                    const std::string& path,
+  bool ValidateAndParsePatternRegex(const std::string& path,
                                     std::string* parsed_value) const;
   extensions::URLPatternSet include_pattern_set_;
   extensions::URLPatternSet exclude_pattern_set_;
@@ -76,6 +84,7 @@ class DebounceRule {
   DebouncePrependScheme prepend_scheme_;
   std::string param_;
   std::string pref_;
+  std::unique_ptr<re2::RE2> param_regex_;
 };
 
 }  // namespace debounce
@@ -0,0 +1,171 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/debounce/browser/debounce_rules_index.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/containers/flat_set.h"
+#include "base/logging.h"
+#include "extensions/common/url_pattern.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "url/gurl.h"
+
+namespace debounce {
+
+namespace {
+
+// Same bound for each pattern as DebounceRule uses for a single regex.
+const int64_t kMaxMemoryPerRegexPattern = 2 << 11;
+
+struct RuleHosts {
+  // The eTLD+1s of the include patterns limited to a single eTLD+1.
+  base::flat_set<std::string> hosts;
+  // Whether an include pattern is not limited to a single eTLD+1, e.g.
+  // "*://*/*" or "*://*.com/*".
+  bool any_host = false;
+};
+
+RuleHosts GetHostsForRule(const DebounceRule& rule) {
+  RuleHosts rule_hosts;
+  for (const URLPattern& pattern : rule.include_pattern_set()) {
+    const std::string etldp1 = DebounceRule::GetETLDForDebounce(pattern.host());
+    if (etldp1.empty())
+      rule_hosts.any_host = true;
+    else
+      rule_hosts.hosts.insert(etldp1);
+  }
+  return rule_hosts;
+}
+
+std::unique_ptr<re2::RE2::Set> BuildPathRegexSet(
+    const std::vector<const DebounceRule*>& rules,
+    std::vector<size_t>* path_regex_rule_positions) {
+  size_t regex_count = 0;
+  for (const DebounceRule* rule : rules) {
+    if (rule->param_regex())
+      regex_count++;
+  }
+  if (regex_count == 0)
+    return nullptr;
+
+  re2::RE2::Options options;
+  options.set_max_mem(kMaxMemoryPerRegexPattern * regex_count);
+  auto path_regex_set =
+      std::make_unique<re2::RE2::Set>(options, re2::RE2::UNANCHORED);
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const re2::RE2* param_regex = rules[i]->param_regex();
+    if (!param_regex)
+      continue;
+    std::string error;
+    if (path_regex_set->Add(param_regex->pattern(), &error) < 0) {
+      VLOG(1) << "Could not add debounce regex to set: " << error;
+      return nullptr;
+    }
+    positions.push_back(i);
+  }
+  if (!path_regex_set->Compile()) {
+    VLOG(1) << "Could not compile debounce regex set";
+    return nullptr;
+  }
+
+  *path_regex_rule_positions = std::move(positions);
+  return path_regex_set;
+}
+
+}  // namespace
+
+DebounceRulesIndex::HostRules::HostRules() = default;
+DebounceRulesIndex::HostRules::HostRules(HostRules&&) = default;
+DebounceRulesIndex::HostRules& DebounceRulesIndex::HostRules::operator=(
+    HostRules&&) = default;
+DebounceRulesIndex::HostRules::~HostRules() = default;
+
+DebounceRulesIndex::DebounceRulesIndex() = default;
+
+DebounceRulesIndex::DebounceRulesIndex(
+    std::vector<std::unique_ptr<DebounceRule>> rules)
+    : rules_(std::move(rules)) {
+  std::vector<RuleHosts> rule_hosts;
+  rule_hosts.reserve(rules_.size());
+  base::flat_set<std::string> all_hosts;
+  for (const std::unique_ptr<DebounceRule>& rule : rules_) {
+    rule_hosts.push_back(GetHostsForRule(*rule));
+    all_hosts.insert(rule_hosts.back().hosts.begin(),
+                     rule_hosts.back().hosts.end());
+  }
+
+  // A rule not limited to some hosts is tried for every host which has rules,
+  // as all rules used to be tried for the hosts in the host cache.
+  std::map<std::string, HostRules> host_rules;
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const base::flat_set<std::string>& hosts =
+        rule_hosts[i].any_host ? all_hosts : rule_hosts[i].hosts;
+    for (const std::string& host : hosts)
+      host_rules[host].rules.push_back(rules_[i].get());
+  }
+
+  for (auto& [host, rules_for_host] : host_rules) {
+    rules_for_host.path_regex_set = BuildPathRegexSet(
+        rules_for_host.rules, &rules_for_host.path_regex_rule_positions);
+  }
+
+  host_rules_ = base::flat_map<std::string, HostRules>(
+      std::make_move_iterator(host_rules.begin()),
+      std::make_move_iterator(host_rules.end()));
+}
+
+DebounceRulesIndex::DebounceRulesIndex(DebounceRulesIndex&&) = default;
+DebounceRulesIndex& DebounceRulesIndex::operator=(DebounceRulesIndex&&) =
+    default;
+DebounceRulesIndex::~DebounceRulesIndex() = default;
+
+bool DebounceRulesIndex::Apply(const GURL& original_url,
+                               GURL* final_url,
+                               const PrefService* prefs) const {
+  const auto it =
+      host_rules_.find(DebounceRule::GetETLDForDebounce(original_url.host()));
+  if (it == host_rules_.end())
+    return false;
+  const HostRules& host_rules = it->second;
+
+  // Regex-path rules whose regex does not match the path cannot apply.
+  std::vector<bool> may_apply(host_rules.rules.size(), true);
+  if (host_rules.path_regex_set) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (host_rules.path_regex_set->Match(original_url.path(), &matches,
+                                         &error_info) ||
+        error_info.kind == re2::RE2::Set::kNoError) {
+      for (size_t position : host_rules.path_regex_rule_positions)
+        may_apply[position] = false;
+      for (int match : matches)
+        may_apply[host_rules.path_regex_rule_positions[match]] = true;
+    } else {
+      // Out of memory, so each rule tries its own regex instead.
+      VLOG(1) << "Failed to match debounce regex set";
+    }
+  }
+
+  for (size_t i = 0; i < host_rules.rules.size(); ++i) {
+    if (!may_apply[i])
+      continue;
+    if (host_rules.rules[i]->Apply(original_url, final_url, prefs)) {
+      if (original_url != *final_url) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool DebounceRulesIndex::HasRulesForHost(const std::string& host) const {
+  return host_rules_.contains(DebounceRule::GetETLDForDebounce(host));
+}
+
+}  // namespace debounce
@@ -0,0 +1,70 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULES_INDEX_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "brave/components/debounce/browser/debounce_rule.h"
+#include "third_party/re2/src/re2/set.h"
+
+class GURL;
+class PrefService;
+
+namespace debounce {
+
+// Debounce rules grouped by the eTLD+1 of their include patterns, built once
+// when the rules are loaded so that a navigation only tries the rules which
+// can apply to its host. The param regexes of the regex-path rules for a host
+// are also combined into a single RE2::Set, so that rules whose regex does not
+// match the path are skipped without running their regex.
+class DebounceRulesIndex {
+ public:
+  DebounceRulesIndex();
+  explicit DebounceRulesIndex(
+      std::vector<std::unique_ptr<DebounceRule>> rules);
+  DebounceRulesIndex(const DebounceRulesIndex&) = delete;
+  DebounceRulesIndex& operator=(const DebounceRulesIndex&) = delete;
+  DebounceRulesIndex(DebounceRulesIndex&&);
+  DebounceRulesIndex& operator=(DebounceRulesIndex&&);
+  ~DebounceRulesIndex();
+
+  // Applies the first rule, in rule list order, which debounces
+  // |original_url| to a different URL.
+  bool Apply(const GURL& original_url,
+             GURL* final_url,
+             const PrefService* prefs) const;
+
+  bool HasRulesForHost(const std::string& host) const;
+
+  size_t rules_count() const { return rules_.size(); }
+
+ private:
+  struct HostRules {
+    HostRules();
+    HostRules(HostRules&&);
+    HostRules& operator=(HostRules&&);
+    ~HostRules();
+
+    // In rule list order.
+    std::vector<const DebounceRule*> rules;
+    // Matches the param regexes of the regex-path rules in |rules|. Null if
+    // there are none, or if they could not be compiled together.
+    std::unique_ptr<re2::RE2::Set> path_regex_set;
+    // For each regex in |path_regex_set|, the position of its rule in |rules|.
+    std::vector<size_t> path_regex_rule_positions;
+  };
+
+  std::vector<std::unique_ptr<DebounceRule>> rules_;
+  base::flat_map<std::string, HostRules> host_rules_;
+};
+
+}  // namespace debounce
+
+#endif  // BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULES_INDEX_H_
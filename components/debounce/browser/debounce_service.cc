@@ -5,14 +5,9 @@
 
 #include "brave/components/debounce/browser/debounce_service.h"
 
-#include <memory>
-#include <string>
-#include <vector>
-
-#include "base/containers/contains.h"
-#include "base/containers/flat_set.h"
 #include "base/logging.h"
 #include "brave/components/debounce/browser/debounce_component_installer.h"
+#include "brave/components/debounce/browser/debounce_rules_index.h"
 #include "brave/components/debounce/common/pref_names.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -29,26 +24,9 @@ DebounceService::~DebounceService() = default;
 
 bool DebounceService::Debounce(const GURL& original_url,
                                GURL* final_url) const {
-  // Check host cache to see if this URL needs to have any debounce rules
-  // applied.
-  const base::flat_set<std::string>& host_cache =
-      component_installer_->host_cache();
-  const std::string etldp1 =
-      DebounceRule::GetETLDForDebounce(original_url.host());
-  if (!base::Contains(host_cache, etldp1))
-    return false;
-
-  const std::vector<std::unique_ptr<DebounceRule>>& rules =
-      component_installer_->rules();
-
-  for (const std::unique_ptr<DebounceRule>& rule : rules) {
-    if (rule->Apply(original_url, final_url, prefs_)) {
-      if (original_url != *final_url) {
-        return true;
-      }
-    }
-  }
-  return false;
+  // Only the rules for the host of this URL are tried.
+  return component_installer_->rules_index().Apply(original_url, final_url,
+                                                   prefs_);
 }
 
 // static
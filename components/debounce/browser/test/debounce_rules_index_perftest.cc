@@ -0,0 +1,150 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/debounce/browser/debounce_rule.h"
+#include "brave/components/debounce/browser/debounce_rules_index.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace debounce {
+
+namespace {
+
+// Pass --debounce-rules-file=<debounce.json> to use the real rule list, and
+// --debounce-navigation-log=<file> with one URL per line to replay recorded
+// navigations. Defaults to synthetic rules and navigations.
+constexpr char kRulesFileSwitch[] = "debounce-rules-file";
+constexpr char kNavigationLogSwitch[] = "debounce-navigation-log";
+
+constexpr char kMetricPrefix[] = "DebounceRulesIndex.";
+constexpr char kMetricBuildTime[] = "build_time";
+constexpr char kMetricTimePerNavigation[] = "time_per_navigation";
+
+constexpr int kSyntheticRules = 500;
+constexpr int kSyntheticSites = 1000;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricBuildTime, "us");
+  reporter.RegisterImportantMetric(kMetricTimePerNavigation, "us");
+  return reporter;
+}
+
+std::string GetRules() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  std::string contents;
+  if (command_line.HasSwitch(kRulesFileSwitch)) {
+    EXPECT_TRUE(base::ReadFileToString(
+        command_line.GetSwitchValuePath(kRulesFileSwitch), &contents));
+    return contents;
+  }
+
+  contents = "[";
+  for (int i = 0; i < kSyntheticRules; ++i) {
+    if (i) {
+      contents += ",";
+    }
+    contents += base::StringPrintf(
+        R"({"include": ["*://tracker%d.com/?url=*"], "exclude": [],
+            "action": "redirect", "param": "url"})",
+        i);
+  }
+  contents += "]";
+  return contents;
+}
+
+std::vector<GURL> GetNavigations() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  std::vector<GURL> navigations;
+  if (command_line.HasSwitch(kNavigationLogSwitch)) {
+    std::string log;
+    EXPECT_TRUE(base::ReadFileToString(
+        command_line.GetSwitchValuePath(kNavigationLogSwitch), &log));
+    for (const auto& line : base::SplitStringPiece(
+             log, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+      navigations.emplace_back(line);
+    }
+    return navigations;
+  }
+
+  // Half of the navigations go through a tracker.
+  for (int i = 0; i < kSyntheticSites; ++i) {
+    navigations.emplace_back(
+        base::StringPrintf("https://tracker%d.com/?url=https://site%d.com/",
+                           i % kSyntheticRules, i));
+    navigations.emplace_back(
+        base::StringPrintf("https://site%d.com/page?id=%d", i, i));
+  }
+  return navigations;
+}
+
+std::vector<std::unique_ptr<DebounceRule>> ParseRules(
+    const std::string& contents) {
+  auto parsed = DebounceRule::ParseRules(contents);
+  EXPECT_TRUE(parsed.has_value());
+  return parsed.has_value() ? std::move(parsed.value())
+                            : std::vector<std::unique_ptr<DebounceRule>>();
+}
+
+}  // namespace
+
+// What DebounceService did before rules were indexed: try every rule.
+TEST(DebounceRulesIndexPerfTest, LinearWalk) {
+  const std::vector<std::unique_ptr<DebounceRule>> rules =
+      ParseRules(GetRules());
+  const std::vector<GURL> navigations = GetNavigations();
+  ASSERT_FALSE(navigations.empty());
+  TestingPrefServiceSimple prefs;
+
+  base::ElapsedTimer timer;
+  for (const GURL& url : navigations) {
+    GURL final_url;
+    for (const std::unique_ptr<DebounceRule>& rule : rules) {
+      if (rule->Apply(url, &final_url, &prefs) && url != final_url) {
+        break;
+      }
+    }
+  }
+  SetUpReporter("linear_walk")
+      .AddResult(kMetricTimePerNavigation,
+                 timer.Elapsed() / navigations.size());
+}
+
+TEST(DebounceRulesIndexPerfTest, Index) {
+  const std::string contents = GetRules();
+  const std::vector<GURL> navigations = GetNavigations();
+  ASSERT_FALSE(navigations.empty());
+  TestingPrefServiceSimple prefs;
+  auto reporter = SetUpReporter("index");
+
+  base::ElapsedTimer build_timer;
+  const DebounceRulesIndex index(ParseRules(contents));
+  reporter.AddResult(kMetricBuildTime, build_timer.Elapsed());
+
+  base::ElapsedTimer timer;
+  for (const GURL& url : navigations) {
+    GURL final_url;
+    index.Apply(url, &final_url, &prefs);
+  }
+  reporter.AddResult(kMetricTimePerNavigation,
+                     timer.Elapsed() / navigations.size());
+}
+
+}  // namespace debounce
@@ -0,0 +1,182 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/debounce/browser/debounce_rules_index.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "brave/components/constants/brave_paths.h"
+#include "brave/components/debounce/browser/debounce_rule.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace debounce {
+
+namespace {
+
+std::vector<std::unique_ptr<DebounceRule>> ParseRules(
+    const std::string& contents) {
+  auto parsed = DebounceRule::ParseRules(contents);
+  EXPECT_TRUE(parsed.has_value());
+  return std::move(parsed.value());
+}
+
+std::string ReadTestRules() {
+  base::FilePath test_data_dir;
+  base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(
+      test_data_dir.AppendASCII("debounce-data/1/debounce.json"), &contents));
+  return contents;
+}
+
+// What DebounceService did before rules were indexed.
+bool ApplyLinearWalk(const std::vector<std::unique_ptr<DebounceRule>>& rules,
+                     const GURL& original_url,
+                     GURL* final_url,
+                     const PrefService* prefs) {
+  for (const std::unique_ptr<DebounceRule>& rule : rules) {
+    if (rule->Apply(original_url, final_url, prefs)) {
+      if (original_url != *final_url) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::string Debounce(const DebounceRulesIndex& index, const GURL& url) {
+  TestingPrefServiceSimple prefs;
+  GURL final_url;
+  if (!index.Apply(url, &final_url, &prefs))
+    return "";
+  return final_url.spec();
+}
+
+}  // namespace
+
+TEST(DebounceRulesIndexUnitTest, MatchesLinearWalk) {
+  const std::string contents = ReadTestRules();
+  const std::vector<std::unique_ptr<DebounceRule>> rules =
+      ParseRules(contents);
+  const DebounceRulesIndex index(ParseRules(contents));
+  ASSERT_EQ(rules.size(), index.rules_count());
+
+  const char* const kUrls[] = {
+      "http://simple.a.com/?url=https://brave.com/",
+      "http://base64.a.com/?url=aHR0cHM6Ly9icmF2ZS5jb20v",
+      "http://double.a.com/?url=http://double.b.com/?url=https://brave.com/",
+      "http://simple.a.com/?other=https://brave.com/",
+      "http://unknown.com/?url=https://brave.com/",
+      "https://brave.com/",
+  };
+  TestingPrefServiceSimple prefs;
+  for (const char* url : kUrls) {
+    GURL expected_url;
+    const bool expected =
+        ApplyLinearWalk(rules, GURL(url), &expected_url, &prefs);
+    GURL final_url;
+    EXPECT_EQ(expected, index.Apply(GURL(url), &final_url, &prefs)) << url;
+    EXPECT_EQ(expected_url, final_url) << url;
+  }
+}
+
+TEST(DebounceRulesIndexUnitTest, OnlyTriesRulesForHost) {
+  const DebounceRulesIndex index(ParseRules(R"json(
+      [{
+          "include": ["*://a.com/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": ["*://*.b.com/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "to"
+      }]
+    )json"));
+
+  EXPECT_TRUE(index.HasRulesForHost("a.com"));
+  EXPECT_TRUE(index.HasRulesForHost("www.b.com"));
+  EXPECT_FALSE(index.HasRulesForHost("c.com"));
+
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://a.com/?url=https://brave.com/")));
+  EXPECT_EQ("", Debounce(index, GURL("https://a.com/?to=https://brave.com/")));
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://x.b.com/?to=https://brave.com/")));
+  EXPECT_EQ("", Debounce(index, GURL("https://c.com/?url=https://brave.com/")));
+}
+
+TEST(DebounceRulesIndexUnitTest, KeepsHostsOfRuleWithWildcard) {
+  // The rule applies to every host with rules, and to a.com even though no
+  // other rule names it.
+  const DebounceRulesIndex index(ParseRules(R"json(
+      [{
+          "include": ["*://a.com/*", "*://*/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": ["*://b.com/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "to"
+      }]
+    )json"));
+
+  EXPECT_TRUE(index.HasRulesForHost("a.com"));
+  EXPECT_TRUE(index.HasRulesForHost("b.com"));
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://a.com/?url=https://brave.com/")));
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://b.com/?url=https://brave.com/")));
+}
+
+TEST(DebounceRulesIndexUnitTest, RegexSetKeepsRuleOrder) {
+  // The last rule matches every path, so it only applies when no earlier rule
+  // does. The invalid regex must not stop the others from being indexed.
+  const DebounceRulesIndex index(ParseRules(R"json(
+      [{
+          "include": ["*://test.com/*"],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "^/first/(.*)$"
+      }, {
+          "include": ["*://test.com/*"],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "())"
+      }, {
+          "include": ["*://test.com/*"],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "^/second/(.*)$"
+      }, {
+          "include": ["*://test.com/*"],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "^/(.*)$"
+      }]
+    )json"));
+
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://test.com/first/https://brave.com/")));
+  EXPECT_EQ(
+      "https://brave.com/",
+      Debounce(index, GURL("https://test.com/second/https://brave.com/")));
+  EXPECT_EQ("https://brave.com/",
+            Debounce(index, GURL("https://test.com/https://brave.com/")));
+  EXPECT_EQ("", Debounce(index, GURL("https://test.com/nothing")));
+}
+
+}  // namespace debounce
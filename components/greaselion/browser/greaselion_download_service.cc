@@ -92,19 +92,19 @@ void GreaselionRule::Parse(base::Value::Dict* preconditions_value,
     for (const auto kv : *preconditions_value) {
       GreaselionPreconditionValue condition = ParsePrecondition(kv.second);
       if (kv.first == kRewards) {
-        preconditions_.rewards_enabled = condition;
+        SetPrecondition(REWARDS, condition);
       } else if (kv.first == kTwitterTips) {
-        preconditions_.twitter_tips_enabled = condition;
+        SetPrecondition(TWITTER_TIPS, condition);
       } else if (kv.first == kRedditTips) {
-        preconditions_.reddit_tips_enabled = condition;
+        SetPrecondition(REDDIT_TIPS, condition);
       } else if (kv.first == kGithubTips) {
-        preconditions_.github_tips_enabled = condition;
+        SetPrecondition(GITHUB_TIPS, condition);
       } else if (kv.first == kAutoContribution) {
-        preconditions_.auto_contribution_enabled = condition;
+        SetPrecondition(AUTO_CONTRIBUTION, condition);
       } else if (kv.first == kAds) {
-        preconditions_.ads_enabled = condition;
+        SetPrecondition(ADS, condition);
       } else if (kv.first == kSupportsMinimumBraveVersion) {
-        preconditions_.supports_minimum_brave_version = condition;
+        SetPrecondition(SUPPORTS_MINIMUM_BRAVE_VERSION, condition);
       } else {
         LOG(INFO) << "Greaselion encountered an unknown precondition: "
             << kv.first;
@@ -141,53 +141,38 @@ void GreaselionRule::Parse(base::Value::Dict* preconditions_value,
 
 GreaselionRule::~GreaselionRule() = default;
 
-bool GreaselionRule::PreconditionFulfilled(
-    GreaselionPreconditionValue precondition,
-    bool value) const {
-  switch (precondition) {
-    case kMustBeTrue:
-      return value;
-    case kMustBeFalse:
-      return !value;
-    default:
-      return true;
+void GreaselionRule::SetPrecondition(GreaselionFeature feature,
+                                     GreaselionPreconditionValue condition) {
+  const GreaselionFeatureBits bit = ToFeatureBit(feature);
+  precondition_mask_ &= ~bit;
+  precondition_values_ &= ~bit;
+  if (condition != kAny) {
+    precondition_mask_ |= bit;
+  }
+  if (condition == kMustBeTrue) {
+    precondition_values_ |= bit;
   }
 }
 
 bool GreaselionRule::Matches(
     GreaselionFeatures state, const base::Version& browser_version) const {
-  // Validate against preconditions.
-  if (!PreconditionFulfilled(preconditions_.rewards_enabled,
-                             state[greaselion::REWARDS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.twitter_tips_enabled,
-                             state[greaselion::TWITTER_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.reddit_tips_enabled,
-                             state[greaselion::REDDIT_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.github_tips_enabled,
-                             state[greaselion::GITHUB_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.auto_contribution_enabled,
-                             state[greaselion::AUTO_CONTRIBUTION]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.supports_minimum_brave_version,
-                          state[greaselion::SUPPORTS_MINIMUM_BRAVE_VERSION]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.ads_enabled,
-                             state[greaselion::ADS]))
-    return false;
-  // Validate against browser version.
-  if (base::Version::IsValidWildcardString(minimum_brave_version_)) {
-    bool rule_version_is_higher_than_browser =
-        (browser_version.CompareToWildcardString(minimum_brave_version_) < 0);
-    if (rule_version_is_higher_than_browser) {
-      return false;
+  GreaselionFeatureBits feature_bits = 0;
+  for (const auto& [feature, enabled] : state) {
+    if (enabled) {
+      feature_bits |= ToFeatureBit(feature);
     }
   }
-  // Rule matches current state.
-  return true;
+  return MatchesFeatures(feature_bits) &&
+         SupportsBrowserVersion(browser_version);
+}
+
+bool GreaselionRule::SupportsBrowserVersion(
+    const base::Version& browser_version) const {
+  if (!base::Version::IsValidWildcardString(minimum_brave_version_)) {
+    return true;
+  }
+  // The rule is not supported if its version is higher than the browser's.
+  return browser_version.CompareToWildcardString(minimum_brave_version_) >= 0;
 }
 
 GreaselionDownloadService::GreaselionDownloadService(
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -40,15 +41,13 @@ extern const char kGreaselionConfigFileVersion[];
 
 enum GreaselionPreconditionValue { kMustBeFalse, kMustBeTrue, kAny };
 
-struct GreaselionPreconditions {
-  GreaselionPreconditionValue rewards_enabled = kAny;
-  GreaselionPreconditionValue twitter_tips_enabled = kAny;
-  GreaselionPreconditionValue reddit_tips_enabled = kAny;
-  GreaselionPreconditionValue github_tips_enabled = kAny;
-  GreaselionPreconditionValue auto_contribution_enabled = kAny;
-  GreaselionPreconditionValue ads_enabled = kAny;
-  GreaselionPreconditionValue supports_minimum_brave_version = kAny;
-};
+// One bit per GreaselionFeature, set if the feature is enabled.
+using GreaselionFeatureBits = uint32_t;
+
+inline constexpr GreaselionFeatureBits ToFeatureBit(
+    GreaselionFeature feature) {
+  return GreaselionFeatureBits{1} << feature;
+}
 
 class GreaselionRule {
  public:
@@ -66,6 +65,10 @@ class GreaselionRule {
              const base::FilePath& resource_dir);
   bool Matches(
       GreaselionFeatures state, const base::Version& browser_version) const;
+  bool MatchesFeatures(GreaselionFeatureBits feature_bits) const {
+    return (feature_bits & precondition_mask_) == precondition_values_;
+  }
+  bool SupportsBrowserVersion(const base::Version& browser_version) const;
   std::string name() const { return name_; }
   std::vector<std::string> url_patterns() const { return url_patterns_; }
   std::vector<base::FilePath> scripts() const { return scripts_; }
@@ -76,12 +79,18 @@ class GreaselionRule {
     return messages_;
   }
   bool has_unknown_preconditions() const { return has_unknown_preconditions_; }
+  // The features the rule has a precondition on, and the values it needs them
+  // to have.
+  GreaselionFeatureBits precondition_mask() const { return precondition_mask_; }
+  GreaselionFeatureBits precondition_values() const {
+    return precondition_values_;
+  }
 
  private:
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
   GreaselionPreconditionValue ParsePrecondition(const base::Value& value);
-  bool PreconditionFulfilled(GreaselionPreconditionValue precondition,
-                             bool value) const;
+  void SetPrecondition(GreaselionFeature feature,
+                       GreaselionPreconditionValue condition);
 
   std::string name_;
   std::vector<std::string> url_patterns_;
@@ -89,7 +98,8 @@ class GreaselionRule {
   std::string run_at_;
   std::string minimum_brave_version_;
   base::FilePath messages_;
-  GreaselionPreconditions preconditions_;
+  GreaselionFeatureBits precondition_mask_ = 0;
+  GreaselionFeatureBits precondition_values_ = 0;
   bool has_unknown_preconditions_ = false;
 };
 
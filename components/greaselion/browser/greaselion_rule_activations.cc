@@ -0,0 +1,99 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_rule_activations.h"
+
+#include "base/check_op.h"
+#include "base/version.h"
+
+namespace greaselion {
+
+GreaselionRuleActivations::GreaselionRuleActivations() = default;
+
+GreaselionRuleActivations::~GreaselionRuleActivations() = default;
+
+void GreaselionRuleActivations::Reset(
+    const std::vector<std::unique_ptr<GreaselionRule>>& rules,
+    const base::Version& browser_version) {
+  activations_.clear();
+  activations_.reserve(rules.size());
+  for (auto& rule_indices : rules_by_feature_) {
+    rule_indices.clear();
+  }
+  active_count_ = 0;
+
+  for (size_t i = 0; i < rules.size(); i++) {
+    const GreaselionRule& rule = *rules[i];
+    RuleActivation activation;
+    activation.precondition_mask = rule.precondition_mask();
+    activation.precondition_values = rule.precondition_values();
+    activation.supported = !rule.has_unknown_preconditions() &&
+                           rule.SupportsBrowserVersion(browser_version);
+    activation.active = ShouldBeActive(activation);
+    if (activation.active) {
+      active_count_++;
+    }
+    activations_.push_back(activation);
+
+    for (int feature = FIRST_FEATURE; feature != LAST_FEATURE; feature++) {
+      if (activation.precondition_mask &
+          ToFeatureBit(static_cast<GreaselionFeature>(feature))) {
+        rules_by_feature_[feature].push_back(i);
+      }
+    }
+  }
+}
+
+bool GreaselionRuleActivations::SetFeatureEnabled(GreaselionFeature feature,
+                                                  bool enabled) {
+  DCHECK(feature >= FIRST_FEATURE && feature < LAST_FEATURE);
+  if (IsFeatureEnabled(feature) == enabled) {
+    return false;
+  }
+
+  if (enabled) {
+    feature_bits_ |= ToFeatureBit(feature);
+  } else {
+    feature_bits_ &= ~ToFeatureBit(feature);
+  }
+
+  bool changed = false;
+  for (const size_t index : rules_by_feature_[feature]) {
+    RuleActivation& activation = activations_[index];
+    const bool active = ShouldBeActive(activation);
+    if (active == activation.active) {
+      continue;
+    }
+
+    activation.active = active;
+    if (active) {
+      active_count_++;
+    } else {
+      active_count_--;
+    }
+    changed = true;
+  }
+
+  return changed;
+}
+
+bool GreaselionRuleActivations::IsFeatureEnabled(
+    GreaselionFeature feature) const {
+  return feature_bits_ & ToFeatureBit(feature);
+}
+
+bool GreaselionRuleActivations::IsActive(size_t index) const {
+  DCHECK_LT(index, activations_.size());
+  return activations_[index].active;
+}
+
+bool GreaselionRuleActivations::ShouldBeActive(
+    const RuleActivation& activation) const {
+  return activation.supported &&
+         (feature_bits_ & activation.precondition_mask) ==
+             activation.precondition_values;
+}
+
+}  // namespace greaselion
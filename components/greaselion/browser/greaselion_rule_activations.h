@@ -0,0 +1,70 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_H_
+#define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "brave/components/greaselion/browser/greaselion_service.h"
+
+namespace base {
+class Version;
+}
+
+namespace greaselion {
+
+// Keeps track of which Greaselion rules should be installed for the enabled
+// features and the browser version. The browser version is checked once per
+// |Reset|, and the preconditions of each rule are kept as bitmasks, so
+// enabling or disabling a feature only re-evaluates the rules which have a
+// precondition on it.
+class GreaselionRuleActivations {
+ public:
+  GreaselionRuleActivations();
+  GreaselionRuleActivations(const GreaselionRuleActivations&) = delete;
+  GreaselionRuleActivations& operator=(const GreaselionRuleActivations&) =
+      delete;
+  ~GreaselionRuleActivations();
+
+  // Re-evaluates all of |rules|, e.g. after they were reloaded or the browser
+  // version changed.
+  void Reset(const std::vector<std::unique_ptr<GreaselionRule>>& rules,
+             const base::Version& browser_version);
+
+  // Returns true if any rule was activated or deactivated.
+  bool SetFeatureEnabled(GreaselionFeature feature, bool enabled);
+  bool IsFeatureEnabled(GreaselionFeature feature) const;
+
+  // Whether the rule at |index| of the rules passed to |Reset| is active.
+  bool IsActive(size_t index) const;
+
+  size_t size() const { return activations_.size(); }
+  size_t active_count() const { return active_count_; }
+
+ private:
+  struct RuleActivation {
+    GreaselionFeatureBits precondition_mask = 0;
+    GreaselionFeatureBits precondition_values = 0;
+    // False if the rule has unknown preconditions or needs a newer browser.
+    bool supported = false;
+    bool active = false;
+  };
+
+  bool ShouldBeActive(const RuleActivation& activation) const;
+
+  GreaselionFeatureBits feature_bits_ = 0;
+  std::vector<RuleActivation> activations_;
+  // Indices of the rules with a precondition on each feature.
+  std::array<std::vector<size_t>, LAST_FEATURE> rules_by_feature_;
+  size_t active_count_ = 0;
+};
+
+}  // namespace greaselion
+
+#endif  // BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_H_
@@ -0,0 +1,98 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/timer/elapsed_timer.h"
+#include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_rule_activations.h"
+#include "brave/components/greaselion/browser/greaselion_rule_activations_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace greaselion {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "GreaselionRuleActivations.";
+constexpr char kMetricResetTime[] = "reset_time";
+constexpr char kMetricTimePerFeatureChange[] = "time_per_feature_change";
+
+constexpr char kBrowserVersion[] = "1.2.3.4";
+constexpr int kRuleCount = 5000;
+constexpr int kFeatureChangeCount = 1000;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricResetTime, "us");
+  reporter.RegisterImportantMetric(kMetricTimePerFeatureChange, "us");
+  return reporter;
+}
+
+std::vector<std::pair<GreaselionFeature, bool>> BuildFeatureChanges(
+    RandomGenerator* generator) {
+  std::vector<std::pair<GreaselionFeature, bool>> feature_changes;
+  for (int i = 0; i < kFeatureChangeCount; i++) {
+    feature_changes.emplace_back(
+        static_cast<GreaselionFeature>(generator->Next() % LAST_FEATURE),
+        generator->Next() % 2 == 1);
+  }
+  return feature_changes;
+}
+
+}  // namespace
+
+// What GreaselionServiceImpl did before the rule activations: match every
+// rule against the features on each feature change.
+TEST(GreaselionRuleActivationsPerfTest, Matches) {
+  RandomGenerator generator;
+  const std::vector<std::unique_ptr<GreaselionRule>> rules =
+      BuildSyntheticRules(&generator, kRuleCount);
+  const auto feature_changes = BuildFeatureChanges(&generator);
+  const base::Version browser_version(kBrowserVersion);
+
+  GreaselionFeatures state;
+  size_t matches_count = 0;
+  base::ElapsedTimer timer;
+  for (const auto& [feature, enabled] : feature_changes) {
+    state[feature] = enabled;
+    for (const auto& rule : rules) {
+      matches_count += rule->Matches(state, browser_version) &&
+                       !rule->has_unknown_preconditions();
+    }
+  }
+  SetUpReporter("matches_5k_rules")
+      .AddResult(kMetricTimePerFeatureChange,
+                 timer.Elapsed() / kFeatureChangeCount);
+  EXPECT_GT(matches_count, 0U);
+}
+
+TEST(GreaselionRuleActivationsPerfTest, Activations) {
+  RandomGenerator generator;
+  const std::vector<std::unique_ptr<GreaselionRule>> rules =
+      BuildSyntheticRules(&generator, kRuleCount);
+  const auto feature_changes = BuildFeatureChanges(&generator);
+  auto reporter = SetUpReporter("activations_5k_rules");
+
+  GreaselionRuleActivations rule_activations;
+  base::ElapsedTimer reset_timer;
+  rule_activations.Reset(rules, base::Version(kBrowserVersion));
+  reporter.AddResult(kMetricResetTime, reset_timer.Elapsed());
+
+  size_t activations_count = 0;
+  base::ElapsedTimer timer;
+  for (const auto& [feature, enabled] : feature_changes) {
+    rule_activations.SetFeatureEnabled(feature, enabled);
+    activations_count += rule_activations.active_count();
+  }
+  reporter.AddResult(kMetricTimePerFeatureChange,
+                     timer.Elapsed() / kFeatureChangeCount);
+  EXPECT_GT(activations_count, 0U);
+}
+
+}  // namespace greaselion
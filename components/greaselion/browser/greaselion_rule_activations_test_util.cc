@@ -0,0 +1,55 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_rule_activations_test_util.h"
+
+#include <utility>
+
+#include "base/files/file_path.h"
+
+namespace greaselion {
+
+std::unique_ptr<GreaselionRule> BuildRule(
+    base::Value::Dict preconditions,
+    const std::string& minimum_brave_version) {
+  auto rule = std::make_unique<GreaselionRule>("test");
+  base::Value::List urls;
+  urls.Append("https://www.example.com/*");
+  base::Value::List scripts;
+  rule->Parse(&preconditions, &urls, &scripts, "", minimum_brave_version,
+              base::FilePath(), base::FilePath());
+  return rule;
+}
+
+std::vector<std::unique_ptr<GreaselionRule>> BuildSyntheticRules(
+    RandomGenerator* generator,
+    const int count) {
+  constexpr const char* kMinimumBraveVersions[] = {"", "", "", "1.2.*", "1.3",
+                                                   "0.9.1"};
+
+  std::vector<std::unique_ptr<GreaselionRule>> rules;
+  for (int i = 0; i < count; i++) {
+    base::Value::Dict preconditions;
+    for (const char* key : kPreconditionKeys) {
+      switch (generator->Next() % 8) {
+        case 0:
+          preconditions.Set(key, true);
+          break;
+        case 1:
+          preconditions.Set(key, false);
+          break;
+        default:
+          break;
+      }
+    }
+    rules.push_back(BuildRule(
+        std::move(preconditions),
+        kMinimumBraveVersions[generator->Next() %
+                              std::size(kMinimumBraveVersions)]));
+  }
+  return rules;
+}
+
+}  // namespace greaselion
@@ -0,0 +1,54 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_TEST_UTIL_H_
+#define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_TEST_UTIL_H_
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/values.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "brave/components/greaselion/browser/greaselion_service.h"
+
+namespace greaselion {
+
+// Precondition keys of Greaselion.json, in GreaselionFeature order.
+inline constexpr const char* kPreconditionKeys[] = {
+    "rewards-enabled",           "twitter-tips-enabled",
+    "reddit-tips-enabled",       "github-tips-enabled",
+    "auto-contribution-enabled", "ads-enabled",
+    "supports-minimum-brave-version"};
+static_assert(std::size(kPreconditionKeys) == LAST_FEATURE);
+
+// Deterministic, so that failures reproduce and benchmark runs are
+// comparable.
+class RandomGenerator {
+ public:
+  uint32_t Next() {
+    state_ = state_ * 1103515245 + 12345;
+    return state_ >> 8;
+  }
+
+ private:
+  uint32_t state_ = 42;
+};
+
+std::unique_ptr<GreaselionRule> BuildRule(
+    base::Value::Dict preconditions,
+    const std::string& minimum_brave_version = "");
+
+// Most rules have a precondition on a feature or two, and a few of them on a
+// minimum browser version.
+std::vector<std::unique_ptr<GreaselionRule>> BuildSyntheticRules(
+    RandomGenerator* generator,
+    int count);
+
+}  // namespace greaselion
+
+#endif  // BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_RULE_ACTIVATIONS_TEST_UTIL_H_
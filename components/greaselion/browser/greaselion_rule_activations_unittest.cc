@@ -0,0 +1,158 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_rule_activations.h"
+
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/values.h"
+#include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_rule_activations_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace greaselion {
+
+namespace {
+
+constexpr char kBrowserVersion[] = "1.2.3.4";
+
+base::Value::Dict BuildPreconditions(
+    std::initializer_list<std::pair<const char*, bool>> values) {
+  base::Value::Dict preconditions;
+  for (const auto& [key, value] : values) {
+    preconditions.Set(key, value);
+  }
+  return preconditions;
+}
+
+std::vector<std::unique_ptr<GreaselionRule>> BuildRules() {
+  std::vector<std::unique_ptr<GreaselionRule>> rules;
+  rules.push_back(BuildRule(BuildPreconditions({{"rewards-enabled", true}})));
+  rules.push_back(BuildRule(BuildPreconditions({{"rewards-enabled", false}})));
+  rules.push_back(BuildRule(BuildPreconditions({})));
+  rules.push_back(BuildRule(BuildPreconditions(
+      {{"rewards-enabled", true}, {"ads-enabled", true}})));
+  rules.push_back(BuildRule(BuildPreconditions({{"unknown-enabled", true}})));
+  rules.push_back(BuildRule(BuildPreconditions({}), "2.0"));
+  rules.push_back(BuildRule(BuildPreconditions({}), "1.2.*"));
+  return rules;
+}
+
+std::vector<size_t> GetActiveRules(
+    const GreaselionRuleActivations& rule_activations) {
+  std::vector<size_t> active_rules;
+  for (size_t i = 0; i < rule_activations.size(); i++) {
+    if (rule_activations.IsActive(i)) {
+      active_rules.push_back(i);
+    }
+  }
+  return active_rules;
+}
+
+// What GreaselionServiceImpl did for each rule on every feature change.
+std::vector<size_t> GetMatchingRules(
+    const std::vector<std::unique_ptr<GreaselionRule>>& rules,
+    const GreaselionFeatures& state,
+    const base::Version& browser_version) {
+  std::vector<size_t> matching_rules;
+  for (size_t i = 0; i < rules.size(); i++) {
+    if (rules[i]->Matches(state, browser_version) &&
+        !rules[i]->has_unknown_preconditions()) {
+      matching_rules.push_back(i);
+    }
+  }
+  return matching_rules;
+}
+
+}  // namespace
+
+TEST(GreaselionRuleActivationsTest, ActivateRulesForEnabledFeatures) {
+  const std::vector<std::unique_ptr<GreaselionRule>> rules = BuildRules();
+  GreaselionRuleActivations rule_activations;
+  rule_activations.Reset(rules, base::Version(kBrowserVersion));
+
+  EXPECT_EQ(std::vector<size_t>({1, 2, 6}), GetActiveRules(rule_activations));
+  EXPECT_EQ(3U, rule_activations.active_count());
+
+  EXPECT_TRUE(rule_activations.SetFeatureEnabled(REWARDS, true));
+  EXPECT_EQ(std::vector<size_t>({0, 2, 6}), GetActiveRules(rule_activations));
+
+  EXPECT_TRUE(rule_activations.SetFeatureEnabled(ADS, true));
+  EXPECT_EQ(std::vector<size_t>({0, 2, 3, 6}),
+            GetActiveRules(rule_activations));
+  EXPECT_EQ(4U, rule_activations.active_count());
+
+  EXPECT_TRUE(rule_activations.SetFeatureEnabled(REWARDS, false));
+  EXPECT_EQ(std::vector<size_t>({1, 2, 6}), GetActiveRules(rule_activations));
+  EXPECT_EQ(3U, rule_activations.active_count());
+}
+
+TEST(GreaselionRuleActivationsTest, IgnoreChangesWhichActivateNoRules) {
+  const std::vector<std::unique_ptr<GreaselionRule>> rules = BuildRules();
+  GreaselionRuleActivations rule_activations;
+  rule_activations.Reset(rules, base::Version(kBrowserVersion));
+
+  // Already disabled.
+  EXPECT_FALSE(rule_activations.SetFeatureEnabled(REWARDS, false));
+  // No rule has a precondition on Twitter tips.
+  EXPECT_FALSE(rule_activations.IsFeatureEnabled(TWITTER_TIPS));
+  EXPECT_FALSE(rule_activations.SetFeatureEnabled(TWITTER_TIPS, true));
+  EXPECT_TRUE(rule_activations.IsFeatureEnabled(TWITTER_TIPS));
+  // Rule 3 also needs rewards to be enabled.
+  EXPECT_FALSE(rule_activations.SetFeatureEnabled(ADS, true));
+
+  EXPECT_EQ(std::vector<size_t>({1, 2, 6}), GetActiveRules(rule_activations));
+}
+
+TEST(GreaselionRuleActivationsTest, KeepEnabledFeaturesOnReset) {
+  GreaselionRuleActivations rule_activations;
+  EXPECT_FALSE(rule_activations.SetFeatureEnabled(REWARDS, true));
+
+  const std::vector<std::unique_ptr<GreaselionRule>> rules = BuildRules();
+  rule_activations.Reset(rules, base::Version(kBrowserVersion));
+  EXPECT_EQ(std::vector<size_t>({0, 2, 6}), GetActiveRules(rule_activations));
+
+  rule_activations.Reset(rules, base::Version("2.0.0.0"));
+  EXPECT_EQ(std::vector<size_t>({0, 2, 5, 6}),
+            GetActiveRules(rule_activations));
+
+  rule_activations.Reset({}, base::Version(kBrowserVersion));
+  EXPECT_EQ(0U, rule_activations.size());
+  EXPECT_EQ(0U, rule_activations.active_count());
+}
+
+TEST(GreaselionRuleActivationsTest, ActivateSameRulesAsMatches) {
+  RandomGenerator generator;
+  const std::vector<std::unique_ptr<GreaselionRule>> rules =
+      BuildSyntheticRules(&generator, 500);
+  const base::Version browser_version(kBrowserVersion);
+  GreaselionRuleActivations rule_activations;
+  rule_activations.Reset(rules, browser_version);
+
+  GreaselionFeatures state;
+  for (int i = FIRST_FEATURE; i != LAST_FEATURE; i++) {
+    state[static_cast<GreaselionFeature>(i)] = false;
+  }
+
+  for (int i = 0; i < 200; i++) {
+    const auto feature =
+        static_cast<GreaselionFeature>(generator.Next() % LAST_FEATURE);
+    const bool enabled = generator.Next() % 2 == 1;
+    const std::vector<size_t> previous_matching_rules =
+        GetMatchingRules(rules, state, browser_version);
+    state[feature] = enabled;
+    const std::vector<size_t> matching_rules =
+        GetMatchingRules(rules, state, browser_version);
+
+    EXPECT_EQ(matching_rules != previous_matching_rules,
+              rule_activations.SetFeatureEnabled(feature, enabled));
+    EXPECT_EQ(matching_rules, GetActiveRules(rule_activations));
+  }
+}
+
+}  // namespace greaselion
@@ -237,10 +237,9 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       weak_factory_(this) {
   download_service_->AddObserver(this);
   extension_registry_->AddObserver(this);
-  for (int i = FIRST_FEATURE; i != LAST_FEATURE; i++)
-    state_[static_cast<GreaselionFeature>(i)] = false;
   // Static-value features
-  state_[GreaselionFeature::SUPPORTS_MINIMUM_BRAVE_VERSION] = true;
+  rule_activations_.SetFeatureEnabled(
+      GreaselionFeature::SUPPORTS_MINIMUM_BRAVE_VERSION, true);
 }
 
 GreaselionServiceImpl::~GreaselionServiceImpl() = default;
@@ -287,6 +286,21 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
   }
 }
 
+bool GreaselionServiceImpl::AreRuleActivationsStale() {
+  // The rules are cleared without OnRulesReady when the configuration fails to
+  // load or parse.
+  return rule_activations_stale_ ||
+         rule_activations_.size() != download_service_->rules()->size();
+}
+
+void GreaselionServiceImpl::MaybeResetRuleActivations() {
+  if (!AreRuleActivationsStale()) {
+    return;
+  }
+  rule_activations_.Reset(*download_service_->rules(), browser_version_);
+  rule_activations_stale_ = false;
+}
+
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
   DCHECK(greaselion_extensions_.empty());
   DCHECK(update_in_progress_);
@@ -301,25 +315,20 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
         base::BindOnce(&DeleteExtensionDirs, std::move(extension_dirs_)));
   }
 
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
-  }
+  MaybeResetRuleActivations();
+  pending_installs_ = static_cast<int>(rule_activations_.active_count());
   if (!pending_installs_) {
     // no rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
+  std::vector<std::unique_ptr<GreaselionRule>>* rules =
+      download_service_->rules();
+  for (size_t i = 0; i < rules->size(); i++) {
+    if (rule_activations_.IsActive(i)) {
       // Convert script file to component extension. This must run on extension
       // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
+      GreaselionRule rule_copy(*(*rules)[i]);
       task_runner_->PostTaskAndReplyWithResult(
           FROM_HERE,
           base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
@@ -404,6 +413,7 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
 
 void GreaselionServiceImpl::OnRulesReady(
     GreaselionDownloadService* download_service) {
+  rule_activations_stale_ = true;
   for (auto& observer : observers_) {
     observer.OnRulesReady(this);
   }
@@ -412,7 +422,13 @@ void GreaselionServiceImpl::OnRulesReady(
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
-  state_[feature] = enabled;
+  const bool rule_activations_changed =
+      rule_activations_.SetFeatureEnabled(feature, enabled);
+  // Only reinstall the extensions if a rule was activated or deactivated, or
+  // if the activations are about to be re-evaluated anyway.
+  if (!rule_activations_changed && !AreRuleActivationsStale()) {
+    return;
+  }
   UpdateInstalledExtensions();
 }
 
@@ -428,6 +444,7 @@ void GreaselionServiceImpl::SetBrowserVersionForTesting(
     const base::Version& version) {
   CHECK(version.IsValid());
   browser_version_ = version;
+  rule_activations_stale_ = true;
   UpdateInstalledExtensions();
 }
 
@@ -16,6 +16,7 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/version.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
+#include "brave/components/greaselion/browser/greaselion_rule_activations.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -71,6 +72,8 @@ class GreaselionServiceImpl : public GreaselionService,
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  bool AreRuleActivationsStale();
+  void MaybeResetRuleActivations();
   void CreateAndInstallExtensions();
   void PostConvert(
       absl::optional<GreaselionConvertedExtension> converted_extension);
@@ -81,7 +84,10 @@ class GreaselionServiceImpl : public GreaselionService,
   void OnRulesReady(GreaselionDownloadService* download_service) override;
 
   raw_ptr<GreaselionDownloadService> download_service_ = nullptr;  // NOT OWNED
-  GreaselionFeatures state_;
+  GreaselionRuleActivations rule_activations_;
+  // Set when the rules or the browser version change, so that all the rule
+  // activations have to be re-evaluated.
+  bool rule_activations_stale_ = true;
   const base::FilePath install_directory_;
   raw_ptr<extensions::ExtensionSystem> extension_system_ =
       nullptr;  // NOT OWNED
@@ -38,6 +38,10 @@ struct ImportedData {
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
 
+using ImportProgressCallback =
+    base::RepeatingCallback<void(uint64_t uploaded_bytes,
+                                 uint64_t total_bytes)>;
+
 }  // namespace ipfs
 
 #endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IMPORTED_DATA_H_
@@ -88,8 +88,8 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
       base::BindOnce(&ipfs::CalculateFileSize, upload_file_path),
-      base::BindOnce(&CreateRequestForFile, upload_file_path,
-                     blob_context_getter_factory_, mime_type, filename,
+      base::BindOnce(&CreateStreamingRequestForFile, upload_file_path,
+                     mime_type, filename, progress_callback_,
                      std::move(upload_callback)));
 }
 
@@ -97,10 +97,15 @@ void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
   auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
                                         weak_factory_.GetWeakPtr());
   data_->filename = folder_path.BaseName().MaybeAsASCII();
-  CreateRequestForFolder(folder_path, blob_context_getter_factory_,
+  CreateRequestForFolder(folder_path, progress_callback_,
                          std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::SetProgressCallback(
+    ImportProgressCallback progress_callback) {
+  progress_callback_ = std::move(progress_callback);
+}
+
 void IpfsImportWorkerBase::ImportText(const std::string& text,
                                       const std::string& host) {
   if (text.empty() || host.empty()) {
@@ -38,7 +38,8 @@ namespace ipfs {
 // The worker must be deleted when the import is completed.
 // The import process consists of the following steps:
 // Worker:
-//   1. Worker prepares a blob block of data to import
+//   1. Worker prepares a blob block of data to import. Files and folders are
+//      streamed from disk through a data pipe instead.
 // IpfsImportWorkerBase:
 //   2. Sends blob to ifps using IPFS api (/api/v0/add)
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
@@ -64,6 +65,9 @@ class IpfsImportWorkerBase {
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
 
+  // Reports the number of bytes of a file or folder import uploaded so far.
+  void SetProgressCallback(ImportProgressCallback progress_callback);
+
  protected:
   scoped_refptr<network::SharedURLLoaderFactory> GetUrlLoaderFactory();
 
@@ -85,6 +89,7 @@ class IpfsImportWorkerBase {
   void OnContentPublished(api_request_helper::APIRequestResult response);
 
   ImportCompletedCallback callback_;
+  ImportProgressCallback progress_callback_;
   std::unique_ptr<ipfs::ImportedData> data_;
 
   BlobContextGetterFactory* blob_context_getter_factory_ = nullptr;
@@ -0,0 +1,203 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/ipfs_multipart_data_pipe_getter.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/functional/bind.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/sequenced_task_runner.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "net/base/net_errors.h"
+
+namespace ipfs {
+
+namespace {
+
+// Progress is reported at most once per this many bytes, and at the end.
+constexpr uint64_t kProgressReportInterval = 1024 * 1024;
+
+// Reads the body on the blocking sequence owned by mojo::DataPipeProducer.
+// Reads are sequential, so only the file of the current segment is kept open.
+class MultipartDataSource : public mojo::DataPipeProducer::DataSource {
+ public:
+  MultipartDataSource(std::vector<MultipartUploadSegment> segments,
+                      uint64_t total_size,
+                      ImportProgressCallback progress_callback)
+      : segments_(std::move(segments)),
+        total_size_(total_size),
+        progress_callback_(std::move(progress_callback)) {}
+  ~MultipartDataSource() override = default;
+  MultipartDataSource(const MultipartDataSource&) = delete;
+  MultipartDataSource& operator=(const MultipartDataSource&) = delete;
+
+  // mojo::DataPipeProducer::DataSource:
+  uint64_t GetLength() const override { return total_size_; }
+
+  ReadResult Read(uint64_t offset, base::span<char> buffer) override {
+    ReadResult result;
+    if (offset >= total_size_)
+      return result;
+
+    if (offset < segment_start_) {
+      current_segment_ = 0;
+      segment_start_ = 0;
+      file_.Close();
+    }
+    while (offset >= segment_start_ + segments_[current_segment_].GetSize()) {
+      segment_start_ += segments_[current_segment_].GetSize();
+      current_segment_++;
+      file_.Close();
+    }
+
+    const MultipartUploadSegment& segment = segments_[current_segment_];
+    const uint64_t segment_offset = offset - segment_start_;
+    const size_t length = static_cast<size_t>(
+        std::min<uint64_t>({buffer.size(), kUploadChunkSize,
+                            segment.GetSize() - segment_offset}));
+    if (segment.path.empty()) {
+      memcpy(buffer.data(), segment.data.data() + segment_offset, length);
+      result.bytes_read = length;
+    } else {
+      if (!file_.IsValid()) {
+        file_.Initialize(segment.path,
+                         base::File::FLAG_OPEN | base::File::FLAG_READ);
+      }
+      const int bytes_read =
+          file_.IsValid() ? file_.Read(segment_offset, buffer.data(), length)
+                          : -1;
+      // The file is shorter than when the body was built, or gone.
+      if (bytes_read <= 0) {
+        result.result = MOJO_RESULT_UNKNOWN;
+        return result;
+      }
+      result.bytes_read = bytes_read;
+    }
+
+    ReportProgress(offset + result.bytes_read);
+    return result;
+  }
+
+ private:
+  void ReportProgress(uint64_t uploaded) {
+    if (!progress_callback_)
+      return;
+    if (uploaded != total_size_ &&
+        uploaded - reported_bytes_ < kProgressReportInterval) {
+      return;
+    }
+    reported_bytes_ = uploaded;
+    progress_callback_.Run(uploaded, total_size_);
+  }
+
+  std::vector<MultipartUploadSegment> segments_;
+  const uint64_t total_size_;
+  ImportProgressCallback progress_callback_;
+  size_t current_segment_ = 0;
+  uint64_t segment_start_ = 0;
+  base::File file_;
+  uint64_t reported_bytes_ = 0;
+};
+
+}  // namespace
+
+MultipartUploadSegment::MultipartUploadSegment() = default;
+MultipartUploadSegment::MultipartUploadSegment(const MultipartUploadSegment&) =
+    default;
+MultipartUploadSegment::MultipartUploadSegment(MultipartUploadSegment&&) =
+    default;
+MultipartUploadSegment& MultipartUploadSegment::operator=(
+    const MultipartUploadSegment&) = default;
+MultipartUploadSegment& MultipartUploadSegment::operator=(
+    MultipartUploadSegment&&) = default;
+MultipartUploadSegment::~MultipartUploadSegment() = default;
+
+// static
+MultipartUploadSegment MultipartUploadSegment::FromData(std::string data) {
+  MultipartUploadSegment segment;
+  segment.data = std::move(data);
+  return segment;
+}
+
+// static
+MultipartUploadSegment MultipartUploadSegment::FromFile(
+    const base::FilePath& path,
+    uint64_t size) {
+  MultipartUploadSegment segment;
+  segment.path = path;
+  segment.file_size = size;
+  return segment;
+}
+
+uint64_t MultipartUploadSegment::GetSize() const {
+  return path.empty() ? data.size() : file_size;
+}
+
+// static
+mojo::PendingRemote<network::mojom::DataPipeGetter>
+IpfsMultipartDataPipeGetter::Create(
+    std::vector<MultipartUploadSegment> segments,
+    ImportProgressCallback progress_callback) {
+  mojo::PendingRemote<network::mojom::DataPipeGetter> remote;
+  // Owns itself, see OnDisconnect.
+  auto* getter = new IpfsMultipartDataPipeGetter(std::move(segments),
+                                                 std::move(progress_callback));
+  getter->Clone(remote.InitWithNewPipeAndPassReceiver());
+  return remote;
+}
+
+IpfsMultipartDataPipeGetter::IpfsMultipartDataPipeGetter(
+    std::vector<MultipartUploadSegment> segments,
+    ImportProgressCallback progress_callback)
+    : segments_(std::move(segments)) {
+  for (const auto& segment : segments_)
+    total_size_ += segment.GetSize();
+  if (progress_callback) {
+    progress_callback_ =
+        base::BindPostTask(base::SequencedTaskRunner::GetCurrentDefault(),
+                           std::move(progress_callback));
+  }
+  receivers_.set_disconnect_handler(base::BindRepeating(
+      &IpfsMultipartDataPipeGetter::OnDisconnect, base::Unretained(this)));
+}
+
+IpfsMultipartDataPipeGetter::~IpfsMultipartDataPipeGetter() = default;
+
+void IpfsMultipartDataPipeGetter::Read(mojo::ScopedDataPipeProducerHandle pipe,
+                                       ReadCallback callback) {
+  std::move(callback).Run(net::OK, total_size_);
+
+  // The network service may ask for the body again, e.g. after a redirect.
+  // Destroying the previous producer cancels its pending write.
+  producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(pipe));
+  producer_->Write(
+      std::make_unique<MultipartDataSource>(segments_, total_size_,
+                                            progress_callback_),
+      base::BindOnce(&IpfsMultipartDataPipeGetter::OnWriteComplete,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void IpfsMultipartDataPipeGetter::Clone(
+    mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) {
+  receivers_.Add(this, std::move(receiver));
+}
+
+void IpfsMultipartDataPipeGetter::OnDisconnect() {
+  if (receivers_.empty())
+    delete this;
+}
+
+void IpfsMultipartDataPipeGetter::OnWriteComplete(MojoResult result) {
+  // A failed write closes the pipe early, which the network service reports
+  // as a failed upload.
+  producer_.reset();
+}
+
+}  // namespace ipfs
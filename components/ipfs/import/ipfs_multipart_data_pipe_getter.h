@@ -0,0 +1,93 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_MULTIPART_DATA_PIPE_GETTER_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_MULTIPART_DATA_PIPE_GETTER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/ipfs/import/imported_data.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "services/network/public/mojom/data_pipe_getter.mojom.h"
+
+namespace mojo {
+class DataPipeProducer;
+}  // namespace mojo
+
+namespace ipfs {
+
+// Maximum number of bytes read from a file per data pipe write.
+inline constexpr size_t kUploadChunkSize = 64 * 1024;
+
+// A part of a multipart upload body. Either holds in-memory |data| such as
+// multipart headers and delimiters, or refers to the first |size| bytes of
+// the file at |path|, which is only read while the body is being uploaded.
+struct MultipartUploadSegment {
+  MultipartUploadSegment();
+  MultipartUploadSegment(const MultipartUploadSegment&);
+  MultipartUploadSegment(MultipartUploadSegment&&);
+  MultipartUploadSegment& operator=(const MultipartUploadSegment&);
+  MultipartUploadSegment& operator=(MultipartUploadSegment&&);
+  ~MultipartUploadSegment();
+
+  static MultipartUploadSegment FromData(std::string data);
+  static MultipartUploadSegment FromFile(const base::FilePath& path,
+                                         uint64_t size);
+
+  uint64_t GetSize() const;
+
+  std::string data;
+  base::FilePath path;
+  uint64_t file_size = 0;
+};
+
+// Serves a multipart upload body to the network service through a data pipe.
+// Files are read lazily in chunks of at most kUploadChunkSize bytes, so the
+// memory used does not depend on the size of the import. The object owns
+// itself and is deleted once all of its receivers are disconnected.
+class IpfsMultipartDataPipeGetter : public network::mojom::DataPipeGetter {
+ public:
+  // |progress_callback| is run on the calling sequence with the number of
+  // bytes written to the pipe so far and the total size of the body.
+  static mojo::PendingRemote<network::mojom::DataPipeGetter> Create(
+      std::vector<MultipartUploadSegment> segments,
+      ImportProgressCallback progress_callback);
+
+  ~IpfsMultipartDataPipeGetter() override;
+  IpfsMultipartDataPipeGetter(const IpfsMultipartDataPipeGetter&) = delete;
+  IpfsMultipartDataPipeGetter& operator=(const IpfsMultipartDataPipeGetter&) =
+      delete;
+
+  // network::mojom::DataPipeGetter:
+  void Read(mojo::ScopedDataPipeProducerHandle pipe,
+            ReadCallback callback) override;
+  void Clone(mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver)
+      override;
+
+ private:
+  IpfsMultipartDataPipeGetter(std::vector<MultipartUploadSegment> segments,
+                              ImportProgressCallback progress_callback);
+
+  void OnDisconnect();
+  void OnWriteComplete(MojoResult result);
+
+  std::vector<MultipartUploadSegment> segments_;
+  uint64_t total_size_ = 0;
+  ImportProgressCallback progress_callback_;
+  std::unique_ptr<mojo::DataPipeProducer> producer_;
+  mojo::ReceiverSet<network::mojom::DataPipeGetter> receivers_;
+  base::WeakPtrFactory<IpfsMultipartDataPipeGetter> weak_factory_{this};
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IPFS_MULTIPART_DATA_PIPE_GETTER_H_
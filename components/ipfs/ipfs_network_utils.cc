@@ -26,6 +26,7 @@
 #include "services/network/public/cpp/simple_url_loader.h"
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
+#include "brave/components/ipfs/import/ipfs_multipart_data_pipe_getter.h"
 #include "storage/browser/blob/blob_data_builder.h"
 #include "storage/browser/blob/blob_impl.h"
 #include "storage/browser/blob/blob_storage_context.h"
@@ -113,12 +114,11 @@ std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFile(
   return blob_builder;
 }
 
-std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFolder(
+std::vector<ipfs::MultipartUploadSegment> BuildFolderSegments(
     base::FilePath upload_path,
     std::string mime_boundary,
     std::vector<ImportFileInfo> files) {
-  auto blob_builder =
-      std::make_unique<storage::BlobDataBuilder>(base::GenerateGUID());
+  std::vector<ipfs::MultipartUploadSegment> segments;
   for (const auto& info : files) {
     std::string data_header;
     base::FilePath::StringType relative_path;
@@ -130,17 +130,41 @@ std::unique_ptr<storage::BlobDataBuilder> BuildBlobWithFolder(
     ipfs::AddMultipartHeaderForUploadWithFileName(
         ipfs::kFileValueName, base::FilePath(relative_path).MaybeAsASCII(),
         info.path.MaybeAsASCII(), mime_boundary, mime_type, &data_header);
-    blob_builder->AppendData(data_header);
+    segments.push_back(
+        ipfs::MultipartUploadSegment::FromData(std::move(data_header)));
     if (mime_type == ipfs::kFileMimeType) {
-      blob_builder->AppendFile(info.path, 0, info.info.GetSize(), base::Time());
+      segments.push_back(ipfs::MultipartUploadSegment::FromFile(
+          info.path, info.info.GetSize()));
     }
   }
 
   std::string post_data_footer = "\r\n";
   net::AddMultipartFinalDelimiterForUpload(mime_boundary, &post_data_footer);
-  blob_builder->AppendData(post_data_footer);
+  segments.push_back(
+      ipfs::MultipartUploadSegment::FromData(std::move(post_data_footer)));
 
-  return blob_builder;
+  return segments;
+}
+
+std::string GetMultipartContentType(const std::string& mime_boundary) {
+  std::string content_type = ipfs::kIPFSImportMultipartContentType;
+  content_type += " boundary=";
+  content_type += mime_boundary;
+  return content_type;
+}
+
+std::unique_ptr<network::ResourceRequest> CreateStreamingResourceRequest(
+    std::vector<ipfs::MultipartUploadSegment> segments,
+    const std::string& mime_boundary,
+    ipfs::ImportProgressCallback progress_callback) {
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->request_body = new network::ResourceRequestBody();
+  request->request_body->AppendDataPipe(
+      ipfs::IpfsMultipartDataPipeGetter::Create(std::move(segments),
+                                                std::move(progress_callback)));
+  request->headers.SetHeader(net::HttpRequestHeaders::kContentType,
+                             GetMultipartContentType(mime_boundary));
+  return request;
 }
 #endif
 
@@ -270,6 +294,37 @@ void CreateRequestForFile(
       std::move(request_callback));
 }
 
+void CreateStreamingRequestForFile(const base::FilePath& upload_file_path,
+                                   const std::string& mime_type,
+                                   const std::string& filename,
+                                   ImportProgressCallback progress_callback,
+                                   ResourceRequestGetter request_callback,
+                                   int64_t file_size) {
+  if (file_size < 0) {
+    std::move(request_callback).Run(nullptr);
+    return;
+  }
+  std::string mime_boundary = net::GenerateMimeMultipartBoundary();
+  std::string post_data_header;
+  AddMultipartHeaderForUploadWithFileName(
+      kFileValueName,
+      filename.empty() ? upload_file_path.BaseName().MaybeAsASCII() : filename,
+      std::string(), mime_boundary, mime_type, &post_data_header);
+  std::string post_data_footer = "\r\n";
+  net::AddMultipartFinalDelimiterForUpload(mime_boundary, &post_data_footer);
+
+  std::vector<MultipartUploadSegment> segments;
+  segments.push_back(
+      MultipartUploadSegment::FromData(std::move(post_data_header)));
+  segments.push_back(
+      MultipartUploadSegment::FromFile(upload_file_path, file_size));
+  segments.push_back(
+      MultipartUploadSegment::FromData(std::move(post_data_footer)));
+  std::move(request_callback)
+      .Run(CreateStreamingResourceRequest(std::move(segments), mime_boundary,
+                                          std::move(progress_callback)));
+}
+
 std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path) {
   std::vector<ImportFileInfo> files;
   base::FileEnumerator file_enum(
@@ -286,35 +341,26 @@ std::vector<ImportFileInfo> EnumerateDirectoryFiles(base::FilePath dir_path) {
   return files;
 }
 
-void CreateRequestForFileList(
-    ResourceRequestGetter request_callback,
-    ipfs::BlobContextGetterFactory* blob_context_getter_factory,
-    const base::FilePath& folder_path,
-    std::vector<ImportFileInfo> files) {
+void CreateRequestForFileList(ResourceRequestGetter request_callback,
+                              ImportProgressCallback progress_callback,
+                              const base::FilePath& folder_path,
+                              std::vector<ImportFileInfo> files) {
   std::string mime_boundary = net::GenerateMimeMultipartBoundary();
-  auto blob_builder_callback =
-      base::BindOnce(&BuildBlobWithFolder, folder_path.DirName(), mime_boundary,
-                     std::move(files));
-
-  std::string content_type = ipfs::kIPFSImportMultipartContentType;
-  content_type += " boundary=";
-  content_type += mime_boundary;
-
-  content::GetIOThreadTaskRunner({})->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&CreateResourceRequest, std::move(blob_builder_callback),
-                     content_type, blob_context_getter_factory),
-      std::move(request_callback));
+  auto segments = BuildFolderSegments(folder_path.DirName(), mime_boundary,
+                                      std::move(files));
+  std::move(request_callback)
+      .Run(CreateStreamingResourceRequest(std::move(segments), mime_boundary,
+                                          std::move(progress_callback)));
 }
 
 void CreateRequestForFolder(const base::FilePath& folder_path,
-                            ipfs::BlobContextGetterFactory* context_factory,
+                            ImportProgressCallback progress_callback,
                             ResourceRequestGetter request_callback) {
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
       base::BindOnce(&EnumerateDirectoryFiles, folder_path),
       base::BindOnce(&CreateRequestForFileList, std::move(request_callback),
-                     context_factory, folder_path));
+                     std::move(progress_callback), folder_path));
 }
 
 void CreateRequestForText(const std::string& text,
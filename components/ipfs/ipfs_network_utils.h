@@ -17,6 +17,10 @@
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "url/gurl.h"
 
+#if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
+#include "brave/components/ipfs/import/imported_data.h"
+#endif
+
 namespace base {
 class FilePath;
 }  // namespace base
@@ -65,8 +69,20 @@ void CreateRequestForFile(const base::FilePath& upload_file_path,
                           ResourceRequestGetter request_callback,
                           size_t file_size);
 
+// Builds an upload request whose multipart body is streamed from
+// |upload_file_path| through a data pipe, so the file is never held in memory
+// or copied into a blob. |file_size| is -1 if the size could not be read.
+void CreateStreamingRequestForFile(const base::FilePath& upload_file_path,
+                                   const std::string& mime_type,
+                                   const std::string& filename,
+                                   ImportProgressCallback progress_callback,
+                                   ResourceRequestGetter request_callback,
+                                   int64_t file_size);
+
+// Same as above for all files and directories under |folder_path|, which are
+// sent as parts of a single multipart body.
 void CreateRequestForFolder(const base::FilePath& folder_path,
-                            BlobContextGetterFactory* context_getter_factory,
+                            ImportProgressCallback progress_callback,
                             ResourceRequestGetter request_callback);
 
 void CreateRequestForText(const std::string& text,
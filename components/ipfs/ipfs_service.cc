@@ -486,6 +486,8 @@ void IpfsService::ImportFileToIpfs(const base::FilePath& path,
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->SetProgressCallback(base::BindRepeating(
+      &IpfsService::OnImportProgress, weak_factory_.GetWeakPtr(), path));
   importers_[hash]->ImportFile(path);
 }
 
@@ -541,6 +543,8 @@ void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->SetProgressCallback(base::BindRepeating(
+      &IpfsService::OnImportProgress, weak_factory_.GetWeakPtr(), folder));
   importers_[hash]->ImportFolder(folder);
 }
 
@@ -580,6 +584,14 @@ void IpfsService::OnImportFinished(ipfs::ImportCompletedCallback callback,
 
   importers_.erase(key);
 }
+
+void IpfsService::OnImportProgress(const base::FilePath& path,
+                                   uint64_t uploaded_bytes,
+                                   uint64_t total_bytes) {
+  for (auto& observer : observers_) {
+    observer.OnImportProgress(path, uploaded_bytes, total_bytes);
+  }
+}
 #endif
 
 void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
@@ -149,6 +149,9 @@ class IpfsService : public KeyedService,
   void OnImportFinished(ipfs::ImportCompletedCallback callback,
                         size_t key,
                         const ipfs::ImportedData& data);
+  void OnImportProgress(const base::FilePath& path,
+                        uint64_t uploaded_bytes,
+                        uint64_t total_bytes);
   void ExportKey(const std::string& key,
                  const base::FilePath& target_path,
                  BoolCallback callback);
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/observer_list_types.h"
 #include "components/component_updater/component_updater_service.h"
 
@@ -25,6 +26,11 @@ class IpfsServiceObserver : public base::CheckedObserver {
   virtual void OnGetConnectedPeers(bool succes,
                                    const std::vector<std::string>& peers) {}
   virtual void OnIpnsKeysLoaded(bool success) {}
+  // Called while a file or directory import at |path| is being uploaded to
+  // the local node.
+  virtual void OnImportProgress(const base::FilePath& path,
+                                uint64_t uploaded_bytes,
+                                uint64_t total_bytes) {}
 };
 
 }  // namespace ipfs
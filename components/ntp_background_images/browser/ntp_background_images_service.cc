@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
@@ -40,6 +41,8 @@ namespace ntp_background_images {
 namespace {
 
 constexpr int kSIComponentUpdateCheckIntervalMins = 15;
+// Enough for the images of the background and sponsored images components.
+constexpr size_t kMaxImageCacheSizeInBytes = 32 * 1024 * 1024;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
 
@@ -100,6 +103,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
     PrefService* local_pref)
     : component_update_service_(cus),
       local_pref_(local_pref),
+      image_cache_(kMaxImageCacheSizeInBytes),
       weak_factory_(this) {
 }
 
@@ -467,6 +471,7 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
     const std::string& json_string) {
   bi_images_data_ =
       std::make_unique<NTPBackgroundImagesData>(json_string, bi_installed_dir_);
+  RetainImages();
 
   for (auto& observer : observer_list_) {
     observer.OnUpdated(bi_images_data_.get());
@@ -513,6 +518,7 @@ void NTPBackgroundImagesService::OnGetSponsoredComponentJsonData(
     si_images_data_ = std::make_unique<NTPSponsoredImagesData>(
         json_string, si_installed_dir_);
   }
+  RetainImages();
 
   if (is_super_referral && !sr_images_data_->IsValid()) {
     DVLOG(2) << __func__ << ": NTP SR campaign ends.";
@@ -527,6 +533,33 @@ void NTPBackgroundImagesService::OnGetSponsoredComponentJsonData(
   }
 }
 
+void NTPBackgroundImagesService::RetainImages() {
+  std::vector<base::FilePath> image_files;
+  if (bi_images_data_) {
+    for (const auto& background : bi_images_data_->backgrounds) {
+      image_files.push_back(background.image_file);
+    }
+  }
+
+  for (const auto* images_data :
+       {si_images_data_.get(), sr_images_data_.get()}) {
+    if (!images_data || !images_data->IsValid()) {
+      continue;
+    }
+    for (const auto& campaign : images_data->campaigns) {
+      for (const auto& background : campaign.backgrounds) {
+        image_files.push_back(background.image_file);
+        image_files.push_back(background.logo.image_file);
+      }
+    }
+    for (const auto& top_site : images_data->top_sites) {
+      image_files.push_back(top_site.image_file);
+    }
+  }
+
+  image_cache_.Retain(image_files);
+}
+
 void NTPBackgroundImagesService::MarkThisInstallIsNotSuperReferralForever() {
   local_pref_->SetDict(prefs::kNewTabPageCachedSuperReferralComponentInfo,
                        base::Value::Dict());
@@ -17,6 +17,7 @@
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
 #include "base/values.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "components/prefs/pref_change_registrar.h"
 
 namespace component_updater {
@@ -64,6 +65,9 @@ class NTPBackgroundImagesService {
   NTPBackgroundImagesData* GetBackgroundImagesData() const;
   NTPSponsoredImagesData* GetBrandedImagesData(bool super_referral) const;
 
+  // Holds the background and sponsored images shown on the new tab page.
+  NTPImageCache* image_cache() { return &image_cache_; }
+
   bool test_data_used() const { return test_data_used_; }
 
   bool IsSuperReferral() const;
@@ -132,6 +136,10 @@ class NTPBackgroundImagesService {
   void OnMappingTableComponentReady(const base::FilePath& installed_dir);
   void OnPreferenceChanged(const std::string& pref_name);
   void OnGetMappingTableData(const std::string& json_string);
+  // Drops the cached images which are no longer part of the current
+  // components. The images are read ahead by ViewCounterService, which knows
+  // whether they are shown at all.
+  void RetainImages();
 
   std::string GetReferralPromoCode() const;
   bool IsValidSuperReferralComponentInfo(
@@ -163,6 +171,7 @@ class NTPBackgroundImagesService {
   base::ObserverList<Observer>::Unchecked observer_list_;
   std::unique_ptr<NTPSponsoredImagesData> si_images_data_;
   std::unique_ptr<NTPSponsoredImagesData> sr_images_data_;
+  NTPImageCache image_cache_;
   PrefChangeRegistrar pref_change_registrar_;
   // This is only used for registration during initial(first) SR component
   // download. After initial download is done, it's cached to
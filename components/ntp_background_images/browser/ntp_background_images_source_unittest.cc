@@ -35,7 +35,7 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                         base::Value::Dict());
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPSponsoredImagesSource> source_;
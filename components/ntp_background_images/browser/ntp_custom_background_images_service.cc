@@ -15,9 +15,18 @@
 
 namespace ntp_background_images {
 
+namespace {
+
+// Custom images are stored downscaled to the display size, so a few of them
+// fit.
+constexpr size_t kMaxImageCacheSizeInBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
 NTPCustomBackgroundImagesService::NTPCustomBackgroundImagesService(
     std::unique_ptr<Delegate> delegate)
-    : delegate_(std::move(delegate)) {
+    : delegate_(std::move(delegate)),
+      image_cache_(kMaxImageCacheSizeInBytes) {
   DCHECK(delegate_);
 }
 
@@ -65,6 +74,11 @@ base::FilePath NTPCustomBackgroundImagesService::GetImageFilePath(
   return delegate_->GetCustomBackgroundImageLocalFilePath(url);
 }
 
+void NTPCustomBackgroundImagesService::OnCustomImageChanged(
+    const base::FilePath& path) {
+  image_cache_.Invalidate(path);
+}
+
 void NTPCustomBackgroundImagesService::Shutdown() {
   delegate_.reset();
 }
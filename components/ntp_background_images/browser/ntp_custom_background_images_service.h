@@ -10,6 +10,7 @@
 #include <string>
 
 #include "base/values.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace base {
@@ -53,12 +54,18 @@ class NTPCustomBackgroundImagesService : public KeyedService {
   bool ShouldShowCustomBackground() const;
   base::Value::Dict GetBackground() const;
   base::FilePath GetImageFilePath(const GURL& url);
+  // Holds the custom images shown on the new tab page.
+  NTPImageCache* image_cache() { return &image_cache_; }
+  // Called when the custom image at |path| is saved or removed, as the same
+  // name can be used again for another image.
+  void OnCustomImageChanged(const base::FilePath& path);
 
  private:
   // KeyedService overrides:
   void Shutdown() override;
 
   std::unique_ptr<Delegate> delegate_;
+  NTPImageCache image_cache_;
 };
 
 }  // namespace ntp_background_images
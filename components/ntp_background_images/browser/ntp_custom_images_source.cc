@@ -9,28 +9,17 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/stringprintf.h"
-#include "base/task/thread_pool.h"
 #include "brave/components/ntp_background_images/browser/ntp_custom_background_images_service.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
 namespace ntp_background_images {
 
-namespace {
-
-std::string ReadFileToString(const base::FilePath& path) {
-  std::string contents;
-  base::ReadFileToString(path, &contents);
-  return contents;
-}
-
-}  // namespace
-
 NTPCustomImagesSource::NTPCustomImagesSource(
     NTPCustomBackgroundImagesService* service)
     : service_(service), weak_factory_(this) {
@@ -61,20 +50,20 @@ bool NTPCustomImagesSource::AllowCaching() {
 
 void NTPCustomImagesSource::GetImageFile(const base::FilePath& image_file_path,
                                          GotDataCallback callback) {
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ReadFileToString, image_file_path),
+  service_->image_cache()->Get(
+      image_file_path,
       base::BindOnce(&NTPCustomImagesSource::OnGotImageFile,
                      weak_factory_.GetWeakPtr(), std::move(callback)));
 }
 
-void NTPCustomImagesSource::OnGotImageFile(GotDataCallback callback,
-                                           const std::string& input) {
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-      reinterpret_cast<const unsigned char*>(input.c_str()), input.length());
+void NTPCustomImagesSource::OnGotImageFile(
+    GotDataCallback callback,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  // Serve an empty image if the file couldn't be read.
+  if (!bytes)
+    bytes = base::MakeRefCounted<base::RefCountedBytes>();
+
   std::move(callback).Run(std::move(bytes));
-  return;
 }
 
 }  // namespace ntp_background_images
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/url_data_source.h"
 
@@ -41,7 +42,8 @@ class NTPCustomImagesSource : public content::URLDataSource {
 
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback, const std::string& input);
+  void OnGotImageFile(GotDataCallback callback,
+                      scoped_refptr<base::RefCountedMemory> bytes);
 
   raw_ptr<NTPCustomBackgroundImagesService> service_ = nullptr;  // not owned
   base::WeakPtrFactory<NTPCustomImagesSource> weak_factory_;
@@ -0,0 +1,206 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <string>
+#include <utility>
+
+#include "base/containers/flat_set.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+NTPImageCache::CachedFile::CachedFile() = default;
+NTPImageCache::CachedFile::CachedFile(
+    base::Time last_modified,
+    scoped_refptr<base::RefCountedMemory> bytes)
+    : last_modified(last_modified), bytes(std::move(bytes)) {}
+NTPImageCache::CachedFile::CachedFile(const CachedFile&) = default;
+NTPImageCache::CachedFile& NTPImageCache::CachedFile::operator=(
+    const CachedFile&) = default;
+NTPImageCache::CachedFile::~CachedFile() = default;
+
+NTPImageCache::NTPImageCache(size_t max_size_in_bytes)
+    : max_size_in_bytes_(max_size_in_bytes),
+      files_(base::LRUCache<base::FilePath, CachedFile>::NO_AUTO_EVICT) {}
+
+NTPImageCache::~NTPImageCache() = default;
+
+void NTPImageCache::Get(const base::FilePath& path, GetCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = files_.Get(path);
+  if (it != files_.end()) {
+    std::move(callback).Run(it->second.bytes);
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&NTPImageCache::ReadFile, path),
+      base::BindOnce(&NTPImageCache::OnReadFile, weak_factory_.GetWeakPtr(),
+                     path, invalidation_count_, std::move(callback)));
+}
+
+void NTPImageCache::Preload(const std::vector<base::FilePath>& paths) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Files not cached yet are given a null modification time, so they are
+  // read whatever their actual one is.
+  std::vector<std::pair<base::FilePath, base::Time>> files;
+  for (const auto& path : base::flat_set<base::FilePath>(paths)) {
+    if (path.empty()) {
+      continue;
+    }
+    auto it = files_.Peek(path);
+    files.emplace_back(path, it != files_.end() ? it->second.last_modified
+                                                : base::Time());
+  }
+
+  PostReadModifiedFiles(std::move(files));
+}
+
+void NTPImageCache::Retain(const std::vector<base::FilePath>& paths) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Reads in progress may be of the files being dropped.
+  invalidation_count_++;
+
+  const base::flat_set<base::FilePath> paths_to_keep(paths);
+  std::vector<std::pair<base::FilePath, base::Time>> files;
+  for (auto it = files_.begin(); it != files_.end();) {
+    if (paths_to_keep.contains(it->first)) {
+      files.emplace_back(it->first, it->second.last_modified);
+      ++it;
+      continue;
+    }
+    size_in_bytes_ -= it->second.bytes->size();
+    it = files_.Erase(it);
+  }
+
+  PostReadModifiedFiles(std::move(files));
+}
+
+void NTPImageCache::Invalidate(const base::FilePath& path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  invalidation_count_++;
+  Erase(path);
+}
+
+bool NTPImageCache::IsCached(const base::FilePath& path) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return files_.Peek(path) != files_.end();
+}
+
+// static
+absl::optional<NTPImageCache::CachedFile> NTPImageCache::ReadFile(
+    const base::FilePath& path) {
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info) || info.is_directory) {
+    return absl::nullopt;
+  }
+
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents)) {
+    return absl::nullopt;
+  }
+
+  return CachedFile(info.last_modified,
+                    base::RefCountedString::TakeString(&contents));
+}
+
+// static
+NTPImageCache::PreloadedFiles NTPImageCache::ReadModifiedFiles(
+    std::vector<std::pair<base::FilePath, base::Time>> files) {
+  PreloadedFiles preloaded_files;
+  for (const auto& [path, last_modified] : files) {
+    base::File::Info info;
+    if (!last_modified.is_null() && base::GetFileInfo(path, &info) &&
+        info.last_modified == last_modified) {
+      continue;
+    }
+    preloaded_files.emplace_back(path, ReadFile(path));
+  }
+
+  return preloaded_files;
+}
+
+void NTPImageCache::PostReadModifiedFiles(
+    std::vector<std::pair<base::FilePath, base::Time>> files) {
+  if (files.empty()) {
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&NTPImageCache::ReadModifiedFiles, std::move(files)),
+      base::BindOnce(&NTPImageCache::OnPreloaded, weak_factory_.GetWeakPtr(),
+                     invalidation_count_));
+}
+
+void NTPImageCache::OnReadFile(const base::FilePath& path,
+                               int invalidation_count,
+                               GetCallback callback,
+                               absl::optional<CachedFile> file) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!file) {
+    std::move(callback).Run(nullptr);
+    return;
+  }
+
+  if (invalidation_count == invalidation_count_) {
+    Put(path, *file);
+  }
+  std::move(callback).Run(std::move(file->bytes));
+}
+
+void NTPImageCache::OnPreloaded(int invalidation_count,
+                                PreloadedFiles files) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (invalidation_count != invalidation_count_) {
+    return;
+  }
+
+  for (const auto& [path, file] : files) {
+    if (file) {
+      Put(path, *file);
+    } else {
+      Erase(path);
+    }
+  }
+}
+
+void NTPImageCache::Put(const base::FilePath& path, const CachedFile& file) {
+  Erase(path);
+  // A file larger than the whole cache is served but not kept.
+  if (file.bytes->size() > max_size_in_bytes_) {
+    return;
+  }
+
+  files_.Put(path, file);
+  size_in_bytes_ += file.bytes->size();
+  while (size_in_bytes_ > max_size_in_bytes_) {
+    auto oldest = files_.rbegin();
+    size_in_bytes_ -= oldest->second.bytes->size();
+    files_.Erase(oldest);
+  }
+}
+
+void NTPImageCache::Erase(const base::FilePath& path) {
+  auto it = files_.Peek(path);
+  if (it == files_.end()) {
+    return;
+  }
+
+  size_in_bytes_ -= it->second.bytes->size();
+  files_.Erase(it);
+}
+
+}  // namespace ntp_background_images
@@ -0,0 +1,115 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/functional/callback.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ntp_background_images {
+
+// Bounded in-memory cache of the image files served to the new tab page, so
+// opening a new tab doesn't read the same few images from disk again. Files
+// are kept as read and handed out as the same |base::RefCountedMemory|, so
+// serving a cached image copies nothing. The least recently used files are
+// dropped once the cached files take more than |max_size_in_bytes|.
+//
+// Files are keyed by path and modification time: when the images change, for
+// instance after a component update, |Retain| drops the files which are no
+// longer used and reads again the ones modified since they were cached.
+class NTPImageCache {
+ public:
+  using GetCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory> bytes)>;
+
+  explicit NTPImageCache(size_t max_size_in_bytes);
+  ~NTPImageCache();
+
+  NTPImageCache(const NTPImageCache&) = delete;
+  NTPImageCache& operator=(const NTPImageCache&) = delete;
+
+  // Runs |callback| with the contents of |path|, synchronously if the file is
+  // cached, or with null if it can't be read.
+  void Get(const base::FilePath& path, GetCallback callback);
+
+  // Reads those of |paths| which aren't cached yet or were modified since,
+  // ahead of the new tabs which show them.
+  void Preload(const std::vector<base::FilePath>& paths);
+
+  // Makes |paths| the only files which may stay cached: drops the other files
+  // and reads again the cached ones modified since. Files which aren't cached
+  // are not read, and reads in progress are not cached.
+  void Retain(const std::vector<base::FilePath>& paths);
+
+  // Drops |path|, for files changed without their modification time telling,
+  // e.g. a file removed and written again within the same second. Reads in
+  // progress are not cached.
+  void Invalidate(const base::FilePath& path);
+
+  bool IsCached(const base::FilePath& path) const;
+  size_t size() const { return files_.size(); }
+  size_t size_in_bytes() const { return size_in_bytes_; }
+
+ private:
+  struct CachedFile {
+    CachedFile();
+    CachedFile(base::Time last_modified,
+               scoped_refptr<base::RefCountedMemory> bytes);
+    CachedFile(const CachedFile&);
+    CachedFile& operator=(const CachedFile&);
+    ~CachedFile();
+
+    base::Time last_modified;
+    scoped_refptr<base::RefCountedMemory> bytes;
+  };
+
+  // The files read by |ReadModifiedFiles|, with no value for those which
+  // couldn't be.
+  using PreloadedFiles =
+      std::vector<std::pair<base::FilePath, absl::optional<CachedFile>>>;
+
+  static absl::optional<CachedFile> ReadFile(const base::FilePath& path);
+  static PreloadedFiles ReadModifiedFiles(
+      std::vector<std::pair<base::FilePath, base::Time>> files);
+
+  // Reads |files| on the thread pool, unless unmodified since their cached
+  // modification time.
+  void PostReadModifiedFiles(
+      std::vector<std::pair<base::FilePath, base::Time>> files);
+  void OnReadFile(const base::FilePath& path,
+                  int invalidation_count,
+                  GetCallback callback,
+                  absl::optional<CachedFile> file);
+  void OnPreloaded(int invalidation_count, PreloadedFiles files);
+  void Put(const base::FilePath& path, const CachedFile& file);
+  void Erase(const base::FilePath& path);
+
+  const size_t max_size_in_bytes_;
+  size_t size_in_bytes_ = 0;
+  // Incremented by |Invalidate| and |Retain|, so files read before are not
+  // cached.
+  int invalidation_count_ = 0;
+  base::LRUCache<base::FilePath, CachedFile> files_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<NTPImageCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
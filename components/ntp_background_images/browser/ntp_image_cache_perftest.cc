@@ -0,0 +1,101 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/task/thread_pool.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "NTPImageCache.";
+constexpr char kMetricTimeToFirstByte[] = "time_to_first_byte";
+
+constexpr int kNewTabCount = 200;
+// About the size of the images in the background images component.
+constexpr size_t kImageSizeInBytes = 600 * 1024;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimeToFirstByte, "us");
+  return reporter;
+}
+
+// What the new tab page image sources did for every request before the cache.
+scoped_refptr<base::RefCountedMemory> ReadFileAndCopy(
+    const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents)) {
+    return nullptr;
+  }
+  return base::MakeRefCounted<base::RefCountedBytes>(
+      reinterpret_cast<const unsigned char*>(contents.c_str()),
+      contents.length());
+}
+
+void OnImage(base::OnceClosure quit,
+             scoped_refptr<base::RefCountedMemory> bytes) {
+  EXPECT_TRUE(bytes);
+  std::move(quit).Run();
+}
+
+}  // namespace
+
+class NTPImageCachePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("background.jpg");
+    ASSERT_TRUE(base::WriteFile(path_, std::string(kImageSizeInBytes, 'x')));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(NTPImageCachePerfTest, ReadAndCopy) {
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kNewTabCount; i++) {
+    base::RunLoop run_loop;
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock()}, base::BindOnce(&ReadFileAndCopy, path_),
+        base::BindOnce(&OnImage, run_loop.QuitClosure()));
+    run_loop.Run();
+  }
+  SetUpReporter("read_and_copy")
+      .AddResult(kMetricTimeToFirstByte, timer.Elapsed() / kNewTabCount);
+}
+
+TEST_F(NTPImageCachePerfTest, Cache) {
+  NTPImageCache cache(32 * 1024 * 1024);
+  cache.Preload({path_});
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(cache.IsCached(path_));
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kNewTabCount; i++) {
+    base::RunLoop run_loop;
+    cache.Get(path_, base::BindOnce(&OnImage, run_loop.QuitClosure()));
+    run_loop.Run();
+  }
+  SetUpReporter("cache").AddResult(kMetricTimeToFirstByte,
+                                   timer.Elapsed() / kNewTabCount);
+}
+
+}  // namespace ntp_background_images
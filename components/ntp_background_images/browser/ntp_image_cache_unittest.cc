@@ -0,0 +1,252 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <string>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+std::string ToString(const scoped_refptr<base::RefCountedMemory>& bytes) {
+  return bytes ? std::string(bytes->front_as<char>(), bytes->size())
+               : std::string();
+}
+
+}  // namespace
+
+class NTPImageCacheTest : public testing::Test {
+ public:
+  NTPImageCacheTest() = default;
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  scoped_refptr<base::RefCountedMemory> Get(NTPImageCache* cache,
+                                            const base::FilePath& path) {
+    scoped_refptr<base::RefCountedMemory> result;
+    base::RunLoop run_loop;
+    cache->Get(path, base::BindOnce(
+                         [](scoped_refptr<base::RefCountedMemory>* result,
+                            base::OnceClosure quit,
+                            scoped_refptr<base::RefCountedMemory> bytes) {
+                           *result = std::move(bytes);
+                           std::move(quit).Run();
+                         },
+                         &result, run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(NTPImageCacheTest, ServesCachedFileWithoutCopy) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("image.jpg", "jpeg");
+
+  const scoped_refptr<base::RefCountedMemory> bytes = Get(&cache, path);
+  EXPECT_EQ("jpeg", ToString(bytes));
+  EXPECT_TRUE(cache.IsCached(path));
+  EXPECT_EQ(4u, cache.size_in_bytes());
+
+  // Served from memory, as the very same bytes.
+  ASSERT_TRUE(base::DeleteFile(path));
+  EXPECT_EQ(bytes, Get(&cache, path));
+}
+
+TEST_F(NTPImageCacheTest, DoesNotCacheMissingFile) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("missing.jpg");
+
+  EXPECT_FALSE(Get(&cache, path));
+  EXPECT_FALSE(cache.IsCached(path));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(NTPImageCacheTest, EvictsLeastRecentlyUsedFiles) {
+  NTPImageCache cache(10);
+  const base::FilePath a = WriteImage("a.jpg", "aaaa");
+  const base::FilePath b = WriteImage("b.jpg", "bbbb");
+  const base::FilePath c = WriteImage("c.jpg", "cccc");
+
+  Get(&cache, a);
+  Get(&cache, b);
+  // |a| is now more recently used than |b|.
+  Get(&cache, a);
+  Get(&cache, c);
+
+  EXPECT_TRUE(cache.IsCached(a));
+  EXPECT_FALSE(cache.IsCached(b));
+  EXPECT_TRUE(cache.IsCached(c));
+  EXPECT_EQ(8u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, DoesNotCacheFileLargerThanCache) {
+  NTPImageCache cache(4);
+  const base::FilePath path = WriteImage("large.jpg", "larger");
+
+  EXPECT_EQ("larger", ToString(Get(&cache, path)));
+  EXPECT_FALSE(cache.IsCached(path));
+  EXPECT_EQ(0u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, PreloadKeepsOtherFiles) {
+  NTPImageCache cache(1024);
+  const base::FilePath a = WriteImage("a.jpg", "aaaa");
+  const base::FilePath b = WriteImage("b.jpg", "bbbb");
+
+  cache.Preload({a});
+  task_environment_.RunUntilIdle();
+  cache.Preload({b});
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache.IsCached(a));
+  EXPECT_TRUE(cache.IsCached(b));
+  EXPECT_EQ(8u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, RetainDropsFilesOfPreviousComponent) {
+  NTPImageCache cache(1024);
+  const base::FilePath a = WriteImage("a.jpg", "aaaa");
+  const base::FilePath b = WriteImage("b.jpg", "bbbb");
+  const base::FilePath c = WriteImage("c.jpg", "cccc");
+
+  cache.Preload({a, b});
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache.IsCached(a));
+  EXPECT_TRUE(cache.IsCached(b));
+
+  // The component is updated: |a| is gone and |c| is new, but isn't read
+  // until it is about to be shown.
+  cache.Retain({b, c});
+  EXPECT_FALSE(cache.IsCached(a));
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(cache.IsCached(a));
+  EXPECT_TRUE(cache.IsCached(b));
+  EXPECT_FALSE(cache.IsCached(c));
+  EXPECT_EQ(4u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, RetainReadsModifiedFilesAgain) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("image.jpg", "old");
+  EXPECT_EQ("old", ToString(Get(&cache, path)));
+
+  // The component is updated in place.
+  WriteImage("image.jpg", "new");
+  const base::Time later = base::Time::Now() + base::Hours(1);
+  ASSERT_TRUE(base::TouchFile(path, later, later));
+  cache.Retain({path});
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("new", ToString(Get(&cache, path)));
+}
+
+TEST_F(NTPImageCacheTest, RetainDropsPreloadInProgress) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("image.jpg", "jpeg");
+
+  cache.Preload({path});
+  cache.Retain({});
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(cache.IsCached(path));
+}
+
+TEST_F(NTPImageCacheTest, PreloadReadsModifiedFilesAgain) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("image.jpg", "old");
+
+  cache.Preload({path});
+  task_environment_.RunUntilIdle();
+  const scoped_refptr<base::RefCountedMemory> old_bytes = Get(&cache, path);
+  EXPECT_EQ("old", ToString(old_bytes));
+
+  // Unmodified files are kept as they are.
+  cache.Preload({path});
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(old_bytes, Get(&cache, path));
+
+  // The component is updated in place.
+  WriteImage("image.jpg", "new");
+  const base::Time later = base::Time::Now() + base::Hours(1);
+  ASSERT_TRUE(base::TouchFile(path, later, later));
+  cache.Preload({path});
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("new", ToString(Get(&cache, path)));
+  EXPECT_EQ(3u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, InvalidateReadsReuploadedFileAgain) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("custom.png", "old");
+  base::File::Info info;
+  ASSERT_TRUE(base::GetFileInfo(path, &info));
+  EXPECT_EQ("old", ToString(Get(&cache, path)));
+
+  // Removed, then uploaded again with the same name and modification time.
+  ASSERT_TRUE(base::DeleteFile(path));
+  cache.Invalidate(path);
+  EXPECT_FALSE(cache.IsCached(path));
+  WriteImage("custom.png", "new");
+  ASSERT_TRUE(base::TouchFile(path, info.last_accessed, info.last_modified));
+
+  EXPECT_EQ("new", ToString(Get(&cache, path)));
+  EXPECT_EQ(3u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, InvalidateDuringRead) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("custom.png", "old");
+
+  scoped_refptr<base::RefCountedMemory> bytes;
+  cache.Get(path, base::BindOnce(
+                      [](scoped_refptr<base::RefCountedMemory>* result,
+                         scoped_refptr<base::RefCountedMemory> bytes) {
+                        *result = std::move(bytes);
+                      },
+                      &bytes));
+  cache.Invalidate(path);
+  task_environment_.RunUntilIdle();
+
+  // Served, but not kept as it may be the file replaced.
+  EXPECT_EQ("old", ToString(bytes));
+  EXPECT_FALSE(cache.IsCached(path));
+}
+
+TEST_F(NTPImageCacheTest, PreloadDropsDeletedFiles) {
+  NTPImageCache cache(1024);
+  const base::FilePath path = WriteImage("image.jpg", "jpeg");
+
+  cache.Preload({path});
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(cache.IsCached(path));
+
+  ASSERT_TRUE(base::DeleteFile(path));
+  cache.Preload({path});
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(cache.IsCached(path));
+  EXPECT_EQ(0u, cache.size_in_bytes());
+}
+
+}  // namespace ntp_background_images
@@ -22,6 +22,7 @@
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/ntp_background_images/browser/features.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_p3a_helper.h"
 #include "brave/components/ntp_background_images/browser/ntp_sponsored_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -307,6 +308,8 @@ void ViewCounterService::ResetModel() {
   if (auto* data = GetCurrentWallpaperData()) {
     model_.set_total_image_count(data->backgrounds.size());
   }
+
+  PreloadImages();
 }
 
 void ViewCounterService::OnPreferenceChanged(const std::string& pref_name) {
@@ -333,6 +336,7 @@ void ViewCounterService::RegisterPageView() {
   service_->CheckNTPSIComponentUpdateIfNeeded();
   model_.RegisterPageView();
   MaybePrefetchNewTabPageAd();
+  PreloadImages();
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
@@ -436,6 +440,40 @@ void ViewCounterService::MaybePrefetchNewTabPageAd() {
   ads_service_->PrefetchNewTabPageAd();
 }
 
+void ViewCounterService::PreloadImages() {
+  std::vector<base::FilePath> image_files;
+
+  // The background shown now and the next one in rotation.
+  NTPBackgroundImagesData* bi_data = GetCurrentWallpaperData();
+  if (IsBackgroundWallpaperActive() && !ShouldShowCustomBackground() &&
+      bi_data && !bi_data->backgrounds.empty()) {
+    const size_t count = bi_data->backgrounds.size();
+    const size_t index = model_.current_wallpaper_image_index();
+    image_files.push_back(bi_data->backgrounds[index % count].image_file);
+    image_files.push_back(bi_data->backgrounds[(index + 1) % count].image_file);
+  }
+
+  // The sponsored image the model points at. The ones picked by the ads
+  // service aren't known ahead and are cached when first shown.
+  NTPSponsoredImagesData* si_data = GetCurrentBrandedWallpaperData();
+  if (IsBrandedWallpaperActive() && !si_data->campaigns.empty() &&
+      (si_data->IsSuperReferral() || !ads_service_ ||
+       !ads_service_->IsEnabled())) {
+    const auto [campaign_index, background_index] =
+        model_.GetCurrentBrandedImageIndex();
+    if (campaign_index < si_data->campaigns.size() &&
+        background_index <
+            si_data->campaigns[campaign_index].backgrounds.size()) {
+      const auto& background =
+          si_data->campaigns[campaign_index].backgrounds[background_index];
+      image_files.push_back(background.image_file);
+      image_files.push_back(background.logo.image_file);
+    }
+  }
+
+  service_->image_cache()->Preload(image_files);
+}
+
 void ViewCounterService::UpdateP3AValues() const {
   uint64_t new_tab_count = new_tab_count_state_->GetHighestValueInWeek();
   p3a_utils::RecordToHistogramBucket("Brave.NTP.NewTabsCreated",
@@ -157,6 +157,10 @@ class ViewCounterService : public KeyedService,
 
   void MaybePrefetchNewTabPageAd();
 
+  // Reads ahead the images the next new tabs are likely to show. Nothing is
+  // read while backgrounds are disabled.
+  void PreloadImages();
+
   void UpdateP3AValues() const;
 
   raw_ptr<NTPBackgroundImagesService> service_ = nullptr;
@@ -0,0 +1,217 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_journal.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+
+namespace brave {
+
+namespace {
+
+// Bump |kVersion| whenever the layout below changes.
+constexpr uint32_t kMagic = 0x4a413350;  // "P3AJ"
+constexpr uint32_t kVersion = 1;
+
+// The file is a header followed by records, each of which is an op, the
+// length of the metric name and the name, followed for kPut by the value,
+// the sent flag and the sent timestamp.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+};
+
+enum Op : uint8_t {
+  kPut = 1,
+  kRemove = 2,
+};
+
+// Appended changes may grow the file up to this size, or twice its compacted
+// size if that is larger, before it is compacted.
+constexpr uint64_t kMinCompactionSize = 64 * 1024;
+
+template <typename T>
+void AppendPod(const T& value, std::string* buffer) {
+  buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(base::StringPiece* data, T* value) {
+  if (data->size() < sizeof(T)) {
+    return false;
+  }
+  memcpy(value, data->data(), sizeof(T));
+  data->remove_prefix(sizeof(T));
+  return true;
+}
+
+void AppendName(Op op, const std::string& name, std::string* buffer) {
+  AppendPod(op, buffer);
+  AppendPod(static_cast<uint32_t>(name.size()), buffer);
+  buffer->append(name);
+}
+
+void AppendPutRecord(const std::string& name,
+                     const BraveP3ALogJournal::Entry& entry,
+                     std::string* buffer) {
+  AppendName(kPut, name, buffer);
+  AppendPod(entry.value, buffer);
+  AppendPod(static_cast<uint8_t>(entry.sent), buffer);
+  AppendPod(entry.sent_timestamp.ToDeltaSinceWindowsEpoch().InMicroseconds(),
+            buffer);
+}
+
+// Applies the record at the start of |data| to |entries| and consumes it.
+// Returns false if the record is incomplete or malformed.
+bool ReadRecord(base::StringPiece* data, BraveP3ALogJournal::Entries* entries) {
+  uint8_t op;
+  uint32_t name_length;
+  if (!ReadPod(data, &op) || !ReadPod(data, &name_length) ||
+      data->size() < name_length) {
+    return false;
+  }
+  std::string name(data->substr(0, name_length));
+  data->remove_prefix(name_length);
+
+  switch (op) {
+    case kPut: {
+      BraveP3ALogJournal::Entry entry;
+      uint8_t sent;
+      int64_t sent_timestamp;
+      if (!ReadPod(data, &entry.value) || !ReadPod(data, &sent) ||
+          !ReadPod(data, &sent_timestamp)) {
+        return false;
+      }
+      entry.sent = sent != 0;
+      entry.sent_timestamp = base::Time::FromDeltaSinceWindowsEpoch(
+          base::Microseconds(sent_timestamp));
+      (*entries)[std::move(name)] = entry;
+      return true;
+    }
+    case kRemove:
+      entries->erase(name);
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+BraveP3ALogJournal::BraveP3ALogJournal(const base::FilePath& path)
+    : path_(path) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+BraveP3ALogJournal::~BraveP3ALogJournal() = default;
+
+BraveP3ALogJournal::LoadResult BraveP3ALogJournal::Load() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  LoadResult result;
+  Entries& entries = result.entries;
+  std::string contents;
+  if (base::ReadFileToString(path_, &contents)) {
+    base::StringPiece data(contents);
+    Header header;
+    if (ReadPod(&data, &header) && header.magic == kMagic &&
+        header.version == kVersion) {
+      while (!data.empty() && ReadRecord(&data, &entries)) {
+      }
+      if (!data.empty()) {
+        LOG(WARNING) << "Dropping " << data.size()
+                     << " malformed bytes at the end of "
+                     << path_.value().c_str();
+      }
+    }
+  }
+
+  result.success = Compact(entries);
+  return result;
+}
+
+void BraveP3ALogJournal::Put(const std::string& name, const Entry& entry) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  entries_[name] = entry;
+  std::string record;
+  AppendPutRecord(name, entry, &record);
+  Append(record);
+}
+
+void BraveP3ALogJournal::Remove(const std::string& name) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (entries_.erase(name) == 0) {
+    return;
+  }
+  std::string record;
+  AppendName(kRemove, name, &record);
+  Append(record);
+}
+
+bool BraveP3ALogJournal::Compact(const Entries& entries) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  entries_ = entries;
+  file_.Close();
+
+  std::string contents;
+  AppendPod(Header{kMagic, kVersion}, &contents);
+  for (const auto& [name, entry] : entries_) {
+    AppendPutRecord(name, entry, &contents);
+  }
+
+  if (!base::CreateDirectory(path_.DirName()) ||
+      !base::ImportantFileWriter::WriteFileAtomically(path_, contents,
+                                                      "P3ALogJournal")) {
+    LOG(ERROR) << "Failed to write P3A log journal " << path_.value().c_str();
+    return false;
+  }
+  bytes_written_ += contents.size();
+  compacted_size_ = contents.size();
+  size_ = contents.size();
+
+  file_.Initialize(path_, base::File::FLAG_OPEN | base::File::FLAG_APPEND);
+  if (!file_.IsValid()) {
+    LOG(ERROR) << "Failed to open P3A log journal " << path_.value().c_str();
+  }
+  // The contents are durable even if later changes can't be appended.
+  return true;
+}
+
+void BraveP3ALogJournal::Append(const std::string& record) {
+  if (size_ + record.size() >
+      std::max(kMinCompactionSize, 2 * compacted_size_)) {
+    // Keeps the file, and so the work to load it, proportional to the
+    // number of values.
+    Compact(entries_);
+    return;
+  }
+  if (!file_.IsValid()) {
+    return;
+  }
+  // A partial write is dropped as a torn record when the file is loaded.
+  if (!file_.WriteAtCurrentPosAndCheck(
+          base::as_bytes(base::make_span(record)))) {
+    LOG(ERROR) << "Failed to append to P3A log journal "
+               << path_.value().c_str();
+    file_.Close();
+    return;
+  }
+  bytes_written_ += record.size();
+  size_ += record.size();
+}
+
+}  // namespace brave
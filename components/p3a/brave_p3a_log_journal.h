@@ -0,0 +1,79 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_JOURNAL_H_
+#define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_JOURNAL_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+
+namespace brave {
+
+// Persists the values of a BraveP3ALogStore in a file of its own. Changes are
+// appended to the file as they happen, and the file is rewritten with just
+// the current values when it is loaded, on rotation, and whenever the
+// appended changes outgrow the current values. So each change costs about
+// one record written, regardless of how many values there are.
+//
+// Does blocking file IO, so it has to live on a sequence that allows it.
+class BraveP3ALogJournal {
+ public:
+  struct Entry {
+    uint64_t value = 0u;
+    bool sent = false;
+    base::Time sent_timestamp;
+  };
+  using Entries = base::flat_map<std::string, Entry>;
+  struct LoadResult {
+    Entries entries;
+    // Whether |entries| were written back to the file.
+    bool success = false;
+  };
+
+  explicit BraveP3ALogJournal(const base::FilePath& path);
+  ~BraveP3ALogJournal();
+
+  BraveP3ALogJournal(const BraveP3ALogJournal&) = delete;
+  BraveP3ALogJournal& operator=(const BraveP3ALogJournal&) = delete;
+
+  // Replays the file, dropping a record torn by a crash at its end, and
+  // compacts it. A missing or malformed file loads as empty.
+  LoadResult Load();
+
+  void Put(const std::string& name, const Entry& entry);
+  void Remove(const std::string& name);
+
+  // Replaces the contents of the file with |entries| and returns whether they
+  // were written. Changes are not appended while the file can't be opened.
+  bool Compact(const Entries& entries);
+
+  // Total bytes written to the file so far.
+  uint64_t bytes_written() const { return bytes_written_; }
+
+ private:
+  void Append(const std::string& record);
+
+  const base::FilePath path_;
+  base::File file_;
+  // The values as of the last append, so compacting doesn't need a reload.
+  Entries entries_;
+  // Size of the file right after the last compaction.
+  uint64_t compacted_size_ = 0u;
+  uint64_t size_ = 0u;
+  uint64_t bytes_written_ = 0u;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_JOURNAL_H_
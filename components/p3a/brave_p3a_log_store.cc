@@ -5,18 +5,22 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <utility>
 #include <vector>
 
 #include "base/check_op.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/p3a/brave_p3a_uploader.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
-#include "components/prefs/scoped_user_pref_update.h"
 
 namespace brave {
 
@@ -24,10 +28,17 @@ namespace {
 constexpr char kTypicalLogPrefName[] = "p3a.logs";
 constexpr char kExpressLogPrefName[] = "p3a.logs_express";
 constexpr char kSlowLogPrefName[] = "p3a.logs_slow";
+constexpr char kTypicalLogVersionPrefName[] = "p3a.logs_version";
+constexpr char kExpressLogVersionPrefName[] = "p3a.logs_express_version";
+constexpr char kSlowLogVersionPrefName[] = "p3a.logs_slow_version";
 constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Version of the persisted values. 0 for values in prefs, and 1 for values in
+// a BraveP3ALogJournal.
+constexpr int kJournalVersion = 1;
+
 void RecordSentAnswersCount(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -51,6 +62,17 @@ const char* GetPrefName(MetricLogType type) {
   }
 }
 
+const char* GetVersionPrefName(MetricLogType type) {
+  switch (type) {
+    case MetricLogType::kSlow:
+      return kSlowLogVersionPrefName;
+    case MetricLogType::kTypical:
+      return kTypicalLogVersionPrefName;
+    case MetricLogType::kExpress:
+      return kExpressLogVersionPrefName;
+  }
+}
+
 std::string GetUploadType(const std::string& histogram_name) {
   if (base::StartsWith(histogram_name, "Brave.P2A",
                        base::CompareCase::SENSITIVE)) {
@@ -66,8 +88,15 @@ std::string GetUploadType(const std::string& histogram_name) {
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
                                    PrefService* local_state,
-                                   MetricLogType type)
-    : delegate_(delegate), local_state_(local_state), type_(type) {
+                                   MetricLogType type,
+                                   const base::FilePath& journal_path)
+    : delegate_(delegate),
+      local_state_(local_state),
+      type_(type),
+      journal_(base::ThreadPool::CreateSequencedTaskRunner(
+                   {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+                    base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+               journal_path) {
   DCHECK(delegate_);
   DCHECK(local_state);
 }
@@ -75,46 +104,38 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
 BraveP3ALogStore::~BraveP3ALogStore() = default;
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
+  // Only read to migrate values persisted by older versions.
   registry->RegisterDictionaryPref(kExpressLogPrefName);
   registry->RegisterDictionaryPref(kTypicalLogPrefName);
   registry->RegisterDictionaryPref(kSlowLogPrefName);
+
+  registry->RegisterIntegerPref(kExpressLogVersionPrefName, 0);
+  registry->RegisterIntegerPref(kTypicalLogVersionPrefName, 0);
+  registry->RegisterIntegerPref(kSlowLogVersionPrefName, 0);
 }
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
-  entry.value = value;
-
-  if (!entry.sent) {
-    DCHECK(entry.sent_timestamp.is_null());
-    unsent_entries_.insert(histogram_name);
+  if (!pending_changes_applied_) {
+    pending_changes_.emplace_back(histogram_name, value);
+    return;
   }
-
-  // Update the persistent value.
-  ScopedDictPrefUpdate update(local_state_, GetPrefName(type_));
-  base::Value::Dict* log_dict = update->EnsureDict(histogram_name);
-  log_dict->Set(kLogValueKey, base::NumberToString(value));
-  log_dict->Set(kLogSentKey, entry.sent);
+  UpdateValueInternal(histogram_name, value);
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
-  log_.erase(histogram_name);
-  unsent_entries_.erase(histogram_name);
-
-  // Update the persistent value.
-  ScopedDictPrefUpdate(local_state_, GetPrefName(type_))
-      ->Remove(histogram_name);
-
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
-    staged_log_.clear();
+  if (!pending_changes_applied_) {
+    pending_changes_.emplace_back(histogram_name, absl::nullopt);
+    return;
   }
+  RemoveValueInternal(histogram_name);
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
+  DCHECK(loaded_);
+
   // Clear log entries flags.
-  ScopedDictPrefUpdate update(local_state_, GetPrefName(type_));
   for (auto it = log_.begin(); it != log_.end();) {
     if (it->second.sent) {
       DCHECK(!it->second.sent_timestamp.is_null());
@@ -124,17 +145,11 @@ void BraveP3ALogStore::ResetUploadStamps() {
         // Ephemeral metrics should only be sent once.
         // Remove value from log store so it doesn't get
         // sent again (unless another histogram value is recorded)
-        update->Remove(it->first);
         it = log_.erase(it);
         continue;
       }
 
       it->second.ResetSentState();
-
-      // Update persistent values.
-      base::Value::Dict* log_dict = update->EnsureDict(it->first);
-      log_dict->Set(kLogSentKey, it->second.sent);
-      log_dict->Set(kLogTimestampKey, it->second.sent_timestamp.ToDoubleT());
     }
     it++;
   }
@@ -149,6 +164,15 @@ void BraveP3ALogStore::ResetUploadStamps() {
   for (const auto& pair : log_) {
     unsent_entries_.insert(pair.first);
   }
+
+  // Rotation touches most of the values, so rewrite them all at once rather
+  // than appending a change for each.
+  BraveP3ALogJournal::Entries entries;
+  for (const auto& [name, entry] : log_) {
+    entries[name] = {entry.value, entry.sent, entry.sent_timestamp};
+  }
+  journal_.AsyncCall(&BraveP3ALogJournal::Compact)
+      .WithArgs(std::move(entries));
 }
 
 const std::string& BraveP3ALogStore::staged_log_key() const {
@@ -219,10 +243,7 @@ void BraveP3ALogStore::DiscardStagedLog() {
   log_iter->second.MarkAsSent();
 
   // Update the persistent value.
-  ScopedDictPrefUpdate update(local_state_, GetPrefName(type_));
-  base::Value::Dict* log_dict = update->EnsureDict(log_iter->first);
-  log_dict->Set(kLogSentKey, log_iter->second.sent);
-  log_dict->Set(kLogTimestampKey, log_iter->second.sent_timestamp.ToDoubleT());
+  PersistEntry(log_iter->first, log_iter->second);
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -241,60 +262,155 @@ void BraveP3ALogStore::TrimAndPersistUnsentLogs(
 }
 
 void BraveP3ALogStore::LoadPersistedUnsentLogs() {
+  LoadPersistedUnsentLogs(base::DoNothing());
+}
+
+void BraveP3ALogStore::LoadPersistedUnsentLogs(base::OnceClosure callback) {
   DCHECK(log_.empty());
   DCHECK(unsent_entries_.empty());
 
-  const char* pref_name = GetPrefName(type_);
-
-  std::vector<std::string> metrics_to_remove;
+  if (local_state_->GetInteger(GetVersionPrefName(type_)) < kJournalVersion) {
+    // Replaces whatever an interrupted migration may have left behind.
+    journal_.AsyncCall(&BraveP3ALogJournal::Compact)
+        .WithArgs(LoadLegacyPrefs())
+        .Then(base::BindOnce(&BraveP3ALogStore::OnLegacyPrefsMigrated,
+                             weak_factory_.GetWeakPtr()));
+  }
+  journal_.AsyncCall(&BraveP3ALogJournal::Load)
+      .Then(base::BindOnce(&BraveP3ALogStore::OnJournalLoaded,
+                           weak_factory_.GetWeakPtr(), std::move(callback)));
+}
 
-  const base::Value::Dict& log_dict = local_state_->GetDict(pref_name);
+BraveP3ALogJournal::Entries BraveP3ALogStore::LoadLegacyPrefs() const {
+  BraveP3ALogJournal::Entries entries;
+  const base::Value::Dict& log_dict =
+      local_state_->GetDict(GetPrefName(type_));
+  // Stops at the first malformed value, keeping the ones before it.
   for (const auto [name, value] : log_dict) {
-    LogEntry entry;
-    // Check if the metric is obsolete.
-    if (!delegate_->IsActualMetric(name)) {
-      // Drop it from the local state.
-      metrics_to_remove.push_back(name);
-      continue;
-    }
+    BraveP3ALogJournal::Entry entry;
     // Value.
-    const base::Value::Dict& dict = value.GetDict();
-    if (const std::string* v = dict.FindString(kLogValueKey)) {
+    const base::Value::Dict* dict = value.GetIfDict();
+    if (!dict) {
+      break;
+    }
+    if (const std::string* v = dict->FindString(kLogValueKey)) {
       if (!base::StringToUint64(*v, &entry.value)) {
-        return;
+        break;
       }
     } else {
-      return;
+      break;
     }
 
     // Sent flag.
-    if (auto v = dict.FindBool(kLogSentKey)) {
+    if (auto v = dict->FindBool(kLogSentKey)) {
       entry.sent = *v;
     } else {
-      return;
+      break;
     }
 
     // Timestamp.
-    if (auto v = dict.FindDouble(kLogTimestampKey)) {
+    if (auto v = dict->FindDouble(kLogTimestampKey)) {
       entry.sent_timestamp = base::Time::FromDoubleT(*v);
-      if ((entry.sent && entry.sent_timestamp.is_null()) ||
-          (!entry.sent && !entry.sent_timestamp.is_null())) {
-        return;
-      }
     }
 
-    log_[name] = entry;
+    entries[name] = entry;
+  }
+  return entries;
+}
+
+void BraveP3ALogStore::OnLegacyPrefsMigrated(bool success) {
+  if (!success) {
+    // The prefs are kept, and migrated again on the next load.
+    return;
+  }
+
+  // The journal now holds the values, so the prefs can go.
+  local_state_->ClearPref(GetPrefName(type_));
+  local_state_->SetInteger(GetVersionPrefName(type_), kJournalVersion);
+}
+
+void BraveP3ALogStore::OnJournalLoaded(base::OnceClosure callback,
+                                       BraveP3ALogJournal::LoadResult result) {
+  DCHECK(!loaded_);
+
+  if (!result.success) {
+    LOG(ERROR) << "P3A values may not be persisted";
+  }
+
+  BraveP3ALogJournal::Entries entries = std::move(result.entries);
+  if (local_state_->GetInteger(GetVersionPrefName(type_)) < kJournalVersion) {
+    // The migration failed, so the prefs still hold the values.
+    entries = LoadLegacyPrefs();
+  }
+
+  for (const auto& [name, entry] : entries) {
+    // Check if the metric is obsolete, or the entry inconsistent.
+    if (!delegate_->IsActualMetric(name) ||
+        entry.sent == entry.sent_timestamp.is_null()) {
+      // Drop it from the journal.
+      journal_.AsyncCall(&BraveP3ALogJournal::Remove).WithArgs(name);
+      continue;
+    }
+
+    LogEntry& log_entry = log_[name];
+    log_entry.value = entry.value;
+    log_entry.sent = entry.sent;
+    log_entry.sent_timestamp = entry.sent_timestamp;
     if (!entry.sent) {
       unsent_entries_.insert(name);
     }
   }
 
-  if (!metrics_to_remove.empty()) {
-    ScopedDictPrefUpdate update(local_state_, pref_name);
-    for (const std::string& name : metrics_to_remove) {
-      update->Remove(name);
+  loaded_ = true;
+  // The rotation at init runs in |callback|. The changes made before then are
+  // applied after it, so that it doesn't drop a value recorded before init
+  // for an ephemeral metric which was already sent.
+  std::move(callback).Run();
+
+  pending_changes_applied_ = true;
+  for (const auto& [name, value] : pending_changes_) {
+    if (value) {
+      UpdateValueInternal(name, *value);
+    } else {
+      RemoveValueInternal(name);
     }
   }
+  pending_changes_.clear();
+}
+
+void BraveP3ALogStore::UpdateValueInternal(const std::string& histogram_name,
+                                           uint64_t value) {
+  LogEntry& entry = log_[histogram_name];
+  entry.value = value;
+
+  if (!entry.sent) {
+    DCHECK(entry.sent_timestamp.is_null());
+    unsent_entries_.insert(histogram_name);
+  }
+
+  // Update the persistent value.
+  PersistEntry(histogram_name, entry);
+}
+
+void BraveP3ALogStore::RemoveValueInternal(const std::string& histogram_name) {
+  log_.erase(histogram_name);
+  unsent_entries_.erase(histogram_name);
+
+  // Update the persistent value.
+  journal_.AsyncCall(&BraveP3ALogJournal::Remove).WithArgs(histogram_name);
+
+  if (has_staged_log() && staged_entry_key_ == histogram_name) {
+    staged_entry_key_.clear();
+    staged_log_.clear();
+  }
+}
+
+void BraveP3ALogStore::PersistEntry(const std::string& histogram_name,
+                                    const LogEntry& entry) {
+  journal_.AsyncCall(&BraveP3ALogJournal::Put)
+      .WithArgs(histogram_name, BraveP3ALogJournal::Entry{
+                                    entry.value, entry.sent,
+                                    entry.sent_timestamp});
 }
 
 }  // namespace brave
@@ -7,11 +7,17 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/functional/callback.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
+#include "base/threading/sequence_bound.h"
 #include "base/time/time.h"
+#include "brave/components/p3a/brave_p3a_log_journal.h"
 #include "brave/components/p3a/metric_log_type.h"
 #include "components/metrics/log_store.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -19,9 +25,17 @@
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class FilePath;
+}  // namespace base
+
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them on the fly in a
+// BraveP3ALogJournal, rather than in local state where every change would
+// rewrite the whole local state file. Local state only keeps the version of
+// the journal, and values persisted in prefs by older versions are migrated
+// to it on load.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -42,12 +56,15 @@ class BraveP3ALogStore : public metrics::LogStore {
 
   BraveP3ALogStore(Delegate* delegate,
                    PrefService* local_state,
-                   MetricLogType type);
+                   MetricLogType type,
+                   const base::FilePath& journal_path);
 
   ~BraveP3ALogStore() override;
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
+  // Changes made before the persisted values are loaded are applied once they
+  // are, after the callback passed to |LoadPersistedUnsentLogs| has run.
   void UpdateValue(const std::string& histogram_name, uint64_t value);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
@@ -70,9 +87,12 @@ class BraveP3ALogStore : public metrics::LogStore {
   // |TrimAndPersistUnsentLogs| should not be used, since we persist everything
   // on the fly.
   void TrimAndPersistUnsentLogs(bool overwrite_in_memory_store) override;
-  // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
 
+  // Loads the persisted values off the UI thread, and runs |callback| once
+  // they are loaded. Nothing is staged until then.
+  void LoadPersistedUnsentLogs(base::OnceClosure callback);
+
  private:
   struct LogEntry {
     LogEntry() {}
@@ -91,11 +111,28 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Values persisted in prefs by versions without a journal.
+  BraveP3ALogJournal::Entries LoadLegacyPrefs() const;
+  void OnLegacyPrefsMigrated(bool success);
+  void OnJournalLoaded(base::OnceClosure callback,
+                       BraveP3ALogJournal::LoadResult result);
+  void UpdateValueInternal(const std::string& histogram_name, uint64_t value);
+  void RemoveValueInternal(const std::string& histogram_name);
+  void PersistEntry(const std::string& histogram_name, const LogEntry& entry);
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
   MetricLogType type_;
 
+  base::SequenceBound<BraveP3ALogJournal> journal_;
+  bool loaded_ = false;
+  bool pending_changes_applied_ = false;
+  // Changes made before the journal was loaded and the load callback has run:
+  // a value to set, or absl::nullopt to remove the value.
+  std::vector<std::pair<std::string, absl::optional<uint64_t>>>
+      pending_changes_;
+
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
@@ -106,6 +143,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   // Not used for now.
   std::string staged_log_hash_;
   std::string staged_log_signature_;
+
+  base::WeakPtrFactory<BraveP3ALogStore> weak_factory_{this};
 };
 
 }  // namespace brave
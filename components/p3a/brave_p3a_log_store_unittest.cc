@@ -0,0 +1,321 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "brave/components/p3a/brave_p3a_log_journal.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kObsoleteMetric[] = "Brave.Test.Obsolete";
+constexpr char kEphemeralMetric[] = "Brave.Test.Ephemeral";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value,
+                        MetricLogType log_type,
+                        const std::string& upload_type) override {
+    return base::StrCat({histogram_name, "=", base::NumberToString(value)});
+  }
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return histogram_name != kObsoleteMetric;
+  }
+  bool IsEphemeralMetric(base::StringPiece histogram_name) const override {
+    return histogram_name == kEphemeralMetric;
+  }
+};
+
+BraveP3ALogJournal::Entry UnsentEntry(uint64_t value) {
+  BraveP3ALogJournal::Entry entry;
+  entry.value = value;
+  return entry;
+}
+
+}  // namespace
+
+class BraveP3ALogJournalTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("P3A").AppendASCII("test.journal");
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(BraveP3ALogJournalTest, PersistsChanges) {
+  {
+    BraveP3ALogJournal journal(path_);
+    const BraveP3ALogJournal::LoadResult result = journal.Load();
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.entries.empty());
+    journal.Put("Brave.Test.A", UnsentEntry(1));
+    journal.Put("Brave.Test.B", UnsentEntry(2));
+    journal.Put("Brave.Test.A", UnsentEntry(3));
+    journal.Remove("Brave.Test.B");
+  }
+
+  BraveP3ALogJournal journal(path_);
+  const BraveP3ALogJournal::Entries entries = journal.Load().entries;
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(3u, entries.at("Brave.Test.A").value);
+  EXPECT_FALSE(entries.at("Brave.Test.A").sent);
+}
+
+TEST_F(BraveP3ALogJournalTest, DropsTornRecord) {
+  {
+    BraveP3ALogJournal journal(path_);
+    journal.Load();
+    journal.Put("Brave.Test.A", UnsentEntry(1));
+  }
+  // What a crash halfway through appending a record leaves behind.
+  ASSERT_TRUE(base::AppendToFile(path_, base::StringPiece("\x01\x20\x00", 3)));
+
+  BraveP3ALogJournal journal(path_);
+  const BraveP3ALogJournal::Entries entries = journal.Load().entries;
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ(1u, entries.at("Brave.Test.A").value);
+}
+
+TEST_F(BraveP3ALogJournalTest, MalformedFileLoadsEmpty) {
+  ASSERT_TRUE(base::CreateDirectory(path_.DirName()));
+  ASSERT_TRUE(base::WriteFile(path_, "{\"p3a\": {}}"));
+
+  BraveP3ALogJournal journal(path_);
+  EXPECT_TRUE(journal.Load().entries.empty());
+}
+
+TEST_F(BraveP3ALogJournalTest, ReportsWriteFailure) {
+  // The journal's directory can't be created over a file.
+  ASSERT_TRUE(base::WriteFile(path_.DirName(), ""));
+
+  BraveP3ALogJournal journal(path_);
+  EXPECT_FALSE(journal.Load().success);
+  BraveP3ALogJournal::Entries entries;
+  entries["Brave.Test.A"] = UnsentEntry(1);
+  EXPECT_FALSE(journal.Compact(entries));
+}
+
+TEST_F(BraveP3ALogJournalTest, BoundedWriteAmplification) {
+  constexpr int kUpdates = 1000000;
+  constexpr int kMetrics = 100;
+
+  BraveP3ALogJournal journal(path_);
+  journal.Load();
+  size_t record_size = 0;
+  for (int i = 0; i < kUpdates; i++) {
+    const std::string name =
+        "Brave.Test.Metric" + base::NumberToString(i % kMetrics);
+    journal.Put(name, UnsentEntry(i % 8));
+    // Op, name length, name, value, sent flag and timestamp.
+    record_size = std::max(record_size, 1 + 4 + name.size() + 8 + 1 + 8);
+  }
+
+  // Rewriting all the values on every update, as local state did, would
+  // write about |kMetrics| records per update. Appending with periodic
+  // compaction writes about one.
+  EXPECT_LT(journal.bytes_written(), 2u * kUpdates * record_size);
+  int64_t file_size = 0;
+  ASSERT_TRUE(base::GetFileSize(path_, &file_size));
+  EXPECT_LT(static_cast<size_t>(file_size), 64 * 1024 + record_size);
+
+  BraveP3ALogJournal reloaded(path_);
+  const BraveP3ALogJournal::Entries entries = reloaded.Load().entries;
+  ASSERT_EQ(static_cast<size_t>(kMetrics), entries.size());
+  EXPECT_EQ(static_cast<uint64_t>((kUpdates - 1) % 8),
+            entries.at("Brave.Test.Metric99").value);
+}
+
+class BraveP3ALogStoreTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateStore() {
+    return std::make_unique<BraveP3ALogStore>(
+        &delegate_, &local_state_, MetricLogType::kTypical,
+        temp_dir_.GetPath().AppendASCII("typical.journal"));
+  }
+
+  void Load(BraveP3ALogStore* store) {
+    base::RunLoop run_loop;
+    store->LoadPersistedUnsentLogs(run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  // Lets the store's journal finish its writes.
+  void Destroy(std::unique_ptr<BraveP3ALogStore> store) {
+    store.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+};
+
+TEST_F(BraveP3ALogStoreTest, MigratesPrefs) {
+  {
+    ScopedDictPrefUpdate update(&local_state_, "p3a.logs");
+    base::Value::Dict sent;
+    sent.Set("value", "3");
+    sent.Set("sent", true);
+    sent.Set("timestamp", base::Time::Now().ToDoubleT());
+    update->Set("Brave.Test.Sent", std::move(sent));
+    base::Value::Dict unsent;
+    unsent.Set("value", "5");
+    unsent.Set("sent", false);
+    update->Set("Brave.Test.Unsent", std::move(unsent));
+    base::Value::Dict obsolete;
+    obsolete.Set("value", "1");
+    obsolete.Set("sent", false);
+    update->Set(kObsoleteMetric, std::move(obsolete));
+  }
+
+  auto store = CreateStore();
+  Load(store.get());
+  EXPECT_TRUE(local_state_.GetDict("p3a.logs").empty());
+  EXPECT_EQ(1, local_state_.GetInteger("p3a.logs_version"));
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_EQ("Brave.Test.Unsent", store->staged_log_key());
+  EXPECT_EQ("Brave.Test.Unsent=5", store->staged_log());
+  Destroy(std::move(store));
+
+  // The values now load from the journal alone.
+  store = CreateStore();
+  Load(store.get());
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_EQ("Brave.Test.Unsent", store->staged_log_key());
+  store->DiscardStagedLog();
+  EXPECT_FALSE(store->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, KeepsPrefsIfMigrationFails) {
+  {
+    ScopedDictPrefUpdate update(&local_state_, "p3a.logs");
+    base::Value::Dict unsent;
+    unsent.Set("value", "5");
+    unsent.Set("sent", false);
+    update->Set("Brave.Test.Unsent", std::move(unsent));
+  }
+  // The journal's directory can't be created over a file.
+  const base::FilePath blocked = temp_dir_.GetPath().AppendASCII("blocked");
+  ASSERT_TRUE(base::WriteFile(blocked, ""));
+
+  auto store = std::make_unique<BraveP3ALogStore>(
+      &delegate_, &local_state_, MetricLogType::kTypical,
+      blocked.AppendASCII("typical.journal"));
+  Load(store.get());
+  EXPECT_FALSE(local_state_.GetDict("p3a.logs").empty());
+  EXPECT_EQ(0, local_state_.GetInteger("p3a.logs_version"));
+
+  // Served from the prefs meanwhile.
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_EQ("Brave.Test.Unsent=5", store->staged_log());
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsSentState) {
+  auto store = CreateStore();
+  Load(store.get());
+  store->UpdateValue("Brave.Test.A", 1);
+  store->UpdateValue("Brave.Test.B", 2);
+  store->StageNextLog();
+  const std::string sent_key = store->staged_log_key();
+  store->DiscardStagedLog();
+  store->MarkStagedLogAsSent();
+  Destroy(std::move(store));
+
+  store = CreateStore();
+  Load(store.get());
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_NE(sent_key, store->staged_log_key());
+  store->DiscardStagedLog();
+  EXPECT_FALSE(store->has_unsent_logs());
+
+  // Rotation marks everything as unsent again.
+  store->ResetUploadStamps();
+  EXPECT_TRUE(store->has_unsent_logs());
+  Destroy(std::move(store));
+
+  store = CreateStore();
+  Load(store.get());
+  store->StageNextLog();
+  store->DiscardStagedLog();
+  EXPECT_TRUE(store->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, AppliesChangesMadeBeforeLoad) {
+  auto store = CreateStore();
+  Load(store.get());
+  store->UpdateValue("Brave.Test.A", 1);
+  store->UpdateValue("Brave.Test.B", 2);
+  Destroy(std::move(store));
+
+  store = CreateStore();
+  store->UpdateValue("Brave.Test.A", 7);
+  store->RemoveValueIfExists("Brave.Test.B");
+  EXPECT_FALSE(store->has_unsent_logs());
+  Load(store.get());
+
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_EQ("Brave.Test.A=7", store->staged_log());
+  store->DiscardStagedLog();
+  EXPECT_FALSE(store->has_unsent_logs());
+}
+
+TEST_F(BraveP3ALogStoreTest, KeepsEphemeralValueUpdatedBeforeLoad) {
+  auto store = CreateStore();
+  Load(store.get());
+  store->UpdateValue(kEphemeralMetric, 1);
+  store->StageNextLog();
+  store->DiscardStagedLog();
+  Destroy(std::move(store));
+
+  // Recorded before the service is initialized, so before the rotation at
+  // init drops the sent value.
+  store = CreateStore();
+  store->UpdateValue(kEphemeralMetric, 2);
+  base::RunLoop run_loop;
+  store->LoadPersistedUnsentLogs(base::BindLambdaForTesting([&] {
+    store->ResetUploadStamps();
+    run_loop.Quit();
+  }));
+  run_loop.Run();
+
+  ASSERT_TRUE(store->has_unsent_logs());
+  store->StageNextLog();
+  EXPECT_EQ("Brave.Test.Ephemeral=2", store->staged_log());
+}
+
+}  // namespace brave
@@ -65,6 +65,8 @@ constexpr char kLastTypicalRotationTimeStampPref[] =
 constexpr char kLastExpressRotationTimeStampPref[] =
     "p3a.last_express_rotation_timestamp";
 constexpr char kDynamicMetricsDictPref[] = "p3a.dynamic_metrics";
+constexpr base::FilePath::CharType kLogStoreDirName[] =
+    FILE_PATH_LITERAL("P3A");
 
 constexpr char kP3AServerUrl[] = "https://p3a-json.brave.com/";
 constexpr char kP3ACreativeServerUrl[] = "https://p3a-creative.brave.com/";
@@ -171,10 +173,12 @@ inline void DCheckCurrentlyOnUIThread() {
 
 BraveP3AService::BraveP3AService(PrefService* local_state,
                                  std::string channel,
-                                 std::string week_of_install)
+                                 std::string week_of_install,
+                                 const base::FilePath& user_data_dir)
     : local_state_(std::move(local_state)),
       channel_(std::move(channel)),
-      week_of_install_(week_of_install) {}
+      week_of_install_(week_of_install),
+      log_store_dir_(user_data_dir.Append(kLogStoreDirName)) {}
 
 BraveP3AService::~BraveP3AService() = default;
 
@@ -310,27 +314,12 @@ void BraveP3AService::Init(
   for (MetricLogType log_type : kAllMetricLogTypes) {
     rotation_timers_[log_type] = std::make_unique<base::WallClockTimer>();
 
-    log_stores_[log_type] =
-        std::make_unique<BraveP3ALogStore>(this, local_state_, log_type);
-    log_stores_[log_type]->LoadPersistedUnsentLogs();
-
-    DoRotationAtInitIfNeeded(log_type);
-
-    upload_schedulers_[log_type] = std::make_unique<BraveP3AScheduler>(
-        base::BindRepeating(&BraveP3AService::StartScheduledUpload, this,
-                            log_type),
-        randomize_upload_interval_
-            ? base::BindRepeating(GetRandomizedUploadInterval,
-                                  average_upload_interval_)
-            : base::BindRepeating(
-                  [](base::TimeDelta interval) { return interval; },
-                  average_upload_interval_));
-
-    upload_schedulers_[log_type]->Start();
-
-    if (!rotation_timers_[log_type]->IsRunning()) {
-      UpdateRotationTimer(log_type);
-    }
+    log_stores_[log_type] = std::make_unique<BraveP3ALogStore>(
+        this, local_state_, log_type,
+        log_store_dir_.AppendASCII(MetricLogTypeToString(log_type))
+            .AddExtension(FILE_PATH_LITERAL("journal")));
+    log_stores_[log_type]->LoadPersistedUnsentLogs(
+        base::BindOnce(&BraveP3AService::OnLogStoreLoaded, this, log_type));
   }
 
   // Store values that were recorded between calling constructor and |Init()|.
@@ -614,6 +603,26 @@ void BraveP3AService::OnLogUploadComplete(int response_code,
   upload_schedulers_[log_type]->UploadFinished(ok);
 }
 
+void BraveP3AService::OnLogStoreLoaded(MetricLogType log_type) {
+  DoRotationAtInitIfNeeded(log_type);
+
+  upload_schedulers_[log_type] = std::make_unique<BraveP3AScheduler>(
+      base::BindRepeating(&BraveP3AService::StartScheduledUpload, this,
+                          log_type),
+      randomize_upload_interval_
+          ? base::BindRepeating(GetRandomizedUploadInterval,
+                                average_upload_interval_)
+          : base::BindRepeating(
+                [](base::TimeDelta interval) { return interval; },
+                average_upload_interval_));
+
+  upload_schedulers_[log_type]->Start();
+
+  if (!rotation_timers_[log_type]->IsRunning()) {
+    UpdateRotationTimer(log_type);
+  }
+}
+
 void BraveP3AService::DoRotationAtInitIfNeeded(MetricLogType log_type) {
   // Do rotation if needed.
   base::Time last_rotation =
@@ -12,6 +12,7 @@
 
 #include "base/callback_list.h"
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/statistics_recorder.h"
@@ -40,9 +41,11 @@ class BraveP3AUploader;
 class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
                         public BraveP3ALogStore::Delegate {
  public:
+  // The logs are persisted in a directory of |user_data_dir|.
   BraveP3AService(PrefService* local_state,
                   std::string channel,
-                  std::string week_of_install);
+                  std::string week_of_install,
+                  const base::FilePath& user_data_dir);
 
   BraveP3AService(const BraveP3AService&) = delete;
   BraveP3AService& operator=(const BraveP3AService&) = delete;
@@ -123,6 +126,9 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
                            bool was_https,
                            MetricLogType log_type);
 
+  // Completes |Init| for |log_type| once its persisted logs are loaded.
+  void OnLogStoreLoaded(MetricLogType log_type);
+
   void DoRotationAtInitIfNeeded(MetricLogType log_type);
 
   // Restart the uploading process (i.e. mark all values as unsent).
@@ -135,6 +141,7 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   const std::string channel_;
   const std::string week_of_install_;
+  const base::FilePath log_store_dir_;
 
   // The average interval between uploading different values.
   base::TimeDelta average_upload_interval_;
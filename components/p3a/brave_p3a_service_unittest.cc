@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_reader.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/metrics/histogram_functions.h"
@@ -47,6 +48,7 @@ class P3AServiceTest : public testing::Test {
 
  protected:
   void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
     base::Time future_mock_time;
     if (base::Time::FromString("2050-01-04", &future_mock_time)) {
       task_environment_.AdvanceClock(future_mock_time - base::Time::Now());
@@ -67,7 +69,8 @@ class P3AServiceTest : public testing::Test {
 
   void SetUpP3AService() {
     p3a_service_ = scoped_refptr(
-        new BraveP3AService(&local_state_, "release", "2049-01-01"));
+        new BraveP3AService(&local_state_, "release", "2049-01-01",
+                            temp_dir_.GetPath()));
     p3a_service_->Init(shared_url_loader_factory_);
     task_environment_.RunUntilIdle();
   }
@@ -102,6 +105,8 @@ class P3AServiceTest : public testing::Test {
     return result;
   }
 
+  // Outlives the task environment, so the log journals are closed first.
+  base::ScopedTempDir temp_dir_;
   content::BrowserTaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
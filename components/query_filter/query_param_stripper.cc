@@ -0,0 +1,143 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/query_filter/query_param_stripper.h"
+
+#include <utility>
+
+#include "base/check.h"
+#include "base/containers/contains.h"
+#include "url/gurl.h"
+
+namespace query_filter {
+
+namespace {
+
+enum class ConditionResult { kUnknown, kFalse, kTrue };
+
+// Returns the key of |param|, or nothing if it has no non-empty value.
+absl::optional<base::StringPiece> GetKeyWithValue(base::StringPiece param) {
+  // Same as taking the first two parts of
+  // SplitStringPiece(param, "=", KEEP_WHITESPACE, SPLIT_WANT_NONEMPTY).
+  size_t key_start = param.find_first_not_of('=');
+  if (key_start == base::StringPiece::npos)
+    return absl::nullopt;
+  size_t key_end = param.find('=', key_start);
+  if (key_end == base::StringPiece::npos)
+    return absl::nullopt;
+  if (param.find_first_not_of('=', key_end) == base::StringPiece::npos)
+    return absl::nullopt;
+  return param.substr(key_start, key_end - key_start);
+}
+
+}  // namespace
+
+QueryParamStripper::QueryParamStripper() = default;
+QueryParamStripper::QueryParamStripper(QueryParamStripper&&) = default;
+QueryParamStripper& QueryParamStripper::operator=(QueryParamStripper&&) =
+    default;
+QueryParamStripper::~QueryParamStripper() = default;
+
+void QueryParamStripper::AddParams(
+    const std::vector<base::StringPiece>& params) {
+  AddParams(params, kAlways);
+}
+
+void QueryParamStripper::AddParams(const std::vector<base::StringPiece>& params,
+                                   Condition condition) {
+  DCHECK(condition);
+  conditions_.push_back(std::move(condition));
+  AddParams(params, conditions_.size() - 1);
+}
+
+void QueryParamStripper::AddParams(const std::vector<base::StringPiece>& params,
+                                   ConditionId condition_id) {
+  for (const base::StringPiece param : params) {
+    std::vector<ConditionId>& condition_ids = params_[std::string(param)];
+    if (!base::Contains(condition_ids, condition_id))
+      condition_ids.push_back(condition_id);
+  }
+}
+
+absl::optional<GURL> QueryParamStripper::Strip(const GURL& url) const {
+  if (params_.empty() || !url.has_query())
+    return absl::nullopt;
+
+  const absl::optional<std::string> query =
+      StripQuery(url.query_piece(), url);
+  if (!query)
+    return absl::nullopt;
+
+  GURL::Replacements replacements;
+  if (query->empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQueryStr(*query);
+  }
+  return url.ReplaceComponents(replacements);
+}
+
+absl::optional<std::string> QueryParamStripper::StripQuery(
+    base::StringPiece query,
+    const GURL& url) const {
+  if (params_.empty())
+    return absl::nullopt;
+
+  std::vector<ConditionResult> condition_results(conditions_.size(),
+                                                 ConditionResult::kUnknown);
+  auto should_strip = [&](base::StringPiece param) {
+    const absl::optional<base::StringPiece> key = GetKeyWithValue(param);
+    if (!key)
+      return false;
+    const auto it = params_.find(*key);
+    if (it == params_.end())
+      return false;
+    for (const ConditionId condition_id : it->second) {
+      if (condition_id == kAlways)
+        return true;
+      ConditionResult& result = condition_results[condition_id];
+      if (result == ConditionResult::kUnknown) {
+        result = conditions_[condition_id].Run(url) ? ConditionResult::kTrue
+                                                    : ConditionResult::kFalse;
+      }
+      if (result == ConditionResult::kTrue)
+        return true;
+    }
+    return false;
+  };
+
+  // The output is only built once the first parameter is removed.
+  absl::optional<std::string> stripped_query;
+  bool is_first_kept_param = true;
+  size_t start = 0;
+  while (true) {
+    size_t end = query.find('&', start);
+    if (end == base::StringPiece::npos)
+      end = query.size();
+    const base::StringPiece param = query.substr(start, end - start);
+    if (should_strip(param)) {
+      if (!stripped_query) {
+        stripped_query.emplace();
+        stripped_query->reserve(query.size());
+        // Everything before this parameter is kept as is.
+        if (start > 0) {
+          stripped_query->append(query.data(), start - 1);
+          is_first_kept_param = false;
+        }
+      }
+    } else if (stripped_query) {
+      if (!is_first_kept_param)
+        stripped_query->push_back('&');
+      stripped_query->append(param.data(), param.size());
+      is_first_kept_param = false;
+    }
+    if (end == query.size())
+      break;
+    start = end + 1;
+  }
+  return stripped_query;
+}
+
+}  // namespace query_filter
@@ -0,0 +1,77 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_QUERY_FILTER_QUERY_PARAM_STRIPPER_H_
+#define BRAVE_COMPONENTS_QUERY_FILTER_QUERY_PARAM_STRIPPER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/functional/callback.h"
+#include "base/strings/string_piece.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class GURL;
+
+namespace query_filter {
+
+// Removes tracking parameters from the query of a URL. Parameters are either
+// removed from every URL, or only from URLs which pass a condition, e.g. a
+// site or a URL pattern. All parameters are compiled into a single lookup
+// table, so the query is parsed once and each parameter is looked up once,
+// with the conditions of a parameter only evaluated when it is found.
+//
+// A parameter is a "&"-separated part of the query. Its key is the first
+// non-empty "="-separated part, and it is only removed if it has a non-empty
+// value. The remaining parameters are kept untouched. See
+// https://github.com/brave/brave-core/pull/13726#discussion_r897712350 for why
+// the query is not parsed with the standard URL query parsing code.
+class QueryParamStripper {
+ public:
+  // Evaluated at most once for each URL, and only if one of its parameters is
+  // in the query.
+  using Condition = base::RepeatingCallback<bool(const GURL& url)>;
+
+  QueryParamStripper();
+  QueryParamStripper(const QueryParamStripper&) = delete;
+  QueryParamStripper& operator=(const QueryParamStripper&) = delete;
+  QueryParamStripper(QueryParamStripper&&);
+  QueryParamStripper& operator=(QueryParamStripper&&);
+  ~QueryParamStripper();
+
+  // Removes |params| from every URL.
+  void AddParams(const std::vector<base::StringPiece>& params);
+  // Removes |params| from the URLs for which |condition| returns true.
+  void AddParams(const std::vector<base::StringPiece>& params,
+                 Condition condition);
+
+  bool empty() const { return params_.empty(); }
+
+  // Returns |url| without the tracking parameters, or nothing if it has none,
+  // so that the URL is only rebuilt if something is removed.
+  absl::optional<GURL> Strip(const GURL& url) const;
+
+  // Returns the query of |url| without the tracking parameters, or nothing if
+  // it has none.
+  absl::optional<std::string> StripQuery(base::StringPiece query,
+                                         const GURL& url) const;
+
+ private:
+  // Index into |conditions_|, or |kAlways|.
+  using ConditionId = size_t;
+  static constexpr ConditionId kAlways = static_cast<ConditionId>(-1);
+
+  void AddParams(const std::vector<base::StringPiece>& params,
+                 ConditionId condition_id);
+
+  base::flat_map<std::string, std::vector<ConditionId>, std::less<>> params_;
+  std::vector<Condition> conditions_;
+};
+
+}  // namespace query_filter
+
+#endif  // BRAVE_COMPONENTS_QUERY_FILTER_QUERY_PARAM_STRIPPER_H_
@@ -0,0 +1,125 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/query_filter/query_param_stripper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace query_filter {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "QueryParamStripper.";
+constexpr char kMetricTimePerUrl[] = "time_per_url";
+
+constexpr int kIterations = 10000;
+
+constexpr const char* kUrls[] = {
+    "https://www.example.com/product/12345?utm_source=newsletter&utm_medium="
+    "email&utm_campaign=spring&fbclid=IwAR2xyz",
+    "https://shop.example.org/search?q=shoes&page=2&sort=price_asc",
+    "https://news.example.net/2023/01/article.html?gclid=Cj0KCQiA&ref=home",
+    "https://www.example.com/?mc_eid=abc123&mc_cid=def456",
+    "https://blog.example.com/post/how-to?id=42&lang=en&theme=dark&view=full",
+    "https://example.com/landing?_hsenc=p2ANqtz&_hsmi=12345&__hssc=1.2.3",
+    "https://video.example.com/watch?v=dQw4w9WgXcQ&t=42s&list=PL123",
+    "https://www.example.com/",
+};
+
+constexpr base::StringPiece kParams[] = {
+    "fbclid", "gclid",  "msclkid", "mc_eid",     "dclid",
+    "_hsenc", "__hssc", "__hstc",  "__hsfp",     "yclid",
+    "twclid", "gbraid", "wbraid",  "utm_source", "utm_medium",
+    "utm_campaign"};
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimePerUrl, "us");
+  return reporter;
+}
+
+// The splitting implementation QueryParamStripper replaced, for comparison.
+absl::optional<std::string> StripWithSplit(
+    base::StringPiece query,
+    const base::flat_set<base::StringPiece>& trackers) {
+  std::vector<base::StringPiece> output_kv_strings;
+  int disallowed_count = 0;
+  for (const auto& kv_string : base::SplitStringPiece(
+           query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL)) {
+    const std::vector<base::StringPiece> pieces = base::SplitStringPiece(
+        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (pieces.size() >= 2 && trackers.contains(pieces[0])) {
+      ++disallowed_count;
+    } else {
+      output_kv_strings.push_back(kv_string);
+    }
+  }
+  if (disallowed_count == 0) {
+    return absl::nullopt;
+  }
+  return base::JoinString(output_kv_strings, "&");
+}
+
+std::vector<GURL> MakeUrls() {
+  std::vector<GURL> urls;
+  for (const char* url : kUrls) {
+    urls.emplace_back(url);
+  }
+  return urls;
+}
+
+}  // namespace
+
+TEST(QueryParamStripperPerfTest, Split) {
+  const base::flat_set<base::StringPiece> trackers(std::begin(kParams),
+                                                   std::end(kParams));
+  const std::vector<GURL> urls = MakeUrls();
+
+  base::ElapsedTimer timer;
+  int stripped = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const GURL& url : urls) {
+      const auto query = StripWithSplit(url.query_piece(), trackers);
+      if (query) {
+        GURL::Replacements replacements;
+        replacements.SetQueryStr(*query);
+        stripped += url.ReplaceComponents(replacements).is_valid();
+      }
+    }
+  }
+  SetUpReporter("split").AddResult(
+      kMetricTimePerUrl, timer.Elapsed() / (kIterations * urls.size()));
+  EXPECT_GT(stripped, 0);
+}
+
+TEST(QueryParamStripperPerfTest, Stripper) {
+  QueryParamStripper stripper;
+  stripper.AddParams(
+      std::vector<base::StringPiece>(std::begin(kParams), std::end(kParams)));
+  const std::vector<GURL> urls = MakeUrls();
+
+  base::ElapsedTimer timer;
+  int stripped = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const GURL& url : urls) {
+      stripped += stripper.Strip(url).has_value();
+    }
+  }
+  SetUpReporter("stripper").AddResult(
+      kMetricTimePerUrl, timer.Elapsed() / (kIterations * urls.size()));
+  EXPECT_GT(stripped, 0);
+}
+
+}  // namespace query_filter
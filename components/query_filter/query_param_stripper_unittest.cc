@@ -0,0 +1,115 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/query_filter/query_param_stripper.h"
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace query_filter {
+
+namespace {
+
+bool IsDomain(base::StringPiece domain, const GURL& url) {
+  return url.DomainIs(domain);
+}
+
+bool CountAndReturnTrue(int* count, const GURL& url) {
+  (*count)++;
+  return true;
+}
+
+// The splitting implementation QueryParamStripper replaced, for comparison.
+absl::optional<std::string> StripWithSplit(
+    base::StringPiece query,
+    const base::flat_set<base::StringPiece>& trackers) {
+  std::vector<base::StringPiece> output_kv_strings;
+  int disallowed_count = 0;
+  for (const auto& kv_string : base::SplitStringPiece(
+           query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL)) {
+    const std::vector<base::StringPiece> pieces = base::SplitStringPiece(
+        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (pieces.size() >= 2 && trackers.contains(pieces[0])) {
+      ++disallowed_count;
+    } else {
+      output_kv_strings.push_back(kv_string);
+    }
+  }
+  if (disallowed_count == 0)
+    return absl::nullopt;
+  return base::JoinString(output_kv_strings, "&");
+}
+
+}  // namespace
+
+TEST(QueryParamStripperTest, StripQuery) {
+  QueryParamStripper stripper;
+  stripper.AddParams({"fbclid", "second"});
+
+  EXPECT_EQ("param1=1",
+            stripper.StripQuery("fbclid=11&param1=1&second=2", GURL()));
+  EXPECT_EQ("fbclid2=ok&&param1=1&foo;bar=yes",
+            stripper.StripQuery(
+                "fbclid=11&fbclid2=ok&&param1=1&foo;bar=yes&second=2", GURL()));
+  EXPECT_EQ("&", stripper.StripQuery("&fbclid=1&", GURL()));
+  EXPECT_EQ("", stripper.StripQuery("fbclid=1&second=2", GURL()));
+  // Parameters without a value are kept.
+  EXPECT_FALSE(stripper.StripQuery("fbclid=&second", GURL()));
+  EXPECT_FALSE(stripper.StripQuery("param1=1", GURL()));
+  EXPECT_FALSE(stripper.StripQuery("", GURL()));
+}
+
+TEST(QueryParamStripperTest, MatchesSplitImplementation) {
+  const base::flat_set<base::StringPiece> trackers = {"fbclid", "gclid", "a"};
+  QueryParamStripper stripper;
+  stripper.AddParams({"fbclid", "gclid", "a"});
+
+  const char* const kQueries[] = {
+      "",          "&",          "&&",       "a",         "a=",
+      "=a",        "=a=1",       "a==1",     "a=1=2",     "a=1&a=2&a=3",
+      "b=1&a=1&c", "&a=1",       "a=1&",     "&&a=1&&",   "fbclid=1&b=2",
+      "b=2&gclid", "b=2&gclid=", "x&gclid=1"};
+  for (const char* query : kQueries) {
+    EXPECT_EQ(StripWithSplit(query, trackers),
+              stripper.StripQuery(query, GURL()))
+        << query;
+  }
+}
+
+TEST(QueryParamStripperTest, Strip) {
+  QueryParamStripper stripper;
+  stripper.AddParams({"utm_source"});
+  stripper.AddParams({"t"}, base::BindRepeating(&IsDomain, "twitter.com"));
+
+  EXPECT_EQ(GURL("https://brave.com/#ref"),
+            stripper.Strip(GURL("https://brave.com/?utm_source=a#ref")));
+  EXPECT_EQ(GURL("https://twitter.com/?b=1"),
+            stripper.Strip(GURL("https://twitter.com/?t=1&b=1")));
+  EXPECT_FALSE(stripper.Strip(GURL("https://brave.com/?t=1")));
+  EXPECT_FALSE(stripper.Strip(GURL("https://brave.com/")));
+  EXPECT_FALSE(stripper.Strip(GURL()));
+}
+
+TEST(QueryParamStripperTest, ConditionsAreEvaluatedOnce) {
+  int count = 0;
+  QueryParamStripper stripper;
+  stripper.AddParams({"a", "b"},
+                     base::BindRepeating(&CountAndReturnTrue, &count));
+
+  EXPECT_FALSE(stripper.Strip(GURL("https://brave.com/?c=1")));
+  EXPECT_EQ(0, count);
+  EXPECT_EQ(GURL("https://brave.com/"),
+            stripper.Strip(GURL("https://brave.com/?a=1&b=2&a=3")));
+  EXPECT_EQ(1, count);
+}
+
+}  // namespace query_filter
@@ -19,6 +19,12 @@ BASE_FEATURE(kSpeedreaderPanelV2,
              "SpeedreaderPanelV2",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+// Feeds the response body to the rewriter as it arrives instead of buffering
+// it first. When disabled the whole body is distilled in a single task.
+BASE_FEATURE(kSpeedreaderIncrementalDistill,
+             "SpeedreaderIncrementalDistill",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
 const base::FeatureParam<int> kSpeedreaderMinOutLengthParam{
     &kSpeedreaderFeature, "min_out_length", 1000};
 
@@ -0,0 +1,85 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+
+#include <utility>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "crypto/sha2.h"
+#include "net/http/http_response_headers.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+// Request headers which, when the response varies with them, make it depend
+// on the user's credentials.
+constexpr const char* kCredentialHeaders[] = {"authorization", "cookie"};
+
+bool VariesWithCredentials(const net::HttpResponseHeaders& headers) {
+  for (const char* header : kCredentialHeaders) {
+    if (headers.HasHeaderValue("vary", header)) {
+      return true;
+    }
+  }
+  return headers.HasHeaderValue("vary", "*");
+}
+
+}  // namespace
+
+DistilledPage::DistilledPage() = default;
+DistilledPage::DistilledPage(std::string content, base::TimeDelta distill_time)
+    : content(std::move(content)), distill_time(distill_time) {}
+DistilledPage::DistilledPage(const DistilledPage&) = default;
+DistilledPage& DistilledPage::operator=(const DistilledPage&) = default;
+DistilledPage::~DistilledPage() = default;
+
+SpeedreaderDistilledPageCache::SpeedreaderDistilledPageCache()
+    : pages_(kMaxEntries) {}
+
+SpeedreaderDistilledPageCache::~SpeedreaderDistilledPageCache() = default;
+
+// static
+std::string SpeedreaderDistilledPageCache::GetKey(
+    const GURL& url,
+    const net::HttpResponseHeaders& headers) {
+  if (headers.HasHeaderValue("cache-control", "no-store") ||
+      headers.HasHeaderValue("cache-control", "private") ||
+      VariesWithCredentials(headers)) {
+    return std::string();
+  }
+  std::string etag;
+  std::string last_modified;
+  headers.GetNormalizedHeader("etag", &etag);
+  headers.GetNormalizedHeader("last-modified", &last_modified);
+  if (etag.empty() && last_modified.empty()) {
+    return std::string();
+  }
+  const std::string digest = crypto::SHA256HashString(
+      base::StrCat({url.GetWithoutRef().spec(), "\n", etag, "\n",
+                    last_modified}));
+  return base::ToLowerASCII(base::HexEncode(digest.data(), digest.size()));
+}
+
+const DistilledPage* SpeedreaderDistilledPageCache::Get(
+    const std::string& key) {
+  auto it = pages_.Get(key);
+  return it == pages_.end() ? nullptr : &it->second;
+}
+
+void SpeedreaderDistilledPageCache::Put(const std::string& key,
+                                        const DistilledPage& page) {
+  pages_.Put(key, page);
+}
+
+void SpeedreaderDistilledPageCache::Clear() {
+  pages_.Clear();
+}
+
+}  // namespace speedreader
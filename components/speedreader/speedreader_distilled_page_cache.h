@@ -0,0 +1,71 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/time/time.h"
+
+class GURL;
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace speedreader {
+
+// A distilled page body, without the reader settings and the stylesheet,
+// which are applied when it is served.
+struct DistilledPage {
+  DistilledPage();
+  DistilledPage(std::string content, base::TimeDelta distill_time);
+  DistilledPage(const DistilledPage&);
+  DistilledPage& operator=(const DistilledPage&);
+  ~DistilledPage();
+
+  std::string content;
+  // CPU time spent distilling the page, saved by every cache hit.
+  base::TimeDelta distill_time;
+};
+
+// Bounded in-memory cache of distilled pages keyed by URL and response
+// validators, so revisiting a page or changing the reader settings does not
+// distill the same document again. Pages are never written to disk, and are
+// dropped with the rest of the cache when browsing data is cleared.
+class SpeedreaderDistilledPageCache {
+ public:
+  static constexpr size_t kMaxEntries = 16;
+
+  SpeedreaderDistilledPageCache();
+  ~SpeedreaderDistilledPageCache();
+
+  SpeedreaderDistilledPageCache(const SpeedreaderDistilledPageCache&) = delete;
+  SpeedreaderDistilledPageCache& operator=(
+      const SpeedreaderDistilledPageCache&) = delete;
+
+  // Returns the cache key for a response, or an empty string if the response
+  // has no validators, must not be stored, is private to the user or varies
+  // with their credentials.
+  static std::string GetKey(const GURL& url,
+                            const net::HttpResponseHeaders& headers);
+
+  // Returns the cached page for |key|, or nullptr. The pointer is only valid
+  // until the cache is next modified.
+  const DistilledPage* Get(const std::string& key);
+  void Put(const std::string& key, const DistilledPage& page);
+  void Clear();
+
+  size_t size() const { return pages_.size(); }
+
+ private:
+  base::LRUCache<std::string, DistilledPage> pages_;
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_PAGE_CACHE_H_
@@ -0,0 +1,103 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+
+#include <string>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+scoped_refptr<net::HttpResponseHeaders> MakeHeaders(const std::string& raw) {
+  return base::MakeRefCounted<net::HttpResponseHeaders>(
+      net::HttpUtil::AssembleRawHeaders(raw));
+}
+
+}  // namespace
+
+TEST(SpeedreaderDistilledPageCacheTest, KeyRequiresValidators) {
+  const GURL url("https://example.com/article");
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetKey(
+                  url, *MakeHeaders("HTTP/1.1 200 OK\n"))
+                  .empty());
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetKey(
+                  url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"
+                                    "Cache-Control: no-store\n"))
+                  .empty());
+
+  const std::string key = SpeedreaderDistilledPageCache::GetKey(
+      url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"));
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(key, SpeedreaderDistilledPageCache::GetKey(
+                     GURL("https://example.com/article#comments"),
+                     *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n")));
+  EXPECT_NE(key, SpeedreaderDistilledPageCache::GetKey(
+                     url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"2\"\n")));
+  EXPECT_FALSE(SpeedreaderDistilledPageCache::GetKey(
+                   url, *MakeHeaders("HTTP/1.1 200 OK\nLast-Modified: "
+                                     "Tue, 07 Mar 2023 10:00:00 GMT\n"))
+                   .empty());
+}
+
+TEST(SpeedreaderDistilledPageCacheTest, NoKeyForPrivateResponses) {
+  const GURL url("https://example.com/account");
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetKey(
+                  url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"
+                                    "Cache-Control: private, max-age=60\n"))
+                  .empty());
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetKey(
+                  url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"
+                                    "Vary: Accept-Encoding, Cookie\n"))
+                  .empty());
+  EXPECT_TRUE(SpeedreaderDistilledPageCache::GetKey(
+                  url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"
+                                    "Vary: Authorization\n"))
+                  .empty());
+  EXPECT_FALSE(SpeedreaderDistilledPageCache::GetKey(
+                   url, *MakeHeaders("HTTP/1.1 200 OK\nETag: \"1\"\n"
+                                     "Cache-Control: public, max-age=60\n"
+                                     "Vary: Accept-Encoding\n"))
+                   .empty());
+}
+
+TEST(SpeedreaderDistilledPageCacheTest, GetAndPut) {
+  SpeedreaderDistilledPageCache cache;
+  EXPECT_FALSE(cache.Get("key"));
+
+  cache.Put("key", DistilledPage("content", base::Milliseconds(20)));
+  const DistilledPage* page = cache.Get("key");
+  ASSERT_TRUE(page);
+  EXPECT_EQ("content", page->content);
+  EXPECT_EQ(base::Milliseconds(20), page->distill_time);
+}
+
+TEST(SpeedreaderDistilledPageCacheTest, IsBounded) {
+  SpeedreaderDistilledPageCache cache;
+  for (size_t i = 0; i <= SpeedreaderDistilledPageCache::kMaxEntries; i++) {
+    cache.Put(base::NumberToString(i), DistilledPage("content", {}));
+  }
+  EXPECT_EQ(SpeedreaderDistilledPageCache::kMaxEntries, cache.size());
+  // The least recently used page was dropped.
+  EXPECT_FALSE(cache.Get("0"));
+  EXPECT_TRUE(cache.Get("1"));
+}
+
+TEST(SpeedreaderDistilledPageCacheTest, Clear) {
+  SpeedreaderDistilledPageCache cache;
+  cache.Put("key", DistilledPage("content", base::Milliseconds(20)));
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_FALSE(cache.Get("key"));
+}
+
+}  // namespace speedreader
@@ -0,0 +1,88 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_incremental_distiller.h"
+
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+
+namespace speedreader {
+
+namespace {
+
+void MaybeSaveDistilledDataForDebug(const GURL& url,
+                                    const std::string& data,
+                                    const std::string& stylesheet,
+                                    const std::string& transformed) {
+#if DCHECK_IS_ON()
+  constexpr const char kCollectSwitch[] = "speedreader-collect-test-data";
+  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(kCollectSwitch))
+    return;
+  const auto dir = base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+      kCollectSwitch);
+  base::CreateDirectory(dir);
+  base::WriteFile(dir.AppendASCII("page.url"), url.spec());
+  base::WriteFile(dir.AppendASCII("original.html"), data);
+  base::WriteFile(dir.AppendASCII("distilled.html"), transformed);
+  base::WriteFile(dir.AppendASCII("result.html"), stylesheet + transformed);
+#endif
+}
+
+// CPU time of the current thread, zero where it can't be measured.
+base::ThreadTicks ThreadNow() {
+  return base::ThreadTicks::IsSupported() ? base::ThreadTicks::Now()
+                                          : base::ThreadTicks();
+}
+
+}  // namespace
+
+DistillResult::DistillResult() = default;
+DistillResult::DistillResult(DistillResult&&) = default;
+DistillResult& DistillResult::operator=(DistillResult&&) = default;
+DistillResult::~DistillResult() = default;
+
+IncrementalDistiller::IncrementalDistiller(std::unique_ptr<Rewriter> rewriter)
+    : rewriter_(std::move(rewriter)) {}
+
+IncrementalDistiller::~IncrementalDistiller() = default;
+
+void IncrementalDistiller::Write(base::StringPiece chunk) {
+  if (failed_) {
+    return;
+  }
+  const base::ThreadTicks start = ThreadNow();
+  // A non-zero result means an error occurred.
+  failed_ = rewriter_->Write(chunk.data(), chunk.size()) != 0;
+  distill_time_ += ThreadNow() - start;
+}
+
+DistillResult IncrementalDistiller::Finish(const GURL& response_url,
+                                           std::string data,
+                                           const std::string& stylesheet) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
+  DistillResult result;
+  if (!failed_) {
+    const base::ThreadTicks start = ThreadNow();
+    rewriter_->End();
+    const std::string& transformed = rewriter_->GetOutput();
+    distill_time_ += ThreadNow() - start;
+
+    // TODO(brave-browser/issues/10372): would be better to pass explicit
+    // signal back from rewriter to indicate if content was found
+    if (transformed.length() >= 1024) {
+      MaybeSaveDistilledDataForDebug(response_url, data, stylesheet,
+                                     transformed);
+      result.page.emplace(transformed, distill_time_);
+    }
+  }
+  result.body = std::move(data);
+  return result;
+}
+
+}  // namespace speedreader
@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_INCREMENTAL_DISTILLER_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_INCREMENTAL_DISTILLER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "base/time/time.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+class Rewriter;
+
+// The original body and, if the page was readable, its distilled content
+// without the reader settings applied.
+struct DistillResult {
+  DistillResult();
+  DistillResult(DistillResult&&);
+  DistillResult& operator=(DistillResult&&);
+  ~DistillResult();
+
+  std::string body;
+  absl::optional<DistilledPage> page;
+};
+
+// Owns a rewriter and parses the body chunk by chunk while it is being
+// downloaded. Readability needs the whole document to score it, so output is
+// still produced once the body is complete, but by then only scoring and
+// extraction are left to do. Not thread safe, lives on the sequence it is
+// used on.
+class IncrementalDistiller {
+ public:
+  explicit IncrementalDistiller(std::unique_ptr<Rewriter> rewriter);
+  ~IncrementalDistiller();
+
+  IncrementalDistiller(const IncrementalDistiller&) = delete;
+  IncrementalDistiller& operator=(const IncrementalDistiller&) = delete;
+
+  void Write(base::StringPiece chunk);
+
+  // Finishes distilling |data|, the body whose chunks have all been written.
+  DistillResult Finish(const GURL& response_url,
+                       std::string data,
+                       const std::string& stylesheet);
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+  bool failed_ = false;
+  // CPU time spent in the rewriter.
+  base::TimeDelta distill_time_;
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_INCREMENTAL_DISTILLER_H_
@@ -0,0 +1,82 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_incremental_distiller.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/strings/string_piece.h"
+#include "base/threading/thread_restrictions.h"
+#include "brave/components/constants/brave_paths.h"
+#include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+constexpr char kUrl[] = "https://test.com";
+
+}  // namespace
+
+class SpeedreaderIncrementalDistillerTest
+    : public ::testing::TestWithParam<const char*> {
+ public:
+  std::string GetPage() {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    base::FilePath path;
+    base::PathService::Get(brave::DIR_TEST_DATA, &path);
+    std::string result;
+    EXPECT_TRUE(base::ReadFileToString(
+        path.AppendASCII("speedreader/rewriter").AppendASCII(GetParam()),
+        &result));
+    return result;
+  }
+
+  // Distills |body| written to the distiller |chunk_size| bytes at a time.
+  DistillResult Distill(const std::string& body, size_t chunk_size) {
+    auto rewriter = speedreader_.MakeRewriter(kUrl);
+    rewriter->SetMinOutLength(100);
+    IncrementalDistiller distiller(std::move(rewriter));
+    const base::StringPiece data(body);
+    for (size_t pos = 0; pos < data.size(); pos += chunk_size) {
+      distiller.Write(data.substr(pos, chunk_size));
+    }
+    return distiller.Finish(GURL(kUrl), body, std::string());
+  }
+
+ private:
+  SpeedReader speedreader_;
+};
+
+INSTANTIATE_TEST_SUITE_P(,
+                         SpeedreaderIncrementalDistillerTest,
+                         ::testing::Values("jsonld_shortest_desc.html",
+                                           "no_span_root.html",
+                                           "too_small_output.html"));
+
+TEST_P(SpeedreaderIncrementalDistillerTest, ChunksMatchWholeBody) {
+  const std::string body = GetPage();
+  ASSERT_FALSE(body.empty());
+
+  const DistillResult expected = Distill(body, body.size());
+  EXPECT_EQ(body, expected.body);
+  for (const size_t chunk_size : {1, 7, 1024}) {
+    SCOPED_TRACE(chunk_size);
+    const DistillResult result = Distill(body, chunk_size);
+    EXPECT_EQ(body, result.body);
+    ASSERT_EQ(expected.page.has_value(), result.page.has_value());
+    if (expected.page) {
+      EXPECT_EQ(expected.page->content, result.page->content);
+    }
+  }
+}
+
+}  // namespace speedreader
@@ -10,6 +10,7 @@
 
 #include "base/memory/raw_ptr.h"
 #include "brave/components/speedreader/common/speedreader_panel.mojom.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
 #include "brave/components/speedreader/speedreader_util.h"
 #include "components/keyed_service/core/keyed_service.h"
 
@@ -51,11 +52,16 @@ class SpeedreaderService : public KeyedService {
   ContentStyle GetContentStyle() const;
   std::string GetContentStyleName() const;
 
+  SpeedreaderDistilledPageCache* distilled_page_cache() {
+    return &distilled_page_cache_;
+  }
+
   SpeedreaderService(const SpeedreaderService&) = delete;
   SpeedreaderService& operator=(const SpeedreaderService&) = delete;
 
  private:
   raw_ptr<PrefService> prefs_ = nullptr;
+  SpeedreaderDistilledPageCache distilled_page_cache_;
 };
 
 }  // namespace speedreader
@@ -8,6 +8,7 @@
 #include <string>
 #include <utility>
 
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_throttle_delegate.h"
 #include "brave/components/speedreader/speedreader_url_loader.h"
@@ -17,6 +18,7 @@
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/system/data_pipe.h"
+#include "net/http/http_response_headers.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
@@ -81,8 +83,10 @@ void SpeedReaderThrottle::WillProcessResponse(
   mojo::ScopedDataPipeConsumerHandle body;
   std::tie(new_remote, new_receiver, speedreader_loader) =
       SpeedReaderURLLoader::CreateLoader(
-          AsWeakPtr(), std::move(delegate_), response_url, task_runner_,
-          rewriter_service_, speedreader_service_);
+          AsWeakPtr(), std::move(delegate_), response_url,
+          SpeedreaderDistilledPageCache::GetKey(response_url,
+                                                *response_head->headers),
+          task_runner_, rewriter_service_, speedreader_service_);
   BodySnifferThrottle::InterceptAndStartLoader(
       std::move(source_loader), std::move(source_client_receiver),
       std::move(new_remote), std::move(new_receiver), speedreader_loader);
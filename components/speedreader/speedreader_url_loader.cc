@@ -10,14 +10,15 @@
 #include <utility>
 
 #include "base/check.h"
-#include "base/command_line.h"
-#include "base/files/file_util.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/body_sniffer/body_sniffer_throttle.h"
+#include "brave/components/speedreader/common/features.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_service.h"
@@ -31,22 +32,30 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
-void MaybeSaveDistilledDataForDebug(const GURL& url,
-                                    const std::string& data,
-                                    const std::string& stylesheet,
-                                    const std::string& transformed) {
-#if DCHECK_IS_ON()
-  constexpr const char kCollectSwitch[] = "speedreader-collect-test-data";
-  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(kCollectSwitch))
-    return;
-  const auto dir = base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
-      kCollectSwitch);
-  base::CreateDirectory(dir);
-  base::WriteFile(dir.AppendASCII("page.url"), url.spec());
-  base::WriteFile(dir.AppendASCII("original.html"), data);
-  base::WriteFile(dir.AppendASCII("distilled.html"), transformed);
-  base::WriteFile(dir.AppendASCII("result.html"), stylesheet + transformed);
-#endif
+// Applies the reader settings to distilled |content| the same way the
+// rewriter does when they are passed to it.
+std::string WrapDistilledContent(const std::string& content,
+                                 const std::string& theme,
+                                 const std::string& font_family,
+                                 const std::string& font_size,
+                                 const std::string& content_style) {
+  if (theme.empty() && font_family.empty() && font_size.empty() &&
+      content_style.empty()) {
+    return content;
+  }
+  std::string result = "<html";
+  const std::pair<const char*, const std::string&> attributes[] = {
+      {"data-theme", theme},
+      {"data-font-family", font_family},
+      {"data-font-size", font_size},
+      {"data-content-style", content_style}};
+  for (const auto& [name, value] : attributes) {
+    if (!value.empty()) {
+      base::StrAppend(&result, {" ", name, "=\"", value, "\""});
+    }
+  }
+  base::StrAppend(&result, {">", content, "</html>"});
+  return result;
 }
 
 }  // namespace
@@ -59,6 +68,7 @@ SpeedReaderURLLoader::CreateLoader(
     base::WeakPtr<body_sniffer::BodySnifferThrottle> throttle,
     base::WeakPtr<SpeedreaderThrottleDelegate> delegate,
     const GURL& response_url,
+    const std::string& cache_key,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
     SpeedreaderRewriterService* rewriter_service,
     SpeedreaderService* speedreader_service) {
@@ -69,7 +79,7 @@ SpeedReaderURLLoader::CreateLoader(
           url_loader_client.InitWithNewPipeAndPassReceiver();
 
   auto loader = base::WrapUnique(new SpeedReaderURLLoader(
-      std::move(throttle), std::move(delegate), response_url,
+      std::move(throttle), std::move(delegate), response_url, cache_key,
       std::move(url_loader_client), std::move(task_runner), rewriter_service,
       speedreader_service));
   SpeedReaderURLLoader* loader_rawptr = loader.get();
@@ -83,6 +93,7 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
     base::WeakPtr<body_sniffer::BodySnifferThrottle> throttle,
     base::WeakPtr<SpeedreaderThrottleDelegate> delegate,
     const GURL& response_url,
+    const std::string& cache_key,
     mojo::PendingRemote<network::mojom::URLLoaderClient>
         destination_url_loader_client,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
@@ -96,7 +107,21 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       delegate_(delegate),
       response_url_(response_url),
       rewriter_service_(rewriter_service),
-      speedreader_service_(speedreader_service) {}
+      speedreader_service_(speedreader_service),
+      distill_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_BLOCKING, base::MayBlock()})),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(distill_task_runner_)),
+      load_start_time_(base::TimeTicks::Now()),
+      cache_key_(cache_key) {
+  auto* cache = GetDistilledPageCache();
+  if (cache && !cache_key_.empty()) {
+    if (const DistilledPage* page = cache->Get(cache_key_)) {
+      cached_page_ = *page;
+    }
+    UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistilledPageCacheHit",
+                          cached_page_.has_value());
+  }
+}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
 
@@ -107,14 +132,29 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
     return;
   }
 
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
-
+  FeedIncrementalDistiller();
   body_consumer_watcher_.ArmOrNotify();
 }
 
+void SpeedReaderURLLoader::FeedIncrementalDistiller() {
+  if (!base::FeatureList::IsEnabled(kSpeedreaderIncrementalDistill) ||
+      !rewriter_service_ || cached_page_) {
+    return;
+  }
+  if (!distiller_) {
+    distiller_.reset(new IncrementalDistiller(MakeRewriter()));
+  }
+  if (buffered_body_.size() <= distilled_bytes_) {
+    return;
+  }
+  distill_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&IncrementalDistiller::Write,
+                     base::Unretained(distiller_.get()),
+                     buffered_body_.substr(distilled_bytes_)));
+  distilled_bytes_ = buffered_body_.size();
+}
+
 void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
   if (bytes_remaining_in_buffer_ > 0) {
@@ -134,6 +174,31 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   VLOG(2) << __func__ << " buffered body size = " << body.size();
   bytes_remaining_in_buffer_ = body.size();
 
+  if (bytes_remaining_in_buffer_ > 0 && cached_page_) {
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.DistillTimeSaved",
+                        cached_page_->distill_time);
+    SendDistilledPage(cached_page_->content);
+    return;
+  }
+
+  if (bytes_remaining_in_buffer_ > 0 && distiller_) {
+    DCHECK_EQ(distilled_bytes_, body.size());
+    // The body has already been written chunk by chunk, only scoring and
+    // extraction are left. Releasing |distiller_| posts its deletion after
+    // the task below.
+    IncrementalDistiller* distiller = distiller_.get();
+    distill_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&IncrementalDistiller::Finish,
+                       base::Unretained(distiller), response_url_,
+                       std::move(body),
+                       rewriter_service_->GetContentStylesheet()),
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
+                       weak_factory_.GetWeakPtr()));
+    distiller_.reset();
+    return;
+  }
+
   if (bytes_remaining_in_buffer_ > 0) {
     // Offload heavy distilling to another thread.
     base::ThreadPool::PostTaskAndReplyWithResult(
@@ -141,46 +206,61 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
         base::BindOnce(
             [](const GURL& response_url, std::string data,
                std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto{
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-              MaybeSaveDistilledDataForDebug(response_url, data, stylesheet,
-                                             transformed);
-              return stylesheet + transformed;
+               const std::string& stylesheet) {
+              IncrementalDistiller distiller(std::move(rewriter));
+              distiller.Write(data);
+              return distiller.Finish(response_url, std::move(data),
+                                      stylesheet);
             },
-            response_url_, std::move(body),
-            rewriter_service_->MakeRewriter(
-                response_url_, speedreader_service_->GetThemeName(),
-                speedreader_service_->GetFontFamilyName(),
-                speedreader_service_->GetFontSizeName(),
-                speedreader_service_->GetContentStyleName()),
+            response_url_, std::move(body), MakeRewriter(),
             rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(
-            [](base::WeakPtr<SpeedReaderURLLoader> self, std::string result) {
-              if (self) {
-                self->BodySnifferURLLoader::CompleteLoading(std::move(result));
-              }
-            },
-            weak_factory_.GetWeakPtr()));
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
+                       weak_factory_.GetWeakPtr()));
     return;
   }
   BodySnifferURLLoader::CompleteLoading(std::move(body));
 }
 
+std::unique_ptr<Rewriter> SpeedReaderURLLoader::MakeRewriter() {
+  // Reader settings are applied when the page is served, so the distilled
+  // content can be cached and reused when they change.
+  return rewriter_service_->MakeRewriter(response_url_, std::string(),
+                                         std::string(), std::string(),
+                                         std::string());
+}
+
+SpeedreaderDistilledPageCache* SpeedReaderURLLoader::GetDistilledPageCache() {
+  return speedreader_service_ ? speedreader_service_->distilled_page_cache()
+                              : nullptr;
+}
+
+void SpeedReaderURLLoader::OnDistilled(DistillResult result) {
+  if (!result.page) {
+    SendBody(std::move(result.body));
+    return;
+  }
+  auto* cache = GetDistilledPageCache();
+  if (cache && !cache_key_.empty()) {
+    cache->Put(cache_key_, *result.page);
+  }
+  SendDistilledPage(result.page->content);
+}
+
+void SpeedReaderURLLoader::SendDistilledPage(const std::string& content) {
+  SendBody(base::StrCat(
+      {rewriter_service_->GetContentStylesheet(),
+       WrapDistilledContent(content, speedreader_service_->GetThemeName(),
+                            speedreader_service_->GetFontFamilyName(),
+                            speedreader_service_->GetFontSizeName(),
+                            speedreader_service_->GetContentStyleName())}));
+}
+
+void SpeedReaderURLLoader::SendBody(std::string body) {
+  UMA_HISTOGRAM_TIMES("Brave.Speedreader.TimeToFirstByte",
+                      base::TimeTicks::Now() - load_start_time_);
+  BodySnifferURLLoader::CompleteLoading(std::move(body));
+}
+
 void SpeedReaderURLLoader::OnCompleteSending() {
   // TODO(keur, iefremov): This API could probably be improved with an enum
   // indicating distill success, distill fail, load from cache.
@@ -6,17 +6,23 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "brave/components/body_sniffer/body_sniffer_url_loader.h"
+#include "brave/components/speedreader/speedreader_distilled_page_cache.h"
+#include "brave/components/speedreader/speedreader_incremental_distiller.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "services/network/public/mojom/url_loader.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace body_sniffer {
@@ -25,6 +31,7 @@ class BodySnifferThrottle;
 
 namespace speedreader {
 
+class Rewriter;
 class SpeedreaderRewriterService;
 class SpeedreaderService;
 class SpeedReaderThrottle;
@@ -42,6 +49,8 @@ class SpeedreaderThrottleDelegate;
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
 // kLoading: Receives the body from the source loader and distills the page.
+//            Each received chunk is handed to a rewriter living on a
+//            dedicated sequence, so parsing overlaps with the download.
 //            The received body is kept in this loader until distilling
 //            is finished. When all body has been received and distilling is
 //            done, this loader will dispatch queued messages like
@@ -58,13 +67,15 @@ class SpeedReaderURLLoader : public body_sniffer::BodySnifferURLLoader {
   ~SpeedReaderURLLoader() override;
 
   // mojo::PendingRemote<network::mojom::URLLoader> controls the lifetime of the
-  // loader.
+  // loader. |cache_key| identifies the response in the distilled page cache,
+  // or is empty if the result must not be cached.
   static std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
                     mojo::PendingReceiver<network::mojom::URLLoaderClient>,
                     SpeedReaderURLLoader*>
   CreateLoader(base::WeakPtr<body_sniffer::BodySnifferThrottle> throttle,
                base::WeakPtr<SpeedreaderThrottleDelegate> delegate,
                const GURL& response_url,
+               const std::string& cache_key,
                scoped_refptr<base::SingleThreadTaskRunner> task_runner,
                SpeedreaderRewriterService* rewriter_service,
                SpeedreaderService* speedreader_service);
@@ -74,6 +85,7 @@ class SpeedReaderURLLoader : public body_sniffer::BodySnifferURLLoader {
       base::WeakPtr<body_sniffer::BodySnifferThrottle> throttle,
       base::WeakPtr<SpeedreaderThrottleDelegate> delegate,
       const GURL& response_url,
+      const std::string& cache_key,
       mojo::PendingRemote<network::mojom::URLLoaderClient>
           destination_url_loader_client,
       scoped_refptr<base::SingleThreadTaskRunner> task_runner,
@@ -85,6 +97,19 @@ class SpeedReaderURLLoader : public body_sniffer::BodySnifferURLLoader {
 
   void CompleteLoading(std::string body) override;
   void OnCompleteSending() override;
+
+  // Writes the part of |buffered_body_| not yet seen by the incremental
+  // distiller to it, creating the distiller on the first call.
+  void FeedIncrementalDistiller();
+  std::unique_ptr<Rewriter> MakeRewriter();
+
+  SpeedreaderDistilledPageCache* GetDistilledPageCache();
+
+  void OnDistilled(DistillResult result);
+  // Sends |content| with the current reader settings and stylesheet applied.
+  void SendDistilledPage(const std::string& content);
+  void SendBody(std::string body);
+
   base::WeakPtr<SpeedreaderThrottleDelegate> delegate_;
 
   GURL response_url_;
@@ -93,6 +118,16 @@ class SpeedReaderURLLoader : public body_sniffer::BodySnifferURLLoader {
   raw_ptr<SpeedreaderRewriterService> rewriter_service_ = nullptr;
   raw_ptr<SpeedreaderService> speedreader_service_ = nullptr;
 
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<IncrementalDistiller, base::OnTaskRunnerDeleter> distiller_;
+  // Number of bytes of |buffered_body_| written to |distiller_|.
+  size_t distilled_bytes_ = 0;
+  const base::TimeTicks load_start_time_;
+
+  const std::string cache_key_;
+  // The distilled page found in the cache when the response started.
+  absl::optional<DistilledPage> cached_page_;
+
   base::WeakPtrFactory<SpeedReaderURLLoader> weak_factory_{this};
 };
 
@@ -89,10 +89,9 @@ TorControl::TorControl(base::WeakPtr<TorControl::Delegate> delegate,
     : running_(false),
       owner_task_runner_(base::SequencedTaskRunner::GetCurrentDefault()),
       io_task_runner_(task_runner),
+      read_parser_(kTorBufferSize),
       writing_(false),
       reading_(false),
-      read_start_(-1),
-      read_cr_(false),
       delegate_(delegate) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
   DETACH_FROM_SEQUENCE(io_sequence_checker_);
@@ -194,8 +193,8 @@ void TorControl::Connected(std::vector<uint8_t> cookie, int rv) {
 //      we're ready.
 //
 void TorControl::Authenticated(bool error,
-                               const std::string& status,
-                               const std::string& reply) {
+                               base::StringPiece status,
+                               base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (!error) {
     if (status != "250" || reply != "OK")
@@ -252,8 +251,8 @@ void TorControl::DoSubscribe(TorControlEvent event,
 void TorControl::Subscribed(TorControlEvent event,
                             base::OnceCallback<void(bool error)> callback,
                             bool error,
-                            const std::string& status,
-                            const std::string& reply) {
+                            base::StringPiece status,
+                            base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (!error) {
     if (status != "250")
@@ -307,8 +306,8 @@ void TorControl::DoUnsubscribe(TorControlEvent event,
 void TorControl::Unsubscribed(TorControlEvent event,
                               base::OnceCallback<void(bool error)> callback,
                               bool error,
-                              const std::string& status,
-                              const std::string& reply) {
+                              base::StringPiece status,
+                              base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   DCHECK_EQ(async_events_.count(event), 0u);
   if (!error) {
@@ -391,8 +390,8 @@ void TorControl::GetVersion(
 }
 
 void TorControl::GetVersionLine(std::string* version,
-                                const std::string& status,
-                                const std::string& reply) {
+                                base::StringPiece status,
+                                base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" ||
       !base::StartsWith(reply, kGetVersionReply,
@@ -401,15 +400,15 @@ void TorControl::GetVersionLine(std::string* version,
     VLOG(0) << "tor: unexpected " << kGetVersionCmd << " reply";
     return;
   }
-  *version = reply.substr(strlen(kGetVersionReply));
+  *version = std::string(reply.substr(strlen(kGetVersionReply)));
 }
 
 void TorControl::GetVersionDone(
     std::unique_ptr<std::string> version,
     base::OnceCallback<void(bool error, const std::string& version)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (error || status != "250" || reply != "OK" || version->empty()) {
     std::move(callback).Run(true, "");
@@ -438,15 +437,15 @@ void TorControl::GetSOCKSListeners(
 }
 
 void TorControl::GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                                       const std::string& status,
-                                       const std::string& reply) {
+                                       base::StringPiece status,
+                                       base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" || !base::StartsWith(reply, kGetSOCKSListenersReply,
                                            base::CompareCase::SENSITIVE)) {
     VLOG(0) << "tor: unexpected " << kGetSOCKSListenersCmd << " reply";
     return;
   }
-  listeners->push_back(reply.substr(strlen(kGetSOCKSListenersReply)));
+  listeners->emplace_back(reply.substr(strlen(kGetSOCKSListenersReply)));
 }
 
 void TorControl::GetSOCKSListenersDone(
@@ -454,8 +453,8 @@ void TorControl::GetSOCKSListenersDone(
     base::OnceCallback<
         void(bool error, const std::vector<std::string>& listeners)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (error || status != "250" || reply != "OK" || listeners->empty()) {
     std::move(callback).Run(true, std::vector<std::string>());
@@ -482,8 +481,8 @@ void TorControl::GetCircuitEstablished(
 }
 
 void TorControl::GetCircuitEstablishedLine(std::string* established,
-                                           const std::string& status,
-                                           const std::string& reply) {
+                                           base::StringPiece status,
+                                           base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   if (status != "250" ||
       !base::StartsWith(reply, kGetCircuitEstablishedReply,
@@ -492,15 +491,16 @@ void TorControl::GetCircuitEstablishedLine(std::string* established,
     VLOG(0) << "tor: unexpected " << kGetCircuitEstablishedCmd << " reply";
     return;
   }
-  *established = reply.substr(strlen(kGetCircuitEstablishedReply));
+  *established =
+      std::string(reply.substr(strlen(kGetCircuitEstablishedReply)));
 }
 
 void TorControl::GetCircuitEstablishedDone(
     std::unique_ptr<std::string> established,
     base::OnceCallback<void(bool error, bool established)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   bool result;
   if (*established == "1")
@@ -600,8 +600,8 @@ void TorControl::SetupBridges(const std::vector<std::string>& bridges,
 void TorControl::OnPluggableTransportsConfigured(
     base::OnceCallback<void(bool error)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   VLOG(1) << __func__ << " " << reply;
   std::move(callback).Run(error || status != "250" || reply != "OK");
@@ -610,8 +610,8 @@ void TorControl::OnPluggableTransportsConfigured(
 void TorControl::OnBrigdesConfigured(
     base::OnceCallback<void(bool error)> callback,
     bool error,
-    const std::string& status,
-    const std::string& reply) {
+    base::StringPiece status,
+    base::StringPiece reply) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   VLOG(1) << __func__ << " " << reply;
   std::move(callback).Run(error || status != "250" || reply != "OK");
@@ -717,7 +717,7 @@ void TorControl::WriteDone(int rv) {
 
 // StartRead()
 //
-//      Create an I/O buffer to read command responses into.
+//      Reset the parser to read command responses into.
 //
 //      Caller must ensure reading_ is true and that there are
 //      synchronous command callbacks or asynchronous event
@@ -727,34 +727,29 @@ void TorControl::StartRead() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   DCHECK(reading_);
   DCHECK(!cmdq_.empty() || !async_events_.empty());
-  readiobuf_ = base::MakeRefCounted<net::GrowableIOBuffer>();
-  readiobuf_->SetCapacity(kTorBufferSize);
-  read_start_ = 0;
-  DCHECK(readiobuf_->RemainingCapacity());
+  read_parser_.Reset();
 }
 
 // DoReads()
 //
-//      Issue reads into readiobuf_ and process them.
+//      Issue reads into the parser's buffer and process them.
 //
-//      Caller must ensure reading_ is true and readiobuf_ is
-//      initialized.
+//      Caller must ensure reading_ is true.
 //
 void TorControl::DoReads() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   DCHECK(reading_);
-  DCHECK(readiobuf_);
   int rv;
-  DCHECK(readiobuf_->RemainingCapacity());
-  while ((rv = socket_->Read(readiobuf_.get(), readiobuf_->RemainingCapacity(),
-                             base::BindOnce(&TorControl::ReadDoneAsync,
-                                            weak_ptr_factory_.GetWeakPtr()))) !=
-         net::ERR_IO_PENDING) {
-    ReadDone(rv);
-    if (!reading_)
+  do {
+    const base::span<char> buffer = read_parser_.GetWriteBuffer();
+    readiobuf_ = base::MakeRefCounted<net::WrappedIOBuffer>(buffer.data());
+    rv = socket_->Read(readiobuf_.get(), buffer.size(),
+                       base::BindOnce(&TorControl::ReadDoneAsync,
+                                      weak_ptr_factory_.GetWeakPtr()));
+    if (rv == net::ERR_IO_PENDING)
       break;
-    DCHECK(readiobuf_->RemainingCapacity());
-  }
+    ReadDone(rv);
+  } while (reading_);
 }
 
 // ReadDoneAsync(rv)
@@ -770,16 +765,15 @@ void TorControl::ReadDoneAsync(int rv) {
   DCHECK(reading_);
   DCHECK(readiobuf_);
   ReadDone(rv);
-  if (reading_) {
-    DCHECK(readiobuf_->RemainingCapacity());
+  if (reading_)
     DoReads();
-  }
 }
 
 // ReadDone()
 //
-//      A read into readiobuf_ just completed.  Process it.  If
-//      there's no more reads to do, disable reading_.
+//      A read into readiobuf_ just completed.  Have the parser split it
+//      into lines and process them.  If there's no more reads to do,
+//      disable reading_.
 //
 //      Caller must ensure reading_ is true and readiobuf_ is
 //      initialized.
@@ -798,83 +792,73 @@ void TorControl::ReadDone(int rv) {
     Error();
     return;
   }
-  const char* data = readiobuf_->data();
-  for (int i = 0; i < rv; i++) {
-    if (!read_cr_) {
-      // No CR yet.  Accept CR or non-LF; reject LF.
-      if (data[i] == 0x0d) {  // CR
-        read_cr_ = true;
-      } else if (data[i] == 0x0a) {  // LF
-        VLOG(1) << "tor: stray line feed";
-        Error();
-        return;
-      } else {
-        // Anything else: Just accept it and move on.
-      }
-    } else {
-      // CR seen.  Accept LF; reject all else.
-      if (data[i] == 0x0a) {  // LF
-        // CRLF seen, so we must have i >= 2.  Emit a line and advance
-        // to the next one, unless anything went wrong with the line.
-        assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
-        read_start_ = readiobuf_->offset() + i + 1;
-        read_cr_ = false;
-        if (!ReadLine(line)) {
-          reading_ = false;
-          return;
-        }
-      } else {
-        // CR seen, but not LF.  Bad.
-        VLOG(1) << "tor: stray carriage return";
-        Error();
-        return;
-      }
-    }
-  }
-
-  // If we've walked up to the end of the buffer, try shifting it to
-  // the beginning to make room; if there's no more room, fail --
-  // lines shouldn't be this long.
-  DCHECK(rv <= readiobuf_->RemainingCapacity());
-  if (readiobuf_->RemainingCapacity() == rv) {
-    if (read_start_ == 0) {
-      // Line is too long.
-      VLOG(1) << "tor: control line too long";
+  readiobuf_.reset();
+  switch (read_parser_.DidRead(static_cast<size_t>(rv), this)) {
+    case TorControlParser::Result::kOk:
+      break;
+    case TorControlParser::Result::kStopped:
+      reading_ = false;
+      return;
+    case TorControlParser::Result::kMalformed:
       Error();
       return;
-    }
-    memmove(readiobuf_->StartOfBuffer(),
-            readiobuf_->StartOfBuffer() + read_start_,
-            readiobuf_->offset() - read_start_ + rv);
-    readiobuf_->set_offset(readiobuf_->offset() - read_start_ + rv);
-    read_start_ = 0;
-  } else {
-    // Otherwise, just advance the offset by the size of this input.
-    readiobuf_->set_offset(readiobuf_->offset() + rv);
   }
-  DCHECK(readiobuf_->RemainingCapacity());
 
   // If we've processed every byte in the input so far, and there's no
   // more command callbacks queued or asynchronous events registered,
   // stop.
-  if (read_start_ == readiobuf_->offset() && cmdq_.empty() &&
+  if (!read_parser_.HasPartialLine() && cmdq_.empty() &&
       async_events_.empty()) {
     reading_ = false;
-    readiobuf_.reset();
-    read_start_ = 0;
-    read_cr_ = false;
+    read_parser_.Reset();
     return;
   }
 }
 
+bool TorControl::OnReplyLine(base::StringPiece line) {
+  // The data of a data reply ends before the next reply line.
+  if (in_data_reply_) {
+    FinishDataReply();
+  }
+  return ReadLine(line);
+}
+
+bool TorControl::OnDataLine(base::StringPiece line) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (!in_data_reply_) {
+    VLOG(1) << "tor: control data line outside of a data reply";
+    Error();
+    return false;
+  }
+  data_reply_lines_.emplace_back(line);
+  return true;
+}
+
+// FinishDataReply()
+//
+//      The data of a `xyz+key=' reply line has all been read.  Pass it
+//      on to the command callback as a single `key=data' line, the data
+//      lines joined by newlines, as if it were a `xyz-' line.
+//
+void TorControl::FinishDataReply() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  DCHECK(in_data_reply_);
+  in_data_reply_ = false;
+  const std::string reply =
+      data_reply_key_ + base::JoinString(data_reply_lines_, "\n");
+  data_reply_lines_.clear();
+  if (!cmdq_.empty()) {
+    PerLineCallback& perline = cmdq_.front().first;
+    perline.Run(data_reply_status_, reply);
+  }
+}
+
 // ReadLine(line)
 //
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -889,9 +873,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  const base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  const base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -902,8 +886,8 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -916,7 +900,8 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           if (found == kTorControlEventByName.end()) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
@@ -931,7 +916,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, std::string(initial), {});
 
           return true;
         }
@@ -940,13 +925,14 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Start a fresh async reply state.  Parse the rest, but
           // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(std::string(event_name));
           const TorControlEvent event =
               (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = std::string(initial);
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -1022,8 +1008,12 @@ bool TorControl::ReadLine(const std::string& line) {
         }
         return true;
       case '+':
-        VLOG(2) << "tor: NYI: control data reply";
-        // XXX Just ignore it for now.
+        // Data reply.  Its data lines follow, and it goes to the
+        // command callback once they have all been read.
+        NotifyTorRawMid(status, reply);
+        in_data_reply_ = true;
+        data_reply_status_ = std::string(status);
+        data_reply_key_ = std::string(reply);
         return true;
       case ' ':
         NotifyTorRawEnd(status, reply);
@@ -1066,9 +1056,10 @@ void TorControl::Error() {
     cmdq_.pop();
   }
   reading_ = false;
+  read_parser_.Reset();
   readiobuf_.reset();
-  read_start_ = -1;
-  read_cr_ = false;
+  in_data_reply_ = false;
+  data_reply_lines_.clear();
 
   // Clear write state.
   writeq_ = {};
@@ -1108,28 +1099,31 @@ void TorControl::NotifyTorRawCmd(const std::string& cmd) {
       FROM_HERE, base::BindOnce(&Delegate::OnTorRawCmd, delegate_, cmd));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawAsync, delegate_, status, line));
+      base::BindOnce(&Delegate::OnTorRawAsync, delegate_, std::string(status),
+                     std::string(line)));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawMid, delegate_, status, line));
+      base::BindOnce(&Delegate::OnTorRawMid, delegate_, std::string(status),
+                     std::string(line)));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawEnd, delegate_, status, line));
+      base::BindOnce(&Delegate::OnTorRawEnd, delegate_, std::string(status),
+                     std::string(line)));
 }
 
 // ParseKV(string, key, value)
@@ -1139,7 +1133,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1154,20 +1148,20 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
   size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
+    *key = std::string(string.substr(0, eq));
     *value = "";
     *end = string.size();
     return true;
@@ -1177,7 +1171,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(" ", vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1187,19 +1181,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if (string.find("\"", vstart) != std::string::npos)
+    if (string.find("\"", vstart) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    *key = std::string(string.substr(0, eq));
+    *value = std::string(string.substr(vstart, vend - vstart));
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  *key = std::string(string.substr(0, eq));
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1214,7 +1208,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
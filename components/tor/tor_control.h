@@ -17,7 +17,9 @@
 #include "base/functional/callback_forward.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/tor/tor_control_event.h"
+#include "brave/components/tor/tor_control_parser.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -25,8 +27,8 @@ class SequencedTaskRunner;
 
 namespace net {
 class DrainableIOBuffer;
-class GrowableIOBuffer;
 class TCPClientSocket;
+class WrappedIOBuffer;
 }  // namespace net
 
 namespace tor {
@@ -42,13 +44,13 @@ namespace tor {
 // invalidate the weak ptr on the correct sequence.
 // When calling API with callback, caller should use base::BindPostTask to make
 // sure callback will be ran on the dedicated thread.
-class TorControl {
+class TorControl : public TorControlParser::Delegate {
  public:
   using PerLineCallback =
-      base::RepeatingCallback<void(const std::string& status,
-                                   const std::string& reply)>;
+      base::RepeatingCallback<void(base::StringPiece status,
+                                   base::StringPiece reply)>;
   using CmdCallback = base::OnceCallback<
-      void(bool error, const std::string& status, const std::string& reply)>;
+      void(bool error, base::StringPiece status, base::StringPiece reply)>;
 
   class Delegate : public base::SupportsWeakPtr<Delegate> {
    public:
@@ -73,7 +75,7 @@ class TorControl {
 
   TorControl(base::WeakPtr<TorControl::Delegate> delegate,
              scoped_refptr<base::SequencedTaskRunner> task_runner);
-  virtual ~TorControl();
+  ~TorControl() override;
 
   void Start(std::vector<uint8_t> cookie, int port);
   void Stop();
@@ -105,15 +107,16 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseKV);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, GetCircuitEstablishedDone);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReplayTranscripts);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -122,65 +125,65 @@ class TorControl {
   void StopOnTaskRunner();
   void Connected(std::vector<uint8_t> cookie, int rv);
   void Authenticated(bool error,
-                     const std::string& status,
-                     const std::string& reply);
+                     base::StringPiece status,
+                     base::StringPiece reply);
 
   void DoCmd(std::string cmd, PerLineCallback perline, CmdCallback callback);
 
   void GetVersionLine(std::string* version,
-                      const std::string& status,
-                      const std::string& line);
+                      base::StringPiece status,
+                      base::StringPiece reply);
   void GetVersionDone(
       std::unique_ptr<std::string> version,
       base::OnceCallback<void(bool error, const std::string& version)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
   void GetSOCKSListenersLine(std::vector<std::string>* listeners,
-                             const std::string& status,
-                             const std::string& reply);
+                             base::StringPiece status,
+                             base::StringPiece reply);
   void GetSOCKSListenersDone(
       std::unique_ptr<std::vector<std::string>> listeners,
       base::OnceCallback<
           void(bool error, const std::vector<std::string>& listeners)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
   void GetCircuitEstablishedLine(std::string* established,
-                                 const std::string& status,
-                                 const std::string& reply);
+                                 base::StringPiece status,
+                                 base::StringPiece reply);
   void GetCircuitEstablishedDone(
       std::unique_ptr<std::string> established,
       base::OnceCallback<void(bool error, bool established)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
 
   void DoSubscribe(TorControlEvent event,
                    base::OnceCallback<void(bool error)> callback);
   void Subscribed(TorControlEvent event,
                   base::OnceCallback<void(bool error)> callback,
                   bool error,
-                  const std::string& status,
-                  const std::string& reply);
+                  base::StringPiece status,
+                  base::StringPiece reply);
   void DoUnsubscribe(TorControlEvent event,
                      base::OnceCallback<void(bool error)> callback);
   void Unsubscribed(TorControlEvent event,
                     base::OnceCallback<void(bool error)> callback,
                     bool error,
-                    const std::string& status,
-                    const std::string& reply);
+                    base::StringPiece status,
+                    base::StringPiece reply);
   std::string SetEventsCmd();
 
   void OnPluggableTransportsConfigured(
       base::OnceCallback<void(bool error)> callback,
       bool error,
-      const std::string& status,
-      const std::string& reply);
+      base::StringPiece status,
+      base::StringPiece reply);
   void OnBrigdesConfigured(base::OnceCallback<void(bool error)> callback,
                            bool error,
-                           const std::string& status,
-                           const std::string& reply);
+                           base::StringPiece status,
+                           base::StringPiece reply);
 
   // Notify delegate on UI thread
   void NotifyTorControlReady();
@@ -190,9 +193,9 @@ class TorControl {
                       const std::string& initial,
                       const std::map<std::string, std::string>& extra);
   void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
 
   void StartWrite();
   void DoWrites();
@@ -203,7 +206,13 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
+  // Hands the data reply read so far to the next command callback.
+  void FinishDataReply();
+
+  // TorControlParser::Delegate:
+  bool OnReplyLine(base::StringPiece line) override;
+  bool OnDataLine(base::StringPiece line) override;
 
   void Error();
 
@@ -217,6 +226,9 @@ class TorControl {
   scoped_refptr<base::SequencedTaskRunner> io_task_runner_;
   SEQUENCE_CHECKER(io_sequence_checker_);
 
+  // Owns the buffer |socket_| reads into, so it is declared first to outlive
+  // any read pending when |socket_| is destroyed.
+  TorControlParser read_parser_;
   std::unique_ptr<net::TCPClientSocket> socket_;
 
   // Write state machine.
@@ -227,9 +239,14 @@ class TorControl {
   // Read state machine.
   std::queue<std::pair<PerLineCallback, CmdCallback>> cmdq_;
   bool reading_;
-  scoped_refptr<net::GrowableIOBuffer> readiobuf_;
-  int read_start_;  // offset where the current line starts
-  bool read_cr_;    // true if we have parsed a CR
+  scoped_refptr<net::WrappedIOBuffer> readiobuf_;
+
+  // Data reply being read: the status and `key=' of its `xyz+' line and the
+  // data lines following it.
+  bool in_data_reply_ = false;
+  std::string data_reply_status_;
+  std::string data_reply_key_;
+  std::vector<std::string> data_reply_lines_;
 
   // Asynchronous command response callback state machine.
   std::map<TorControlEvent, size_t> async_events_;
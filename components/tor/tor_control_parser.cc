@@ -0,0 +1,110 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_control_parser.h"
+
+#include <string.h>
+
+#include "base/check_op.h"
+#include "base/logging.h"
+
+namespace tor {
+
+TorControlParser::TorControlParser(size_t capacity)
+    : capacity_(capacity), buffer_(std::make_unique<char[]>(capacity)) {
+  DCHECK_GT(capacity_, 0u);
+}
+
+TorControlParser::~TorControlParser() = default;
+
+base::span<char> TorControlParser::GetWriteBuffer() {
+  DCHECK_LT(end_, capacity_);
+  return base::make_span(buffer_.get() + end_, capacity_ - end_);
+}
+
+TorControlParser::Result TorControlParser::DidRead(size_t size,
+                                                   Delegate* delegate) {
+  DCHECK(delegate);
+  DCHECK_LE(size, capacity_ - end_);
+  const size_t start = end_;
+  end_ += size;
+
+  for (size_t i = start; i < end_; i++) {
+    const char ch = buffer_[i];
+    if (!read_cr_) {
+      // No CR yet.  Accept CR or non-LF; reject LF.
+      if (ch == 0x0d) {  // CR
+        read_cr_ = true;
+      } else if (ch == 0x0a) {  // LF
+        VLOG(1) << "tor: stray line feed";
+        return Result::kMalformed;
+      }
+      continue;
+    }
+
+    // CR seen.  Accept LF; reject all else.
+    if (ch != 0x0a) {
+      VLOG(1) << "tor: stray carriage return";
+      return Result::kMalformed;
+    }
+    read_cr_ = false;
+    // Emit the line without its CRLF and advance to the next one.
+    const base::StringPiece line(buffer_.get() + line_start_,
+                                 i - 1 - line_start_);
+    line_start_ = i + 1;
+    if (!DispatchLine(line, delegate)) {
+      return Result::kStopped;
+    }
+  }
+
+  if (!HasPartialLine()) {
+    // Every line was handed out, so start over from the beginning.
+    line_start_ = 0;
+    end_ = 0;
+  } else if (end_ == capacity_) {
+    // If we've walked up to the end of the buffer, try shifting the
+    // current line to the beginning to make room; if there's no more
+    // room, fail -- lines shouldn't be this long.
+    if (line_start_ == 0) {
+      VLOG(1) << "tor: control line too long";
+      return Result::kMalformed;
+    }
+    memmove(buffer_.get(), buffer_.get() + line_start_, end_ - line_start_);
+    end_ -= line_start_;
+    line_start_ = 0;
+  }
+
+  return Result::kOk;
+}
+
+void TorControlParser::Reset() {
+  line_start_ = 0;
+  end_ = 0;
+  read_cr_ = false;
+  in_data_ = false;
+}
+
+bool TorControlParser::DispatchLine(base::StringPiece line,
+                                    Delegate* delegate) {
+  if (in_data_) {
+    // A lone `.' ends the data; otherwise a leading `.' is doubled.
+    if (line == ".") {
+      in_data_ = false;
+      return true;
+    }
+    if (!line.empty() && line[0] == '.') {
+      line.remove_prefix(1);
+    }
+    return delegate->OnDataLine(line);
+  }
+
+  // `xyz+...' is followed by data.
+  if (line.size() >= 4 && line[3] == '+') {
+    in_data_ = true;
+  }
+  return delegate->OnReplyLine(line);
+}
+
+}  // namespace tor
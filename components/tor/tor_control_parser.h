@@ -0,0 +1,82 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TOR_TOR_CONTROL_PARSER_H_
+#define BRAVE_COMPONENTS_TOR_TOR_CONTROL_PARSER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+
+namespace tor {
+
+// Incremental parser for the replies read from the Tor control channel, see
+// section 2.3 of the control spec. Input is read straight into the parser's
+// fixed size buffer and every complete line is handed to the delegate as a
+// view into that buffer, so nothing is copied or allocated per line. Space
+// taken by lines already handed out is reused: the unfinished line, if any,
+// is moved to the front of the buffer once the end is reached, so lines are
+// always contiguous.
+//
+// Reply lines (`xyz-...', `xyz+...' and `xyz ...') are passed on as is. The
+// data lines following a `xyz+...' line, up to the terminating `.', are
+// passed on separately with their dot encoding undone.
+class TorControlParser {
+ public:
+  class Delegate {
+   public:
+    virtual ~Delegate() = default;
+    // Both return false to stop parsing. |line| is only valid during the
+    // call and doesn't include the CRLF.
+    virtual bool OnReplyLine(base::StringPiece line) = 0;
+    virtual bool OnDataLine(base::StringPiece line) = 0;
+  };
+
+  enum class Result {
+    kOk,
+    // The delegate stopped parsing.
+    kStopped,
+    // Stray CR or LF, or a line which doesn't fit in the buffer.
+    kMalformed,
+  };
+
+  explicit TorControlParser(size_t capacity);
+  TorControlParser(const TorControlParser&) = delete;
+  TorControlParser& operator=(const TorControlParser&) = delete;
+  ~TorControlParser();
+
+  // Where to read the next input to. Never empty.
+  base::span<char> GetWriteBuffer();
+
+  // Parses |size| bytes just read into the write buffer. Once it returns
+  // anything but kOk, the parser has to be Reset before it is used again.
+  Result DidRead(size_t size, Delegate* delegate);
+
+  // Whether part of a line is still waiting for its CRLF.
+  bool HasPartialLine() const { return line_start_ != end_; }
+
+  void Reset();
+
+ private:
+  bool DispatchLine(base::StringPiece line, Delegate* delegate);
+
+  const size_t capacity_;
+  std::unique_ptr<char[]> buffer_;
+  // Offset where the current line starts.
+  size_t line_start_ = 0;
+  // Offset up to which input is valid.
+  size_t end_ = 0;
+  // True if we have parsed a CR.
+  bool read_cr_ = false;
+  // True between a data reply line and the end of its data.
+  bool in_data_ = false;
+};
+
+}  // namespace tor
+
+#endif  // BRAVE_COMPONENTS_TOR_TOR_CONTROL_PARSER_H_
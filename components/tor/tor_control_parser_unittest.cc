@@ -0,0 +1,219 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_control_parser.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/base_paths.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace tor {
+
+namespace {
+
+constexpr const char* kTranscripts[] = {"getinfo", "events", "data_reply"};
+
+class RecordingDelegate : public TorControlParser::Delegate {
+ public:
+  bool OnReplyLine(base::StringPiece line) override {
+    lines.push_back("reply:" + std::string(line));
+    return lines.size() != stop_after;
+  }
+
+  bool OnDataLine(base::StringPiece line) override {
+    lines.push_back("data:" + std::string(line));
+    return lines.size() != stop_after;
+  }
+
+  std::vector<std::string> lines;
+  size_t stop_after = 0;
+};
+
+// Feeds |input| to |parser| |chunk_size| bytes at a time, as reads from the
+// control channel would, stopping at the first result other than kOk.
+TorControlParser::Result Feed(TorControlParser* parser,
+                              base::StringPiece input,
+                              size_t chunk_size,
+                              TorControlParser::Delegate* delegate) {
+  while (!input.empty()) {
+    const base::span<char> buffer = parser->GetWriteBuffer();
+    const size_t size = std::min({chunk_size, buffer.size(), input.size()});
+    memcpy(buffer.data(), input.data(), size);
+    input.remove_prefix(size);
+    const TorControlParser::Result result = parser->DidRead(size, delegate);
+    if (result != TorControlParser::Result::kOk) {
+      return result;
+    }
+  }
+  return TorControlParser::Result::kOk;
+}
+
+std::string ReadTranscript(const std::string& name) {
+  base::FilePath path;
+  EXPECT_TRUE(base::PathService::Get(base::DIR_SOURCE_ROOT, &path));
+  path = path.Append(FILE_PATH_LITERAL("brave"))
+             .Append(FILE_PATH_LITERAL("test"))
+             .Append(FILE_PATH_LITERAL("data"))
+             .AppendASCII("tor")
+             .AppendASCII("tor_control_transcripts")
+             .AppendASCII(name);
+  std::string transcript;
+  EXPECT_TRUE(base::ReadFileToString(path, &transcript)) << path;
+  return transcript;
+}
+
+}  // namespace
+
+TEST(TorControlParserTest, ReplyLines) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "250-SOCKSPORT=9050\r\n250 OK\r\n650 BW 1 2\r\n",
+                 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250-SOCKSPORT=9050",
+                                      "reply:250 OK", "reply:650 BW 1 2"}),
+            delegate.lines);
+  EXPECT_FALSE(parser.HasPartialLine());
+}
+
+TEST(TorControlParserTest, PartialLine) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "250 OK\r\n250-vers", 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250 OK"}), delegate.lines);
+  EXPECT_TRUE(parser.HasPartialLine());
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "ion=0.4.7.13\r", 1024, &delegate));
+  EXPECT_TRUE(parser.HasPartialLine());
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "\n", 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>(
+                {"reply:250 OK", "reply:250-version=0.4.7.13"}),
+            delegate.lines);
+  EXPECT_FALSE(parser.HasPartialLine());
+}
+
+TEST(TorControlParserTest, DataLines) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser,
+                 "250+config-text=\r\nSocksPort 9050\r\n\r\n..hidden\r\n.\r\n"
+                 "250 OK\r\n.\r\n",
+                 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250+config-text=",
+                                      "data:SocksPort 9050", "data:",
+                                      "data:.hidden", "reply:250 OK",
+                                      "reply:."}),
+            delegate.lines);
+}
+
+TEST(TorControlParserTest, StrayLineFeed) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kMalformed,
+            Feed(&parser, "250 OK\n", 1024, &delegate));
+  EXPECT_TRUE(delegate.lines.empty());
+}
+
+TEST(TorControlParserTest, StrayCarriageReturn) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kMalformed,
+            Feed(&parser, "250 OK\r\r\n", 1024, &delegate));
+  EXPECT_TRUE(delegate.lines.empty());
+}
+
+TEST(TorControlParserTest, LineTooLong) {
+  TorControlParser parser(16);
+  RecordingDelegate delegate;
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "250-0123456789\r\n", 1, &delegate));
+  EXPECT_EQ(TorControlParser::Result::kMalformed,
+            Feed(&parser, "250-0123456789ab\r\n", 1, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250-0123456789"}),
+            delegate.lines);
+}
+
+TEST(TorControlParserTest, ReusesBuffer) {
+  TorControlParser parser(16);
+  RecordingDelegate delegate;
+
+  // Far more input than fits in the buffer, with lines straddling its end.
+  std::string input;
+  std::vector<std::string> expected_lines;
+  for (int i = 0; i < 100; i++) {
+    const std::string line = "650 BW " + std::string(i % 8, 'x');
+    input += line + "\r\n";
+    expected_lines.push_back("reply:" + line);
+  }
+
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, input, 7, &delegate));
+  EXPECT_EQ(expected_lines, delegate.lines);
+}
+
+TEST(TorControlParserTest, DelegateStops) {
+  TorControlParser parser(1024);
+  RecordingDelegate delegate;
+  delegate.stop_after = 1;
+
+  EXPECT_EQ(TorControlParser::Result::kStopped,
+            Feed(&parser, "250 OK\r\n250 OK\r\n", 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250 OK"}), delegate.lines);
+
+  parser.Reset();
+  delegate.stop_after = 0;
+  EXPECT_EQ(TorControlParser::Result::kOk,
+            Feed(&parser, "250 OK\r\n", 1024, &delegate));
+  EXPECT_EQ(std::vector<std::string>({"reply:250 OK", "reply:250 OK"}),
+            delegate.lines);
+}
+
+// Replays transcripts of the control channel in every read size, through a
+// buffer small enough to have to be reused, and checks the lines come out the
+// same as when the transcript is read at once.
+TEST(TorControlParserTest, ReplayTranscripts) {
+  for (const char* name : kTranscripts) {
+    const std::string transcript = ReadTranscript(name);
+    ASSERT_FALSE(transcript.empty()) << name;
+
+    TorControlParser whole_parser(transcript.size() + 1);
+    RecordingDelegate expected;
+    ASSERT_EQ(TorControlParser::Result::kOk,
+              Feed(&whole_parser, transcript, transcript.size(), &expected))
+        << name;
+    EXPECT_FALSE(whole_parser.HasPartialLine()) << name;
+    EXPECT_FALSE(expected.lines.empty()) << name;
+
+    for (size_t chunk_size = 1; chunk_size <= transcript.size();
+         chunk_size++) {
+      TorControlParser parser(256);
+      RecordingDelegate delegate;
+      ASSERT_EQ(TorControlParser::Result::kOk,
+                Feed(&parser, transcript, chunk_size, &delegate))
+          << name << ": " << chunk_size;
+      EXPECT_EQ(expected.lines, delegate.lines) << name << ": " << chunk_size;
+    }
+  }
+}
+
+}  // namespace tor
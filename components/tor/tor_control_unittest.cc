@@ -3,12 +3,26 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string.h>
+
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "brave/components/tor/tor_control.h"
 
+#include "base/base_paths.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/functional/callback_helpers.h"
+#include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "net/base/io_buffer.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
@@ -30,6 +44,42 @@ class MockTorControlDelegate : public TorControl::Delegate {
   MOCK_METHOD2(OnTorRawMid, void(const std::string&, const std::string&));
   MOCK_METHOD2(OnTorRawEnd, void(const std::string&, const std::string&));
 };
+
+// Records the events and the end of the control channel.
+class RecordingTorControlDelegate : public TorControl::Delegate {
+ public:
+  void OnTorControlReady() override {}
+  void OnTorControlClosed(bool was_running) override {
+    events.push_back("closed");
+  }
+  void OnTorEvent(TorControlEvent event,
+                  const std::string& initial,
+                  const std::map<std::string, std::string>& extra) override {
+    std::string entry =
+        base::StrCat({kTorControlEventByEnum.at(event), " ", initial});
+    for (const auto& [key, value] : extra) {
+      base::StrAppend(&entry, {" ", key, "=", value});
+    }
+    events.push_back(entry);
+  }
+
+  std::vector<std::string> events;
+};
+
+std::string ReadTranscript(const std::string& name) {
+  base::FilePath path;
+  EXPECT_TRUE(base::PathService::Get(base::DIR_SOURCE_ROOT, &path));
+  path = path.Append(FILE_PATH_LITERAL("brave"))
+             .Append(FILE_PATH_LITERAL("test"))
+             .Append(FILE_PATH_LITERAL("data"))
+             .AppendASCII("tor")
+             .AppendASCII("tor_control_transcripts")
+             .AppendASCII(name);
+  std::string transcript;
+  EXPECT_TRUE(base::ReadFileToString(path, &transcript)) << path;
+  return transcript;
+}
+
 }  // namespace
 
 TEST(TorControlTest, ParseQuoted) {
@@ -302,4 +352,125 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
   base::RunLoop().RunUntilIdle();
 }
 
+// Replays transcripts of the control channel through ReadDone, in several
+// read sizes, and checks what reaches the command callbacks and the delegate.
+TEST(TorControlTest, ReplayTranscripts) {
+  base::test::SingleThreadTaskEnvironment task_environment;
+
+  const struct {
+    const char* name;
+    std::vector<TorControlEvent> subscribed;
+    size_t commands;
+    std::vector<std::string> expected_replies;
+    std::vector<std::string> expected_events;
+  } cases[] = {
+      {"getinfo",
+       {},
+       6,
+       {
+           "0 250 OK",
+           "1 250 OK",
+           "2 250 OK",
+           "3 250-version=0.4.7.13 (git-7c1601fb6edd780f)",
+           "3 250 OK",
+           "4 250-net/listeners/socks=\"127.0.0.1:9050\" "
+           "\"unix:/tmp/tor/socks\"",
+           "4 250 OK",
+           "5 250-status/circuit-established=1",
+           "5 250 OK",
+       },
+       {}},
+      {"events",
+       {TorControlEvent::STATUS_CLIENT, TorControlEvent::NETWORK_LIVENESS,
+        TorControlEvent::CIRC, TorControlEvent::BW},
+       0,
+       {},
+       {
+           "STATUS_CLIENT NOTICE BOOTSTRAP PROGRESS=5 TAG=conn "
+           "SUMMARY=\"Connecting to a relay\"",
+           "STATUS_CLIENT NOTICE BOOTSTRAP PROGRESS=100 TAG=done "
+           "SUMMARY=\"Done\"",
+           "NETWORK_LIVENESS UP",
+           "CIRC 12 LAUNCHED BUILD_FLAGS=NEED_CAPACITY PURPOSE=GENERAL "
+           "TIME_CREATED=2023-03-15T10:41:07.123456",
+           "CIRC 12 BUILT $0123456789ABCDEF0123456789ABCDEF01234567~relay1,"
+           "$89ABCDEF0123456789ABCDEF0123456789ABCDEF~relay2,"
+           "$FEDCBA9876543210FEDCBA9876543210FEDCBA98~relay3 "
+           "BUILD_FLAGS=NEED_CAPACITY PURPOSE=GENERAL "
+           "TIME_CREATED=2023-03-15T10:41:07.123456",
+           "BW 1536 2048",
+           "BW 0 0",
+           "CIRC 13 EXTENDED ANONYMITY=high EXTRAMAGIC=99",
+           "NETWORK_LIVENESS DOWN",
+       }},
+      {"data_reply",
+       {},
+       4,
+       {
+           "0 250-config-text=ControlPort 9051\nSocksPort 9050\n\n.hidden",
+           "0 250 OK",
+           "1 250-info/names=",
+           "1 250 OK",
+           "2 552 Unrecognized key \"foo\"",
+           "3 250 OK",
+       },
+       {}},
+  };
+
+  for (const auto& c : cases) {
+    const std::string transcript = ReadTranscript(c.name);
+    ASSERT_FALSE(transcript.empty()) << c.name;
+
+    for (size_t chunk_size : {size_t{1}, size_t{7}, transcript.size()}) {
+      RecordingTorControlDelegate delegate;
+      TorControl control(delegate.AsWeakPtr(),
+                         base::SequencedTaskRunner::GetCurrentDefault());
+      for (TorControlEvent event : c.subscribed) {
+        control.async_events_[event] = 1;
+      }
+      // Data and end lines are told apart by the separator, as the command
+      // callbacks do by the keys they expect.
+      std::vector<std::string> replies;
+      for (size_t i = 0; i < c.commands; i++) {
+        const std::string prefix = base::NumberToString(i);
+        control.cmdq_.emplace(
+            base::BindLambdaForTesting(
+                [&replies, prefix](base::StringPiece status,
+                                   base::StringPiece reply) {
+                  replies.push_back(
+                      base::StrCat({prefix, " ", status, "-", reply}));
+                }),
+            base::BindLambdaForTesting(
+                [&replies, prefix](bool error, base::StringPiece status,
+                                   base::StringPiece reply) {
+                  EXPECT_FALSE(error);
+                  replies.push_back(
+                      base::StrCat({prefix, " ", status, " ", reply}));
+                }));
+      }
+
+      // Reads into the parser's buffer as DoReads does.
+      control.reading_ = true;
+      base::StringPiece input = transcript;
+      while (!input.empty() && control.reading_) {
+        const base::span<char> buffer = control.read_parser_.GetWriteBuffer();
+        const size_t size =
+            std::min({chunk_size, buffer.size(), input.size()});
+        memcpy(buffer.data(), input.data(), size);
+        input.remove_prefix(size);
+        control.readiobuf_ =
+            base::MakeRefCounted<net::WrappedIOBuffer>(buffer.data());
+        control.ReadDone(static_cast<int>(size));
+      }
+      base::RunLoop().RunUntilIdle();
+
+      EXPECT_TRUE(input.empty()) << c.name << ": " << chunk_size;
+      EXPECT_TRUE(control.cmdq_.empty()) << c.name << ": " << chunk_size;
+      EXPECT_EQ(c.expected_replies, replies) << c.name << ": " << chunk_size;
+      EXPECT_EQ(c.expected_events, delegate.events)
+          << c.name << ": " << chunk_size;
+    }
+  }
+}
+
 }  // namespace tor
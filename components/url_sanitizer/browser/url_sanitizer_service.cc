@@ -8,10 +8,9 @@
 #include <memory>
 #include <vector>
 
+#include "base/functional/bind.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
-#include "base/strings/string_split.h"
-#include "base/strings/string_util.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "extensions/common/url_pattern.h"
@@ -88,6 +87,10 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
   return matchers;
 }
 
+bool MatchesItem(const URLSanitizerService::MatchItem* item, const GURL& url) {
+  return item->include.MatchesURL(url) && !item->exclude.MatchesURL(url);
+}
+
 }  // namespace
 
 URLSanitizerService::URLSanitizerService() = default;
@@ -112,66 +115,35 @@ void URLSanitizerService::Initialize(const std::string& json) {
 void URLSanitizerService::UpdateMatchers(
     base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> mappings) {
   matchers_ = std::move(mappings);
+  // The parameters of all matchers are stripped in a single pass, so the URL
+  // patterns are matched against the URL before any parameter is removed.
+  query_param_stripper_ = query_filter::QueryParamStripper();
+  for (const auto& it : matchers_) {
+    query_param_stripper_.AddParams(
+        std::vector<base::StringPiece>(it->params.begin(), it->params.end()),
+        base::BindRepeating(&MatchesItem, base::Unretained(it.get())));
+  }
   if (initialization_callback_for_testing_)
     std::move(initialization_callback_for_testing_).Run();
 }
 
 GURL URLSanitizerService::SanitizeURL(const GURL& initial_url) {
-  if (matchers_.empty() || !initial_url.SchemeIsHTTPOrHTTPS())
+  if (query_param_stripper_.empty() || !initial_url.SchemeIsHTTPOrHTTPS())
     return initial_url;
-  GURL url = initial_url;
-  for (const auto& it : matchers_) {
-    if (!it->include.MatchesURL(url) || it->exclude.MatchesURL(url))
-      continue;
-    auto sanitized_query = StripQueryParameter(url.query(), it->params);
-    GURL::Replacements replacements;
-    if (!sanitized_query.empty()) {
-      replacements.SetQueryStr(sanitized_query);
-    } else {
-      replacements.ClearQuery();
-    }
-    url = url.ReplaceComponents(replacements);
-  }
-  return url;
+  return query_param_stripper_.Strip(initial_url).value_or(initial_url);
 }
 
 void URLSanitizerService::OnRulesReady(const std::string& json_content) {
   Initialize(json_content);
 }
 
-// FIXME: merge with
-// browser/net/brave_site_hacks_network_delegate_helper.cc::StripQueryParameter()
-// Remove tracking query parameters from a GURL, leaving all
-// other parts untouched.
 std::string URLSanitizerService::StripQueryParameter(
     const std::string& query,
     const base::flat_set<std::string>& trackers) {
-  // We are using custom query string parsing code here. See
-  // https://github.com/brave/brave-core/pull/13726#discussion_r897712350
-  // for more information on why this approach was selected.
-  //
-  // Split query string by ampersands, remove tracking parameters,
-  // then join the remaining query parameters, untouched, back into
-  // a single query string.
-  const std::vector<std::string> input_kv_strings =
-      SplitString(query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  std::vector<std::string> output_kv_strings;
-  int disallowed_count = 0;
-  for (const std::string& kv_string : input_kv_strings) {
-    const std::vector<std::string> pieces = SplitString(
-        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-    const std::string& key = pieces.empty() ? std::string() : pieces[0];
-    if (pieces.size() >= 2 && trackers.count(key) == 1) {
-      ++disallowed_count;
-    } else {
-      output_kv_strings.push_back(kv_string);
-    }
-  }
-  if (disallowed_count > 0) {
-    return base::JoinString(output_kv_strings, "&");
-  } else {
-    return query;
-  }
+  query_filter::QueryParamStripper stripper;
+  stripper.AddParams(
+      std::vector<base::StringPiece>(trackers.begin(), trackers.end()));
+  return stripper.StripQuery(query, GURL()).value_or(query);
 }
 
 }  // namespace brave
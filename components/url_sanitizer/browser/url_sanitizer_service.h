@@ -16,6 +16,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
+#include "brave/components/query_filter/query_param_stripper.h"
 #include "brave/components/url_sanitizer/browser/url_sanitizer_component_installer.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "extensions/common/url_pattern_set.h"
@@ -60,6 +61,8 @@ class URLSanitizerService : public KeyedService,
 
  private:
   base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers_;
+  // Refers to |matchers_|.
+  query_filter::QueryParamStripper query_param_stripper_;
   base::OnceClosure initialization_callback_for_testing_;
   base::WeakPtrFactory<URLSanitizerService> weak_factory_{this};
 };
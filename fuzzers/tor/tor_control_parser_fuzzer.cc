@@ -0,0 +1,59 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+#include <string.h>
+
+#include <string>
+
+#include "base/check_op.h"
+#include "base/logging.h"
+#include "brave/components/tor/tor_control_parser.h"
+
+namespace {
+
+// Large enough for the control lines tor sends, small enough to be
+// reused often.
+constexpr size_t kBufferSize = 256;
+
+class Delegate : public tor::TorControlParser::Delegate {
+ public:
+  bool OnReplyLine(base::StringPiece line) override {
+    CHECK_EQ(line.find_first_of("\r\n"), base::StringPiece::npos);
+    return true;
+  }
+
+  bool OnDataLine(base::StringPiece line) override {
+    CHECK_EQ(line.find_first_of("\r\n"), base::StringPiece::npos);
+    return true;
+  }
+};
+
+}  // namespace
+
+struct Environment {
+  Environment() { logging::SetMinLogLevel(logging::LOG_FATAL); }
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static Environment env;
+
+  FuzzedDataProvider data_provider(data, size);
+
+  tor::TorControlParser parser(kBufferSize);
+  Delegate delegate;
+  while (data_provider.remaining_bytes() > 0) {
+    const base::span<char> buffer = parser.GetWriteBuffer();
+    const std::string input = data_provider.ConsumeBytesAsString(
+        data_provider.ConsumeIntegralInRange<size_t>(1, buffer.size()));
+    memcpy(buffer.data(), input.data(), input.size());
+    if (parser.DidRead(input.size(), &delegate) !=
+        tor::TorControlParser::Result::kOk) {
+      parser.Reset();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,414 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/net/cookies/ephemeral_cookie_store.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/contains.h"
+#include "base/feature_list.h"
+#include "base/notreached.h"
+#include "base/time/time.h"
+#include "net/base/features.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/cookies/cookie_constants.h"
+#include "net/cookies/cookie_monster.h"
+#include "net/cookies/cookie_partition_key.h"
+#include "net/cookies/cookie_util.h"
+
+namespace net {
+
+namespace {
+
+using CookieMap = std::multimap<std::string, std::unique_ptr<CanonicalCookie>>;
+using CookieItVector = std::vector<CookieMap::iterator>;
+
+// Same as CookieMonster::GetKey().
+std::string GetKey(base::StringPiece domain) {
+  std::string effective_domain =
+      registry_controlled_domains::GetDomainAndRegistry(
+          domain, registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  if (effective_domain.empty()) {
+    effective_domain = std::string(domain);
+  }
+  return cookie_util::CookieDomainAsHost(effective_domain);
+}
+
+// Longest path first, then oldest first, as CookieMonster returns them.
+bool CookieSorter(const CanonicalCookie* cc1, const CanonicalCookie* cc2) {
+  if (cc1->Path().length() == cc2->Path().length()) {
+    return cc1->CreationDate() < cc2->CreationDate();
+  }
+  return cc1->Path().length() > cc2->Path().length();
+}
+
+bool LastAccessSorter(const CanonicalCookie* cc1, const CanonicalCookie* cc2) {
+  return cc1->LastAccessDate() < cc2->LastAccessDate();
+}
+
+void SortLeastRecentlyAccessed(CookieItVector& cookies) {
+  std::sort(cookies.begin(), cookies.end(),
+            [](const auto& it1, const auto& it2) {
+              return LastAccessSorter(it1->second.get(), it2->second.get());
+            });
+}
+
+// Same partitioned cookies as CookieMonster returns for |collection|.
+bool IsInPartitionKeyCollection(
+    const CanonicalCookie& cookie,
+    const CookiePartitionKeyCollection& collection) {
+  if (!cookie.IsPartitioned()) {
+    return true;
+  }
+  return collection.ContainsAllKeys() ||
+         collection.PartitionKeys().contains(*cookie.PartitionKey());
+}
+
+// Removes the expired of |cookies| from |map| and returns the others.
+CookieItVector PurgeExpired(const CookieItVector& cookies,
+                            base::Time now,
+                            CookieMap& map) {
+  CookieItVector unexpired;
+  for (const auto& it : cookies) {
+    if (it->second->IsExpired(now)) {
+      map.erase(it);
+    } else {
+      unexpired.push_back(it);
+    }
+  }
+  return unexpired;
+}
+
+// CookieMonster's eviction rounds within a domain, from non-secure low
+// priority cookies to secure high priority ones.
+constexpr struct {
+  CookiePriority priority;
+  bool protect_secure_cookies;
+} kPurgeRounds[] = {
+    {COOKIE_PRIORITY_LOW, true},     {COOKIE_PRIORITY_LOW, false},
+    {COOKIE_PRIORITY_MEDIUM, true},  {COOKIE_PRIORITY_HIGH, true},
+    {COOKIE_PRIORITY_MEDIUM, false}, {COOKIE_PRIORITY_HIGH, false},
+};
+
+size_t GetDomainCookiesQuota(CookiePriority priority) {
+  switch (priority) {
+    case COOKIE_PRIORITY_LOW:
+      return CookieMonster::kDomainCookiesQuotaLow;
+    case COOKIE_PRIORITY_MEDIUM:
+      return CookieMonster::kDomainCookiesQuotaMedium;
+    case COOKIE_PRIORITY_HIGH:
+      return CookieMonster::kDomainCookiesQuotaHigh;
+  }
+  NOTREACHED();
+  return 0;
+}
+
+// Same as CookieMonster::PurgeLeastRecentMatches(): evicts the least recently
+// accessed of |cookies| at |priority|, sorted that way, until |purge_goal| are
+// evicted. The priority's quota of cookies, and the secure cookies if
+// |protect_secure_cookies|, are spared. Returns the number evicted.
+size_t PurgeLeastRecentMatches(CookieItVector& cookies,
+                               CookiePriority priority,
+                               size_t purge_goal,
+                               bool protect_secure_cookies,
+                               CookieMap& map) {
+  const size_t to_protect = GetDomainCookiesQuota(priority);
+  size_t priority_count = 0;
+  size_t secure_count = 0;
+  for (const auto& it : cookies) {
+    if (it->second->Priority() == priority) {
+      priority_count++;
+      secure_count += it->second->IsSecure();
+    }
+  }
+  if (priority_count <= to_protect) {
+    return 0;
+  }
+
+  size_t evictable_count =
+      priority_count -
+      (protect_secure_cookies ? std::max(secure_count, to_protect)
+                              : to_protect);
+  size_t removed = 0;
+  size_t current = 0;
+  while (removed < purge_goal && current < cookies.size() &&
+         evictable_count > 0) {
+    const CanonicalCookie& cookie = *cookies[current]->second;
+    if (cookie.Priority() == priority &&
+        (!protect_secure_cookies || !cookie.IsSecure())) {
+      map.erase(cookies[current]);
+      cookies.erase(cookies.begin() + current);
+      removed++;
+      evictable_count--;
+    } else {
+      current++;
+    }
+  }
+  return removed;
+}
+
+// Same as CookieMonster::GarbageCollectLeastRecentlyAccessed(): evicts up to
+// |purge_goal| of the least recently accessed |cookies|, but none accessed
+// since |safe_date|. Returns the number evicted.
+size_t EvictLeastRecentlyAccessed(CookieItVector cookies,
+                                  size_t purge_goal,
+                                  base::Time safe_date,
+                                  CookieMap& map) {
+  purge_goal = std::min(purge_goal, cookies.size());
+  std::partial_sort(cookies.begin(), cookies.begin() + purge_goal,
+                    cookies.end(), [](const auto& it1, const auto& it2) {
+                      return LastAccessSorter(it1->second.get(),
+                                              it2->second.get());
+                    });
+  size_t removed = 0;
+  while (removed < purge_goal &&
+         cookies[removed]->second->LastAccessDate() < safe_date) {
+    map.erase(cookies[removed]);
+    removed++;
+  }
+  return removed;
+}
+
+}  // namespace
+
+EphemeralCookieStore::EphemeralCookieStore()
+    : cookieable_schemes_(CookieMonster::kDefaultCookieableSchemes,
+                          CookieMonster::kDefaultCookieableSchemes +
+                              CookieMonster::kDefaultCookieableSchemesCount),
+      same_party_attribute_enabled_(
+          base::FeatureList::IsEnabled(features::kSamePartyAttributeEnabled)) {}
+
+EphemeralCookieStore::~EphemeralCookieStore() = default;
+
+CookieAccessParams EphemeralCookieStore::GetAccessParams(
+    const CanonicalCookie& cookie,
+    const CookieOptions& options) const {
+  // Ephemeral cookies never had a CookieAccessDelegate.
+  return CookieAccessParams(
+      CookieAccessSemantics::UNKNOWN,
+      /*delegate_treats_url_as_trustworthy=*/false,
+      cookie_util::GetSamePartyStatus(cookie, options,
+                                      same_party_attribute_enabled_));
+}
+
+void EphemeralCookieStore::SetCanonicalCookie(
+    const std::string& partition,
+    std::unique_ptr<CanonicalCookie> cookie,
+    const GURL& source_url,
+    const CookieOptions& options,
+    CookieStore::SetCookiesCallback callback,
+    absl::optional<CookieAccessResult> cookie_access_result) {
+  CookieAccessResult access_result = cookie->IsSetPermittedInContext(
+      source_url, options, GetAccessParams(*cookie, options),
+      cookieable_schemes_, cookie_access_result);
+
+  const base::Time now = base::Time::Now();
+  if (cookie->CreationDate().is_null()) {
+    cookie->SetCreationDate(now);
+  }
+  const bool already_expired = cookie->IsExpired(cookie->CreationDate());
+
+  CookieMap& cookies = partitions_[partition];
+  const std::string key = GetKey(cookie->Domain());
+  auto range = cookies.equal_range(key);
+  auto equivalent_it = cookies.end();
+  for (auto it = range.first; it != range.second; ++it) {
+    const CanonicalCookie& existing = *it->second;
+    // Leave secure cookies alone, as CookieMonster does.
+    if (!access_result.is_allowed_to_access_secure_cookies &&
+        existing.IsSecure() &&
+        cookie->IsEquivalentForSecureCookieMatching(existing)) {
+      access_result.status.AddExclusionReason(
+          CookieInclusionStatus::EXCLUDE_OVERWRITE_SECURE);
+    }
+    if (cookie->IsEquivalent(existing)) {
+      if (options.exclude_httponly() && existing.IsHttpOnly()) {
+        access_result.status.AddExclusionReason(
+            CookieInclusionStatus::EXCLUDE_OVERWRITE_HTTP_ONLY);
+      } else {
+        equivalent_it = it;
+      }
+    }
+  }
+
+  if (access_result.status.IsInclude()) {
+    if (equivalent_it != cookies.end()) {
+      cookie->SetCreationDate(equivalent_it->second->CreationDate());
+      cookies.erase(equivalent_it);
+    }
+    // An expired cookie only deletes the one it replaces.
+    if (!already_expired) {
+      cookies.emplace(key, std::move(cookie));
+      GarbageCollect(key, cookies);
+    }
+  }
+  if (cookies.empty()) {
+    partitions_.erase(partition);
+  }
+
+  if (callback) {
+    std::move(callback).Run(std::move(access_result));
+  }
+}
+
+void EphemeralCookieStore::GetCookieListWithOptions(
+    const std::string& partition,
+    const GURL& url,
+    const CookieOptions& options,
+    const CookiePartitionKeyCollection& cookie_partition_key_collection,
+    CookieStore::GetCookieListCallback callback) {
+  CookieAccessResultList included_cookies;
+  CookieAccessResultList excluded_cookies;
+
+  auto partition_it = partitions_.find(partition);
+  if (partition_it != partitions_.end() &&
+      base::Contains(cookieable_schemes_, url.scheme())) {
+    CookieMap& cookies = partition_it->second;
+    const base::Time now = base::Time::Now();
+    std::vector<CanonicalCookie*> matching_cookies;
+    auto range = cookies.equal_range(GetKey(url.host()));
+    for (auto it = range.first; it != range.second;) {
+      if (it->second->IsExpired(now)) {
+        it = cookies.erase(it);
+        continue;
+      }
+      if (it->second->IsDomainMatch(url.host()) &&
+          IsInPartitionKeyCollection(*it->second,
+                                     cookie_partition_key_collection)) {
+        matching_cookies.push_back(it->second.get());
+      }
+      ++it;
+    }
+
+    std::sort(matching_cookies.begin(), matching_cookies.end(), CookieSorter);
+    for (CanonicalCookie* cookie : matching_cookies) {
+      CookieAccessResult access_result = cookie->IncludeForRequestURL(
+          url, options, GetAccessParams(*cookie, options));
+      if (access_result.status.IsInclude()) {
+        if (options.update_access_time()) {
+          cookie->SetLastAccessDate(now);
+        }
+        included_cookies.push_back({*cookie, std::move(access_result)});
+      } else if (options.return_excluded_cookies()) {
+        excluded_cookies.push_back({*cookie, std::move(access_result)});
+      }
+    }
+    if (cookies.empty()) {
+      partitions_.erase(partition_it);
+    }
+  }
+
+  if (callback) {
+    std::move(callback).Run(included_cookies, excluded_cookies);
+  }
+}
+
+void EphemeralCookieStore::DeleteCanonicalCookie(
+    const CanonicalCookie& cookie) {
+  DeleteMatching([&cookie](const CanonicalCookie& candidate) {
+    return candidate.IsEquivalent(cookie) &&
+           candidate.Value() == cookie.Value();
+  });
+}
+
+void EphemeralCookieStore::DeleteAllCreatedInTimeRange(
+    const CookieDeletionInfo::TimeRange& creation_range) {
+  DeleteMatching([&creation_range](const CanonicalCookie& cookie) {
+    return creation_range.Contains(cookie.CreationDate());
+  });
+}
+
+void EphemeralCookieStore::DeleteAllMatchingInfo(
+    const CookieDeletionInfo& delete_info) {
+  DeleteMatching([this, &delete_info](const CanonicalCookie& cookie) {
+    return delete_info.Matches(cookie,
+                               GetAccessParams(cookie, CookieOptions()));
+  });
+}
+
+void EphemeralCookieStore::DeleteSessionCookies() {
+  DeleteMatching(
+      [](const CanonicalCookie& cookie) { return !cookie.IsPersistent(); });
+}
+
+void EphemeralCookieStore::SetCookieableSchemes(
+    const std::vector<std::string>& schemes) {
+  cookieable_schemes_ = schemes;
+}
+
+void EphemeralCookieStore::DeletePartition(const std::string& partition) {
+  partitions_.erase(partition);
+}
+
+void EphemeralCookieStore::DeleteMatching(
+    base::FunctionRef<bool(const CanonicalCookie&)> predicate) {
+  for (auto partition_it = partitions_.begin();
+       partition_it != partitions_.end();) {
+    CookieMap& cookies = partition_it->second;
+    for (auto it = cookies.begin(); it != cookies.end();) {
+      it = predicate(*it->second) ? cookies.erase(it) : std::next(it);
+    }
+    partition_it =
+        cookies.empty() ? partitions_.erase(partition_it) : ++partition_it;
+  }
+}
+
+void EphemeralCookieStore::GarbageCollect(const std::string& key,
+                                          CookieMap& cookies) {
+  const base::Time now = base::Time::Now();
+
+  if (cookies.count(key) > CookieMonster::kDomainMaxCookies) {
+    CookieItVector domain_cookies;
+    auto range = cookies.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      domain_cookies.push_back(it);
+    }
+    domain_cookies = PurgeExpired(domain_cookies, now, cookies);
+
+    if (domain_cookies.size() > CookieMonster::kDomainMaxCookies) {
+      size_t purge_goal =
+          domain_cookies.size() - (CookieMonster::kDomainMaxCookies -
+                                   CookieMonster::kDomainPurgeCookies);
+      SortLeastRecentlyAccessed(domain_cookies);
+      for (const auto& round : kPurgeRounds) {
+        if (purge_goal == 0) {
+          break;
+        }
+        purge_goal -=
+            PurgeLeastRecentMatches(domain_cookies, round.priority, purge_goal,
+                                    round.protect_secure_cookies, cookies);
+      }
+    }
+  }
+
+  if (cookies.size() > CookieMonster::kMaxCookies) {
+    CookieItVector all_cookies;
+    for (auto it = cookies.begin(); it != cookies.end(); ++it) {
+      all_cookies.push_back(it);
+    }
+    all_cookies = PurgeExpired(all_cookies, now, cookies);
+
+    if (all_cookies.size() > CookieMonster::kMaxCookies) {
+      size_t purge_goal = all_cookies.size() - (CookieMonster::kMaxCookies -
+                                                CookieMonster::kPurgeCookies);
+      CookieItVector secure_cookies;
+      CookieItVector non_secure_cookies;
+      for (const auto& it : all_cookies) {
+        (it->second->IsSecure() ? secure_cookies : non_secure_cookies)
+            .push_back(it);
+      }
+      // Non-secure cookies go first, and recently accessed cookies stay.
+      const base::Time safe_date =
+          now - base::Days(CookieMonster::kSafeFromGlobalPurgeDays);
+      purge_goal -= EvictLeastRecentlyAccessed(
+          std::move(non_secure_cookies), purge_goal, safe_date, cookies);
+      EvictLeastRecentlyAccessed(std::move(secure_cookies), purge_goal,
+                                 safe_date, cookies);
+    }
+  }
+}
+
+}  // namespace net
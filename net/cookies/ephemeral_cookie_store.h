@@ -0,0 +1,93 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_NET_COOKIES_EPHEMERAL_COOKIE_STORE_H_
+#define BRAVE_NET_COOKIES_EPHEMERAL_COOKIE_STORE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/functional/function_ref.h"
+#include "net/base/net_export.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_access_result.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_partition_key_collection.h"
+#include "net/cookies/cookie_store.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace net {
+
+// In-memory store for the cookies of all ephemeral storage partitions of a
+// CookieMonster. Cookies are grouped by partition, i.e. the ephemeral storage
+// domain of the top frame, and inside a partition by the eTLD+1 of the cookie
+// domain, the same way CookieMonster keys them. Ending a partition's lifetime
+// is a single map erase. Nothing is persisted and no change notifications are
+// sent, as for the in-memory CookieMonsters this replaces. Garbage collection
+// follows CookieMonster's thresholds, priority quotas and eviction order,
+// applied per partition.
+class NET_EXPORT EphemeralCookieStore {
+ public:
+  EphemeralCookieStore();
+  ~EphemeralCookieStore();
+
+  EphemeralCookieStore(const EphemeralCookieStore&) = delete;
+  EphemeralCookieStore& operator=(const EphemeralCookieStore&) = delete;
+
+  // Both run |callback| synchronously.
+  void SetCanonicalCookie(
+      const std::string& partition,
+      std::unique_ptr<CanonicalCookie> cookie,
+      const GURL& source_url,
+      const CookieOptions& options,
+      CookieStore::SetCookiesCallback callback,
+      absl::optional<CookieAccessResult> cookie_access_result);
+  void GetCookieListWithOptions(
+      const std::string& partition,
+      const GURL& url,
+      const CookieOptions& options,
+      const CookiePartitionKeyCollection& cookie_partition_key_collection,
+      CookieStore::GetCookieListCallback callback);
+
+  // These apply to every partition.
+  void DeleteCanonicalCookie(const CanonicalCookie& cookie);
+  void DeleteAllCreatedInTimeRange(
+      const CookieDeletionInfo::TimeRange& creation_range);
+  void DeleteAllMatchingInfo(const CookieDeletionInfo& delete_info);
+  void DeleteSessionCookies();
+  void SetCookieableSchemes(const std::vector<std::string>& schemes);
+
+  void DeletePartition(const std::string& partition);
+
+  size_t GetPartitionCount() const { return partitions_.size(); }
+
+ private:
+  // Keyed by the eTLD+1 of the cookie domain.
+  using CookieMap =
+      std::multimap<std::string, std::unique_ptr<CanonicalCookie>>;
+
+  CookieAccessParams GetAccessParams(const CanonicalCookie& cookie,
+                                     const CookieOptions& options) const;
+  // Deletes the cookies |predicate| returns true for from every partition and
+  // drops the partitions left empty.
+  void DeleteMatching(
+      base::FunctionRef<bool(const CanonicalCookie&)> predicate);
+  // Once |key| or |cookies| has more than the allowed number of cookies,
+  // purges the expired ones, then evicts the least recently accessed, the
+  // same way CookieMonster::GarbageCollect does.
+  void GarbageCollect(const std::string& key, CookieMap& cookies);
+
+  std::map<std::string, CookieMap> partitions_;
+  std::vector<std::string> cookieable_schemes_;
+  const bool same_party_attribute_enabled_;
+};
+
+}  // namespace net
+
+#endif  // BRAVE_NET_COOKIES_EPHEMERAL_COOKIE_STORE_H_
@@ -0,0 +1,90 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/functional/callback_helpers.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/net/cookies/ephemeral_cookie_store.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_partition_key_collection.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "EphemeralCookieStore.";
+constexpr char kMetricSetTime[] = "set_time";
+constexpr char kMetricGetTime[] = "get_time";
+constexpr char kMetricDeletePartitionTime[] = "delete_partition_time";
+
+constexpr int kPartitions = 200;
+constexpr int kTrackers = 20;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricSetTime, "us");
+  reporter.RegisterImportantMetric(kMetricGetTime, "us");
+  reporter.RegisterImportantMetric(kMetricDeletePartitionTime, "us");
+  return reporter;
+}
+
+}  // namespace
+
+// Times cookie access and partition teardown with many ephemeral partitions,
+// each with the cookies of the same trackers.
+TEST(EphemeralCookieStorePerfTest, ManyPartitions) {
+  EphemeralCookieStore store;
+  std::vector<GURL> tracker_urls;
+  for (int i = 0; i < kTrackers; ++i) {
+    tracker_urls.emplace_back(base::StringPrintf("https://tracker%d.com/", i));
+  }
+  std::vector<std::string> partitions;
+  for (int i = 0; i < kPartitions; ++i) {
+    partitions.push_back(base::StringPrintf("site%d.com", i));
+  }
+  constexpr int kAccesses = kPartitions * kTrackers;
+  auto reporter = SetUpReporter("200_partitions");
+
+  base::ElapsedTimer set_timer;
+  for (const std::string& partition : partitions) {
+    for (const GURL& url : tracker_urls) {
+      store.SetCanonicalCookie(
+          partition,
+          CanonicalCookie::Create(url, "id=1; max-age=3600", base::Time::Now(),
+                                  absl::nullopt, absl::nullopt),
+          url, CookieOptions::MakeAllInclusive(), base::DoNothing(),
+          absl::nullopt);
+    }
+  }
+  reporter.AddResult(kMetricSetTime, set_timer.Elapsed() / kAccesses);
+
+  base::ElapsedTimer get_timer;
+  for (const std::string& partition : partitions) {
+    for (const GURL& url : tracker_urls) {
+      store.GetCookieListWithOptions(
+          partition, url, CookieOptions::MakeAllInclusive(),
+          CookiePartitionKeyCollection(), base::DoNothing());
+    }
+  }
+  reporter.AddResult(kMetricGetTime, get_timer.Elapsed() / kAccesses);
+
+  base::ElapsedTimer delete_timer;
+  for (const std::string& partition : partitions) {
+    store.DeletePartition(partition);
+  }
+  reporter.AddResult(kMetricDeletePartitionTime,
+                     delete_timer.Elapsed() / kPartitions);
+  EXPECT_EQ(0u, store.GetPartitionCount());
+}
+
+}  // namespace net
@@ -0,0 +1,227 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/net/cookies/ephemeral_cookie_store.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/time/time.h"
+#include "net/base/features.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_monster.h"
+#include "net/cookies/cookie_options.h"
+#include "net/cookies/cookie_partition_key.h"
+#include "net/cookies/cookie_partition_key_collection.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+bool SetCookie(EphemeralCookieStore* store,
+               const std::string& partition,
+               const GURL& url,
+               const std::string& cookie_line,
+               absl::optional<CookiePartitionKey> cookie_partition_key =
+                   absl::nullopt,
+               base::Time creation_time = base::Time::Now()) {
+  auto cookie = CanonicalCookie::Create(url, cookie_line, creation_time,
+                                        absl::nullopt, cookie_partition_key);
+  if (!cookie) {
+    return false;
+  }
+  bool result = false;
+  store->SetCanonicalCookie(
+      partition, std::move(cookie), url, CookieOptions::MakeAllInclusive(),
+      base::BindLambdaForTesting([&result](CookieAccessResult access_result) {
+        result = access_result.status.IsInclude();
+      }),
+      absl::nullopt);
+  return result;
+}
+
+std::string GetCookies(EphemeralCookieStore* store,
+                       const std::string& partition,
+                       const GURL& url,
+                       const CookiePartitionKeyCollection&
+                           cookie_partition_key_collection =
+                               CookiePartitionKeyCollection()) {
+  std::string result;
+  store->GetCookieListWithOptions(
+      partition, url, CookieOptions::MakeAllInclusive(),
+      cookie_partition_key_collection,
+      base::BindLambdaForTesting([&result](const CookieAccessResultList& list,
+                                           const CookieAccessResultList&) {
+        for (const auto& cookie_with_access_result : list) {
+          if (!result.empty()) {
+            result += "; ";
+          }
+          const CanonicalCookie& cookie = cookie_with_access_result.cookie;
+          result += cookie.Name() + "=" + cookie.Value();
+        }
+      }));
+  return result;
+}
+
+size_t CountCookies(const std::string& cookies) {
+  return std::count(cookies.begin(), cookies.end(), '=');
+}
+
+}  // namespace
+
+TEST(EphemeralCookieStoreTest, PartitionsAreIsolated) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "id=1"));
+  EXPECT_TRUE(SetCookie(&store, "b.com", url, "id=2"));
+
+  EXPECT_EQ("id=1", GetCookies(&store, "a.com", url));
+  EXPECT_EQ("id=2", GetCookies(&store, "b.com", url));
+  EXPECT_EQ("", GetCookies(&store, "c.com", url));
+  EXPECT_EQ(2u, store.GetPartitionCount());
+}
+
+TEST(EphemeralCookieStoreTest, OverwritesEquivalentCookie) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/path");
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "id=1"));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "id=2"));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "other=3; path=/path"));
+  EXPECT_EQ("other=3; id=2", GetCookies(&store, "a.com", url));
+
+  // Setting an expired cookie deletes the existing one.
+  EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                        "id=2; expires=Thu, 01 Jan 1970 00:00:00 GMT"));
+  EXPECT_EQ("other=3", GetCookies(&store, "a.com", url));
+}
+
+TEST(EphemeralCookieStoreTest, RespectsCookieableSchemes) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "id=1"));
+  store.SetCookieableSchemes({"http"});
+  EXPECT_EQ("", GetCookies(&store, "a.com", url));
+  EXPECT_FALSE(SetCookie(&store, "a.com", url, "id=2"));
+}
+
+TEST(EphemeralCookieStoreTest, Deletion) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "session=1"));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "persistent=1; max-age=3600"));
+  EXPECT_TRUE(SetCookie(&store, "b.com", url, "session=2"));
+  EXPECT_TRUE(SetCookie(&store, "c.com", url, "persistent=3; max-age=3600"));
+
+  store.DeleteSessionCookies();
+  EXPECT_EQ("persistent=1", GetCookies(&store, "a.com", url));
+  EXPECT_EQ("", GetCookies(&store, "b.com", url));
+  EXPECT_EQ(2u, store.GetPartitionCount());
+
+  store.DeletePartition("a.com");
+  EXPECT_EQ("", GetCookies(&store, "a.com", url));
+  EXPECT_EQ("persistent=3", GetCookies(&store, "c.com", url));
+
+  CookieDeletionInfo delete_info;
+  delete_info.host = "tracker.com";
+  store.DeleteAllMatchingInfo(delete_info);
+  EXPECT_EQ("", GetCookies(&store, "c.com", url));
+  EXPECT_EQ(0u, store.GetPartitionCount());
+}
+
+TEST(EphemeralCookieStoreTest, FiltersPartitionedCookies) {
+  base::test::ScopedFeatureList feature_list(features::kPartitionedCookies);
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  const auto a_key =
+      CookiePartitionKey::FromURLForTesting(GURL("https://a.com"));
+  const auto b_key =
+      CookiePartitionKey::FromURLForTesting(GURL("https://b.com"));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "unpartitioned=1"));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                        "a=1; Secure; SameSite=None; Partitioned; path=/a",
+                        a_key));
+  EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                        "b=1; Secure; SameSite=None; Partitioned", b_key));
+
+  EXPECT_EQ("unpartitioned=1", GetCookies(&store, "a.com", url));
+  EXPECT_EQ("unpartitioned=1",
+            GetCookies(&store, "a.com", url,
+                       CookiePartitionKeyCollection(a_key)));
+  EXPECT_EQ("a=1; unpartitioned=1",
+            GetCookies(&store, "a.com", GURL("https://tracker.com/a"),
+                       CookiePartitionKeyCollection(a_key)));
+  EXPECT_EQ(3u, CountCookies(GetCookies(
+                    &store, "a.com", GURL("https://tracker.com/a"),
+                    CookiePartitionKeyCollection::ContainsAll())));
+}
+
+TEST(EphemeralCookieStoreTest, DomainCookiesAreBounded) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  for (size_t i = 0; i <= CookieMonster::kDomainMaxCookies; ++i) {
+    EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                          base::StringPrintf("c%zu=1", i)));
+  }
+  EXPECT_EQ(
+      CookieMonster::kDomainMaxCookies - CookieMonster::kDomainPurgeCookies,
+      CountCookies(GetCookies(&store, "a.com", url)));
+}
+
+TEST(EphemeralCookieStoreTest, ExpiredCookiesArePurgedFirst) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  // Expired by now, but not when created.
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "expired=1; max-age=60",
+                        absl::nullopt, base::Time::Now() - base::Minutes(2)));
+  for (size_t i = 0; i < CookieMonster::kDomainMaxCookies; ++i) {
+    EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                          base::StringPrintf("c%zu=1", i)));
+  }
+  EXPECT_EQ(CookieMonster::kDomainMaxCookies,
+            CountCookies(GetCookies(&store, "a.com", url)));
+}
+
+TEST(EphemeralCookieStoreTest, SecureCookieSurvivesEviction) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  // Least recently accessed, but evicted only after the non-secure cookies.
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "secure=1; Secure"));
+  for (size_t i = 0; i < CookieMonster::kDomainMaxCookies; ++i) {
+    EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                          base::StringPrintf("c%zu=1", i)));
+  }
+  const std::string cookies = GetCookies(&store, "a.com", url);
+  EXPECT_EQ(
+      CookieMonster::kDomainMaxCookies - CookieMonster::kDomainPurgeCookies,
+      CountCookies(cookies));
+  EXPECT_NE(std::string::npos, cookies.find("secure=1"));
+  EXPECT_EQ(std::string::npos, cookies.find("c0=1"));
+}
+
+TEST(EphemeralCookieStoreTest, HighPriorityCookieSurvivesEviction) {
+  EphemeralCookieStore store;
+  const GURL url("https://tracker.com/");
+  // Least recently accessed, but evicted only after the medium priority
+  // cookies beyond their quota.
+  EXPECT_TRUE(SetCookie(&store, "a.com", url, "high=1; Priority=High"));
+  for (size_t i = 0; i < CookieMonster::kDomainMaxCookies; ++i) {
+    EXPECT_TRUE(SetCookie(&store, "a.com", url,
+                          base::StringPrintf("c%zu=1", i)));
+  }
+  const std::string cookies = GetCookies(&store, "a.com", url);
+  EXPECT_EQ(
+      CookieMonster::kDomainMaxCookies - CookieMonster::kDomainPurgeCookies,
+      CountCookies(cookies));
+  EXPECT_NE(std::string::npos, cookies.find("high=1"));
+  EXPECT_EQ(std::string::npos, cookies.find("c0=1"));
+}
+
+}  // namespace net
@@ -0,0 +1,112 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+
+#include <string.h>
+
+#include "base/check.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+#include "third_party/boringssl/src/include/openssl/siphash.h"
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t zero = 0;
+constexpr size_t kCanvasKeySize = 32;
+
+inline uint64_t lfsr_next(uint64_t v) {
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+void ComputeCanvasKeyV1(uint64_t key,
+                        const uint8_t* pixels,
+                        size_t size,
+                        uint8_t* canvas_key) {
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&key), sizeof key));
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
+               canvas_key, kCanvasKeySize));
+}
+
+void ComputeCanvasKeyV2(uint64_t key,
+                        const uint8_t* pixels,
+                        size_t size,
+                        uint8_t* canvas_key) {
+  const uint64_t sip_key[2] = {key, static_cast<uint64_t>(size)};
+  uint64_t digest = 0;
+  if (size <= kCanvasFarblingFullHashMaxBytes) {
+    digest = SIPHASH_24(sip_key, pixels, size);
+  } else {
+    // Tiles are spread evenly so that the first one starts at the beginning
+    // of the buffer and the last one ends at its end. Each tile is keyed with
+    // the digest of the previous ones, chaining them into a single hash.
+    const size_t stride = (size - kCanvasFarblingTileBytes) /
+                          (kCanvasFarblingSampledTiles - 1);
+    uint64_t chained_key[2] = {key, 0};
+    for (size_t i = 0; i < kCanvasFarblingSampledTiles; i++) {
+      chained_key[1] = static_cast<uint64_t>(size) ^ digest;
+      digest = SIPHASH_24(chained_key, pixels + i * stride,
+                          kCanvasFarblingTileBytes);
+    }
+  }
+  // Expand the 64-bit digest into the 32 bytes consumed by the perturbation
+  // loop.
+  for (size_t i = 0; i < kCanvasKeySize / sizeof(uint64_t); i++) {
+    const uint64_t block[2] = {digest, static_cast<uint64_t>(i)};
+    const uint64_t word = SIPHASH_24(
+        sip_key, reinterpret_cast<const uint8_t*>(block), sizeof block);
+    memcpy(canvas_key + i * sizeof(uint64_t), &word, sizeof word);
+  }
+}
+
+}  // namespace
+
+void PerturbCanvasPixels(CanvasFarblingVersion version,
+                         uint64_t key,
+                         uint8_t* pixels,
+                         size_t size) {
+  if (!pixels || size == 0)
+    return;
+
+  // Four bytes per pixel
+  const size_t pixel_count = size / 4;
+  if (pixel_count == 0)
+    return;
+  // calculate initial seed to find first pixel to perturb, based on session
+  // key, domain key, and canvas contents
+  uint8_t canvas_key[kCanvasKeySize];
+  switch (version) {
+    case CanvasFarblingVersion::kV1:
+      ComputeCanvasKeyV1(key, pixels, size, canvas_key);
+      break;
+    case CanvasFarblingVersion::kV2:
+      ComputeCanvasKeyV2(key, pixels, size, canvas_key);
+      break;
+  }
+  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
+  uint64_t pixel_index;
+  // choose which channel (R, G, or B) to perturb
+  uint8_t channel;
+  // iterate through 32-byte canvas key and use each bit to determine how to
+  // perturb the current pixel
+  for (size_t i = 0; i < kCanvasKeySize; i++) {
+    uint8_t bit = canvas_key[i];
+    for (int j = 0; j < 16; j++) {
+      if (j % 8 == 0)
+        bit = canvas_key[i];
+      channel = v % 3;
+      pixel_index = 4 * (v % pixel_count) + channel;
+      pixels[pixel_index] = pixels[pixel_index] ^ (bit & 0x1);
+      bit = bit >> 1;
+      // find next pixel to perturb
+      v = lfsr_next(v);
+    }
+  }
+}
+
+}  // namespace brave
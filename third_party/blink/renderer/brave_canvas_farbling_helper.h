@@ -0,0 +1,42 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "third_party/blink/public/platform/web_common.h"
+
+namespace brave {
+
+// Selects how the per-canvas key that drives pixel perturbation is derived.
+enum class CanvasFarblingVersion {
+  // HMAC-SHA256 over the whole pixel buffer.
+  kV1,
+  // SipHash-2-4 over a fixed number of tiles sampled from the pixel buffer.
+  // Small canvases are still hashed in full.
+  kV2,
+};
+
+// Canvases up to this many bytes are always hashed in full.
+inline constexpr size_t kCanvasFarblingFullHashMaxBytes = 64 * 1024;
+// Number and size of the tiles sampled from larger canvases.
+inline constexpr size_t kCanvasFarblingSampledTiles = 64;
+inline constexpr size_t kCanvasFarblingTileBytes = 1024;
+
+// Flips the low bit of up to 512 color channels in the RGBA |pixels| buffer.
+// Which channels are flipped is derived from |key| (the session and domain
+// keys) and the canvas contents, so the result is deterministic for a given
+// session, domain and image.
+BLINK_EXPORT void PerturbCanvasPixels(CanvasFarblingVersion version,
+                                      uint64_t key,
+                                      uint8_t* pixels,
+                                      size_t size);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
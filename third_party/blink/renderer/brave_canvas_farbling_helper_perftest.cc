@@ -0,0 +1,54 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/timer/elapsed_timer.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "BraveCanvasFarbling.";
+constexpr char kMetricTimePerCanvas[] = "time_per_canvas";
+
+constexpr uint64_t kKey = 0x0123456789abcdefULL;
+constexpr int kIterations = 20;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimePerCanvas, "us");
+  return reporter;
+}
+
+void RunBenchmark(CanvasFarblingVersion version, const std::string& story) {
+  std::vector<uint8_t> pixels(3840 * 2160 * 4);
+  for (size_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = static_cast<uint8_t>((i * 31 + i / 7) & 0xff);
+  }
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; i++) {
+    PerturbCanvasPixels(version, kKey, pixels.data(), pixels.size());
+  }
+  SetUpReporter(story).AddResult(kMetricTimePerCanvas,
+                                 timer.Elapsed() / kIterations);
+}
+
+}  // namespace
+
+TEST(BraveCanvasFarblingHelperPerfTest, V1_4KCanvas) {
+  RunBenchmark(CanvasFarblingVersion::kV1, "v1_4k_canvas");
+}
+
+TEST(BraveCanvasFarblingHelperPerfTest, V2_4KCanvas) {
+  RunBenchmark(CanvasFarblingVersion::kV2, "v2_4k_canvas");
+}
+
+}  // namespace brave
@@ -0,0 +1,103 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t kKey = 0x0123456789abcdefULL;
+constexpr uint64_t kOtherKey = 0xfedcba9876543210ULL;
+
+std::vector<uint8_t> MakeCanvas(size_t width, size_t height) {
+  std::vector<uint8_t> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = static_cast<uint8_t>((i * 31 + i / 7) & 0xff);
+  }
+  return pixels;
+}
+
+std::vector<uint8_t> Perturb(CanvasFarblingVersion version,
+                             uint64_t key,
+                             std::vector<uint8_t> pixels) {
+  PerturbCanvasPixels(version, key, pixels.data(), pixels.size());
+  return pixels;
+}
+
+}  // namespace
+
+class BraveCanvasFarblingHelperTest
+    : public testing::TestWithParam<CanvasFarblingVersion> {};
+
+TEST_P(BraveCanvasFarblingHelperTest, OnlyFlipsLowBitsOfColorChannels) {
+  for (size_t width : {1, 16, 200, 1024}) {
+    const std::vector<uint8_t> original = MakeCanvas(width, width);
+    const std::vector<uint8_t> farbled = Perturb(GetParam(), kKey, original);
+    ASSERT_EQ(original.size(), farbled.size());
+    size_t changed = 0;
+    for (size_t i = 0; i < original.size(); i++) {
+      if (original[i] == farbled[i])
+        continue;
+      changed++;
+      EXPECT_EQ(1, original[i] ^ farbled[i]);
+      EXPECT_NE(3u, i % 4) << "alpha channel must not be perturbed";
+    }
+    EXPECT_LE(changed, 512u);
+  }
+}
+
+TEST_P(BraveCanvasFarblingHelperTest, DeterministicPerKeyAndContent) {
+  const std::vector<uint8_t> original = MakeCanvas(512, 512);
+  const std::vector<uint8_t> farbled = Perturb(GetParam(), kKey, original);
+  EXPECT_EQ(farbled, Perturb(GetParam(), kKey, original));
+  EXPECT_NE(farbled, Perturb(GetParam(), kOtherKey, original));
+}
+
+TEST_P(BraveCanvasFarblingHelperTest, HandlesDegenerateBuffers) {
+  PerturbCanvasPixels(GetParam(), kKey, nullptr, 0);
+  std::vector<uint8_t> tiny = {1, 2, 3};
+  PerturbCanvasPixels(GetParam(), kKey, tiny.data(), tiny.size());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3}), tiny);
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         BraveCanvasFarblingHelperTest,
+                         testing::Values(CanvasFarblingVersion::kV1,
+                                         CanvasFarblingVersion::kV2));
+
+TEST(BraveCanvasFarblingHelperV2Test, SmallCanvasesAreHashedInFull) {
+  std::vector<uint8_t> original = MakeCanvas(64, 64);
+  ASSERT_LE(original.size(), kCanvasFarblingFullHashMaxBytes);
+  const std::vector<uint8_t> farbled =
+      Perturb(CanvasFarblingVersion::kV2, kKey, original);
+  // Changing a single pixel anywhere must change which pixels are perturbed.
+  original[original.size() / 2 + 1] ^= 0x80;
+  std::vector<uint8_t> refarbled =
+      Perturb(CanvasFarblingVersion::kV2, kKey, original);
+  refarbled[original.size() / 2 + 1] ^= 0x80;
+  EXPECT_NE(farbled, refarbled);
+}
+
+TEST(BraveCanvasFarblingHelperV2Test, SampledTilesCoverBufferEnds) {
+  std::vector<uint8_t> original = MakeCanvas(1024, 1024);
+  ASSERT_GT(original.size(), kCanvasFarblingFullHashMaxBytes);
+  const std::vector<uint8_t> farbled =
+      Perturb(CanvasFarblingVersion::kV2, kKey, original);
+  for (size_t index : {size_t(0), original.size() - 1}) {
+    std::vector<uint8_t> modified = original;
+    modified[index] ^= 0x80;
+    std::vector<uint8_t> refarbled =
+        Perturb(CanvasFarblingVersion::kV2, kKey, modified);
+    refarbled[index] ^= 0x80;
+    EXPECT_NE(farbled, refarbled) << index;
+  }
+}
+
+}  // namespace brave
@@ -8,6 +8,7 @@
 
 #include <string>
 
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "brave/third_party/blink/renderer/platform/brave_audio_farbling_helper.h"
 #include "third_party/abseil-cpp/absl/random/random.h"
@@ -96,6 +97,7 @@ class CORE_EXPORT BraveSessionCache final
   uint8_t domain_key_[32];
   WTF::HashMap<FarbleKey, int> farbled_integers_;
   BraveFarblingLevel farbling_level_;
+  CanvasFarblingVersion canvas_farbling_version_;
   absl::optional<blink::BraveAudioFarblingHelper> audio_farbling_helper_;
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
@@ -6,40 +6,91 @@
 #include "brave/third_party/blink/renderer/platform/brave_audio_farbling_helper.h"
 
 #include <limits.h>
+#include <string.h>
 
+#include <algorithm>
+
+#include "base/numerics/safe_conversions.h"
 #include "third_party/blink/renderer/platform/audio/audio_utilities.h"
+#include "third_party/blink/renderer/platform/audio/vector_math.h"
 
 namespace blink {
 namespace {
 
 constexpr uint64_t zero = 0;
 constexpr double maxUInt64AsDouble = static_cast<double>(UINT64_MAX);
+// Number of LFSR states produced per block in GenerateNoise.
+constexpr size_t kNoiseBlockSize = 64;
 
 inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
+// Advances the LFSR |count| times starting from |*state| and writes the
+// resulting samples to |dst|. States are produced by a tight integer loop and
+// converted to samples in a separate pass that the compiler can vectorize.
+void GenerateNoise(uint64_t* state, float* dst, size_t count) {
+  uint64_t states[kNoiseBlockSize];
+  uint64_t v = *state;
+  for (size_t offset = 0; offset < count; offset += kNoiseBlockSize) {
+    const size_t block = std::min(kNoiseBlockSize, count - offset);
+    for (size_t i = 0; i < block; ++i) {
+      v = lfsr_next(v);
+      states[i] = v;
+    }
+    for (size_t i = 0; i < block; ++i) {
+      dst[offset + i] = (states[i] / maxUInt64AsDouble) / 10;
+    }
+  }
+  *state = v;
+}
+
 }  // namespace
 
 BraveAudioFarblingHelper::BraveAudioFarblingHelper(double fudge_factor,
                                                    uint64_t seed,
                                                    bool max)
-    : fudge_factor_(fudge_factor), seed_(seed), max_(max) {}
+    : fudge_factor_(fudge_factor), max_(max), noise_state_(seed) {}
+
+BraveAudioFarblingHelper::BraveAudioFarblingHelper(
+    const BraveAudioFarblingHelper&) = default;
+BraveAudioFarblingHelper& BraveAudioFarblingHelper::operator=(
+    const BraveAudioFarblingHelper&) = default;
+BraveAudioFarblingHelper::BraveAudioFarblingHelper(
+    BraveAudioFarblingHelper&&) = default;
+BraveAudioFarblingHelper& BraveAudioFarblingHelper::operator=(
+    BraveAudioFarblingHelper&&) = default;
 
 BraveAudioFarblingHelper::~BraveAudioFarblingHelper() = default;
 
+const float* BraveAudioFarblingHelper::GetNoise(size_t count) const {
+  if (noise_.size() < count) {
+    const size_t cached = noise_.size();
+    noise_.resize(count);
+    GenerateNoise(&noise_state_, noise_.data() + cached, count - cached);
+  }
+  return noise_.data();
+}
+
 void BraveAudioFarblingHelper::FarbleAudioChannel(float* dst,
                                                   size_t count) const {
+  if (count == 0) {
+    return;
+  }
   if (max_) {
-    uint64_t v = seed_;
-    for (size_t i = 0; i < count; i++) {
-      v = lfsr_next(v);
-      dst[i] = (v / maxUInt64AsDouble) / 10;
+    // The noise only depends on the seed, so the prefix that fits in the
+    // cache is copied and anything past it is generated on the fly.
+    const float* noise = GetNoise(std::min(count, kMaxCachedNoiseFrames));
+    const size_t cached = std::min(count, noise_.size());
+    memcpy(dst, noise, cached * sizeof(float));
+    if (count > cached) {
+      uint64_t v = noise_state_;
+      GenerateNoise(&v, dst + cached, count - cached);
     }
   } else {
-    for (size_t i = 0; i < count; i++) {
-      dst[i] = dst[i] * fudge_factor_;
-    }
+    const float fudge_factor = static_cast<float>(fudge_factor_);
+    vector_math::Vsmul(dst, 1, &fudge_factor, dst, 1,
+                       base::checked_cast<uint32_t>(count));
   }
 }
 
@@ -51,22 +102,26 @@ void BraveAudioFarblingHelper::FarbleFloatTimeDomainData(
     unsigned write_index,
     unsigned fft_size,
     unsigned input_buffer_size) const {
+  if (len == 0) {
+    return;
+  }
   if (max_) {
-    uint64_t v = seed_;
-    for (size_t i = 0; i < len; ++i) {
-      v = lfsr_next(v);
-      float value = (v / maxUInt64AsDouble) / 10;
-      destination[i] = value;
-    }
+    memcpy(destination, GetNoise(len), len * sizeof(float));
   } else {
-    for (size_t i = 0; i < len; ++i) {
-      // Buffer access is protected due to modulo operation.
-      float value =
-          fudge_factor_ *
-          input_buffer[(i + write_index - fft_size + input_buffer_size) %
-                       input_buffer_size];
-
-      destination[i] = value;
+    // The input is a ring buffer, so it is scaled in at most two contiguous
+    // runs: from the read position to the end and then from the start.
+    const float fudge_factor = static_cast<float>(fudge_factor_);
+    size_t read_index =
+        (static_cast<size_t>(write_index) + input_buffer_size - fft_size) %
+        input_buffer_size;
+    size_t done = 0;
+    while (done < len) {
+      const size_t run = std::min(len - done, input_buffer_size - read_index);
+      vector_math::Vsmul(input_buffer + read_index, 1, &fudge_factor,
+                         destination + done, 1,
+                         base::checked_cast<uint32_t>(run));
+      done += run;
+      read_index = 0;
     }
   }
 }
@@ -80,10 +135,9 @@ void BraveAudioFarblingHelper::FarbleByteTimeDomainData(
     unsigned fft_size,
     unsigned input_buffer_size) const {
   if (max_) {
-    uint64_t v = seed_;
+    const float* noise = GetNoise(len);
     for (size_t i = 0; i < len; ++i) {
-      v = lfsr_next(v);
-      float value = (v / maxUInt64AsDouble) / 10;
+      float value = noise[i];
 
       // Scale from nominal -1 -> +1 to unsigned byte.
       double scaled_value = 128 * (value + 1);
@@ -130,10 +184,9 @@ void BraveAudioFarblingHelper::FarbleConvertToByteData(
     double min_decibels,
     double range_scale_factor) const {
   if (max_) {
-    uint64_t v = seed_;
+    const float* noise = GetNoise(len);
     for (size_t i = 0; i < len; ++i) {
-      v = lfsr_next(v);
-      float linear_value = (v / maxUInt64AsDouble) / 10;
+      float linear_value = noise[i];
       double db_mag = audio_utilities::LinearToDecibels(linear_value);
 
       // The range m_minDecibels to m_maxDecibels will be scaled to byte values
@@ -179,10 +232,9 @@ void BraveAudioFarblingHelper::FarbleConvertFloatToDb(const float* source,
                                                       float* destination,
                                                       size_t len) const {
   if (max_) {
-    uint64_t v = seed_;
+    const float* noise = GetNoise(len);
     for (size_t i = 0; i < len; ++i) {
-      v = lfsr_next(v);
-      float linear_value = (v / maxUInt64AsDouble) / 10;
+      float linear_value = noise[i];
       double db_mag = audio_utilities::LinearToDecibels(linear_value);
       destination[i] = static_cast<float>(db_mag);
     }
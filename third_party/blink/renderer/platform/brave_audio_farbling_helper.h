@@ -9,13 +9,23 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "third_party/blink/renderer/platform/platform_export.h"
 
 namespace blink {
 
 class PLATFORM_EXPORT BraveAudioFarblingHelper final {
  public:
+  // Noise samples beyond this many frames are not cached. This covers the
+  // largest AnalyserNode FFT size.
+  static constexpr size_t kMaxCachedNoiseFrames = 32768;
+
   BraveAudioFarblingHelper(double fudge_factor, uint64_t seed, bool max);
+  BraveAudioFarblingHelper(const BraveAudioFarblingHelper&);
+  BraveAudioFarblingHelper& operator=(const BraveAudioFarblingHelper&);
+  BraveAudioFarblingHelper(BraveAudioFarblingHelper&&);
+  BraveAudioFarblingHelper& operator=(BraveAudioFarblingHelper&&);
   ~BraveAudioFarblingHelper();
 
   void FarbleAudioChannel(float* dst, size_t count) const;
@@ -41,9 +51,17 @@ class PLATFORM_EXPORT BraveAudioFarblingHelper final {
                               size_t len) const;
 
  private:
+  // Returns at least |count| samples of the LFSR noise used in maximum mode,
+  // generating and caching any that have not been produced yet.
+  const float* GetNoise(size_t count) const;
+
   double fudge_factor_;
-  uint64_t seed_;
   bool max_;
+  // Noise is a pure function of the seed, so it is generated once and reused.
+  // |noise_state_| is the LFSR state after the last cached sample and starts
+  // out as the seed.
+  mutable std::vector<float> noise_;
+  mutable uint64_t noise_state_;
 };
 
 }  // namespace blink
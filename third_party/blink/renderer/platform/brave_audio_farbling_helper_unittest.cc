@@ -0,0 +1,89 @@
+/* Copyright (c) 2023 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/platform/brave_audio_farbling_helper.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+
+namespace {
+
+constexpr uint64_t kSeed = 0x5eed5eed5eed5eedULL;
+constexpr double kFudgeFactor = 0.995;
+constexpr size_t kOneSecondFrames = 48000;
+
+// Scalar reference for the noise produced in maximum mode.
+std::vector<float> ReferenceNoise(size_t count) {
+  constexpr uint64_t zero = 0;
+  std::vector<float> noise(count);
+  uint64_t v = kSeed;
+  for (size_t i = 0; i < count; i++) {
+    v = ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+    noise[i] = (v / static_cast<double>(UINT64_MAX)) / 10;
+  }
+  return noise;
+}
+
+std::vector<float> MakeSignal(size_t count) {
+  std::vector<float> signal(count);
+  for (size_t i = 0; i < count; i++) {
+    signal[i] = static_cast<float>(i % 200) / 100.0f - 1.0f;
+  }
+  return signal;
+}
+
+}  // namespace
+
+TEST(BraveAudioFarblingHelperTest, MaxNoiseMatchesReference) {
+  const BraveAudioFarblingHelper helper(kFudgeFactor, kSeed, true);
+  // Shorter than, equal to and longer than the cached prefix.
+  for (size_t count :
+       {size_t(1), size_t(1000), BraveAudioFarblingHelper::kMaxCachedNoiseFrames,
+        kOneSecondFrames}) {
+    std::vector<float> channel(count, 1.0f);
+    helper.FarbleAudioChannel(channel.data(), channel.size());
+    EXPECT_EQ(ReferenceNoise(count), channel) << count;
+  }
+
+  std::vector<float> time_domain(2048);
+  helper.FarbleFloatTimeDomainData(nullptr, time_domain.data(),
+                                   time_domain.size(), 0, 2048, 2048);
+  EXPECT_EQ(ReferenceNoise(2048), time_domain);
+}
+
+TEST(BraveAudioFarblingHelperTest, BalancedScalesSamples) {
+  const BraveAudioFarblingHelper helper(kFudgeFactor, kSeed, false);
+  const std::vector<float> signal = MakeSignal(kOneSecondFrames);
+  std::vector<float> channel = signal;
+  helper.FarbleAudioChannel(channel.data(), channel.size());
+  for (size_t i = 0; i < signal.size(); i++) {
+    EXPECT_FLOAT_EQ(signal[i] * kFudgeFactor, channel[i]);
+  }
+}
+
+TEST(BraveAudioFarblingHelperTest, BalancedTimeDomainWrapsRingBuffer) {
+  const BraveAudioFarblingHelper helper(kFudgeFactor, kSeed, false);
+  constexpr unsigned kInputBufferSize = 4096;
+  constexpr unsigned kFFTSize = 2048;
+  const std::vector<float> input = MakeSignal(kInputBufferSize);
+  for (unsigned write_index : {0u, 1000u, kFFTSize, 3000u}) {
+    std::vector<float> destination(kFFTSize);
+    helper.FarbleFloatTimeDomainData(input.data(), destination.data(),
+                                     destination.size(), write_index, kFFTSize,
+                                     kInputBufferSize);
+    for (size_t i = 0; i < destination.size(); i++) {
+      const float expected =
+          kFudgeFactor *
+          input[(i + write_index - kFFTSize + kInputBufferSize) %
+                kInputBufferSize];
+      EXPECT_FLOAT_EQ(expected, destination[i]) << write_index << " " << i;
+    }
+  }
+}
+
+}  // namespace blink